@@ -0,0 +1,47 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+
+namespace Confus
+{
+    class OpenALBuffer;
+
+    namespace Assets
+    {
+        /// <summary> The kinds of assets that are loaded and tracked </summary>
+        enum class EAssetType
+        {
+            Texture, ///< An image, decoded on a worker and uploaded to the video driver.
+            Mesh, ///< A mesh file, read on a worker and parsed into Irrlicht's mesh cache.
+            Sound ///< A wave file relative to the media folder, read on a worker and uploaded to OpenAL.
+        };
+
+        /// <summary>
+        /// A reference to an asset in the <see cref="AssetRegistry"/>, typed by the kind of asset it refers to.
+        /// The generation is bumped whenever a slot is reused, so a handle to an unloaded asset resolves to nullptr
+        /// instead of to whatever was loaded into its slot afterwards.
+        /// </summary>
+        /// <remarks> Handles are plain values, copying one does not add a reference to the asset </remarks>
+        template<typename TAsset>
+        struct AssetHandle
+        {
+            /// <summary> The index of the slot in the registry, InvalidIndex if the handle refers to nothing </summary>
+            irr::u32 Index = InvalidIndex;
+            /// <summary> The generation of the slot at the time the handle was given out </summary>
+            irr::u32 Generation = 0;
+
+            static const irr::u32 InvalidIndex = 0xFFFFFFFF;
+
+            /// <summary>
+            /// Whether the handle was given out by a registry, it may still have been released since.
+            /// </summary>
+            bool isValid() const
+            {
+                return Index != InvalidIndex;
+            }
+        };
+
+        using TextureHandle = AssetHandle<irr::video::ITexture>;
+        using MeshHandle = AssetHandle<irr::scene::IAnimatedMesh>;
+        using SoundHandle = AssetHandle<OpenALBuffer>;
+    }
+}
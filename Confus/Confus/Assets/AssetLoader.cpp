@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "AssetLoader.h"
+
+namespace Confus
+{
+    namespace Assets
+    {
+        namespace
+        {
+            /// <summary>
+            /// Reads a whole file into memory.
+            /// </summary>
+            bool readFile(const std::string& a_Path, std::vector<char>& a_Data)
+            {
+                std::ifstream stream(a_Path, std::ios::binary | std::ios::ate);
+                if(!stream)
+                {
+                    return false;
+                }
+                a_Data.resize(static_cast<size_t>(stream.tellg()));
+                stream.seekg(0);
+                return static_cast<bool>(stream.read(a_Data.data(), a_Data.size()));
+            }
+
+            /// <summary>
+            /// A file over memory owned by the caller, so the workers can hand file data to the image loaders
+            /// without going through Irrlicht's file system.
+            /// </summary>
+            class MemoryReadFile : public irr::io::IReadFile
+            {
+            private:
+                const std::vector<char>& m_Data;
+                irr::io::path m_FileName;
+                long m_Position = 0;
+            public:
+                MemoryReadFile(const std::vector<char>& a_Data, const std::string& a_FileName)
+                    : m_Data(a_Data), m_FileName(a_FileName.c_str())
+                {
+                }
+
+                virtual irr::s32 read(void* a_Buffer, irr::u32 a_SizeToRead) override
+                {
+                    long size = std::min(static_cast<long>(a_SizeToRead), getSize() - m_Position);
+                    std::copy(m_Data.data() + m_Position, m_Data.data() + m_Position + size, static_cast<char*>(a_Buffer));
+                    m_Position += size;
+                    return static_cast<irr::s32>(size);
+                }
+
+                virtual bool seek(long a_FinalPosition, bool a_RelativeMovement) override
+                {
+                    long position = a_RelativeMovement ? m_Position + a_FinalPosition : a_FinalPosition;
+                    if(position < 0 || position > getSize())
+                    {
+                        return false;
+                    }
+                    m_Position = position;
+                    return true;
+                }
+
+                virtual long getSize() const override
+                {
+                    return static_cast<long>(m_Data.size());
+                }
+
+                virtual long getPos() const override
+                {
+                    return m_Position;
+                }
+
+                virtual const irr::io::path& getFileName() const override
+                {
+                    return m_FileName;
+                }
+            };
+        }
+
+        AssetLoader::AssetLoader(irr::IrrlichtDevice* a_Device, AssetRegistry& a_Registry, const std::vector<AssetRequest>& a_Assets)
+            : m_Device(a_Device), m_Registry(a_Registry), m_NextJob(0)
+        {
+            m_Jobs.resize(a_Assets.size());
+            size_t remainingTextures = 0;
+            for(size_t i = 0; i < a_Assets.size(); ++i)
+            {
+                m_Jobs[i].Type = a_Assets[i].Type;
+                m_Jobs[i].Path = a_Assets[i].Path;
+                if(a_Assets[i].Type == EAssetType::Texture)
+                {
+                    ++remainingTextures;
+                }
+            }
+
+            auto driver = m_Device->getVideoDriver();
+            for(irr::u32 i = 0; i < driver->getImageLoaderCount(); ++i)
+            {
+                m_ImageLoaders.push_back(driver->getImageLoader(i));
+            }
+
+            //One core is left for the main thread, which uploads the assets as they come in
+            size_t coreCount = std::thread::hardware_concurrency();
+            size_t workerCount = std::min(coreCount > 1 ? coreCount - 1 : 1, m_Jobs.size());
+            for(size_t i = 0; i < workerCount; ++i)
+            {
+                m_Workers.emplace_back(&AssetLoader::work, this);
+            }
+
+            //Meshes look up their textures while being parsed, so they wait until every texture is in the cache
+            std::vector<size_t> waitingMeshes;
+            std::vector<size_t> finishedJobs;
+            while(m_CompletedJobCount < m_Jobs.size())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_FinishedMutex);
+                    m_FinishedCondition.wait_for(lock, std::chrono::milliseconds(16), [this]() { return !m_FinishedJobs.empty(); });
+                    finishedJobs.swap(m_FinishedJobs);
+                }
+
+                for(size_t jobIndex : finishedJobs)
+                {
+                    Job& job = m_Jobs[jobIndex];
+                    if(job.Type == EAssetType::Mesh && remainingTextures > 0)
+                    {
+                        waitingMeshes.push_back(jobIndex);
+                        continue;
+                    }
+                    if(job.Type == EAssetType::Texture)
+                    {
+                        --remainingTextures;
+                    }
+                    upload(job);
+                }
+                finishedJobs.clear();
+
+                if(remainingTextures == 0)
+                {
+                    for(size_t jobIndex : waitingMeshes)
+                    {
+                        upload(m_Jobs[jobIndex]);
+                    }
+                    waitingMeshes.clear();
+                }
+
+                m_Device->run();
+                drawProgress();
+            }
+
+            for(auto& worker : m_Workers)
+            {
+                worker.join();
+            }
+            m_Workers.clear();
+        }
+
+        AssetLoader::~AssetLoader()
+        {
+            for(auto& worker : m_Workers)
+            {
+                worker.join();
+            }
+
+            for(auto& texture : m_Textures)
+            {
+                m_Registry.release(texture);
+            }
+            for(auto& mesh : m_Meshes)
+            {
+                m_Registry.release(mesh);
+            }
+            for(auto& sound : m_Sounds)
+            {
+                m_Registry.release(sound);
+            }
+        }
+
+        float AssetLoader::getProgress() const
+        {
+            if(m_Jobs.empty())
+            {
+                return 1.0f;
+            }
+            return static_cast<float>(m_CompletedJobCount) / m_Jobs.size();
+        }
+
+        void AssetLoader::work()
+        {
+            for(size_t jobIndex = m_NextJob++; jobIndex < m_Jobs.size(); jobIndex = m_NextJob++)
+            {
+                read(m_Jobs[jobIndex]);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_FinishedMutex);
+                    m_FinishedJobs.push_back(jobIndex);
+                }
+                m_FinishedCondition.notify_one();
+            }
+        }
+
+        void AssetLoader::read(Job& a_Job)
+        {
+            switch(a_Job.Type)
+            {
+            case EAssetType::Texture:
+                if(readFile(a_Job.Path, a_Job.FileData))
+                {
+                    //The file is only seen by this worker, so its reference count is never shared
+                    auto file = new MemoryReadFile(a_Job.FileData, a_Job.Path);
+                    a_Job.Image = decodeImage(file);
+                    file->drop();
+                    std::vector<char>().swap(a_Job.FileData);
+                }
+                a_Job.Read = a_Job.Image != nullptr;
+                break;
+            case EAssetType::Mesh:
+                a_Job.Read = readFile(a_Job.Path, a_Job.FileData);
+                break;
+            case EAssetType::Sound:
+                a_Job.Read = OpenALBuffer::read(a_Job.Path, a_Job.WaveData);
+                break;
+            }
+        }
+
+        irr::video::IImage* AssetLoader::decodeImage(irr::io::IReadFile* a_File)
+        {
+            std::lock_guard<std::mutex> lock(m_DecodeMutex);
+            //Like the driver, the loaders added last are tried first, by extension and then by the contents of the file
+            for(size_t i = m_ImageLoaders.size(); i-- > 0;)
+            {
+                if(m_ImageLoaders[i]->isALoadableFileExtension(a_File->getFileName()))
+                {
+                    a_File->seek(0);
+                    irr::video::IImage* image = m_ImageLoaders[i]->loadImage(a_File);
+                    if(image != nullptr)
+                    {
+                        return image;
+                    }
+                }
+            }
+            for(size_t i = m_ImageLoaders.size(); i-- > 0;)
+            {
+                a_File->seek(0);
+                if(m_ImageLoaders[i]->isALoadableFileFormat(a_File))
+                {
+                    a_File->seek(0);
+                    irr::video::IImage* image = m_ImageLoaders[i]->loadImage(a_File);
+                    if(image != nullptr)
+                    {
+                        return image;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        void AssetLoader::upload(Job& a_Job)
+        {
+            ++m_CompletedJobCount;
+            if(!a_Job.Read)
+            {
+                std::cout << "Failed to load " << a_Job.Path << std::endl;
+                return;
+            }
+
+            switch(a_Job.Type)
+            {
+            case EAssetType::Texture:
+                //Textures are looked up by name, so naming it after its path makes the registry find it in the cache
+                m_Device->getVideoDriver()->addTexture(a_Job.Path.c_str(), a_Job.Image);
+                a_Job.Image->drop();
+                a_Job.Image = nullptr;
+                m_Textures.push_back(m_Registry.acquireTexture(a_Job.Path));
+                break;
+            case EAssetType::Mesh:
+            {
+                //The mesh cache uses the name of the file, so the in-memory file is named after the path as well
+                auto file = m_Device->getFileSystem()->createMemoryReadFile(a_Job.FileData.data(), static_cast<irr::s32>(a_Job.FileData.size()), a_Job.Path.c_str(), false);
+                if(m_Device->getSceneManager()->getMesh(file) == nullptr)
+                {
+                    std::cout << "Failed to load " << a_Job.Path << std::endl;
+                }
+                else
+                {
+                    m_Meshes.push_back(m_Registry.acquireMesh(a_Job.Path));
+                }
+                file->drop();
+                std::vector<char>().swap(a_Job.FileData);
+                break;
+            }
+            case EAssetType::Sound:
+                try
+                {
+                    //The uploaded buffer stays in OpenALBuffer's cache while it is held here, so the registry picks it up from there
+                    auto uploadedSound = OpenALBuffer::load(a_Job.Path, a_Job.WaveData);
+                    m_Sounds.push_back(m_Registry.acquireSound(a_Job.Path));
+                }
+                catch(std::invalid_argument&)
+                {
+                    std::cout << "Failed to load " << a_Job.Path << std::endl;
+                }
+                a_Job.WaveData = OpenALWaveData();
+                break;
+            }
+        }
+
+        void AssetLoader::drawProgress()
+        {
+            auto driver = m_Device->getVideoDriver();
+            irr::core::dimension2du screenSize = driver->getScreenSize();
+            irr::s32 width = static_cast<irr::s32>(screenSize.Width) / 2;
+            irr::s32 left = static_cast<irr::s32>(screenSize.Width) / 4;
+            irr::s32 top = static_cast<irr::s32>(screenSize.Height) / 2 - 8;
+
+            driver->beginScene(true, true, irr::video::SColor(255, 20, 20, 20));
+            driver->draw2DRectangle(irr::video::SColor(255, 60, 60, 60), irr::core::recti(left, top, left + width, top + 16));
+            driver->draw2DRectangle(irr::video::SColor(255, 200, 200, 200),
+                irr::core::recti(left, top, left + static_cast<irr::s32>(width * getProgress()), top + 16));
+            driver->endScene();
+        }
+    }
+}
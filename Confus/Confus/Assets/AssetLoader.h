@@ -0,0 +1,119 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../OpenAL/OpenALBuffer.h"
+#include "AssetRegistry.h"
+
+namespace Confus
+{
+    namespace Assets
+    {
+        /// <summary> An asset to load, identified by the path it is later requested with </summary>
+        struct AssetRequest
+        {
+            EAssetType Type;
+            std::string Path;
+        };
+
+        /// <summary>
+        /// Class AssetLoader loads a list of assets into the <see cref="AssetRegistry"/> before the game objects acquire them.
+        /// Files are read and decoded on worker threads, while only the uploads to the video driver, the mesh cache
+        /// and OpenAL happen on the main thread, which draws the loading progress in between.
+        /// </summary>
+        /// <remarks>
+        /// Meshes are read from disk on the workers but parsed on the main thread,
+        /// as Irrlicht's mesh loaders request their textures from the video driver, which is not thread-safe.
+        /// Textures are decoded on the workers without going through the driver or the file system, with the image loaders
+        /// taken from the driver on the main thread. The loaders are shared and some keep state between calls,
+        /// so only a single worker decodes at a time, while the others keep reading files.
+        /// </remarks>
+        class AssetLoader
+        {
+        private:
+            /// <summary> The loading state of a single requested asset </summary>
+            struct Job
+            {
+                EAssetType Type;
+                std::string Path;
+                /// <summary> The contents of the file, for meshes </summary>
+                std::vector<char> FileData;
+                /// <summary> The decoded image, for textures </summary>
+                irr::video::IImage* Image = nullptr;
+                /// <summary> The PCM data, for sounds </summary>
+                OpenALWaveData WaveData;
+                /// <summary> Whether the worker managed to read the asset </summary>
+                bool Read = false;
+            };
+
+            irr::IrrlichtDevice* m_Device;
+            AssetRegistry& m_Registry;
+            /// <summary> Every requested asset, indexed by the workers and the main thread alike </summary>
+            std::vector<Job> m_Jobs;
+            /// <summary> The index of the next job a worker picks up </summary>
+            std::atomic<size_t> m_NextJob;
+            std::vector<std::thread> m_Workers;
+            /// <summary> Guards the finished jobs </summary>
+            std::mutex m_FinishedMutex;
+            /// <summary> Wakes up the main thread when a job has been read </summary>
+            std::condition_variable m_FinishedCondition;
+            /// <summary> The jobs that have been read by a worker and are waiting to be uploaded </summary>
+            std::vector<size_t> m_FinishedJobs;
+            /// <summary> The amount of jobs that have been uploaded, or have failed </summary>
+            size_t m_CompletedJobCount = 0;
+            /// <summary> The image loaders of the video driver, taken before the workers start so they never touch the driver </summary>
+            std::vector<irr::video::IImageLoader*> m_ImageLoaders;
+            /// <summary> Guards the image loaders, which are not safe to call from several threads at once </summary>
+            std::mutex m_DecodeMutex;
+            /// <summary> The handles to the loaded assets, which keep them resident for as long as the loader exists </summary>
+            std::vector<TextureHandle> m_Textures;
+            std::vector<MeshHandle> m_Meshes;
+            std::vector<SoundHandle> m_Sounds;
+        public:
+            /// <summary>
+            /// Loads the given assets, returning once all of them are in the registry.
+            /// </summary>
+            /// <param name="a_Device">The active Irrlicht Device.</param>
+            /// <param name="a_Registry">The registry the loaded assets are added to.</param>
+            /// <param name="a_Assets">The assets to load.</param>
+            /// <remarks> OpenAL has to be initialized before sounds can be loaded </remarks>
+            AssetLoader(irr::IrrlichtDevice* a_Device, AssetRegistry& a_Registry, const std::vector<AssetRequest>& a_Assets);
+            /// <summary>
+            /// Releases the handles to the loaded assets, unloading those no game object has acquired.
+            /// </summary>
+            ~AssetLoader();
+            /// <summary>
+            /// Gets the fraction of the assets that have been loaded, from 0 to 1.
+            /// </summary>
+            float getProgress() const;
+        private:
+            /// <summary>
+            /// Reads jobs until none are left, run on every worker thread.
+            /// </summary>
+            void work();
+            /// <summary>
+            /// Reads and decodes the file of a job, without touching the video driver or OpenAL.
+            /// </summary>
+            void read(Job& a_Job);
+            /// <summary>
+            /// Decodes an image with the first of the image loaders that takes it, the way the video driver picks one.
+            /// </summary>
+            /// <returns>The image, or nullptr if no loader could decode it.</returns>
+            irr::video::IImage* decodeImage(irr::io::IReadFile* a_File);
+            /// <summary>
+            /// Hands the read asset of a job to the video driver, the mesh cache or OpenAL and adds it to the registry, on the main thread.
+            /// </summary>
+            void upload(Job& a_Job);
+            /// <summary>
+            /// Draws a progress bar in the window.
+            /// </summary>
+            void drawProgress();
+        };
+    }
+}
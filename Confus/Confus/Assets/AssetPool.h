@@ -0,0 +1,189 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetHandle.h"
+
+namespace Confus
+{
+    namespace Assets
+    {
+        /// <summary>
+        /// The slots of a single kind of asset in the <see cref="AssetRegistry"/>, each loaded asset living in one slot.
+        /// Assets are looked up by key so every asset is only loaded once, and are reference counted by the handles given out.
+        /// </summary>
+        /// <param name="TAsset">The type the handles resolve to.</param>
+        /// <param name="TStorage">The type the pool keeps the asset in, which owns one reference to it.</param>
+        template<typename TAsset, typename TStorage>
+        class AssetPool
+        {
+        private:
+            /// <summary> A loaded asset, or an empty slot waiting to be reused </summary>
+            struct Slot
+            {
+                TStorage Asset = TStorage();
+                std::string Key;
+                irr::u32 Generation = 0;
+                irr::u32 ReferenceCount = 0;
+                /// <summary> The estimated amount of memory the asset takes up, in bytes </summary>
+                size_t MemorySize = 0;
+            };
+
+            std::vector<Slot> m_Slots;
+            /// <summary> The indices of the slots whose asset has been unloaded </summary>
+            std::vector<irr::u32> m_FreeSlots;
+            /// <summary> The slot of each loaded asset by key </summary>
+            std::unordered_map<std::string, irr::u32> m_Lookup;
+            /// <summary> The summed memory size of the loaded assets </summary>
+            size_t m_MemorySize = 0;
+        public:
+            /// <summary>
+            /// Adds a reference to the asset with the given key, if it has been loaded.
+            /// </summary>
+            /// <param name="a_Key">The key the asset was added with.</param>
+            /// <param name="a_Handle">The handle to the asset to set.</param>
+            /// <returns>Whether the asset was loaded.</returns>
+            bool find(const std::string& a_Key, AssetHandle<TAsset>& a_Handle)
+            {
+                auto iterator = m_Lookup.find(a_Key);
+                if(iterator == m_Lookup.end())
+                {
+                    return false;
+                }
+                Slot& slot = m_Slots[iterator->second];
+                ++slot.ReferenceCount;
+                a_Handle.Index = iterator->second;
+                a_Handle.Generation = slot.Generation;
+                return true;
+            }
+
+            /// <summary>
+            /// Adds a newly loaded asset with a single reference to it.
+            /// </summary>
+            /// <param name="a_Key">The key the asset is looked up with.</param>
+            /// <param name="a_Asset">The asset, of which the pool takes over the reference.</param>
+            /// <param name="a_MemorySize">The estimated amount of memory the asset takes up.</param>
+            /// <returns>The handle to the asset.</returns>
+            AssetHandle<TAsset> add(const std::string& a_Key, TStorage a_Asset, size_t a_MemorySize)
+            {
+                irr::u32 index;
+                if(m_FreeSlots.empty())
+                {
+                    index = static_cast<irr::u32>(m_Slots.size());
+                    m_Slots.emplace_back();
+                }
+                else
+                {
+                    index = m_FreeSlots.back();
+                    m_FreeSlots.pop_back();
+                }
+
+                Slot& slot = m_Slots[index];
+                slot.Asset = std::move(a_Asset);
+                slot.Key = a_Key;
+                slot.ReferenceCount = 1;
+                slot.MemorySize = a_MemorySize;
+                m_Lookup[a_Key] = index;
+                m_MemorySize += a_MemorySize;
+
+                AssetHandle<TAsset> handle;
+                handle.Index = index;
+                handle.Generation = slot.Generation;
+                return handle;
+            }
+
+            /// <summary>
+            /// Gets the asset stored for a handle, or nullptr if the handle refers to nothing or has been released.
+            /// </summary>
+            const TStorage* get(const AssetHandle<TAsset>& a_Handle) const
+            {
+                if(a_Handle.Index >= m_Slots.size())
+                {
+                    return nullptr;
+                }
+                const Slot& slot = m_Slots[a_Handle.Index];
+                if(slot.Generation != a_Handle.Generation || slot.ReferenceCount == 0)
+                {
+                    return nullptr;
+                }
+                return &slot.Asset;
+            }
+
+            /// <summary>
+            /// Adds a reference to the asset of a handle that is already held.
+            /// </summary>
+            /// <returns>Whether the handle still referred to a loaded asset.</returns>
+            bool grab(const AssetHandle<TAsset>& a_Handle)
+            {
+                if(get(a_Handle) == nullptr)
+                {
+                    return false;
+                }
+                ++m_Slots[a_Handle.Index].ReferenceCount;
+                return true;
+            }
+
+            /// <summary>
+            /// Removes a reference to an asset, unloading it when it was the last one.
+            /// The slot's generation is bumped on unloading, so every other handle to it resolves to nullptr from then on.
+            /// </summary>
+            /// <param name="a_Handle">The handle to release, which refers to nothing afterwards.</param>
+            /// <param name="a_Unload">Called with the asset when it is unloaded, to give up the pool's reference.</param>
+            void release(AssetHandle<TAsset>& a_Handle, const std::function<void(TStorage&)>& a_Unload)
+            {
+                if(get(a_Handle) != nullptr)
+                {
+                    Slot& slot = m_Slots[a_Handle.Index];
+                    if(--slot.ReferenceCount == 0)
+                    {
+                        a_Unload(slot.Asset);
+                        slot.Asset = TStorage();
+                        m_Lookup.erase(slot.Key);
+                        slot.Key.clear();
+                        m_MemorySize -= slot.MemorySize;
+                        slot.MemorySize = 0;
+                        ++slot.Generation;
+                        m_FreeSlots.push_back(a_Handle.Index);
+                    }
+                }
+                a_Handle = AssetHandle<TAsset>();
+            }
+
+            /// <summary>
+            /// Unloads every asset, regardless of the handles that are still held.
+            /// </summary>
+            void clear(const std::function<void(TStorage&)>& a_Unload)
+            {
+                for(Slot& slot : m_Slots)
+                {
+                    if(slot.ReferenceCount > 0)
+                    {
+                        a_Unload(slot.Asset);
+                    }
+                }
+                m_Slots.clear();
+                m_FreeSlots.clear();
+                m_Lookup.clear();
+                m_MemorySize = 0;
+            }
+
+            /// <summary>
+            /// Gets the amount of loaded assets.
+            /// </summary>
+            size_t getCount() const
+            {
+                return m_Lookup.size();
+            }
+
+            /// <summary>
+            /// Gets the summed estimated memory size of the loaded assets, in bytes.
+            /// </summary>
+            size_t getMemorySize() const
+            {
+                return m_MemorySize;
+            }
+        };
+    }
+}
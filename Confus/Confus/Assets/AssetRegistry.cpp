@@ -0,0 +1,232 @@
+#include <IrrAssimp/IrrAssimp.h>
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <stdexcept>
+
+#include "AssetRegistry.h"
+#include "../OpenAL/OpenALBuffer.h"
+
+namespace Confus
+{
+    namespace Assets
+    {
+        AssetRegistry::AssetRegistry(irr::IrrlichtDevice* a_Device)
+            : m_Device(a_Device)
+        {
+        }
+
+        AssetRegistry::~AssetRegistry()
+        {
+            m_Textures.clear([this](irr::video::ITexture*& a_Texture) { unloadTexture(a_Texture); });
+            m_Meshes.clear([this](irr::scene::IAnimatedMesh*& a_Mesh) { unloadMesh(a_Mesh); });
+            m_Sounds.clear([](std::shared_ptr<OpenALBuffer>& a_Sound) { a_Sound.reset(); });
+        }
+
+        TextureHandle AssetRegistry::acquireTexture(const std::string& a_Path)
+        {
+            std::string key = getKey(a_Path);
+            TextureHandle handle;
+            if(m_Textures.find(key, handle))
+            {
+                return handle;
+            }
+
+            irr::video::ITexture* texture = m_Device->getVideoDriver()->getTexture(a_Path.c_str());
+            if(texture == nullptr)
+            {
+                std::cout << "Failed to load " << a_Path << std::endl;
+                return handle;
+            }
+            //The registry keeps its own reference, the one held by the driver's cache is removed when the texture is unloaded
+            texture->grab();
+            return m_Textures.add(key, texture, getMemorySize(texture));
+        }
+
+        MeshHandle AssetRegistry::acquireMesh(const std::string& a_Path)
+        {
+            std::string key = getKey(a_Path);
+            MeshHandle handle;
+            if(m_Meshes.find(key, handle))
+            {
+                return handle;
+            }
+
+            auto sceneManager = m_Device->getSceneManager();
+            irr::scene::IAnimatedMesh* mesh = sceneManager->getMesh(a_Path.c_str());
+            if(mesh == nullptr)
+            {
+                if(!m_Importer)
+                {
+                    m_Importer = std::make_unique<IrrAssimp>(sceneManager);
+                }
+                if(m_Importer->isLoadable(a_Path.c_str()))
+                {
+                    mesh = m_Importer->getMesh(a_Path.c_str());
+                }
+            }
+            if(mesh == nullptr)
+            {
+                std::cout << "Failed to load " << a_Path << std::endl;
+                return handle;
+            }
+            mesh->grab();
+            return m_Meshes.add(key, mesh, getMemorySize(mesh));
+        }
+
+        SoundHandle AssetRegistry::acquireSound(const std::string& a_WaveFile)
+        {
+            std::string key = getKey(a_WaveFile);
+            SoundHandle handle;
+            if(m_Sounds.find(key, handle))
+            {
+                return handle;
+            }
+
+            try
+            {
+                std::shared_ptr<OpenALBuffer> sound = OpenALBuffer::load(a_WaveFile);
+                size_t memorySize = getMemorySize(*sound);
+                return m_Sounds.add(key, std::move(sound), memorySize);
+            }
+            catch(std::invalid_argument&)
+            {
+                std::cout << "Failed to load " << a_WaveFile << std::endl;
+                return handle;
+            }
+        }
+
+        TextureHandle AssetRegistry::acquire(const TextureHandle& a_Handle)
+        {
+            return m_Textures.grab(a_Handle) ? a_Handle : TextureHandle();
+        }
+
+        MeshHandle AssetRegistry::acquire(const MeshHandle& a_Handle)
+        {
+            return m_Meshes.grab(a_Handle) ? a_Handle : MeshHandle();
+        }
+
+        SoundHandle AssetRegistry::acquire(const SoundHandle& a_Handle)
+        {
+            return m_Sounds.grab(a_Handle) ? a_Handle : SoundHandle();
+        }
+
+        irr::video::ITexture* AssetRegistry::get(const TextureHandle& a_Handle) const
+        {
+            auto texture = m_Textures.get(a_Handle);
+            return texture != nullptr ? *texture : nullptr;
+        }
+
+        irr::scene::IAnimatedMesh* AssetRegistry::get(const MeshHandle& a_Handle) const
+        {
+            auto mesh = m_Meshes.get(a_Handle);
+            return mesh != nullptr ? *mesh : nullptr;
+        }
+
+        OpenALBuffer* AssetRegistry::get(const SoundHandle& a_Handle) const
+        {
+            auto sound = m_Sounds.get(a_Handle);
+            return sound != nullptr ? sound->get() : nullptr;
+        }
+
+        void AssetRegistry::release(TextureHandle& a_Handle)
+        {
+            m_Textures.release(a_Handle, [this](irr::video::ITexture*& a_Texture) { unloadTexture(a_Texture); });
+        }
+
+        void AssetRegistry::release(MeshHandle& a_Handle)
+        {
+            m_Meshes.release(a_Handle, [this](irr::scene::IAnimatedMesh*& a_Mesh) { unloadMesh(a_Mesh); });
+        }
+
+        void AssetRegistry::release(SoundHandle& a_Handle)
+        {
+            //Sources that are still playing the sound keep the buffer alive through their own reference
+            m_Sounds.release(a_Handle, [](std::shared_ptr<OpenALBuffer>& a_Sound) { a_Sound.reset(); });
+        }
+
+        size_t AssetRegistry::getAssetCount(EAssetType a_Type) const
+        {
+            switch(a_Type)
+            {
+            case EAssetType::Texture:
+                return m_Textures.getCount();
+            case EAssetType::Mesh:
+                return m_Meshes.getCount();
+            case EAssetType::Sound:
+                return m_Sounds.getCount();
+            }
+            return 0;
+        }
+
+        size_t AssetRegistry::getMemoryUsage(EAssetType a_Type) const
+        {
+            switch(a_Type)
+            {
+            case EAssetType::Texture:
+                return m_Textures.getMemorySize();
+            case EAssetType::Mesh:
+                return m_Meshes.getMemorySize();
+            case EAssetType::Sound:
+                return m_Sounds.getMemorySize();
+            }
+            return 0;
+        }
+
+        std::string AssetRegistry::getKey(const std::string& a_Path)
+        {
+            std::string key = a_Path;
+            std::transform(key.begin(), key.end(), key.begin(), [](char a_Character)
+            {
+                return a_Character == '\\' ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(a_Character)));
+            });
+            return key;
+        }
+
+        void AssetRegistry::unloadTexture(irr::video::ITexture*& a_Texture)
+        {
+            //Removing it from the cache drops the driver's reference, after which only the registry's is left
+            m_Device->getVideoDriver()->removeTexture(a_Texture);
+            a_Texture->drop();
+            a_Texture = nullptr;
+        }
+
+        void AssetRegistry::unloadMesh(irr::scene::IAnimatedMesh*& a_Mesh)
+        {
+            m_Device->getSceneManager()->getMeshCache()->removeMesh(a_Mesh);
+            a_Mesh->drop();
+            a_Mesh = nullptr;
+        }
+
+        size_t AssetRegistry::getMemorySize(irr::video::ITexture* a_Texture)
+        {
+            size_t size = static_cast<size_t>(a_Texture->getPitch()) * a_Texture->getSize().Height;
+            //A full mip chain adds a third of the base level
+            return a_Texture->hasMipMaps() ? size + size / 3 : size;
+        }
+
+        size_t AssetRegistry::getMemorySize(irr::scene::IAnimatedMesh* a_Mesh)
+        {
+            size_t size = 0;
+            irr::scene::IMesh* mesh = a_Mesh->getMesh(0);
+            if(mesh == nullptr)
+            {
+                return size;
+            }
+            for(irr::u32 i = 0; i < mesh->getMeshBufferCount(); ++i)
+            {
+                irr::scene::IMeshBuffer* buffer = mesh->getMeshBuffer(i);
+                size += buffer->getVertexCount() * irr::video::getVertexPitchFromType(buffer->getVertexType());
+                size += buffer->getIndexCount() * (buffer->getIndexType() == irr::video::EIT_16BIT ? sizeof(irr::u16) : sizeof(irr::u32));
+            }
+            return size;
+        }
+
+        size_t AssetRegistry::getMemorySize(const OpenALBuffer& a_Sound)
+        {
+            ALint size = 0;
+            alGetBufferi(a_Sound.getBufferID(), AL_SIZE, &size);
+            return static_cast<size_t>(size);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <memory>
+#include <string>
+
+#include "AssetHandle.h"
+#include "AssetPool.h"
+
+class IrrAssimp;
+
+namespace Confus
+{
+    namespace Assets
+    {
+        /// <summary>
+        /// Class AssetRegistry owns the textures, meshes and sounds that game objects use, loading every asset only once.
+        /// Game objects acquire a handle to an asset when they are created and release it when they are destroyed,
+        /// the asset is unloaded from Irrlicht's caches or OpenAL once nothing holds a handle to it anymore.
+        /// </summary>
+        /// <remarks>
+        /// Paths are compared case-insensitively and with either kind of slash, as they are on Windows,
+        /// so "media/textures/a.png" and "Media\Textures\a.png" share one asset.
+        /// </remarks>
+        class AssetRegistry
+        {
+        private:
+            irr::IrrlichtDevice* m_Device;
+            AssetPool<irr::video::ITexture, irr::video::ITexture*> m_Textures;
+            AssetPool<irr::scene::IAnimatedMesh, irr::scene::IAnimatedMesh*> m_Meshes;
+            AssetPool<OpenALBuffer, std::shared_ptr<OpenALBuffer>> m_Sounds;
+            /// <summary>
+            /// The Assimp importer for the mesh formats Irrlicht cannot load itself, only created once it is needed
+            /// </summary>
+            std::unique_ptr<IrrAssimp> m_Importer;
+        public:
+            /// <summary>
+            /// Initializes a new instance of the <see cref="AssetRegistry"/> class.
+            /// </summary>
+            /// <param name="a_Device">The active Irrlicht Device.</param>
+            AssetRegistry(irr::IrrlichtDevice* a_Device);
+            /// <summary>
+            /// Unloads every asset that is still held.
+            /// </summary>
+            ~AssetRegistry();
+            AssetRegistry(const AssetRegistry&) = delete;
+            AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+            /// <summary>
+            /// Gets a handle to a texture, loading it only if it is not held yet.
+            /// </summary>
+            /// <param name="a_Path">The path of the image file.</param>
+            /// <returns>The handle, which has to be released again, or an invalid handle if the texture could not be loaded.</returns>
+            TextureHandle acquireTexture(const std::string& a_Path);
+            /// <summary>
+            /// Gets a handle to a mesh, loading it only if it is not held yet.
+            /// Formats Irrlicht cannot load are loaded through Assimp.
+            /// </summary>
+            /// <param name="a_Path">The path of the mesh file.</param>
+            /// <returns>The handle, which has to be released again, or an invalid handle if the mesh could not be loaded.</returns>
+            MeshHandle acquireMesh(const std::string& a_Path);
+            /// <summary>
+            /// Gets a handle to a sound buffer, loading it only if it is not held yet.
+            /// </summary>
+            /// <param name="a_WaveFile">The wave file, relative to the media folder.</param>
+            /// <returns>The handle, which has to be released again, or an invalid handle if the sound could not be loaded.</returns>
+            SoundHandle acquireSound(const std::string& a_WaveFile);
+
+            /// <summary>
+            /// Adds a reference to an asset through a handle that is already held, without looking up its path.
+            /// </summary>
+            /// <returns>A handle to the same asset, or an invalid handle if it had been released.</returns>
+            TextureHandle acquire(const TextureHandle& a_Handle);
+            MeshHandle acquire(const MeshHandle& a_Handle);
+            SoundHandle acquire(const SoundHandle& a_Handle);
+
+            /// <summary>
+            /// Gets the asset a handle refers to.
+            /// </summary>
+            /// <returns>The asset, or nullptr if the handle is invalid or has been released.</returns>
+            irr::video::ITexture* get(const TextureHandle& a_Handle) const;
+            irr::scene::IAnimatedMesh* get(const MeshHandle& a_Handle) const;
+            OpenALBuffer* get(const SoundHandle& a_Handle) const;
+
+            /// <summary>
+            /// Releases a handle, unloading the asset when it was the last handle to it.
+            /// </summary>
+            /// <param name="a_Handle">The handle to release, which is reset to an invalid handle.</param>
+            void release(TextureHandle& a_Handle);
+            void release(MeshHandle& a_Handle);
+            void release(SoundHandle& a_Handle);
+
+            /// <summary>
+            /// Gets the amount of loaded assets of a type.
+            /// </summary>
+            size_t getAssetCount(EAssetType a_Type) const;
+            /// <summary>
+            /// Gets the estimated memory the loaded assets of a type take up, in bytes.
+            /// </summary>
+            /// <remarks> Textures are counted at their uploaded size, meshes by their vertices and indices, sounds by their PCM data </remarks>
+            size_t getMemoryUsage(EAssetType a_Type) const;
+        private:
+            /// <summary>
+            /// Converts a path into the key assets are looked up with.
+            /// </summary>
+            static std::string getKey(const std::string& a_Path);
+            /// <summary>
+            /// Removes a texture from the video driver.
+            /// </summary>
+            void unloadTexture(irr::video::ITexture*& a_Texture);
+            /// <summary>
+            /// Removes a mesh from the mesh cache.
+            /// </summary>
+            void unloadMesh(irr::scene::IAnimatedMesh*& a_Mesh);
+            /// <summary>
+            /// Estimates the memory a texture takes up.
+            /// </summary>
+            static size_t getMemorySize(irr::video::ITexture* a_Texture);
+            /// <summary>
+            /// Estimates the memory a mesh takes up.
+            /// </summary>
+            static size_t getMemorySize(irr::scene::IAnimatedMesh* a_Mesh);
+            /// <summary>
+            /// Gets the size of the PCM data in a sound buffer.
+            /// </summary>
+            static size_t getMemorySize(const OpenALBuffer& a_Sound);
+        };
+    }
+}
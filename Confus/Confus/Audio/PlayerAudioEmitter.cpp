@@ -6,44 +6,28 @@ namespace Confus
 {
     namespace Audio
     {
-        PlayerAudioEmitter::PlayerAudioEmitter(irr::scene::IAnimatedMeshSceneNode* a_AttachedPlayer) : m_AttachedPlayer(a_AttachedPlayer)
+        const std::string PlayerAudioEmitter::FootstepSounds[3] = { "Footstep1_Concrete.wav", "Footstep2_Concrete.wav", "Footstep3_Concrete.wav" };
+        const std::string PlayerAudioEmitter::GruntSounds[2] = { "Grunt1.wav", "Grunt2.wav" };
+        const std::string PlayerAudioEmitter::HeavyGruntSound = "GruntHeavy.wav";
+        const std::string PlayerAudioEmitter::SwordSwoshSounds[4] = { "Sword_swing_1.wav", "Sword_swing_2.wav", "Sword_swing_3.wav", "Sword_swing_4.wav" };
+
+        PlayerAudioEmitter::PlayerAudioEmitter(irr::scene::IAnimatedMeshSceneNode* a_AttachedPlayer, VoicePool& a_VoicePool)
+            : m_VoicePool(a_VoicePool), m_AttachedPlayer(a_AttachedPlayer)
         {
-        createAudioSources();
+            preloadSounds();
         }
 
         PlayerAudioEmitter::~PlayerAudioEmitter()
         {
-            for(auto audioSource : m_AudioSourceFootsteps)
-            {
-                delete(audioSource);
-            }
-            for(auto audioSource : m_AudioSourceGrunts)
-            {
-                delete(audioSource);
-            }
-            for(auto audioSource : m_AudioSourceSwordSwoshes)
-            {
-                delete(audioSource);
-            }
+            m_VoicePool.detachEmitter(m_AttachedPlayer);
         }
 
-        void PlayerAudioEmitter::playFootStepSound() const
+        void PlayerAudioEmitter::playFootStepSound()
         {
-            if(!m_AudioSourceFootsteps[0]->isPlaying())
-            {
-                m_AudioSourceFootsteps[0]->play();
-            }
-            else if(!m_AudioSourceFootsteps[1]->isPlaying())
-            {
-                m_AudioSourceFootsteps[1]->play();
-            }
-            else
-            {
-                m_AudioSourceFootsteps[2]->play();
-            }
+            m_VoicePool.play(FootstepSounds[m_NextFootstep], m_AttachedPlayer, ESoundPriority::Low);
+            m_NextFootstep = (m_NextFootstep + 1) % 3;
         }
 
-
         void PlayerAudioEmitter::playAttackSound(bool a_HeavyAttack) const
         {
             if(!a_HeavyAttack)
@@ -52,7 +36,7 @@ namespace Confus
             }
             else
             {
-                m_AudioSourceGrunts[2]->play();
+                m_VoicePool.play(HeavyGruntSound, m_AttachedPlayer, ESoundPriority::High, 0.1f);
             }
             playRandomSwordSwosh();
         }
@@ -61,81 +45,31 @@ namespace Confus
         {
             std::srand(static_cast<int>(time(NULL)));
             auto randomNumber = std::rand() % 2;
-
-            switch(randomNumber)
-            {
-            case 0:
-                m_AudioSourceGrunts[0]->play();
-                break;
-            case 1:
-                m_AudioSourceGrunts[1]->play();
-                break;
-            default:
-                break;
-            }
+            m_VoicePool.play(GruntSounds[randomNumber], m_AttachedPlayer, ESoundPriority::Normal, 0.1f);
         }
 
         void PlayerAudioEmitter::playRandomSwordSwosh() const
         {
             std::srand(static_cast<int>(time(NULL)));
             auto randomNumber = std::rand() % 4;
-
-            switch(randomNumber)
-            {
-            case 0:
-                m_AudioSourceSwordSwoshes[0]->play();
-                break;
-            case 1:
-                m_AudioSourceSwordSwoshes[1]->play();
-                break;
-            case 2:
-                m_AudioSourceSwordSwoshes[2]->play();
-                break;
-            case 3:
-                m_AudioSourceSwordSwoshes[3]->play();
-                break;
-            default:
-                break;
-            }
+            m_VoicePool.play(SwordSwoshSounds[randomNumber], m_AttachedPlayer, ESoundPriority::Normal);
         }
 
-        void PlayerAudioEmitter::updatePosition() const
+        void PlayerAudioEmitter::preloadSounds() const
         {
-            for(auto audioSource : m_AudioSourceFootsteps)
+            for(auto& sound : FootstepSounds)
             {
-                audioSource->setPosition(m_AttachedPlayer->getAbsolutePosition());
+                m_VoicePool.preload(sound);
             }
-
-            for (auto audioSource : m_AudioSourceGrunts)
+            for(auto& sound : GruntSounds)
             {
-                audioSource->setPosition(m_AttachedPlayer->getAbsolutePosition());
+                m_VoicePool.preload(sound);
             }
-
-            for(auto audioSource : m_AudioSourceSwordSwoshes)
-            {
-                audioSource->setPosition(m_AttachedPlayer->getAbsolutePosition());
-            }
-        }
-
-        void PlayerAudioEmitter::createAudioSources()
-        {
-            m_AudioSourceFootsteps[0] = new OpenALSource("Footstep1_Concrete.wav");
-            m_AudioSourceFootsteps[1] = new OpenALSource("Footstep2_Concrete.wav");
-            m_AudioSourceFootsteps[2] = new OpenALSource("Footstep3_Concrete.wav");
-
-            m_AudioSourceGrunts[0] = new OpenALSource("Grunt1.wav");
-            m_AudioSourceGrunts[1] = new OpenALSource("Grunt2.wav");
-            m_AudioSourceGrunts[2] = new OpenALSource("GruntHeavy.wav");
-
-            for(auto audioSource : m_AudioSourceGrunts)
+            m_VoicePool.preload(HeavyGruntSound);
+            for(auto& sound : SwordSwoshSounds)
             {
-                audioSource->setVolume(0.1f);
+                m_VoicePool.preload(sound);
             }
-            
-            m_AudioSourceSwordSwoshes[0] = new OpenALSource("Sword_swing_1.wav");
-            m_AudioSourceSwordSwoshes[1] = new OpenALSource("Sword_swing_2.wav");
-            m_AudioSourceSwordSwoshes[2] = new OpenALSource("Sword_swing_3.wav");
-            m_AudioSourceSwordSwoshes[3] = new OpenALSource("Sword_swing_4.wav");
         }
     }
 }
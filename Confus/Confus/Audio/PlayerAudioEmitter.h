@@ -1,8 +1,7 @@
 #pragma once
 #include <irrlicht/irrlicht.h>
-#include <vector>
 
-#include "..\OpenAL\OpenALSource.h"
+#include "VoicePool.h"
 
 namespace Confus
 {
@@ -10,28 +9,35 @@ namespace Confus
     {
         /// <summary>
         /// Class PlayerAudioEmitter emits sounds like footsteps and attacking sounds from each individual player.
+        /// The sounds are played through the shared <see cref="VoicePool"/>, so a player does not own any OpenAL sources itself.
+        /// Playing sounds follow the player as it moves.
         /// </summary>
         class PlayerAudioEmitter
         {
-            OpenALSource* m_AudioSourceFootsteps[3];
-            OpenALSource* m_AudioSourceGrunts[3];
-            OpenALSource* m_AudioSourceSwordSwoshes[4];
-            
+            static const std::string FootstepSounds[3];
+            static const std::string GruntSounds[2];
+            static const std::string HeavyGruntSound;
+            static const std::string SwordSwoshSounds[4];
+
+            VoicePool& m_VoicePool;
             irr::scene::IAnimatedMeshSceneNode* m_AttachedPlayer;
+            /// <summary> The footstep sound that will be played next, footsteps are played in turn </summary>
+            size_t m_NextFootstep = 0u;
         public:            
             /// <summary>
             /// Initializes a new instance of the <see cref="PlayerAudioEmitter"/> class.
             /// </summary>
             /// <param name="a_AttachedPlayer">The player that owns this emitter.</param>
-            PlayerAudioEmitter(irr::scene::IAnimatedMeshSceneNode* a_AttachedPlayer);
+            /// <param name="a_VoicePool">The voice pool to play the sounds through.</param>
+            PlayerAudioEmitter(irr::scene::IAnimatedMeshSceneNode* a_AttachedPlayer, VoicePool& a_VoicePool);
             /// <summary>
-            /// Finalizes an instance of the <see cref="PlayerAudioEmitter"/> class.
+            /// Finalizes an instance of the <see cref="PlayerAudioEmitter"/> class, so that playing sounds stop following the player.
             /// </summary>
             ~PlayerAudioEmitter();
             /// <summary>
-            /// Plays a random footstep sound.
+            /// Plays the next footstep sound.
             /// </summary>
-            void playFootStepSound() const;            
+            void playFootStepSound();
             /// <summary>
             /// Plays a random attack sound.
             /// </summary>
@@ -46,14 +52,9 @@ namespace Confus
             /// </summary>
             void playRandomSwordSwosh() const;
             /// <summary>
-            /// Updates the position of this instance.
-            /// </summary>
-            void updatePosition() const;            
-            /// <summary>
-            /// Creates the audio sources.
+            /// Loads the sounds of this emitter, so that playing them does not stall the game.
             /// </summary>
-            void createAudioSources();
+            void preloadSounds() const;
         };
     }
 }
-
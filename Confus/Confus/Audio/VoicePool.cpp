@@ -0,0 +1,219 @@
+#include "VoicePool.h"
+
+namespace Confus
+{
+    namespace Audio
+    {
+        const size_t VoicePool::MaxVoiceCount = 16u;
+        const float VoicePool::MaxAudibleDistance = 60.0f;
+        const float VoicePool::PositionUpdateThreshold = 0.1f;
+        const float VoicePool::OccludedGain = 0.35f;
+
+        VoicePool::VoicePool(const MazeLineOfSight& a_LineOfSight)
+            : m_LineOfSight(a_LineOfSight)
+        {
+            m_Voices.reserve(MaxVoiceCount);
+            for(size_t i = 0u; i < MaxVoiceCount; ++i)
+            {
+                Voice voice;
+                alGetError();
+                alGenSources(1, &voice.Source);
+                //The hardware may support less sources than requested, so we stop at the first failure
+                if(alGetError() != AL_NO_ERROR)
+                {
+                    break;
+                }
+                m_Voices.push_back(voice);
+            }
+        }
+
+        VoicePool::~VoicePool()
+        {
+            for(auto& voice : m_Voices)
+            {
+                alSourceStop(voice.Source);
+                alDeleteSources(1, &voice.Source);
+            }
+        }
+
+        void VoicePool::preload(const std::string& a_WaveFile)
+        {
+            getBuffer(a_WaveFile);
+        }
+
+        bool VoicePool::play(const std::string& a_WaveFile, irr::core::vector3df a_Position, ESoundPriority a_Priority, float a_Volume)
+        {
+            return startVoice(a_WaveFile, a_Position, a_Priority, a_Volume) != nullptr;
+        }
+
+        bool VoicePool::play(const std::string& a_WaveFile, const irr::scene::ISceneNode* a_Emitter, ESoundPriority a_Priority, float a_Volume)
+        {
+            Voice* voice = startVoice(a_WaveFile, a_Emitter->getAbsolutePosition(), a_Priority, a_Volume);
+            if(voice == nullptr)
+            {
+                return false;
+            }
+            voice->Emitter = a_Emitter;
+            return true;
+        }
+
+        VoicePool::Voice* VoicePool::startVoice(const std::string& a_WaveFile, irr::core::vector3df a_Position, ESoundPriority a_Priority, float a_Volume)
+        {
+            if(m_ListenerPosition.getDistanceFromSQ(a_Position) > MaxAudibleDistance * MaxAudibleDistance)
+            {
+                return nullptr;
+            }
+
+            Voice* voice = findVoice(a_Position, a_Priority);
+            if(voice == nullptr)
+            {
+                return nullptr;
+            }
+
+            auto buffer = getBuffer(a_WaveFile);
+            if(voice->RemainingTime > 0.0f)
+            {
+                alSourceStop(voice->Source);
+            }
+            bool occluded = !m_LineOfSight.isVisible(m_ListenerPosition, a_Position);
+            alSourcei(voice->Source, AL_BUFFER, buffer->getBufferID());
+            alSourcef(voice->Source, AL_GAIN, occluded ? a_Volume * OccludedGain : a_Volume);
+            alSource3f(voice->Source, AL_POSITION, a_Position.X, a_Position.Y, a_Position.Z);
+            alSource3f(voice->Source, AL_VELOCITY, 0.0f, 0.0f, 0.0f);
+            alSourcePlay(voice->Source);
+
+            voice->Buffer = buffer;
+            voice->Priority = a_Priority;
+            voice->Position = a_Position;
+            voice->Emitter = nullptr;
+            voice->TimeSincePositionUpdate = 0.0f;
+            voice->RemainingTime = buffer->getDuration();
+            voice->Volume = a_Volume;
+            voice->Occluded = occluded;
+            return voice;
+        }
+
+        void VoicePool::detachEmitter(const irr::scene::ISceneNode* a_Emitter)
+        {
+            for(auto& voice : m_Voices)
+            {
+                if(voice.Emitter == a_Emitter)
+                {
+                    voice.Emitter = nullptr;
+                }
+            }
+        }
+
+        void VoicePool::update(double a_DeltaTime, irr::core::vector3df a_ListenerPosition)
+        {
+            m_ListenerPosition = a_ListenerPosition;
+            //Voices are tracked by their known play length, so no source state has to be queried from OpenAL
+            for(auto& voice : m_Voices)
+            {
+                if(voice.RemainingTime > 0.0f)
+                {
+                    voice.RemainingTime -= static_cast<float>(a_DeltaTime);
+                    if(voice.RemainingTime <= 0.0f)
+                    {
+                        voice.RemainingTime = 0.0f;
+                        voice.Buffer = nullptr;
+                        voice.Emitter = nullptr;
+                    }
+                    else if(voice.Emitter != nullptr)
+                    {
+                        updateVoicePosition(voice, static_cast<float>(a_DeltaTime));
+                    }
+                }
+            }
+            updateOcclusion();
+        }
+
+        void VoicePool::updateOcclusion()
+        {
+            m_OcclusionQueries.clear();
+            m_OcclusionVoices.clear();
+            for(auto& voice : m_Voices)
+            {
+                if(voice.RemainingTime > 0.0f)
+                {
+                    m_OcclusionQueries.push_back({ m_ListenerPosition, voice.Position });
+                    m_OcclusionVoices.push_back(&voice);
+                }
+            }
+            m_LineOfSight.areVisible(m_OcclusionQueries, m_OcclusionResults);
+
+            for(size_t i = 0; i < m_OcclusionVoices.size(); ++i)
+            {
+                Voice& voice = *m_OcclusionVoices[i];
+                bool occluded = m_OcclusionResults[i] == 0u;
+                if(occluded != voice.Occluded)
+                {
+                    alSourcef(voice.Source, AL_GAIN, occluded ? voice.Volume * OccludedGain : voice.Volume);
+                    voice.Occluded = occluded;
+                }
+            }
+        }
+
+        void VoicePool::updateVoicePosition(Voice& a_Voice, float a_DeltaTime)
+        {
+            a_Voice.TimeSincePositionUpdate += a_DeltaTime;
+            irr::core::vector3df position = a_Voice.Emitter->getAbsolutePosition();
+            if(position.getDistanceFromSQ(a_Voice.Position) < PositionUpdateThreshold * PositionUpdateThreshold)
+            {
+                return;
+            }
+
+            irr::core::vector3df velocity = (position - a_Voice.Position) / a_Voice.TimeSincePositionUpdate;
+            alSource3f(a_Voice.Source, AL_POSITION, position.X, position.Y, position.Z);
+            alSource3f(a_Voice.Source, AL_VELOCITY, velocity.X, velocity.Y, velocity.Z);
+            a_Voice.Position = position;
+            a_Voice.TimeSincePositionUpdate = 0.0f;
+        }
+
+        std::shared_ptr<OpenALBuffer> VoicePool::getBuffer(const std::string& a_WaveFile)
+        {
+            auto& buffer = m_Buffers[a_WaveFile];
+            if(buffer == nullptr)
+            {
+                buffer = OpenALBuffer::load(a_WaveFile);
+            }
+            return buffer;
+        }
+
+        VoicePool::Voice* VoicePool::findVoice(irr::core::vector3df a_Position, ESoundPriority a_Priority)
+        {
+            const float maxDistanceSQ = MaxAudibleDistance * MaxAudibleDistance;
+            float distanceSQ = m_ListenerPosition.getDistanceFromSQ(a_Position);
+
+            Voice* candidate = nullptr;
+            bool candidateAudible = true;
+            float candidateDistanceSQ = 0.0f;
+            for(auto& voice : m_Voices)
+            {
+                if(voice.RemainingTime <= 0.0f)
+                {
+                    return &voice;
+                }
+
+                float voiceDistanceSQ = m_ListenerPosition.getDistanceFromSQ(voice.Position);
+                bool audible = voiceDistanceSQ <= maxDistanceSQ;
+                if(audible && (voice.Priority > a_Priority || (voice.Priority == a_Priority && voiceDistanceSQ < distanceSQ)))
+                {
+                    continue;
+                }
+
+                bool better = candidate == nullptr
+                    || (candidateAudible && !audible)
+                    || (candidateAudible == audible && voice.Priority < candidate->Priority)
+                    || (candidateAudible == audible && voice.Priority == candidate->Priority && voiceDistanceSQ > candidateDistanceSQ);
+                if(better)
+                {
+                    candidate = &voice;
+                    candidateAudible = audible;
+                    candidateDistanceSQ = voiceDistanceSQ;
+                }
+            }
+            return candidate;
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../OpenAL/OpenALBuffer.h"
+#include "../MazeLineOfSight.h"
+
+namespace Confus
+{
+    namespace Audio
+    {
+        /// <summary> The importance of a sound, used to decide which voices may be taken over when all are in use </summary>
+        enum class ESoundPriority
+        {
+            Low, ///< Ambient or frequent sounds such as footsteps, the first to be cut off.
+            Normal, ///< Regular gameplay sounds such as sword swings.
+            High ///< Sounds that should always be heard, such as heavy attacks.
+        };
+
+        /// <summary>
+        /// Class VoicePool owns a fixed amount of OpenAL sources (voices) that are shared by every sound in the game.
+        /// Sounds are fired and forgotten; when every voice is in use the least important one is stolen,
+        /// preferring voices that are out of hearing range, then lower priorities, then those furthest from the listener.
+        /// Sounds without a line of sight to the listener through the maze are muffled.
+        /// </summary>
+        class VoicePool
+        {
+        private:
+            /// <summary> A single OpenAL source and the sound it is currently playing </summary>
+            struct Voice
+            {
+                /// <summary> The OpenAL source name </summary>
+                ALuint Source = 0;
+                /// <summary> The buffer being played, kept alive until the voice is reused </summary>
+                std::shared_ptr<OpenALBuffer> Buffer;
+                /// <summary> The priority of the sound being played </summary>
+                ESoundPriority Priority = ESoundPriority::Low;
+                /// <summary> The world position of the sound being played, as last sent to OpenAL </summary>
+                irr::core::vector3df Position;
+                /// <summary> The node the sound follows, or nullptr if it stays at its position </summary>
+                const irr::scene::ISceneNode* Emitter = nullptr;
+                /// <summary> The time in seconds since the position was last sent to OpenAL </summary>
+                float TimeSincePositionUpdate = 0.0f;
+                /// <summary> The time in seconds until the sound has finished playing </summary>
+                float RemainingTime = 0.0f;
+                /// <summary> The volume the sound was started at, before occlusion </summary>
+                float Volume = 1.0f;
+                /// <summary> Whether the sound is currently muffled by a wall between it and the listener </summary>
+                bool Occluded = false;
+            };
+
+            /// <summary> The maximum amount of voices to allocate </summary>
+            static const size_t MaxVoiceCount;
+            /// <summary> The distance from the listener beyond which sounds are considered inaudible </summary>
+            static const float MaxAudibleDistance;
+            /// <summary> The distance an emitter has to move before the position of its voices is updated </summary>
+            static const float PositionUpdateThreshold;
+            /// <summary> The factor the gain of a sound is multiplied with while it is behind a wall </summary>
+            static const float OccludedGain;
+
+            /// <summary> The voices owned by this pool </summary>
+            std::vector<Voice> m_Voices;
+            /// <summary> The buffers that have been played through this pool, kept resident so they are only loaded once </summary>
+            std::unordered_map<std::string, std::shared_ptr<OpenALBuffer>> m_Buffers;
+            /// <summary> The position of the listener as of the last update </summary>
+            irr::core::vector3df m_ListenerPosition;
+            /// <summary> The walls that muffle the sounds behind them </summary>
+            const MazeLineOfSight& m_LineOfSight;
+            /// <summary> The line of sight query of every playing voice and the results, kept to avoid allocating every update </summary>
+            std::vector<LineOfSightQuery> m_OcclusionQueries;
+            std::vector<irr::u8> m_OcclusionResults;
+            std::vector<Voice*> m_OcclusionVoices;
+        public:
+            /// <summary>
+            /// Initializes a new instance of the <see cref="VoicePool"/> class, allocating the voices.
+            /// </summary>
+            /// <param name="a_LineOfSight">The walls that muffle the sounds behind them.</param>
+            /// <remarks> OpenAL has to be initialized before the pool is created </remarks>
+            VoicePool(const MazeLineOfSight& a_LineOfSight);
+            /// <summary>
+            /// Finalizes an instance of the <see cref="VoicePool"/> class, stopping and releasing the voices.
+            /// </summary>
+            ~VoicePool();
+            /// <summary>
+            /// Loads the given wave file ahead of time, so that playing it does not stall the game.
+            /// </summary>
+            /// <param name="a_WaveFile">The wave file, relative to the media folder.</param>
+            void preload(const std::string& a_WaveFile);
+            /// <summary>
+            /// Plays a sound once at the given position, if a voice is available for it.
+            /// </summary>
+            /// <param name="a_WaveFile">The wave file, relative to the media folder.</param>
+            /// <param name="a_Position">The world position to play the sound at.</param>
+            /// <param name="a_Priority">The priority of the sound.</param>
+            /// <param name="a_Volume">The volume to play the sound at.</param>
+            /// <returns>Whether the sound is being played.</returns>
+            bool play(const std::string& a_WaveFile, irr::core::vector3df a_Position, ESoundPriority a_Priority, float a_Volume = 1.0f);
+            /// <summary>
+            /// Plays a sound once, following the given node while it plays, if a voice is available for it.
+            /// </summary>
+            /// <param name="a_WaveFile">The wave file, relative to the media folder.</param>
+            /// <param name="a_Emitter">The node the sound follows, which has to outlive the sound or be detached.</param>
+            /// <param name="a_Priority">The priority of the sound.</param>
+            /// <param name="a_Volume">The volume to play the sound at.</param>
+            /// <returns>Whether the sound is being played.</returns>
+            bool play(const std::string& a_WaveFile, const irr::scene::ISceneNode* a_Emitter, ESoundPriority a_Priority, float a_Volume = 1.0f);
+            /// <summary>
+            /// Stops the playing sounds from following the given node, leaving them at its last known position.
+            /// </summary>
+            /// <param name="a_Emitter">The node that is about to be removed.</param>
+            void detachEmitter(const irr::scene::ISceneNode* a_Emitter);
+            /// <summary>
+            /// Advances the playing voices, freeing the ones that have finished.
+            /// The position and velocity of a playing voice are only sent to OpenAL once its emitter has moved noticeably,
+            /// and its gain only when it moves into or out of the listener's line of sight.
+            /// </summary>
+            /// <param name="a_DeltaTime">The time in seconds since the last update.</param>
+            /// <param name="a_ListenerPosition">The current position of the listener.</param>
+            void update(double a_DeltaTime, irr::core::vector3df a_ListenerPosition);
+        private:
+            /// <summary>
+            /// Gets the buffer for the given wave file, loading it if it is not resident yet.
+            /// </summary>
+            std::shared_ptr<OpenALBuffer> getBuffer(const std::string& a_WaveFile);
+            /// <summary>
+            /// Starts playing a sound on a free or stolen voice.
+            /// </summary>
+            /// <returns>The voice playing the sound, or nullptr if it is inaudible or no voice could be taken.</returns>
+            Voice* startVoice(const std::string& a_WaveFile, irr::core::vector3df a_Position, ESoundPriority a_Priority, float a_Volume);
+            /// <summary>
+            /// Sends the position and velocity of a voice to OpenAL if its emitter has moved beyond the threshold.
+            /// </summary>
+            /// <param name="a_Voice">The playing voice that follows an emitter.</param>
+            /// <param name="a_DeltaTime">The time in seconds since the last update.</param>
+            void updateVoicePosition(Voice& a_Voice, float a_DeltaTime);
+            /// <summary>
+            /// Tests every playing voice for a line of sight to the listener in one batch, muffling those behind a wall.
+            /// </summary>
+            void updateOcclusion();
+            /// <summary>
+            /// Finds a free voice, or the voice that is the best candidate to be stolen for the new sound.
+            /// </summary>
+            /// <returns>The voice to use, or nullptr if every voice is more important than the new sound.</returns>
+            Voice* findVoice(irr::core::vector3df a_Position, ESoundPriority a_Priority);
+        };
+    }
+}
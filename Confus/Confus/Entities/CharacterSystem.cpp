@@ -0,0 +1,41 @@
+#include "CharacterSystem.h"
+
+namespace Confus
+{
+    namespace Entities
+    {
+        CharacterSystem::CharacterSystem(EntityStore& a_EntityStore, const ConfusShared::CollisionWorld& a_CollisionWorld)
+            : m_EntityStore(a_EntityStore),
+            m_CollisionWorld(a_CollisionWorld)
+        {
+        }
+
+        void CharacterSystem::fixedUpdate(float a_DeltaTime)
+        {
+            for(size_t i = 0; i < m_EntityStore.Characters.size(); ++i)
+            {
+                CharacterComponent& character = m_EntityStore.Characters.at(i);
+                character.PreviousPosition = character.State.Position;
+                m_Controller.simulate(character.State, character.Input, m_CollisionWorld, a_DeltaTime);
+            }
+        }
+
+        void CharacterSystem::interpolate(float a_Alpha)
+        {
+            float eyeHeight = m_Controller.getSettings().EyeHeight;
+            for(size_t i = 0; i < m_EntityStore.Characters.size(); ++i)
+            {
+                const CharacterComponent& character = m_EntityStore.Characters.at(i);
+                ConfusShared::Vector3 position = character.PreviousPosition + (character.State.Position - character.PreviousPosition) * a_Alpha;
+                character.Camera->setPosition(irr::core::vector3df(position.X, position.Y + eyeHeight, position.Z));
+            }
+        }
+
+        void CharacterSystem::teleport(CharacterComponent& a_Character, const ConfusShared::Vector3& a_Position)
+        {
+            a_Character.State = ConfusShared::CharacterState();
+            a_Character.State.Position = a_Position;
+            a_Character.PreviousPosition = a_Position;
+        }
+    }
+}
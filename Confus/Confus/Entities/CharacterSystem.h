@@ -0,0 +1,49 @@
+#pragma once
+#include "ConfusShared/CharacterController.h"
+#include "ConfusShared/CollisionWorld.h"
+
+#include "EntityStore.h"
+
+namespace Confus
+{
+    namespace Entities
+    {
+        /// <summary>
+        /// Moves the characters through the level with the same controller the server uses, one fixed update at a time,
+        /// and puts their cameras between the last two fixed updates every frame so the view moves smoothly at any frame rate.
+        /// </summary>
+        class CharacterSystem
+        {
+        private:
+            EntityStore& m_EntityStore;
+            const ConfusShared::CollisionWorld& m_CollisionWorld;
+            ConfusShared::CharacterController m_Controller;
+        public:
+            /// <summary>
+            /// Initializes a new instance of the <see cref="CharacterSystem"/> class.
+            /// </summary>
+            /// <param name="a_EntityStore">The store to walk, which has to outlive this.</param>
+            /// <param name="a_CollisionWorld">The level the characters collide with, which has to outlive this.</param>
+            CharacterSystem(EntityStore& a_EntityStore, const ConfusShared::CollisionWorld& a_CollisionWorld);
+
+            /// <summary>
+            /// Moves every character by its input for a single fixed update.
+            /// </summary>
+            /// <param name="a_DeltaTime">The length of a fixed update in seconds.</param>
+            void fixedUpdate(float a_DeltaTime);
+
+            /// <summary>
+            /// Puts the camera of every character at its eyes, part of the way from where it was before the last fixed update.
+            /// </summary>
+            /// <param name="a_Alpha">How far the time is into the next fixed update, from 0 to 1.</param>
+            void interpolate(float a_Alpha);
+
+            /// <summary>
+            /// Moves a character to a position at once, standing still, without interpolating the camera from where it was.
+            /// </summary>
+            /// <param name="a_Character">The character component of the entity.</param>
+            /// <param name="a_Position">The position of the feet.</param>
+            static void teleport(CharacterComponent& a_Character, const ConfusShared::Vector3& a_Position);
+        };
+    }
+}
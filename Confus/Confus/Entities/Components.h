@@ -0,0 +1,63 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+
+#include "ConfusShared/CharacterController.h"
+#include "ConfusShared/EntityStore.h"
+
+namespace Confus
+{
+    class Flag;
+
+    using ConfusShared::ETeamIdentifier;
+    using ConfusShared::EFlagEnum;
+    using ConfusShared::Health;
+
+    namespace Entities
+    {
+        using ConfusShared::Entity;
+        using ConfusShared::TeamComponent;
+
+        /// <summary>
+        /// Where an entity is in the world, read from the scene node that represents it
+        /// </summary>
+        struct TransformComponent
+        {
+            irr::scene::ISceneNode* Node = nullptr;
+        };
+
+        /// <summary>
+        /// Whether an entity that can pick up flags is carrying one, and which
+        /// </summary>
+        struct FlagCarrierComponent
+        {
+            EFlagEnum Status = EFlagEnum::None;
+            /// <summary> The flag being carried, nullptr once it has been dropped, returned or scored </summary>
+            Flag* CarriedFlag = nullptr;
+        };
+
+        /// <summary>
+        /// A character moved by the shared character controller each fixed update, and the camera that follows it
+        /// </summary>
+        struct CharacterComponent
+        {
+            /// <summary> The camera placed at the eyes of the character, which only turns with the mouse itself </summary>
+            irr::scene::ICameraSceneNode* Camera = nullptr;
+            ConfusShared::CharacterState State;
+            /// <summary> The position of the feet before the last fixed update, to interpolate the camera from </summary>
+            ConfusShared::Vector3 PreviousPosition;
+            /// <summary> The input the character moves by in the next fixed update </summary>
+            ConfusShared::PlayerInput Input;
+        };
+
+        /// <summary>
+        /// How an entity that is moved as a character is put back into its base, after dying or falling out of the level
+        /// </summary>
+        struct RespawnComponent
+        {
+            /// <summary> The position of the feet at the base </summary>
+            ConfusShared::Vector3 SpawnPosition;
+            /// <summary> The height below which the entity has fallen out of the level </summary>
+            irr::f32 FallHeight = ConfusShared::FallHeight;
+        };
+    }
+}
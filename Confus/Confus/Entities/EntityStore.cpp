@@ -0,0 +1,16 @@
+#include "EntityStore.h"
+
+namespace Confus
+{
+    namespace Entities
+    {
+        void EntityStore::removeComponents(Entity a_Entity)
+        {
+            ConfusShared::EntityStore::removeComponents(a_Entity);
+            Transforms.remove(a_Entity);
+            FlagCarriers.remove(a_Entity);
+            Respawns.remove(a_Entity);
+            Characters.remove(a_Entity);
+        }
+    }
+}
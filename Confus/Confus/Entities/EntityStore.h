@@ -0,0 +1,25 @@
+#pragma once
+#include "ConfusShared/EntityStore.h"
+#include "Components.h"
+
+namespace Confus
+{
+    namespace Entities
+    {
+        using ConfusShared::ComponentArray;
+
+        /// <summary>
+        /// The entities of the client, with the components that refer to its scene next to the ones shared with the server.
+        /// </summary>
+        class EntityStore : public ConfusShared::EntityStore
+        {
+        public:
+            ComponentArray<TransformComponent> Transforms;
+            ComponentArray<FlagCarrierComponent> FlagCarriers;
+            ComponentArray<RespawnComponent> Respawns;
+            ComponentArray<CharacterComponent> Characters;
+        protected:
+            virtual void removeComponents(Entity a_Entity) override;
+        };
+    }
+}
@@ -0,0 +1,57 @@
+#include "CharacterSystem.h"
+#include "RespawnSystem.h"
+#include "../Flag.h"
+
+namespace Confus
+{
+    namespace Entities
+    {
+        RespawnSystem::RespawnSystem(EntityStore& a_EntityStore)
+            : m_EntityStore(a_EntityStore)
+        {
+        }
+
+        void RespawnSystem::update()
+        {
+            for(size_t i = 0; i < m_EntityStore.Respawns.size(); ++i)
+            {
+                Entity entity = m_EntityStore.Respawns.getEntity(i);
+                if(!m_EntityStore.Characters.has(entity))
+                {
+                    continue;
+                }
+
+                const RespawnComponent& respawnComponent = m_EntityStore.Respawns.at(i);
+                CharacterComponent& character = m_EntityStore.Characters.get(entity);
+                bool died = m_EntityStore.Healths.has(entity) && m_EntityStore.Healths.get(entity).getHealth() <= 0;
+                bool fell = character.State.Position.Y <= respawnComponent.FallHeight;
+                if(!died && !fell)
+                {
+                    continue;
+                }
+
+                respawn(respawnComponent, character);
+                if(m_EntityStore.FlagCarriers.has(entity))
+                {
+                    Flag* carriedFlag = m_EntityStore.FlagCarriers.get(entity).CarriedFlag;
+                    if(carriedFlag != nullptr)
+                    {
+                        if(died)
+                        {
+                            carriedFlag->drop(entity);
+                        }
+                        else
+                        {
+                            carriedFlag->returnToStartPosition();
+                        }
+                    }
+                }
+            }
+        }
+
+        void RespawnSystem::respawn(const RespawnComponent& a_Respawn, CharacterComponent& a_Character)
+        {
+            CharacterSystem::teleport(a_Character, a_Respawn.SpawnPosition);
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "EntityStore.h"
+
+namespace Confus
+{
+    namespace Entities
+    {
+        /// <summary>
+        /// Puts entities back into their base once they have died or fallen out of the level.
+        /// Walks the packed respawn components, so every player is handled in one linear pass instead of by its own update.
+        /// </summary>
+        class RespawnSystem
+        {
+        private:
+            EntityStore& m_EntityStore;
+        public:
+            /// <summary>
+            /// Initializes a new instance of the <see cref="RespawnSystem"/> class.
+            /// </summary>
+            /// <param name="a_EntityStore">The store to walk, which has to outlive this.</param>
+            RespawnSystem(EntityStore& a_EntityStore);
+
+            /// <summary>
+            /// Respawns every entity that has died or fallen, dropping the flag it carried where it died
+            /// or returning it to its base if it fell.
+            /// </summary>
+            void update();
+
+            /// <summary>
+            /// Moves the character of an entity back to its spawn position.
+            /// </summary>
+            /// <param name="a_Respawn">The respawn component of the entity.</param>
+            /// <param name="a_Character">The character component of the entity.</param>
+            static void respawn(const RespawnComponent& a_Respawn, CharacterComponent& a_Character);
+        };
+    }
+}
@@ -1,37 +1,26 @@
 #pragma once
+#include <Irrlicht/irrlicht.h>
+
+#include "Entities\EntityStore.h"
 
 namespace Confus 
 {
-class Player;
 class Collider;
 
-/// <summary> The Team's Identifier. A player has a team, flag has a team, ui has a team, etc. </summary>
-enum class ETeamIdentifier 
-{
-	
-	None, ///< This object doesn't have a team identifier.
-	TeamRed, ///< This object has a red team identifier.
-	TeamBlue ///< This object has a blue team identifier.
-};
-
-/// <summary> The Flag's status. A player can have flagtaken or no flag. A flag can be taken, dropped or at base. </summary>
-enum class EFlagEnum
-{ 
-    None, ///< Player is carrying nothing		  
-	FlagBase, ///< Flag is at the base
-    FlagTaken, ///< The flag is taken. / A player is carrying a flag.
-    FlagDropped ///< The flag is dropped.
-};
-
 	///Flag Class, every flag should have this class, contains info about a flag
 	/// Flag class with status and team id
 	class Flag 
     {
     private:		
-		irr::core::vector3df* m_StartPosition;
-		irr::core::vector3df* m_StartRotation;
-		EFlagEnum* m_FlagStatus;
-        ETeamIdentifier* m_TeamIdentifier;
+		irr::core::vector3df m_StartPosition;
+		irr::core::vector3df m_StartRotation;
+		EFlagEnum m_FlagStatus = EFlagEnum::FlagBase;
+        /// <summary> The store holding the team of the flag and the state of the players that carry it </summary>
+        Entities::EntityStore& m_EntityStore;
+        /// <summary> The flag itself, with its team and transform </summary>
+        Entities::Entity m_Entity;
+        /// <summary> The entity carrying the flag, invalid while nobody is </summary>
+        Entities::Entity m_Carrier;
         irr::scene::IMeshSceneNode* m_FlagNode;
         Collider* m_Collider;
         irr::scene::ISceneNode* m_FlagOldParent;
@@ -39,13 +28,14 @@ enum class EFlagEnum
     public: 
         /// <summary> Flag class constructor. </summary>
         /// <param name="a_Device">The active Irrlicht Device.</param>
+        /// <param name="a_EntityStore">The store to create the flag's entity in.</param>
         /// <param name="a_TeamIdentifier">The team's identifier the flag should have.</param>
-        Flag(irr::IrrlichtDevice* a_Device, ETeamIdentifier a_TeamIdentifier);
+        Flag(irr::IrrlichtDevice* a_Device, Entities::EntityStore& a_EntityStore, ETeamIdentifier a_TeamIdentifier);
         /// <summary> Flag class destructor </summary>
         ~Flag();
-		/// <summary> Capture Flag a flag with the wanted playerobject parent. </summary>
-		/// <param name="a_PlayerObject"> The player object that should carry the flag. </param>
-		void captureFlag(Player* a_PlayerObject);
+		/// <summary> Capture Flag a flag with the wanted carrier as parent. </summary>
+		/// <param name="a_Carrier"> The entity that should carry the flag, which needs a team, transform and flag carrier. </param>
+		void captureFlag(Entities::Entity a_Carrier);
 		/// <summary> Set the starting position of the flag that it will reset to. </summary>
 		/// <param name="a_Position"> The position the flag will reset to. </param>
         void setStartPosition(irr::core::vector3df a_Position);
@@ -53,13 +43,13 @@ enum class EFlagEnum
 		/// <param name="a_Rotation"> The rotation the flag will reset to. </param>
         void setStartRotation(irr::core::vector3df a_Rotation);
 		/// <summary> Will drop the flag at the current position. </summary>
-		/// <param name="a_PlayerObject"> The player object that drops the flag. </param>
-		void drop(Player* a_PlayerObject);
-		/// <summary> Will return the flag to it's starting position and rotation. </summary>
+		/// <param name="a_Carrier"> The entity that drops the flag. </param>
+		void drop(Entities::Entity a_Carrier);
+		/// <summary> Will return the flag to it's starting position and rotation, taking it from its carrier if it had one. </summary>
 		void returnToStartPosition();
-		/// <summary> The player carrying a flag has gotten a point. </summary>
-		/// <param name="a_PlayerObject"> Score a point for the player object. </param>
-		void score(Player* a_PlayerObject);
+		/// <summary> The carrier of a flag has gotten a point. </summary>
+		/// <param name="a_Carrier"> Score a point for the carrier. </param>
+		void score(Entities::Entity a_Carrier);
 		/// <summary> Set the collision of the level and players and add an physics animation. </summary>
 		/// <param name="a_SceneManager"> Pass the scenemanager to add a physics animator. </param>
 		/// <param name="a_TriangleSelector"> The triangle seletor that has the level and players. </param>
@@ -71,5 +61,8 @@ enum class EFlagEnum
         void initParticleSystem(irr::scene::ISceneManager* a_SceneManager);
 		void setColor(irr::video::IVideoDriver* a_VideoDriver);
 		irr::video::SColor getColor();
+        ETeamIdentifier getTeam() const;
+        /// <summary> Clears the flag from its carrier, if it has one </summary>
+        void releaseCarrier();
 	};
 }
@@ -1,4 +1,5 @@
 #include <Irrlicht/irrlicht.h>
+#include <cwchar>
 
 #include "GUI.h"
 
@@ -14,7 +15,8 @@ namespace Confus
 		m_BloodOverlay->setVisible(false);
 		m_PlayerNode = a_Player;
 		m_HealthTextBox = m_GUIEnvironment->addStaticText(L"", irr::core::rect<irr::s32>(10, 10, 100, 25), false);
-		m_AudioSourceLowHealth = new OpenALSource("heartbeat.wav");
+		m_AudioSourceLowHealth = new OpenALStreamingSource("heartbeat.wav");
+		m_AudioSourceLowHealth->enableLoop();
 	}
 
 	GUI::~GUI()
@@ -24,26 +26,34 @@ namespace Confus
 
 	void GUI::update()
 	{
-		m_HealthString = (L"Health: " + std::to_wstring(m_PlayerNode->PlayerHealth.getHealth()) + L"%").c_str();
-		m_HealthTextBox->setText(m_HealthString.c_str());
+		int health = m_PlayerNode->getHealth().getHealth();
+		//The text is only rebuilt when the health changes, instead of allocating a new string every frame
+		if (health != m_ShownHealth)
+		{
+			wchar_t healthText[32];
+			std::swprintf(healthText, sizeof(healthText) / sizeof(healthText[0]), L"Health: %d%%", health);
+			m_HealthTextBox->setText(healthText);
+			m_ShownHealth = health;
+		}
 		drawBloodOverlay();
 		lowHealthAudio();
 	}
 
 	void GUI::drawBloodOverlay()
 	{
-		m_BloodOverlay->setVisible(m_PlayerNode->PlayerHealth.getHealth() <= 50);
+		m_BloodOverlay->setVisible(m_PlayerNode->getHealth().getHealth() <= 50);
 	}
 
 	void GUI::lowHealthAudio()
 	{
-		if (m_PlayerNode->PlayerHealth.getHealth() <= 25)
+		if (m_PlayerNode->getHealth().getHealth() <= 25)
 		{
 			m_AudioSourceLowHealth->play();
 		}
-		else
+		else if (m_AudioSourceLowHealth->isPlaying())
 		{
 			m_AudioSourceLowHealth->stop();
 		}
+		m_AudioSourceLowHealth->update();
 	}
 }
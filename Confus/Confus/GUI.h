@@ -2,7 +2,7 @@
 #include <Irrlicht/irrlicht.h>
 
 #include "Player.h"
-#include "OpenAL\OpenALSource.h"
+#include "OpenAL\OpenALStreamingSource.h"
 
 namespace Confus
 {
@@ -12,11 +12,12 @@ namespace Confus
 		Player* m_PlayerNode;
 		irr::gui::IGUIEnvironment* m_GUIEnvironment;
 		irr::gui::IGUIStaticText* m_HealthTextBox;
-		irr::core::stringw m_HealthString = L"";
+		/// <summary> The health the text box currently shows, -1 before it shows any </summary>
+		int m_ShownHealth = -1;
 		irr::video::IVideoDriver* m_Driver;
 		irr::video::ITexture* m_BloodImage;
 		irr::gui::IGUIImage* m_BloodOverlay;
-		OpenALSource* m_AudioSourceLowHealth;
+		OpenALStreamingSource* m_AudioSourceLowHealth;
 
 	public:
 		GUI(irr::IrrlichtDevice* a_Device, Player* a_Player);
@@ -1,6 +1,8 @@
 #include <Irrlicht/irrlicht.h>
-#include <time.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "Game.h"
 #include "Player.h"
@@ -10,20 +12,101 @@
 
 namespace Confus
 {
-    const double Game::FixedUpdateInterval = 0.02;
+    namespace
+    {
+        /// <summary>
+        /// Adds the triangles a selector has in world space to the collision world as a body.
+        /// </summary>
+        std::uint32_t addCollisionBody(ConfusShared::CollisionWorld& a_World, irr::scene::ITriangleSelector* a_Selector)
+        {
+            std::vector<irr::core::triangle3df> triangles(static_cast<size_t>(a_Selector->getTriangleCount()));
+            irr::s32 count = 0;
+            a_Selector->getTriangles(triangles.data(), static_cast<irr::s32>(triangles.size()), count);
+
+            std::vector<ConfusShared::Triangle> converted;
+            converted.reserve(static_cast<size_t>(count));
+            for(irr::s32 i = 0; i < count; ++i)
+            {
+                const irr::core::triangle3df& triangle = triangles[i];
+                converted.push_back({ { triangle.pointA.X, triangle.pointA.Y, triangle.pointA.Z },
+                    { triangle.pointB.X, triangle.pointB.Y, triangle.pointB.Z },
+                    { triangle.pointC.X, triangle.pointC.Y, triangle.pointC.Z } });
+            }
+            return a_World.addBody(converted.data(), converted.size());
+        }
+    }
+
+    const double Game::FixedUpdateInterval = ConfusShared::TickInterval;
     const double Game::MaxFixedUpdateInterval = 0.1;
+    const double Game::MaxTimelineDrift = 1.0;
+    const std::vector<Assets::AssetRequest> Game::PreloadedAssets = {
+        { Assets::EAssetType::Texture, "Media/Textures/SquareWall.jpg" },
+        { Assets::EAssetType::Texture, "Media/Textures/SquareWallTransparent.png" },
+        { Assets::EAssetType::Texture, "Media/Textures/Flag/FLAG_BLUE.png" },
+        { Assets::EAssetType::Texture, "Media/Textures/Flag/FLAG_RED.png" },
+        { Assets::EAssetType::Texture, "Media/Textures/Blood.png" },
+        { Assets::EAssetType::Texture, "Media/nskinbl.jpg" },
+        { Assets::EAssetType::Texture, "Media/nskinrd.jpg" },
+        { Assets::EAssetType::Texture, "media/textures/concrete.png" },
+        { Assets::EAssetType::Texture, "media/textures/redbox.png" },
+        { Assets::EAssetType::Texture, "media/textures/bluebox.png" },
+        { Assets::EAssetType::Texture, "media/textures/glass.png" },
+        { Assets::EAssetType::Texture, "media/textures/floor/floortexture_1.jpg" },
+        { Assets::EAssetType::Mesh, "Media/Meshes/WallMeshSquare.irrmesh" },
+        { Assets::EAssetType::Mesh, "Media/BaseGlassFloor.irrmesh" },
+        { Assets::EAssetType::Mesh, "Media/Meshes/Flag.3ds" },
+        { Assets::EAssetType::Mesh, "Media/ninja.b3d" },
+        { Assets::EAssetType::Sound, "Footstep1_Concrete.wav" },
+        { Assets::EAssetType::Sound, "Footstep2_Concrete.wav" },
+        { Assets::EAssetType::Sound, "Footstep3_Concrete.wav" },
+        { Assets::EAssetType::Sound, "Grunt1.wav" },
+        { Assets::EAssetType::Sound, "Grunt2.wav" },
+        { Assets::EAssetType::Sound, "GruntHeavy.wav" },
+        { Assets::EAssetType::Sound, "Sword_swing_1.wav" },
+        { Assets::EAssetType::Sound, "Sword_swing_2.wav" },
+        { Assets::EAssetType::Sound, "Sword_swing_3.wav" },
+        { Assets::EAssetType::Sound, "Sword_swing_4.wav" }
+    };
 
     Game::Game()
         : m_Device(irr::createDevice(irr::video::E_DRIVER_TYPE::EDT_OPENGL)),
-		m_MazeGenerator(m_Device, irr::core::vector3df(0.0f, 0.0f, 0.0f),(19+20+21+22+23+24)), // magic number is just so everytime the first maze is generated it looks the same, not a specific number is chosen
-        m_PlayerNode(m_Device, 1, ETeamIdentifier::TeamBlue, true),
-        m_SecondPlayerNode(m_Device, 1, ETeamIdentifier::TeamRed, false),
-        m_BlueFlag(m_Device, ETeamIdentifier::TeamBlue),
-        m_RedFlag(m_Device, ETeamIdentifier::TeamRed),
-        m_RedRespawnFloor(m_Device),
-        m_BlueRespawnFloor(m_Device),
-		m_GUI(m_Device, &m_PlayerNode)
+        m_AssetRegistry(m_Device),
+        m_AssetLoader(m_Device, m_AssetRegistry, PreloadedAssets),
+		m_MazeSchedule(ConfusShared::MazeSchedule::MatchSeed),
+		m_MazeGenerator(m_Device, m_AssetRegistry, m_SolidityEvents, irr::core::vector3df(0.0f, 0.0f, 0.0f), m_MazeSchedule.getSeed(), m_FrameArena),
+        m_LineOfSight(m_MazeGenerator.getMainMaze()),
+        m_MazeVisibility(m_MazeGenerator.getMainMaze(), m_LineOfSight),
+        m_VoicePool(m_LineOfSight),
+        m_CharacterSystem(m_EntityStore, m_CollisionWorld),
+        m_RespawnSystem(m_EntityStore),
+        m_PlayerNode(m_Device, m_EntityStore, 1, ETeamIdentifier::TeamBlue, true, m_VoicePool),
+        m_SecondPlayerNode(m_Device, m_EntityStore, 1, ETeamIdentifier::TeamRed, false, m_VoicePool),
+        m_BlueFlag(m_Device, m_EntityStore, ETeamIdentifier::TeamBlue),
+        m_RedFlag(m_Device, m_EntityStore, ETeamIdentifier::TeamRed),
+        m_RedRespawnFloor(m_Device, m_AssetRegistry, m_SolidityEvents),
+        m_BlueRespawnFloor(m_Device, m_AssetRegistry, m_SolidityEvents),
+		m_GUI(m_Device, &m_PlayerNode),
+        m_FrameSystems(m_WorkerPool),
+        m_FixedSystems(m_WorkerPool)
+    {
+        registerSystems();
+    }
+
+    void Game::registerSystems()
     {
+        using Component = ESystemComponent;
+        //Systems that conflict run in the order they are registered in, the others run in parallel
+        m_FrameSystems.addSystem("Player", { Component::Players }, { Component::Audio }, [this]() { m_PlayerNode.update(); });
+        m_FrameSystems.addSystem("GUI", { Component::Health }, { Component::Gui, Component::Audio }, [this]() { m_GUI.update(); });
+        m_FrameSystems.addSystem("Audio", { Component::Cameras }, { Component::Audio }, [this]() { updateAudio(); });
+
+        m_FixedSystems.addSystem("MazeSchedule", {}, { Component::MazeSchedule, Component::MazeWalls, Component::LevelCollision }, [this]() { updateMazeSchedule(); });
+        m_FixedSystems.addSystem("MazeWalls", {}, { Component::MazeWalls, Component::LevelCollision }, [this]() { m_MazeGenerator.fixedUpdate(); });
+        m_FixedSystems.addSystem("LineOfSight", { Component::MazeWalls }, { Component::LineOfSight }, [this]() { m_LineOfSight.updateOccluders(); });
+        m_FixedSystems.addSystem("Characters", { Component::LevelCollision }, { Component::Characters },
+            [this]() { m_CharacterSystem.fixedUpdate(static_cast<float>(FixedUpdateInterval)); });
+        //Falls are checked right after every move, in the same tick as the server checks them
+        m_FixedSystems.addSystem("Respawn", { Component::Health }, { Component::Characters, Component::Flags }, [this]() { m_RespawnSystem.update(); });
     }
 
     void Game::run()
@@ -33,19 +116,36 @@ namespace Confus
         m_LevelRootNode = m_Device->getSceneManager()->addEmptySceneNode();
 
         m_LevelRootNode->setPosition(irr::core::vector3df(1.0f, 1.0f, 1.0f));
-        sceneManager->loadScene("Media/IrrlichtScenes/Bases 2.irr", nullptr, m_LevelRootNode);
+        try
+        {
+            m_CookedLevel = std::make_unique<Level::CookedLevel>(m_Device, Level::CookedLevel::DefaultCookedFile, m_LevelRootNode);
+        }
+        catch(std::invalid_argument&)
+        {
+            //The level has not been cooked yet, so the XML scene is loaded instead
+            sceneManager->loadScene(Level::CookedLevel::DefaultSceneFile, nullptr, m_LevelRootNode);
+        }
         m_LevelRootNode->setScale(irr::core::vector3df(1.0f, 1.0f, 1.0f));
         m_LevelRootNode->setVisible(true);
+        m_BlueRespawnFloor.setPosition(irr::core::vector3df(0.f, 3.45f, 11.f));
+        m_RedRespawnFloor.setPosition(irr::core::vector3df(0.f, 3.45f, -83.f));
         
         processTriangleSelectors();
+        //Everything is solid at this point, from here on only the transitions have to be applied to the level selector
+        m_SolidityEvents.addListener([this](const SolidityEvent& a_Event) { updateLevelCollision(a_Event); });
 
-        m_PlayerNode.setLevelCollider(m_Device->getSceneManager(), m_LevelRootNode->getTriangleSelector());
-        m_SecondPlayerNode.setLevelCollider(m_Device->getSceneManager(), m_LevelRootNode->getTriangleSelector());
         m_BlueFlag.setCollisionTriangleSelector(m_Device->getSceneManager(), m_LevelRootNode->getTriangleSelector());
         m_RedFlag.setCollisionTriangleSelector(m_Device->getSceneManager(), m_LevelRootNode->getTriangleSelector());
 
-        m_BlueRespawnFloor.setPosition(irr::core::vector3df(0.f, 3.45f, 11.f));
-        m_RedRespawnFloor.setPosition(irr::core::vector3df(0.f, 3.45f, -83.f));
+        std::cout << "Resident assets: "
+            << m_AssetRegistry.getAssetCount(Assets::EAssetType::Texture) << " textures ("
+            << m_AssetRegistry.getMemoryUsage(Assets::EAssetType::Texture) / 1024 << " KiB), "
+            << m_AssetRegistry.getAssetCount(Assets::EAssetType::Mesh) << " meshes ("
+            << m_AssetRegistry.getMemoryUsage(Assets::EAssetType::Mesh) / 1024 << " KiB), "
+            << m_AssetRegistry.getAssetCount(Assets::EAssetType::Sound) << " sounds ("
+            << m_AssetRegistry.getMemoryUsage(Assets::EAssetType::Sound) / 1024 << " KiB)" << std::endl;
+
+        m_MazeVisibility.addDynamicNode(m_SecondPlayerNode.PlayerNode);
 
         m_Device->setEventReceiver(&m_EventManager);
         m_Device->getCursorControl()->setVisible(false);
@@ -71,16 +171,38 @@ namespace Confus
         {
             irr::scene::ISceneNode* node = nodes[i];
             irr::scene::ITriangleSelector* selector = nullptr;
+            //Parents come before their children, so the selectors read the world positions the nodes will have once drawn
+            node->updateAbsolutePosition();
 
             switch(node->getType())
             {
             case irr::scene::ESNT_CUBE:
-            case irr::scene::ESNT_ANIMATED_MESH:
                 selector = m_Device->getSceneManager()->createTriangleSelectorFromBoundingBox(node);
                 break;
+            case irr::scene::ESNT_ANIMATED_MESH:
+                //Walls and floors that can become passable collide through their own selector, so it can be removed again
+                selector = node->getTriangleSelector();
+                if(selector)
+                {
+                    selector->grab();
+                }
+                else
+                {
+                    selector = m_Device->getSceneManager()->createTriangleSelectorFromBoundingBox(node);
+                }
+                break;
             case irr::scene::ESNT_MESH:
             case irr::scene::ESNT_SPHERE:
-                selector = sceneManager->createTriangleSelector(((irr::scene::IMeshSceneNode*)node)->getMesh(), node);
+                //The cooked level comes with a prebuilt selector
+                selector = node->getTriangleSelector();
+                if(selector)
+                {
+                    selector->grab();
+                }
+                else
+                {
+                    selector = sceneManager->createTriangleSelector(((irr::scene::IMeshSceneNode*)node)->getMesh(), node);
+                }
                 break;
             case irr::scene::ESNT_TERRAIN:
                 selector = sceneManager->createTerrainTriangleSelector((irr::scene::ITerrainSceneNode*)node);
@@ -95,10 +217,50 @@ namespace Confus
             if(selector)
             {
                 metatriangleSelector->addTriangleSelector(selector);
+                if(!isEntityNode(node))
+                {
+                    m_CollisionBodies[selector] = addCollisionBody(m_CollisionWorld, selector);
+                }
                 selector->drop();
             }
         }
         m_LevelRootNode->setTriangleSelector(metatriangleSelector);
+        m_LevelTriangleSelector = metatriangleSelector;
+        m_CollisionWorld.build();
+    }
+
+    bool Game::isEntityNode(irr::scene::ISceneNode* a_Node) const
+    {
+        for(irr::scene::ISceneNode* node = a_Node; node != nullptr; node = node->getParent())
+        {
+            for(size_t i = 0; i < m_EntityStore.Transforms.size(); ++i)
+            {
+                if(m_EntityStore.Transforms.at(i).Node == node)
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void Game::updateLevelCollision(const SolidityEvent& a_Event)
+    {
+        bool solid = a_Event.Change == ESolidityChange::BecameSolid;
+        if(solid)
+        {
+            m_LevelTriangleSelector->addTriangleSelector(a_Event.Collider);
+        }
+        else
+        {
+            m_LevelTriangleSelector->removeTriangleSelector(a_Event.Collider);
+        }
+
+        auto body = m_CollisionBodies.find(a_Event.Collider);
+        if(body != m_CollisionBodies.end())
+        {
+            m_CollisionWorld.setBodySolid(body->second, solid);
+        }
     }
 
     void Game::initializeConnection()
@@ -125,19 +287,30 @@ namespace Confus
         m_CurrentTicks = m_Device->getTimer()->getTime();
         m_DeltaTime = (m_CurrentTicks - m_PreviousTicks) / 1000.0;
 
-        m_PlayerNode.update();
-		m_GUI.update();
-        m_Listener.setPosition(m_PlayerNode.CameraNode->getAbsolutePosition());
-        irr::core::quaternion playerRotation(m_PlayerNode.CameraNode->getRotation());
+        m_FrameSystems.run();
+        m_FrameArena.reset();
+    }
 
-        //Todo: Fix rotations
-        irr::core::vector3df upVector = playerRotation * irr::core::vector3df( 0, 1, 0 );
-        irr::core::vector3df forwardVector = playerRotation * irr::core::vector3df(0, 0, 1);
-        m_Listener.setDirection(forwardVector, upVector);     
+    void Game::updateAudio()
+    {
+        //Suspending the context lets OpenAL apply all of this frame's changes as a single batch
+        auto context = alcGetCurrentContext();
+        alcSuspendContext(context);
+        m_Listener.update(m_PlayerNode.CameraNode->getAbsolutePosition(), m_PlayerNode.CameraNode->getRotation());
+        m_VoicePool.update(m_DeltaTime, m_PlayerNode.CameraNode->getAbsolutePosition());
+        alcProcessContext(context);
     }
 
     void Game::processFixedUpdates()
     {
+        if(m_Connection->isClockSynchronized())
+        {
+            followServerTimeline();
+            m_CharacterSystem.interpolate(static_cast<float>(std::min(m_FixedUpdateTimer / FixedUpdateInterval, 1.0)));
+            return;
+        }
+
+        m_OnServerTimeline = false;
         m_FixedUpdateTimer += m_DeltaTime;
         m_FixedUpdateTimer = irr::core::min_(m_FixedUpdateTimer, MaxFixedUpdateInterval);
         while(m_FixedUpdateTimer >= FixedUpdateInterval)
@@ -145,29 +318,80 @@ namespace Confus
             m_FixedUpdateTimer -= FixedUpdateInterval;
             fixedUpdate();
         }
+        m_CharacterSystem.interpolate(static_cast<float>(m_FixedUpdateTimer / FixedUpdateInterval));
     }
 
     void Game::fixedUpdate()
     {
-		static float timer = 0.0f;
-		timer += static_cast<float>(m_DeltaTime);
-        if(timer >= 3.0f && timer <= 8.0f)
+        //The character moves by the quantized input, exactly what the server receives, so both end up in the same place
+        ConfusShared::PlayerInput input = ConfusShared::InputCodec::quantize(m_PlayerNode.sampleInput(m_EventManager, m_Tick));
+        m_PlayerNode.setInput(input);
+        m_FixedSystems.run();
+        //The input goes out every tick on its own, as the redundancy only helps when every packet carries the newest input
+        m_Connection->sendInput(input);
+        //Everything queued for the server during the tick leaves in as few datagrams as possible
+        m_Connection->flushMessages();
+        m_FrameArena.reset();
+        ++m_Tick;
+    }
+
+    void Game::followServerTimeline()
+    {
+        std::uint32_t serverTick = m_Connection->getServerTick();
+        double serverTime = m_Connection->getServerTime();
+        double drift = (static_cast<double>(serverTick) - m_Tick) * FixedUpdateInterval;
+        if(!m_OnServerTimeline || std::abs(drift) > MaxTimelineDrift)
+        {
+            skipToTick(serverTick);
+            m_OnServerTimeline = true;
+        }
+
+        //Like the local clock, a long frame does not make up for more than the maximum interval at once
+        auto maxFixedUpdates = static_cast<int>(MaxFixedUpdateInterval / FixedUpdateInterval);
+        for(int i = 0; i < maxFixedUpdates && m_Tick < serverTick; ++i)
+        {
+            fixedUpdate();
+        }
+        m_FixedUpdateTimer = std::max(serverTime - m_Tick * FixedUpdateInterval, 0.0);
+    }
+
+    void Game::skipToTick(std::uint32_t a_Tick)
+    {
+        std::int32_t previousSeed = m_MazeSchedule.getSeed();
+        if(a_Tick < m_Tick)
+        {
+            m_MazeSchedule = ConfusShared::MazeSchedule(ConfusShared::MazeSchedule::MatchSeed);
+            m_Tick = 0;
+        }
+        m_MazeSchedule.skip(a_Tick - m_Tick, FixedUpdateInterval);
+        m_Tick = a_Tick;
+        if(m_MazeSchedule.getSeed() != previousSeed)
+        {
+            m_MazeGenerator.refillMainMaze(m_MazeSchedule.getSeed());
+        }
+    }
+
+    void Game::updateMazeSchedule()
+    {
+        if(m_MazeSchedule.fixedUpdate(FixedUpdateInterval))
+        {
+            m_MazeGenerator.refillMainMaze(m_MazeSchedule.getSeed());
+        }
+        if(m_MazeSchedule.areRespawnFloorsSolid())
         {
             m_BlueRespawnFloor.enableCollision();
             m_RedRespawnFloor.enableCollision();
         }
-		if (timer >= 9.0f)
-		{
-			timer = 0.0f;
-			m_MazeGenerator.refillMainMaze(static_cast<int>(time(0)));
+        else
+        {
             m_BlueRespawnFloor.disableCollision();
             m_RedRespawnFloor.disableCollision();
-		}
-		m_MazeGenerator.fixedUpdate();
+        }
     }
 
     void Game::render()
     {
+        m_MazeVisibility.update(m_PlayerNode.CameraNode->getAbsolutePosition());
         m_Device->getVideoDriver()->beginScene(true, true, irr::video::SColor(255, 100, 101, 140));
         m_Device->getSceneManager()->drawAll();
         m_Device->getGUIEnvironment()->drawAll();
@@ -1,15 +1,27 @@
 #pragma once
 #include <Irrlicht/irrlicht.h>
+#include <unordered_map>
+#include "ConfusShared/ClockSync.h"
+#include "ConfusShared/CollisionWorld.h"
+#include "ConfusShared/FrameArena.h"
+#include "ConfusShared/MazeSchedule.h"
+#include "ConfusShared/SystemScheduler.h"
 
 #include "Networking/ClientConnection.h"
 #include "MazeGenerator.h"
 #include "OpenAL\OpenALListener.h"
 #include "Player.h"
 #include "Audio\PlayerAudioEmitter.h"
+#include "Audio\VoicePool.h"
 #include "EventManager.h"
 #include "Flag.h"
 #include "RespawnFloor.h"
 #include "GUI.h"
+#include "Level\CookedLevel.h"
+#include "Assets\AssetLoader.h"
+#include "Rendering\MazeVisibility.h"
+#include "Entities\CharacterSystem.h"
+#include "Entities\RespawnSystem.h"
 
 namespace Confus
 {    
@@ -21,6 +33,24 @@ namespace Confus
     class Game
     {
     private:
+        /// <summary>
+        /// What the systems of the game read and write, so the ones that do not conflict can run in parallel
+        /// </summary>
+        enum class ESystemComponent
+        {
+            Players, ///< The player scene nodes and their animation.
+            Health, ///< The health of the players.
+            Cameras, ///< The cameras the players look through.
+            Characters, ///< The characters that move the players through the level.
+            Flags, ///< The flags and who carries them.
+            Audio, ///< The voice pool, the listener and everything else that plays sound.
+            Gui, ///< The GUI elements.
+            MazeSchedule, ///< The timeline of refills.
+            MazeWalls, ///< The maze tiles and the walls on them.
+            LevelCollision, ///< The level triangle selector, changed whenever something becomes solid or passable.
+            LineOfSight ///< The occluders of the line of sight.
+        };
+
         /// <summary>
         /// The rate at which fixed updates are carried out
         /// </summary>
@@ -29,6 +59,14 @@ namespace Confus
         /// The interval to clamp to if the delay between sequential fixed updates is too long
         /// </summary>
         static const double MaxFixedUpdateInterval;
+        /// <summary>
+        /// How far in seconds the client may be behind or ahead of the server's timeline before it skips to where the server is
+        /// </summary>
+        static const double MaxTimelineDrift;
+        /// <summary>
+        /// The textures, meshes and sounds that are loaded in parallel before the game objects are created
+        /// </summary>
+        static const std::vector<Assets::AssetRequest> PreloadedAssets;
 
         /// <summary>
         /// The instance of the IrrlichtDevice
@@ -36,14 +74,66 @@ namespace Confus
         /// </summary>
         irr::IrrlichtDevice* m_Device;
         /// <summary>
+        /// The OpenAL listener that is attached to the camera.
+        /// </summary>
+        OpenALListener m_Listener;
+        /// <summary>
+        /// Owns the assets the objects below acquire, so it has to outlive them
+        /// </summary>
+        Assets::AssetRegistry m_AssetRegistry;
+        /// <summary>
+        /// Loads the assets before the objects below acquire them, so it has to stay above them
+        /// </summary>
+        Assets::AssetLoader m_AssetLoader;
+        /// <summary>
+        /// Where the maze walls and respawn floors publish becoming solid or passable, so it has to outlive them
+        /// </summary>
+        SolidityEvents m_SolidityEvents;
+        /// <summary>
+        /// The memory for containers that only live during a single update, reset at the end of every update and fixed update
+        /// </summary>
+        ConfusShared::FrameArena m_FrameArena;
+        /// <summary>
+        /// When the maze is refilled and with which seed, advanced each fixed update
+        /// </summary>
+        ConfusShared::MazeSchedule m_MazeSchedule;
+        /// <summary>
         /// MazeGenerator that hasa accesible maze
         /// </summary>
         MazeGenerator m_MazeGenerator;
         /// <summary>
-        /// The OpenAL listener that is attached to the camera.
+        /// The line of sight through the maze, shared by the culling and the sound occlusion
         /// </summary>
-        OpenALListener m_Listener;
+        MazeLineOfSight m_LineOfSight;
+        /// <summary>
+        /// Culls the maze walls and the other player the camera cannot see
+        /// </summary>
+        Rendering::MazeVisibility m_MazeVisibility;
+        /// <summary>
+        /// The voices all positional sound effects are played through.
+        /// </summary>
+        Audio::VoicePool m_VoicePool;
         EventManager m_EventManager;
+        /// <summary>
+        /// The components of the players and flags, which have to outlive them
+        /// </summary>
+        Entities::EntityStore m_EntityStore;
+        /// <summary>
+        /// The level the characters collide with, built from the level selectors once the level is loaded
+        /// </summary>
+        ConfusShared::CollisionWorld m_CollisionWorld;
+        /// <summary>
+        /// The body in the collision world of each selector, to make it solid or passable along with the level selector
+        /// </summary>
+        std::unordered_map<irr::scene::ITriangleSelector*, std::uint32_t> m_CollisionBodies;
+        /// <summary>
+        /// Moves the players through the level with the controller the server uses as well
+        /// </summary>
+        Entities::CharacterSystem m_CharacterSystem;
+        /// <summary>
+        /// Respawns the players that died or fell out of the level
+        /// </summary>
+        Entities::RespawnSystem m_RespawnSystem;
 		/// <summary>
 		/// The GUI for the Player
 		/// </summary>
@@ -67,6 +157,14 @@ namespace Confus
         /// The delay between the last and future fixed update
         /// </summary>
         double m_FixedUpdateTimer = 0.0;
+        /// <summary>
+        /// The tick of the shared timeline that the next fixed update simulates
+        /// </summary>
+        std::uint32_t m_Tick = 0;
+        /// <summary>
+        /// Whether the fixed updates follow the server's timeline, they run on the local clock until it is known
+        /// </summary>
+        bool m_OnServerTimeline = false;
         /// <summary>
 		/// The time interval between the last update and the second-last
         /// </summary>
@@ -80,10 +178,30 @@ namespace Confus
         /// </summary>
         irr::u32 m_CurrentTicks = 0;
         irr::scene::ISceneNode* m_LevelRootNode;
+        /// <summary>
+        /// The selector everything collides with the level through, held by the level root node
+        /// </summary>
+        irr::scene::IMetaTriangleSelector* m_LevelTriangleSelector = nullptr;
+        /// <summary>
+        /// The cooked level geometry, or nullptr if the XML scene was loaded instead
+        /// </summary>
+        std::unique_ptr<Level::CookedLevel> m_CookedLevel;
 		/// <summary>
 		/// The connection as a client to the server that we are currently connected to
 		/// </summary>
 		std::unique_ptr<Networking::ClientConnection> m_Connection;
+        /// <summary>
+        /// The threads the systems run on, which has to outlive the schedulers
+        /// </summary>
+        ConfusShared::WorkerPool m_WorkerPool;
+        /// <summary>
+        /// The systems run once per frame
+        /// </summary>
+        ConfusShared::SystemScheduler m_FrameSystems;
+        /// <summary>
+        /// The systems run once per fixed update
+        /// </summary>
+        ConfusShared::SystemScheduler m_FixedSystems;
 
     public:
         /// <summary>
@@ -100,12 +218,26 @@ namespace Confus
         /// </summary>
         void run();
     private:
+        /// <summary>
+        /// Registers the work done each frame and each fixed update as systems, with what each of them reads and writes.
+        /// </summary>
+        void registerSystems();
         /// <summary>
         /// Processes the triangle selectors.
         /// </summary>
         void processTriangleSelectors();
         irr::scene::IMetaTriangleSelector* processLevelMetaTriangles();        
         /// <summary>
+        /// Gets whether a scene node is, or is attached to, the node of an entity, which moves and so is not part of the level
+        /// </summary>
+        /// <param name="a_Node">The scene node.</param>
+        bool isEntityNode(irr::scene::ISceneNode* a_Node) const;
+        /// <summary>
+        /// Adds or removes the collider of an object from the level selector and the collision world when it becomes solid or passable
+        /// </summary>
+        /// <param name="a_Event">The change in solidity.</param>
+        void updateLevelCollision(const SolidityEvent& a_Event);
+        /// <summary>
         /// Initializes the connection to the server.
         /// </summary>
         void initializeConnection();
@@ -118,6 +250,10 @@ namespace Confus
         /// </summary>
         void update();
         /// <summary>
+        /// Moves the listener and the playing sounds, sending only what changed to OpenAL
+        /// </summary>
+        void updateAudio();
+        /// <summary>
         /// Runs a set of fixed update calls based on the tim elapsed since the last
         /// </summary>
         void processFixedUpdates();
@@ -126,6 +262,19 @@ namespace Confus
         /// </summary>
         void fixedUpdate();
         /// <summary>
+        /// Runs the fixed updates up to the tick the server is in
+        /// </summary>
+        void followServerTimeline();
+        /// <summary>
+        /// Skips to a tick of the shared timeline, bringing the maze schedule along without running the fixed updates in between
+        /// </summary>
+        /// <param name="a_Tick">The tick to skip to, which may be before the current one</param>
+        void skipToTick(std::uint32_t a_Tick);
+        /// <summary>
+        /// Advances the maze schedule, refilling the maze and switching the respawn floors when it is time to
+        /// </summary>
+        void updateMazeSchedule();
+        /// <summary>
         /// Renders the objects in the game
         /// </summary>
         void render();
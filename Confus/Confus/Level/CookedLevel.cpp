@@ -0,0 +1,525 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "CookedLevel.h"
+
+namespace Confus
+{
+    namespace Level
+    {
+        const char* const CookedLevel::DefaultSceneFile = "Media/IrrlichtScenes/Bases 2.irr";
+        const char* const CookedLevel::DefaultCookedFile = "Media/IrrlichtScenes/Bases 2.level";
+        const irr::u32 CookedLevel::CookedVersion = 1;
+        const irr::u64 CookedLevel::SectionAlignment = 16;
+        const irr::u32 CookedLevel::GridResolution = 32;
+
+        namespace
+        {
+            irr::u64 align(irr::u64 a_Offset, irr::u64 a_Alignment)
+            {
+                return (a_Offset + a_Alignment - 1) / a_Alignment * a_Alignment;
+            }
+
+            /// <summary>
+            /// Writes the data at the given offset, padding the stream with zeroes up to it.
+            /// </summary>
+            void writeAt(std::ofstream& a_Stream, irr::u64 a_Offset, const void* a_Data, size_t a_Size)
+            {
+                while(static_cast<irr::u64>(a_Stream.tellp()) < a_Offset)
+                {
+                    a_Stream.put(0);
+                }
+                a_Stream.write(static_cast<const char*>(a_Data), static_cast<std::streamsize>(a_Size));
+            }
+        }
+
+        CookedLevel::CookedLevel(irr::IrrlichtDevice* a_Device, const std::string& a_CookedFile, irr::scene::ISceneNode* a_Parent)
+            : m_File(a_CookedFile, true)
+        {
+            auto header = getSection<const Header>(0, 1);
+            if(std::memcmp(header->Magic, "CLVL", 4) != 0 || header->Version != CookedVersion || !(header->CellSize > 0.0f))
+            {
+                throw std::invalid_argument("Invalid cooked level");
+            }
+
+            auto batches = getSection<const Batch>(header->BatchOffset, header->BatchCount);
+            auto lights = getSection<const Light>(header->LightOffset, header->LightCount);
+            CollisionGrid grid;
+            grid.Triangles = getSection<const irr::core::triangle3df>(header->TriangleOffset, header->TriangleCount);
+            grid.TriangleCount = header->TriangleCount;
+            irr::u64 cellCount = 1;
+            for(irr::u32 axis = 0; axis < 3; ++axis)
+            {
+                //The selector numbers cells with 32 bits, which also keeps the product below from overflowing
+                if(header->CellCounts[axis] == 0 || cellCount * header->CellCounts[axis] >= 0xFFFFFFFFull)
+                {
+                    throw std::invalid_argument("Invalid cooked level");
+                }
+                cellCount *= header->CellCounts[axis];
+            }
+            grid.CellStarts = getSection<const irr::u32>(header->CellStartOffset, cellCount + 1);
+            grid.CellTriangles = getSection<const irr::u32>(header->CellTriangleOffset, header->CellTriangleCount);
+            grid.Origin = header->GridOrigin;
+            grid.CellSize = header->CellSize;
+            std::copy(header->CellCounts, header->CellCounts + 3, grid.CellCounts);
+
+            //Check every range and every index up front, so nothing is added to the scene for a damaged file
+            //and neither the mesh buffers nor the selector ever read or write outside of what the file holds
+            for(irr::u64 cell = 0; cell < cellCount; ++cell)
+            {
+                if(grid.CellStarts[cell] > grid.CellStarts[cell + 1])
+                {
+                    throw std::invalid_argument("Invalid cooked level");
+                }
+            }
+            if(grid.CellStarts[cellCount] > header->CellTriangleCount)
+            {
+                throw std::invalid_argument("Invalid cooked level");
+            }
+            for(irr::u64 i = 0; i < header->CellTriangleCount; ++i)
+            {
+                if(grid.CellTriangles[i] >= header->TriangleCount)
+                {
+                    throw std::invalid_argument("Invalid cooked level");
+                }
+            }
+
+            for(irr::u32 i = 0; i < header->BatchCount; ++i)
+            {
+                const Batch& batch = batches[i];
+                if(batch.VertexType == irr::video::EVT_2TCOORDS)
+                {
+                    getSection<irr::video::S3DVertex2TCoords>(batch.VertexOffset, batch.VertexCount);
+                }
+                else if(batch.VertexType == irr::video::EVT_STANDARD)
+                {
+                    getSection<irr::video::S3DVertex>(batch.VertexOffset, batch.VertexCount);
+                }
+                else
+                {
+                    throw std::invalid_argument("Invalid cooked level");
+                }
+                auto indices = getSection<const irr::u16>(batch.IndexOffset, batch.IndexCount);
+                for(irr::u32 index = 0; index < batch.IndexCount; ++index)
+                {
+                    if(indices[index] >= batch.VertexCount)
+                    {
+                        throw std::invalid_argument("Invalid cooked level");
+                    }
+                }
+            }
+
+            auto sceneManager = a_Device->getSceneManager();
+            auto driver = a_Device->getVideoDriver();
+            auto mesh = new irr::scene::SMesh();
+            for(irr::u32 i = 0; i < header->BatchCount; ++i)
+            {
+                irr::scene::IMeshBuffer* buffer;
+                if(batches[i].VertexType == irr::video::EVT_2TCOORDS)
+                {
+                    buffer = createMeshBuffer<irr::video::S3DVertex2TCoords>(batches[i]);
+                }
+                else
+                {
+                    buffer = createMeshBuffer<irr::video::S3DVertex>(batches[i]);
+                }
+                buffer->getMaterial() = createMaterial(driver, batches[i].BatchMaterial);
+                mesh->addMeshBuffer(buffer);
+                buffer->drop();
+            }
+            //The geometry never changes, so it is uploaded once and drawn from video memory
+            mesh->setHardwareMappingHint(irr::scene::EHM_STATIC);
+            mesh->recalculateBoundingBox();
+            m_Node = sceneManager->addMeshSceneNode(mesh, a_Parent);
+            mesh->drop();
+
+            auto selector = new CookedLevelSelector(m_Node, grid);
+            m_Node->setTriangleSelector(selector);
+            selector->drop();
+
+            for(irr::u32 i = 0; i < header->LightCount; ++i)
+            {
+                auto lightNode = sceneManager->addLightSceneNode(a_Parent, lights[i].Position);
+                lightNode->setRotation(lights[i].Rotation);
+                lightNode->setRadius(lights[i].Data.Radius);
+                lightNode->setLightData(lights[i].Data);
+            }
+        }
+
+        CookedLevel::~CookedLevel()
+        {
+            if(m_Node != nullptr)
+            {
+                m_Node->remove();
+            }
+        }
+
+        template<typename T>
+        T* CookedLevel::getSection(irr::u64 a_Offset, irr::u64 a_Count)
+        {
+            irr::u64 fileSize = m_File.getSize();
+            if(a_Offset > fileSize || a_Count > (fileSize - a_Offset) / sizeof(T))
+            {
+                throw std::invalid_argument("Invalid cooked level");
+            }
+            return reinterpret_cast<T*>(m_File.getData() + a_Offset);
+        }
+
+        template<typename TVertex>
+        irr::scene::CMeshBuffer<TVertex>* CookedLevel::createMeshBuffer(const Batch& a_Batch)
+        {
+            auto buffer = new irr::scene::CMeshBuffer<TVertex>();
+            //The arrays use the mapped memory as is and are told not to free it
+            buffer->Vertices.set_pointer(getSection<TVertex>(a_Batch.VertexOffset, a_Batch.VertexCount), a_Batch.VertexCount, false, false);
+            buffer->Indices.set_pointer(getSection<irr::u16>(a_Batch.IndexOffset, a_Batch.IndexCount), a_Batch.IndexCount, false, false);
+            buffer->BoundingBox = a_Batch.BoundingBox;
+            return buffer;
+        }
+
+        irr::video::SMaterial CookedLevel::createMaterial(irr::video::IVideoDriver* a_Driver, const Material& a_Material)
+        {
+            irr::video::SMaterial material;
+            material.MaterialType = static_cast<irr::video::E_MATERIAL_TYPE>(a_Material.Type);
+            material.AmbientColor = a_Material.AmbientColor;
+            material.DiffuseColor = a_Material.DiffuseColor;
+            material.EmissiveColor = a_Material.EmissiveColor;
+            material.SpecularColor = a_Material.SpecularColor;
+            material.Shininess = a_Material.Shininess;
+            material.MaterialTypeParam = a_Material.Param1;
+            material.MaterialTypeParam2 = a_Material.Param2;
+            material.Lighting = a_Material.Lighting != 0;
+            material.BackfaceCulling = a_Material.BackfaceCulling != 0;
+            material.FrontfaceCulling = a_Material.FrontfaceCulling != 0;
+            material.FogEnable = a_Material.FogEnable != 0;
+            material.NormalizeNormals = a_Material.NormalizeNormals != 0;
+            material.ZWriteEnable = a_Material.ZWriteEnable != 0;
+            material.GouraudShading = a_Material.GouraudShading != 0;
+            material.Wireframe = a_Material.Wireframe != 0;
+            for(irr::u32 layer = 0; layer < 2; ++layer)
+            {
+                if(a_Material.Textures[layer][0] != '\0')
+                {
+                    material.setTexture(layer, a_Driver->getTexture(a_Material.Textures[layer]));
+                }
+            }
+            return material;
+        }
+
+        CookedLevel::Material CookedLevel::storeMaterial(irr::io::IFileSystem* a_FileSystem, const irr::video::SMaterial& a_Material)
+        {
+            Material stored;
+            //Cleared completely, padding included, so that equal materials compare equal byte for byte
+            std::memset(static_cast<void*>(&stored), 0, sizeof(Material));
+            stored.Type = static_cast<irr::u32>(a_Material.MaterialType);
+            stored.AmbientColor = a_Material.AmbientColor;
+            stored.DiffuseColor = a_Material.DiffuseColor;
+            stored.EmissiveColor = a_Material.EmissiveColor;
+            stored.SpecularColor = a_Material.SpecularColor;
+            stored.Shininess = a_Material.Shininess;
+            stored.Param1 = a_Material.MaterialTypeParam;
+            stored.Param2 = a_Material.MaterialTypeParam2;
+            stored.Lighting = a_Material.Lighting;
+            stored.BackfaceCulling = a_Material.BackfaceCulling;
+            stored.FrontfaceCulling = a_Material.FrontfaceCulling;
+            stored.FogEnable = a_Material.FogEnable;
+            stored.NormalizeNormals = a_Material.NormalizeNormals;
+            stored.ZWriteEnable = a_Material.ZWriteEnable;
+            stored.GouraudShading = a_Material.GouraudShading;
+            stored.Wireframe = a_Material.Wireframe;
+            for(irr::u32 layer = 0; layer < 2; ++layer)
+            {
+                irr::video::ITexture* texture = a_Material.getTexture(layer);
+                if(texture != nullptr)
+                {
+                    irr::io::path path = a_FileSystem->getRelativeFilename(texture->getName().getPath(), a_FileSystem->getWorkingDirectory());
+                    std::strncpy(stored.Textures[layer], path.c_str(), sizeof(stored.Textures[layer]) - 1);
+                }
+            }
+            return stored;
+        }
+
+        bool CookedLevel::cook(irr::IrrlichtDevice* a_Device, const std::string& a_SceneFile, const std::string& a_CookedFile)
+        {
+            auto sceneManager = a_Device->getSceneManager();
+            auto root = sceneManager->addEmptySceneNode();
+            if(!sceneManager->loadScene(a_SceneFile.c_str(), nullptr, root))
+            {
+                std::cout << "Failed to load " << a_SceneFile << std::endl;
+                root->remove();
+                return false;
+            }
+            //Updates the absolute transformation of every node in the level
+            root->OnAnimate(0);
+
+            struct CookingBatch
+            {
+                Material BatchMaterial;
+                irr::video::E_VERTEX_TYPE VertexType;
+                std::vector<irr::video::S3DVertex> Vertices;
+                std::vector<irr::video::S3DVertex2TCoords> LightMapVertices;
+                std::vector<irr::u16> Indices;
+                irr::core::aabbox3df BoundingBox;
+            };
+            std::vector<CookingBatch> batches;
+            std::vector<irr::core::triangle3df> triangles;
+
+            irr::core::array<irr::scene::ISceneNode*> nodes;
+            sceneManager->getSceneNodesFromType(irr::scene::ESNT_MESH, nodes, root);
+            for(irr::u32 i = 0; i < nodes.size(); ++i)
+            {
+                auto meshNode = static_cast<irr::scene::IMeshSceneNode*>(nodes[i]);
+                irr::scene::IMesh* mesh = meshNode->getMesh();
+                if(mesh == nullptr)
+                {
+                    continue;
+                }
+                const irr::core::matrix4& transform = meshNode->getAbsoluteTransformation();
+
+                for(irr::u32 bufferIndex = 0; bufferIndex < mesh->getMeshBufferCount(); ++bufferIndex)
+                {
+                    irr::scene::IMeshBuffer* meshBuffer = mesh->getMeshBuffer(bufferIndex);
+                    irr::video::E_VERTEX_TYPE vertexType = meshBuffer->getVertexType();
+                    if((vertexType != irr::video::EVT_STANDARD && vertexType != irr::video::EVT_2TCOORDS) || meshBuffer->getIndexType() != irr::video::EIT_16BIT)
+                    {
+                        std::cout << "Skipping a mesh buffer of " << meshNode->getName() << ", its vertex or index type can not be cooked" << std::endl;
+                        continue;
+                    }
+
+                    Material material = storeMaterial(a_Device->getFileSystem(),
+                        meshNode->isReadOnlyMaterials() ? meshBuffer->getMaterial() : meshNode->getMaterial(bufferIndex));
+                    irr::u32 vertexCount = meshBuffer->getVertexCount();
+                    auto batch = std::find_if(batches.begin(), batches.end(), [&](const CookingBatch& a_Batch)
+                    {
+                        size_t batchVertexCount = a_Batch.Vertices.size() + a_Batch.LightMapVertices.size();
+                        return a_Batch.VertexType == vertexType && batchVertexCount + vertexCount <= 0xFFFF &&
+                            std::memcmp(&a_Batch.BatchMaterial, &material, sizeof(Material)) == 0;
+                    });
+                    if(batch == batches.end())
+                    {
+                        batches.emplace_back();
+                        batch = batches.end() - 1;
+                        batch->BatchMaterial = material;
+                        batch->VertexType = vertexType;
+                    }
+
+                    //Moves the vertices into level space and adds them to the batch, along with their triangles
+                    auto appendBuffer = [&](auto* a_Vertices, auto& a_Target)
+                    {
+                        irr::u16 firstVertex = static_cast<irr::u16>(a_Target.size());
+                        for(irr::u32 vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+                        {
+                            auto vertex = a_Vertices[vertexIndex];
+                            transform.transformVect(vertex.Pos);
+                            transform.rotateVect(vertex.Normal);
+                            vertex.Normal.normalize();
+                            if(a_Target.empty())
+                            {
+                                batch->BoundingBox.reset(vertex.Pos);
+                            }
+                            else
+                            {
+                                batch->BoundingBox.addInternalPoint(vertex.Pos);
+                            }
+                            a_Target.push_back(vertex);
+                        }
+
+                        const irr::u16* indices = meshBuffer->getIndices();
+                        irr::u32 indexCount = meshBuffer->getIndexCount() - meshBuffer->getIndexCount() % 3;
+                        for(irr::u32 index = 0; index < indexCount; index += 3)
+                        {
+                            irr::u16 a = static_cast<irr::u16>(firstVertex + indices[index]);
+                            irr::u16 b = static_cast<irr::u16>(firstVertex + indices[index + 1]);
+                            irr::u16 c = static_cast<irr::u16>(firstVertex + indices[index + 2]);
+                            batch->Indices.push_back(a);
+                            batch->Indices.push_back(b);
+                            batch->Indices.push_back(c);
+                            triangles.push_back(irr::core::triangle3df(a_Target[a].Pos, a_Target[b].Pos, a_Target[c].Pos));
+                        }
+                    };
+                    if(vertexType == irr::video::EVT_2TCOORDS)
+                    {
+                        appendBuffer(static_cast<const irr::video::S3DVertex2TCoords*>(meshBuffer->getVertices()), batch->LightMapVertices);
+                    }
+                    else
+                    {
+                        appendBuffer(static_cast<const irr::video::S3DVertex*>(meshBuffer->getVertices()), batch->Vertices);
+                    }
+                }
+            }
+
+            std::vector<Light> lights;
+            nodes.clear();
+            sceneManager->getSceneNodesFromType(irr::scene::ESNT_LIGHT, nodes, root);
+            for(irr::u32 i = 0; i < nodes.size(); ++i)
+            {
+                Light light;
+                light.Position = nodes[i]->getAbsolutePosition();
+                light.Rotation = nodes[i]->getAbsoluteTransformation().getRotationDegrees();
+                light.Data = static_cast<irr::scene::ILightSceneNode*>(nodes[i])->getLightData();
+                lights.push_back(light);
+            }
+            root->remove();
+
+            //Buckets the triangles into a grid of cubic cells covering the whole level
+            Header header;
+            std::memset(static_cast<void*>(&header), 0, sizeof(Header));
+            std::memcpy(header.Magic, "CLVL", 4);
+            header.Version = CookedVersion;
+            header.BatchCount = static_cast<irr::u32>(batches.size());
+            header.LightCount = static_cast<irr::u32>(lights.size());
+            header.TriangleCount = static_cast<irr::u32>(triangles.size());
+            header.CellSize = 1.0f;
+            header.CellCounts[0] = header.CellCounts[1] = header.CellCounts[2] = 1;
+
+            irr::core::aabbox3df levelBox;
+            if(!triangles.empty())
+            {
+                levelBox.reset(triangles[0].pointA);
+                for(auto& triangle : triangles)
+                {
+                    levelBox.addInternalPoint(triangle.pointA);
+                    levelBox.addInternalPoint(triangle.pointB);
+                    levelBox.addInternalPoint(triangle.pointC);
+                }
+                irr::core::vector3df extent = levelBox.getExtent();
+                irr::f32 longestAxis = std::max(extent.X, std::max(extent.Y, extent.Z));
+                if(longestAxis > 0.0f)
+                {
+                    header.CellSize = longestAxis / GridResolution;
+                }
+                irr::f32 axisExtents[3] = { extent.X, extent.Y, extent.Z };
+                for(irr::u32 axis = 0; axis < 3; ++axis)
+                {
+                    header.CellCounts[axis] = std::min(GridResolution, std::max(1u, static_cast<irr::u32>(std::ceil(axisExtents[axis] / header.CellSize))));
+                }
+            }
+            header.GridOrigin = levelBox.MinEdge;
+
+            auto getCell = [&](irr::f32 a_Position, irr::f32 a_Origin, irr::u32 a_Axis)
+            {
+                irr::f32 cell = std::floor((a_Position - a_Origin) / header.CellSize);
+                return std::min(header.CellCounts[a_Axis] - 1, static_cast<irr::u32>(std::max(cell, 0.0f)));
+            };
+            irr::u32 cellCount = header.CellCounts[0] * header.CellCounts[1] * header.CellCounts[2];
+            std::vector<irr::u32> cellStarts(cellCount + 1, 0u);
+            std::vector<irr::u32> cellTriangles;
+            //The first pass counts the triangles of each cell, the second pass stores them
+            for(irr::u32 pass = 0; pass < 2; ++pass)
+            {
+                std::vector<irr::u32> cellCursors(cellStarts.begin(), cellStarts.end() - 1);
+                for(irr::u32 index = 0; index < triangles.size(); ++index)
+                {
+                    irr::core::aabbox3df triangleBox(triangles[index].pointA);
+                    triangleBox.addInternalPoint(triangles[index].pointB);
+                    triangleBox.addInternalPoint(triangles[index].pointC);
+                    irr::u32 firstX = getCell(triangleBox.MinEdge.X, levelBox.MinEdge.X, 0), lastX = getCell(triangleBox.MaxEdge.X, levelBox.MinEdge.X, 0);
+                    irr::u32 firstY = getCell(triangleBox.MinEdge.Y, levelBox.MinEdge.Y, 1), lastY = getCell(triangleBox.MaxEdge.Y, levelBox.MinEdge.Y, 1);
+                    irr::u32 firstZ = getCell(triangleBox.MinEdge.Z, levelBox.MinEdge.Z, 2), lastZ = getCell(triangleBox.MaxEdge.Z, levelBox.MinEdge.Z, 2);
+                    for(irr::u32 z = firstZ; z <= lastZ; ++z)
+                    {
+                        for(irr::u32 y = firstY; y <= lastY; ++y)
+                        {
+                            for(irr::u32 x = firstX; x <= lastX; ++x)
+                            {
+                                irr::u32 cell = (z * header.CellCounts[1] + y) * header.CellCounts[0] + x;
+                                if(pass == 0)
+                                {
+                                    ++cellStarts[cell + 1];
+                                }
+                                else
+                                {
+                                    cellTriangles[cellCursors[cell]++] = index;
+                                }
+                            }
+                        }
+                    }
+                }
+                if(pass == 0)
+                {
+                    for(irr::u32 cell = 0; cell < cellCount; ++cell)
+                    {
+                        cellStarts[cell + 1] += cellStarts[cell];
+                    }
+                    cellTriangles.resize(cellStarts[cellCount]);
+                }
+            }
+            header.CellTriangleCount = cellTriangles.size();
+
+            irr::u64 offset = align(sizeof(Header), SectionAlignment);
+            header.BatchOffset = offset;
+            offset = align(offset + batches.size() * sizeof(Batch), SectionAlignment);
+            header.LightOffset = offset;
+            offset = align(offset + lights.size() * sizeof(Light), SectionAlignment);
+            header.TriangleOffset = offset;
+            offset = align(offset + triangles.size() * sizeof(irr::core::triangle3df), SectionAlignment);
+            header.CellStartOffset = offset;
+            offset = align(offset + cellStarts.size() * sizeof(irr::u32), SectionAlignment);
+            header.CellTriangleOffset = offset;
+            offset += cellTriangles.size() * sizeof(irr::u32);
+
+            std::vector<Batch> batchRecords(batches.size());
+            for(size_t i = 0; i < batches.size(); ++i)
+            {
+                Batch& record = batchRecords[i];
+                std::memset(static_cast<void*>(&record), 0, sizeof(Batch));
+                record.BatchMaterial = batches[i].BatchMaterial;
+                record.VertexType = batches[i].VertexType;
+                record.BoundingBox = batches[i].BoundingBox;
+                record.IndexCount = static_cast<irr::u32>(batches[i].Indices.size());
+                if(batches[i].VertexType == irr::video::EVT_2TCOORDS)
+                {
+                    record.VertexCount = static_cast<irr::u32>(batches[i].LightMapVertices.size());
+                    record.VertexOffset = align(offset, SectionAlignment);
+                    offset = record.VertexOffset + record.VertexCount * sizeof(irr::video::S3DVertex2TCoords);
+                }
+                else
+                {
+                    record.VertexCount = static_cast<irr::u32>(batches[i].Vertices.size());
+                    record.VertexOffset = align(offset, SectionAlignment);
+                    offset = record.VertexOffset + record.VertexCount * sizeof(irr::video::S3DVertex);
+                }
+                record.IndexOffset = align(offset, SectionAlignment);
+                offset = record.IndexOffset + record.IndexCount * sizeof(irr::u16);
+            }
+
+            std::ofstream cookedStream(a_CookedFile, std::ios::binary | std::ios::trunc);
+            if(!cookedStream)
+            {
+                std::cout << "Failed to write " << a_CookedFile << std::endl;
+                return false;
+            }
+            writeAt(cookedStream, 0, &header, sizeof(Header));
+            writeAt(cookedStream, header.BatchOffset, batchRecords.data(), batchRecords.size() * sizeof(Batch));
+            writeAt(cookedStream, header.LightOffset, lights.data(), lights.size() * sizeof(Light));
+            writeAt(cookedStream, header.TriangleOffset, triangles.data(), triangles.size() * sizeof(irr::core::triangle3df));
+            writeAt(cookedStream, header.CellStartOffset, cellStarts.data(), cellStarts.size() * sizeof(irr::u32));
+            writeAt(cookedStream, header.CellTriangleOffset, cellTriangles.data(), cellTriangles.size() * sizeof(irr::u32));
+            for(size_t i = 0; i < batches.size(); ++i)
+            {
+                if(batches[i].VertexType == irr::video::EVT_2TCOORDS)
+                {
+                    writeAt(cookedStream, batchRecords[i].VertexOffset, batches[i].LightMapVertices.data(), batches[i].LightMapVertices.size() * sizeof(irr::video::S3DVertex2TCoords));
+                }
+                else
+                {
+                    writeAt(cookedStream, batchRecords[i].VertexOffset, batches[i].Vertices.data(), batches[i].Vertices.size() * sizeof(irr::video::S3DVertex));
+                }
+                writeAt(cookedStream, batchRecords[i].IndexOffset, batches[i].Indices.data(), batches[i].Indices.size() * sizeof(irr::u16));
+            }
+
+            if(!cookedStream)
+            {
+                std::cout << "Failed to write " << a_CookedFile << std::endl;
+                return false;
+            }
+            std::cout << "Cooked " << lights.size() << " lights, " << batches.size() << " batches and "
+                << triangles.size() << " collision triangles into " << a_CookedFile << std::endl;
+            return true;
+        }
+    }
+}
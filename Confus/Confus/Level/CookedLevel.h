@@ -0,0 +1,158 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <string>
+
+#include "../MappedFile.h"
+#include "CookedLevelSelector.h"
+
+namespace Confus
+{
+    namespace Level
+    {
+        /// <summary>
+        /// A level scene that has been cooked offline into a single binary file.
+        /// The file holds the geometry merged per material and already moved into level space, the lights,
+        /// and a prebuilt collision grid. Loading it maps the file and points the mesh buffers straight into the mapping,
+        /// instead of parsing the XML scene and its meshes and building the collision selectors afterwards.
+        /// </summary>
+        /// <remarks> The file stores Irrlicht's vertex layouts as they are in memory, so it has to be cooked by the same build that loads it </remarks>
+        class CookedLevel
+        {
+        public:
+            /// <summary> The XML scene of the level that is cooked </summary>
+            static const char* const DefaultSceneFile;
+            /// <summary> The cooked level file that is written by the cooker and loaded by the game </summary>
+            static const char* const DefaultCookedFile;
+        private:
+            /// <summary>
+            /// The material of a batch, with the textures stored by path
+            /// </summary>
+            struct Material
+            {
+                irr::u32 Type;
+                irr::video::SColor AmbientColor;
+                irr::video::SColor DiffuseColor;
+                irr::video::SColor EmissiveColor;
+                irr::video::SColor SpecularColor;
+                irr::f32 Shininess;
+                irr::f32 Param1;
+                irr::f32 Param2;
+                irr::u8 Lighting;
+                irr::u8 BackfaceCulling;
+                irr::u8 FrontfaceCulling;
+                irr::u8 FogEnable;
+                irr::u8 NormalizeNormals;
+                irr::u8 ZWriteEnable;
+                irr::u8 GouraudShading;
+                irr::u8 Wireframe;
+                /// <summary> The paths of the first two texture layers, empty if unused </summary>
+                char Textures[2][128];
+            };
+
+            /// <summary>
+            /// A merged mesh buffer, holding every triangle of one material and vertex type
+            /// </summary>
+            struct Batch
+            {
+                Material BatchMaterial;
+                /// <summary> The <see cref="irr::video::E_VERTEX_TYPE"/>, either standard or with two texture coordinates </summary>
+                irr::u32 VertexType;
+                irr::u32 VertexCount;
+                irr::u32 IndexCount;
+                irr::u32 Reserved;
+                irr::core::aabbox3df BoundingBox;
+                irr::u64 VertexOffset;
+                irr::u64 IndexOffset;
+            };
+
+            /// <summary>
+            /// A light of the level with its transformation relative to the level
+            /// </summary>
+            struct Light
+            {
+                irr::core::vector3df Position;
+                irr::core::vector3df Rotation;
+                irr::video::SLight Data;
+            };
+
+            /// <summary>
+            /// The header at the start of the cooked file, with the offsets of each section
+            /// </summary>
+            struct Header
+            {
+                /// <summary> Identifies the file as a cooked level, always "CLVL" </summary>
+                char Magic[4];
+                irr::u32 Version;
+                irr::u32 BatchCount;
+                irr::u32 LightCount;
+                irr::u32 TriangleCount;
+                irr::u32 CellCounts[3];
+                irr::core::vector3df GridOrigin;
+                irr::f32 CellSize;
+                irr::u64 BatchOffset;
+                irr::u64 LightOffset;
+                irr::u64 TriangleOffset;
+                irr::u64 CellStartOffset;
+                irr::u64 CellTriangleOffset;
+                irr::u64 CellTriangleCount;
+            };
+
+            static const irr::u32 CookedVersion;
+            /// <summary> The alignment of every section in the cooked file </summary>
+            static const irr::u64 SectionAlignment;
+            /// <summary> The maximum amount of cells along the longest axis of the collision grid </summary>
+            static const irr::u32 GridResolution;
+
+            /// <summary>
+            /// The mapped cooked file, mapped copy-on-write because Irrlicht's mesh buffers take non-const vertex arrays
+            /// </summary>
+            MappedFile m_File;
+            /// <summary>
+            /// The node holding the level geometry, removed when the level is destroyed
+            /// </summary>
+            irr::scene::IMeshSceneNode* m_Node = nullptr;
+        public:
+            /// <summary>
+            /// Maps the cooked file and adds the level geometry, lights and collision to the scene.
+            /// </summary>
+            /// <param name="a_Device">The active Irrlicht Device.</param>
+            /// <param name="a_CookedFile">The path of the cooked level file.</param>
+            /// <param name="a_Parent">The node the level is attached to.</param>
+            /// <exception cref="std::invalid_argument">The file could not be mapped or is not a valid cooked level.</exception>
+            CookedLevel(irr::IrrlichtDevice* a_Device, const std::string& a_CookedFile, irr::scene::ISceneNode* a_Parent);
+            /// <summary>
+            /// Removes the level geometry from the scene, before the file it points into is unmapped.
+            /// </summary>
+            ~CookedLevel();
+            /// <summary>
+            /// Cooks the XML scene and the meshes it references into a cooked level file.
+            /// This is an offline step, run with the --cook-level command line switch whenever the level changes.
+            /// </summary>
+            /// <param name="a_Device">An Irrlicht Device to load the scene with, which may use the null driver.</param>
+            /// <param name="a_SceneFile">The path of the XML scene.</param>
+            /// <param name="a_CookedFile">The path of the cooked level file to write.</param>
+            /// <returns>Whether the cooked level was written.</returns>
+            static bool cook(irr::IrrlichtDevice* a_Device, const std::string& a_SceneFile, const std::string& a_CookedFile);
+        private:
+            /// <summary>
+            /// Gets a pointer into the mapped file, checking that the whole range lies inside it.
+            /// </summary>
+            /// <exception cref="std::invalid_argument">The range lies outside of the file.</exception>
+            template<typename T>
+            T* getSection(irr::u64 a_Offset, irr::u64 a_Count);
+            /// <summary>
+            /// Creates a mesh buffer whose vertices and indices point into the mapped file.
+            /// </summary>
+            template<typename TVertex>
+            irr::scene::CMeshBuffer<TVertex>* createMeshBuffer(const Batch& a_Batch);
+            /// <summary>
+            /// Creates the Irrlicht material of a batch, loading its textures.
+            /// </summary>
+            static irr::video::SMaterial createMaterial(irr::video::IVideoDriver* a_Driver, const Material& a_Material);
+            /// <summary>
+            /// Converts an Irrlicht material into the stored form, with the texture paths relative to the working directory.
+            /// </summary>
+            static Material storeMaterial(irr::io::IFileSystem* a_FileSystem, const irr::video::SMaterial& a_Material);
+        };
+    }
+}
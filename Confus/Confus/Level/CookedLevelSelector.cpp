@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+
+#include "CookedLevelSelector.h"
+
+namespace Confus
+{
+    namespace Level
+    {
+        CookedLevelSelector::CookedLevelSelector(irr::scene::ISceneNode* a_Node, const CollisionGrid& a_Grid)
+            : m_Node(a_Node), m_Grid(a_Grid), m_TriangleQueries(a_Grid.TriangleCount, 0u)
+        {
+        }
+
+        irr::s32 CookedLevelSelector::getTriangleCount() const
+        {
+            return static_cast<irr::s32>(m_Grid.TriangleCount);
+        }
+
+        void CookedLevelSelector::getTriangles(irr::core::triangle3df* a_Triangles, irr::s32 a_ArraySize,
+            irr::s32& a_OutTriangleCount, const irr::core::matrix4* a_Transform) const
+        {
+            irr::core::matrix4 transform = getOutputTransform(a_Transform);
+            irr::u32 count = std::min(m_Grid.TriangleCount, static_cast<irr::u32>(std::max(a_ArraySize, 0)));
+            for(irr::u32 i = 0; i < count; ++i)
+            {
+                const irr::core::triangle3df& triangle = m_Grid.Triangles[i];
+                transform.transformVect(a_Triangles[i].pointA, triangle.pointA);
+                transform.transformVect(a_Triangles[i].pointB, triangle.pointB);
+                transform.transformVect(a_Triangles[i].pointC, triangle.pointC);
+            }
+            a_OutTriangleCount = static_cast<irr::s32>(count);
+        }
+
+        void CookedLevelSelector::getTriangles(irr::core::triangle3df* a_Triangles, irr::s32 a_ArraySize,
+            irr::s32& a_OutTriangleCount, const irr::core::aabbox3df& a_Box, const irr::core::matrix4* a_Transform) const
+        {
+            a_OutTriangleCount = 0;
+
+            //The box is given in world space, while the grid is in level space
+            irr::core::matrix4 worldToLevel;
+            m_Node->getAbsoluteTransformation().getInverse(worldToLevel);
+            irr::core::aabbox3df levelBox(a_Box);
+            worldToLevel.transformBoxEx(levelBox);
+
+            irr::u32 first[3], last[3];
+            if(!getCellRange(levelBox.MinEdge.X, levelBox.MaxEdge.X, 0, first[0], last[0]) ||
+                !getCellRange(levelBox.MinEdge.Y, levelBox.MaxEdge.Y, 1, first[1], last[1]) ||
+                !getCellRange(levelBox.MinEdge.Z, levelBox.MaxEdge.Z, 2, first[2], last[2]))
+            {
+                return;
+            }
+
+            if(++m_CurrentQuery == 0)
+            {
+                std::fill(m_TriangleQueries.begin(), m_TriangleQueries.end(), 0u);
+                m_CurrentQuery = 1;
+            }
+
+            irr::core::matrix4 transform = getOutputTransform(a_Transform);
+            for(irr::u32 z = first[2]; z <= last[2]; ++z)
+            {
+                for(irr::u32 y = first[1]; y <= last[1]; ++y)
+                {
+                    for(irr::u32 x = first[0]; x <= last[0]; ++x)
+                    {
+                        irr::u32 cell = (z * m_Grid.CellCounts[1] + y) * m_Grid.CellCounts[0] + x;
+                        for(irr::u32 entry = m_Grid.CellStarts[cell]; entry < m_Grid.CellStarts[cell + 1]; ++entry)
+                        {
+                            irr::u32 index = m_Grid.CellTriangles[entry];
+                            if(m_TriangleQueries[index] == m_CurrentQuery)
+                            {
+                                continue;
+                            }
+                            m_TriangleQueries[index] = m_CurrentQuery;
+
+                            const irr::core::triangle3df& triangle = m_Grid.Triangles[index];
+                            irr::core::aabbox3df triangleBox(triangle.pointA);
+                            triangleBox.addInternalPoint(triangle.pointB);
+                            triangleBox.addInternalPoint(triangle.pointC);
+                            if(!triangleBox.intersectsWithBox(levelBox))
+                            {
+                                continue;
+                            }
+
+                            if(a_OutTriangleCount >= a_ArraySize)
+                            {
+                                return;
+                            }
+                            irr::core::triangle3df& output = a_Triangles[a_OutTriangleCount++];
+                            transform.transformVect(output.pointA, triangle.pointA);
+                            transform.transformVect(output.pointB, triangle.pointB);
+                            transform.transformVect(output.pointC, triangle.pointC);
+                        }
+                    }
+                }
+            }
+        }
+
+        void CookedLevelSelector::getTriangles(irr::core::triangle3df* a_Triangles, irr::s32 a_ArraySize,
+            irr::s32& a_OutTriangleCount, const irr::core::line3df& a_Line, const irr::core::matrix4* a_Transform) const
+        {
+            irr::core::aabbox3df box(a_Line.start);
+            box.addInternalPoint(a_Line.end);
+            getTriangles(a_Triangles, a_ArraySize, a_OutTriangleCount, box, a_Transform);
+        }
+
+        irr::scene::ISceneNode* CookedLevelSelector::getSceneNodeForTriangle(irr::u32 a_TriangleIndex) const
+        {
+            return m_Node;
+        }
+
+        irr::u32 CookedLevelSelector::getSelectorCount() const
+        {
+            return 1;
+        }
+
+        irr::scene::ITriangleSelector* CookedLevelSelector::getSelector(irr::u32 a_Index)
+        {
+            return a_Index == 0 ? this : nullptr;
+        }
+
+        const irr::scene::ITriangleSelector* CookedLevelSelector::getSelector(irr::u32 a_Index) const
+        {
+            return a_Index == 0 ? this : nullptr;
+        }
+
+        irr::core::matrix4 CookedLevelSelector::getOutputTransform(const irr::core::matrix4* a_Transform) const
+        {
+            irr::core::matrix4 transform;
+            if(a_Transform != nullptr)
+            {
+                transform = *a_Transform;
+            }
+            transform *= m_Node->getAbsoluteTransformation();
+            return transform;
+        }
+
+        bool CookedLevelSelector::getCellRange(irr::f32 a_Min, irr::f32 a_Max, irr::u32 a_Axis, irr::u32& a_OutFirst, irr::u32& a_OutLast) const
+        {
+            irr::f32 origin = a_Axis == 0 ? m_Grid.Origin.X : (a_Axis == 1 ? m_Grid.Origin.Y : m_Grid.Origin.Z);
+            irr::f32 first = std::floor((a_Min - origin) / m_Grid.CellSize);
+            irr::f32 last = std::floor((a_Max - origin) / m_Grid.CellSize);
+            irr::f32 cellCount = static_cast<irr::f32>(m_Grid.CellCounts[a_Axis]);
+            if(last < 0.0f || first >= cellCount)
+            {
+                return false;
+            }
+            a_OutFirst = static_cast<irr::u32>(std::max(first, 0.0f));
+            a_OutLast = static_cast<irr::u32>(std::min(last, cellCount - 1.0f));
+            return true;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <vector>
+
+namespace Confus
+{
+    namespace Level
+    {
+        /// <summary>
+        /// The prebuilt collision data of a cooked level, pointing into the mapped level file.
+        /// The triangles are in level space and bucketed into a uniform grid of cells.
+        /// </summary>
+        struct CollisionGrid
+        {
+            /// <summary> The collision triangles in level space </summary>
+            const irr::core::triangle3df* Triangles = nullptr;
+            /// <summary> The amount of collision triangles </summary>
+            irr::u32 TriangleCount = 0;
+            /// <summary> For each cell the index of its first entry in CellTriangles, followed by the total amount of entries </summary>
+            const irr::u32* CellStarts = nullptr;
+            /// <summary> The triangle indices of every cell, stored cell after cell </summary>
+            const irr::u32* CellTriangles = nullptr;
+            /// <summary> The level space position of the minimum corner of the grid </summary>
+            irr::core::vector3df Origin;
+            /// <summary> The size of a cubic cell along each axis </summary>
+            irr::f32 CellSize = 1.0f;
+            /// <summary> The amount of cells along the X, Y and Z axis </summary>
+            irr::u32 CellCounts[3];
+        };
+
+        /// <summary>
+        /// Triangle selector over the collision grid of a cooked level.
+        /// Box and line queries only visit the cells they overlap, instead of testing every triangle of the level.
+        /// </summary>
+        /// <seealso cref="irr::scene::ITriangleSelector" />
+        class CookedLevelSelector : public irr::scene::ITriangleSelector
+        {
+        private:
+            /// <summary>
+            /// The node the level geometry is attached to, whose transformation moves the triangles into world space
+            /// </summary>
+            irr::scene::ISceneNode* m_Node;
+            CollisionGrid m_Grid;
+            /// <summary>
+            /// The query each triangle was last returned by, so triangles spanning several cells are only returned once
+            /// </summary>
+            mutable std::vector<irr::u32> m_TriangleQueries;
+            /// <summary>
+            /// The number of the current query, increased on every box query
+            /// </summary>
+            mutable irr::u32 m_CurrentQuery = 0;
+        public:
+            /// <summary>
+            /// Initializes a new instance of the <see cref="CookedLevelSelector"/> class.
+            /// </summary>
+            /// <param name="a_Node">The node the level geometry is attached to.</param>
+            /// <param name="a_Grid">The collision grid, which has to stay mapped while the selector is used.
+            /// Its cell ranges and triangle indices are used as is, so they have to have been checked against the file.</param>
+            CookedLevelSelector(irr::scene::ISceneNode* a_Node, const CollisionGrid& a_Grid);
+
+            virtual irr::s32 getTriangleCount() const override;
+            virtual void getTriangles(irr::core::triangle3df* a_Triangles, irr::s32 a_ArraySize,
+                irr::s32& a_OutTriangleCount, const irr::core::matrix4* a_Transform = 0) const override;
+            virtual void getTriangles(irr::core::triangle3df* a_Triangles, irr::s32 a_ArraySize,
+                irr::s32& a_OutTriangleCount, const irr::core::aabbox3df& a_Box, const irr::core::matrix4* a_Transform = 0) const override;
+            virtual void getTriangles(irr::core::triangle3df* a_Triangles, irr::s32 a_ArraySize,
+                irr::s32& a_OutTriangleCount, const irr::core::line3df& a_Line, const irr::core::matrix4* a_Transform = 0) const override;
+            virtual irr::scene::ISceneNode* getSceneNodeForTriangle(irr::u32 a_TriangleIndex) const override;
+            virtual irr::u32 getSelectorCount() const override;
+            virtual irr::scene::ITriangleSelector* getSelector(irr::u32 a_Index) override;
+            virtual const irr::scene::ITriangleSelector* getSelector(irr::u32 a_Index) const override;
+        private:
+            /// <summary>
+            /// Gets the transformation from level space to the space the triangles are returned in.
+            /// </summary>
+            /// <param name="a_Transform">The extra transformation requested by the caller, or nullptr.</param>
+            irr::core::matrix4 getOutputTransform(const irr::core::matrix4* a_Transform) const;
+            /// <summary>
+            /// Gets the first and last cell along one axis that the given range overlaps, clamped to the grid.
+            /// </summary>
+            /// <returns>Whether the range overlaps the grid at all.</returns>
+            bool getCellRange(irr::f32 a_Min, irr::f32 a_Max, irr::u32 a_Axis, irr::u32& a_OutFirst, irr::u32& a_OutLast) const;
+        };
+    }
+}
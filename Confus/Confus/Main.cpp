@@ -1,7 +1,25 @@
+#include <cstring>
+
 #include "Game.h"
+#include "OpenAL\OpenALSoundPack.h"
+#include "Level\CookedLevel.h"
 
-int main()
+int main(int argc, char* argv[])
 {
+    //Converts the wave files into the sound pack instead of starting the game
+    if(argc > 1 && std::strcmp(argv[1], "--pack-audio") == 0)
+    {
+        return Confus::OpenALSoundPack::build("Media\\", Confus::OpenALSoundPack::DefaultPackFile) ? 0 : 1;
+    }
+    //Cooks the level scene, loading it without opening a window
+    if(argc > 1 && std::strcmp(argv[1], "--cook-level") == 0)
+    {
+        irr::IrrlichtDevice* device = irr::createDevice(irr::video::EDT_NULL);
+        bool cooked = Confus::Level::CookedLevel::cook(device, Confus::Level::CookedLevel::DefaultSceneFile, Confus::Level::CookedLevel::DefaultCookedFile);
+        device->drop();
+        return cooked ? 0 : 1;
+    }
+
     Confus::Game game;
     game.run();
 
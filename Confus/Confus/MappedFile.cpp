@@ -0,0 +1,68 @@
+#include <stdexcept>
+
+#include "MappedFile.h"
+
+namespace Confus
+{
+    MappedFile::MappedFile(const std::string& a_FilePath, bool a_CopyOnWrite)
+    {
+        m_File = CreateFileA(a_FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER fileSize;
+        if(m_File == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_File, &fileSize) || fileSize.QuadPart == 0)
+        {
+            close();
+            throw std::invalid_argument("Path was invalid");
+        }
+        m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+        m_Mapping = CreateFileMappingA(m_File, nullptr, a_CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+        if(m_Mapping != nullptr)
+        {
+            m_Data = static_cast<char*>(MapViewOfFile(m_Mapping, a_CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+        }
+        if(m_Data == nullptr)
+        {
+            close();
+            throw std::invalid_argument("Failed to map file");
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    const char* MappedFile::getData() const
+    {
+        return m_Data;
+    }
+
+    char* MappedFile::getData()
+    {
+        return m_Data;
+    }
+
+    size_t MappedFile::getSize() const
+    {
+        return m_Size;
+    }
+
+    void MappedFile::close()
+    {
+        if(m_Data != nullptr)
+        {
+            UnmapViewOfFile(m_Data);
+            m_Data = nullptr;
+        }
+        if(m_Mapping != nullptr)
+        {
+            CloseHandle(m_Mapping);
+            m_Mapping = nullptr;
+        }
+        if(m_File != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_File);
+            m_File = INVALID_HANDLE_VALUE;
+        }
+    }
+}
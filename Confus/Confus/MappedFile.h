@@ -0,0 +1,59 @@
+#pragma once
+#include <Windows.h>
+#include <string>
+
+namespace Confus
+{
+    /// <summary>
+    /// A file mapped into memory, used for the asset files that are built offline and read in place at runtime.
+    /// The file stays mapped for the lifetime of this object, so pointers into it must not outlive it.
+    /// </summary>
+    class MappedFile
+    {
+    private:
+        HANDLE m_File = INVALID_HANDLE_VALUE;
+        HANDLE m_Mapping = nullptr;
+        /// <summary>
+        /// The start of the mapped view
+        /// </summary>
+        char* m_Data = nullptr;
+        /// <summary>
+        /// The size of the file in bytes
+        /// </summary>
+        size_t m_Size = 0;
+    public:
+        /// <summary>
+        /// Maps the whole file into memory.
+        /// </summary>
+        /// <param name="a_FilePath">The path of the file to map.</param>
+        /// <param name="a_CopyOnWrite">
+        /// Whether the view may be written to, in which case written pages are copied instead of changing the file.
+        /// Otherwise the view is read-only.
+        /// </param>
+        /// <exception cref="std::invalid_argument">The file does not exist, is empty or could not be mapped.</exception>
+        MappedFile(const std::string& a_FilePath, bool a_CopyOnWrite = false);
+        /// <summary>
+        /// Unmaps and closes the file.
+        /// </summary>
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        /// <summary>
+        /// Gets the start of the mapped file.
+        /// </summary>
+        const char* getData() const;
+        /// <summary>
+        /// Gets the start of the mapped file, which may only be written to if it was mapped copy-on-write.
+        /// </summary>
+        char* getData();
+        /// <summary>
+        /// Gets the size of the mapped file in bytes.
+        /// </summary>
+        size_t getSize() const;
+    private:
+        /// <summary>
+        /// Unmaps and closes whatever part of the file has been opened.
+        /// </summary>
+        void close();
+    };
+}
@@ -3,16 +3,18 @@
 
 namespace Confus
 {
-	Maze::Maze(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_StartPosition, bool a_NeedRender)
-		:m_MazeSizeX(60), m_MazeSizeY(60)
+	Maze::Maze(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_StartPosition, bool a_NeedRender)
+		:m_WallAnimator(a_SolidityEvents), m_MazeSizeX(60), m_MazeSizeY(60)
 	{
 		m_IrrDevice = a_Device;
+		m_AssetRegistry = &a_AssetRegistry;
 		resetMaze(irr::core::vector2df(30, -7), a_NeedRender);
 	}
 
 	void Maze::resetMaze(irr::core::vector2df a_Offset, bool a_NeedRender)
 	{
 		MazeTiles.clear();
+		m_Offset = a_Offset;
 		for (int x = 0; x < m_MazeSizeX; x++)
 		{
 			std::vector<std::shared_ptr<MazeTile>> tempVector;
@@ -21,7 +23,7 @@ namespace Confus
 			{
 				if (a_NeedRender)
 				{
-					std::shared_ptr<WalledMazeTile> mazeTile = std::make_shared<WalledMazeTile>(m_IrrDevice, irr::core::vector3df(static_cast<float>(-x + a_Offset.X), 0.5f, static_cast<float>(-y + a_Offset.Y)),
+					std::shared_ptr<WalledMazeTile> mazeTile = std::make_shared<WalledMazeTile>(m_IrrDevice, *m_AssetRegistry, m_WallAnimator, irr::core::vector3df(static_cast<float>(-x + a_Offset.X), 0.5f, static_cast<float>(-y + a_Offset.Y)),
 															 irr::core::vector3df(static_cast<float>(-x + a_Offset.X), 0.5f, static_cast<float>(-y + a_Offset.Y)));
 					const irr::scene::IAnimatedMeshSceneNode* wallMeshNode = mazeTile->getWall()->getMeshNode();
 					irr::core::vector3df boundingBox = wallMeshNode->getBoundingBox().getExtent();
@@ -42,13 +44,13 @@ namespace Confus
 
 	void Maze::fixedUpdate()
 	{
-		for (auto wallVector : MazeTiles)
-		{
-			for (auto wall : wallVector)
-			{
-				wall->fixedUpdate();
-			}
-		}
+		m_WallAnimator.fixedUpdate();
+	}
+
+	irr::core::vector2df Maze::getGridPosition(const irr::core::vector3df& a_WorldPosition) const
+	{
+		//Tiles are placed towards negative X and Z with their centers on whole units
+		return irr::core::vector2df(m_Offset.X + 0.5f - a_WorldPosition.X, m_Offset.Y + 0.5f - a_WorldPosition.Z);
 	}
 
 	int const & Maze::mazeSizeY() const
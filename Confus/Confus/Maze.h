@@ -2,6 +2,7 @@
 #include <vector>
 
 #include "MazeTile.h"
+#include "WallAnimator.h"
 
 namespace Confus
 {
@@ -10,6 +11,12 @@ namespace Confus
 	/// </summary>
 	class Maze
 	{
+	private:
+		/// <summary>
+		/// Moves the walls of the created MazeTiles, declared before them so it outlives them
+		/// </summary>
+		WallAnimator m_WallAnimator;
+
 	public:
 		/// <summary>
 		/// A 2D vector that contains all the MazeTiles
@@ -22,6 +29,11 @@ namespace Confus
 		/// </summary>
 		irr::IrrlichtDevice* m_IrrDevice;
 
+		/// <summary>
+		/// The registry the walls of created MazeTiles acquire their assets from.
+		/// </summary>
+		Assets::AssetRegistry* m_AssetRegistry;
+
 		/// <summary>
 		/// the X size of the maze
 		/// </summary>
@@ -32,6 +44,11 @@ namespace Confus
 		/// </summary>
 		int m_MazeSizeY;
 
+		/// <summary>
+		/// The world position of the tile at the grid origin, as given to <see cref="resetMaze"/>
+		/// </summary>
+		irr::core::vector2df m_Offset;
+
 	public:
 		/// <summary>
 		/// Gets the current X size of the maze
@@ -43,13 +60,22 @@ namespace Confus
 		/// </summary>
 		int const& mazeSizeY() const;
 
+		/// <summary>
+		/// Converts a world position into a continuous position on the tile grid, where tile (x, y) covers [x, x + 1) by [y, y + 1).
+		/// Positions outside of the maze give coordinates outside of that range.
+		/// </summary>
+		/// <param name="a_WorldPosition">The position to convert, of which the height is ignored.</param>
+		irr::core::vector2df getGridPosition(const irr::core::vector3df& a_WorldPosition) const;
+
 		/// <summary>
 		/// Constructor for this class
 		/// </summary>
 		/// <param name="a_Device">The current Irrlicht device.</param>
+		/// <param name="a_AssetRegistry">The registry the walls acquire their assets from.</param>
+		/// <param name="a_SolidityEvents">Where the walls becoming solid or passable are published.</param>
 		/// <param name="a_StartPosition">Startposition is passed on in the constructor so we might be able to adjust the position where the maze is drawn</param>
 		/// <param name="a_NeedRender">Boolean that states if this maze needs to be rendered or not</param>
-		Maze(irr::IrrlichtDevice * a_Device, irr::core::vector3df a_StartPosition, bool a_NeedRender = false);
+		Maze(irr::IrrlichtDevice * a_Device, Assets::AssetRegistry& a_AssetRegistry, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_StartPosition, bool a_NeedRender = false);
 
 		/// <summary>
 		/// Resets the 2d vector, raising all mazetiles in it or making it a rendered maze
@@ -59,7 +85,7 @@ namespace Confus
 		void resetMaze(irr::core::vector2df a_Offset, bool a_NeedRender = false);
 
 		/// <summary>
-		/// The fixed update used to update the state of the maze
+		/// The fixed update used to update the state of the maze, moving all transitioning walls at once
 		/// </summary>
 		void fixedUpdate();
 
@@ -4,8 +4,9 @@
 namespace Confus
 {
 
-	MazeGenerator::MazeGenerator(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_StartPosition, int a_InitialSeed)
-		: m_MainMaze(a_Device, a_StartPosition,true), m_ReplacementMaze(a_Device, a_StartPosition, false), m_Seed(a_InitialSeed)
+	MazeGenerator::MazeGenerator(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_StartPosition, int a_InitialSeed, ConfusShared::FrameArena& a_Scratch)
+		: m_MainMaze(a_Device, a_AssetRegistry, a_SolidityEvents, a_StartPosition,true), m_ReplacementMaze(a_Device, a_AssetRegistry, a_SolidityEvents, a_StartPosition, false),
+		m_Layout(static_cast<size_t>(m_MainMaze.mazeSizeX()), static_cast<size_t>(m_MainMaze.mazeSizeY())), m_Scratch(a_Scratch), m_Seed(a_InitialSeed)
 	{
 		generateMaze(m_MainMaze.MazeTiles, a_InitialSeed);
 	}
@@ -22,6 +23,11 @@ namespace Confus
 		m_ReplacementMaze.resetMaze(irr::core::vector2df(30,-7),false);
 	}
 
+	Maze& MazeGenerator::getMainMaze()
+	{
+		return m_MainMaze;
+	}
+
 	void MazeGenerator::replaceMainMaze()
 	{
 		for (int x = 0; x < m_MainMaze.mazeSizeX(); x++)
@@ -50,96 +56,22 @@ namespace Confus
 
 	void MazeGenerator::generateMaze(std::vector<std::vector<std::shared_ptr<MazeTile>>> &  a_Maze, int a_Seed)
 	{
-		//setup globals & variables
-		srand(a_Seed);
-		MoveableWall* wall = nullptr;
-		std::shared_ptr<MazeTile> currentTile = a_Maze[0][0];
-
-		//Startcell must be set to visited, add to visitedcount
-		currentTile->Raised = false;
-
-		wall = currentTile->getWall();
-		if (wall)
+		m_Layout.generate(a_Seed, m_Scratch);
+		for (size_t x = 0; x < m_Layout.getWidth(); x++)
 		{
-			wall->hide();
-		}
-
-		do
-		{
-			std::vector<std::shared_ptr<MazeTile>> Neighbours = getNeighbours(a_Maze,*currentTile);
-			if (Neighbours.size() != 0)
+			for (size_t y = 0; y < m_Layout.getHeight(); y++)
 			{
-				m_TileStack.push(currentTile);
-				std::shared_ptr<MazeTile> tile = Neighbours[rand() % Neighbours.size()];
-				int xmovement = (tile->XPos - currentTile->XPos) / 2;
-				int ymovement = (tile->YPos - currentTile->YPos) / 2;
-
-
-				if (xmovement != 0)
+				if (!m_Layout.isRaised(x, y))
 				{
-					std::shared_ptr<MazeTile>  inBetweenTile = a_Maze[currentTile->XPos + xmovement][currentTile->YPos];
-					inBetweenTile->Raised = false;
-					wall = inBetweenTile->getWall();
+					a_Maze[x][y]->Raised = false;
+					MoveableWall* wall = a_Maze[x][y]->getWall();
 					if (wall)
 					{
 						wall->hide();
 					}
 				}
-				else if (ymovement != 0)
-				{
-					std::shared_ptr<MazeTile> inBetweenTile = a_Maze[currentTile->XPos][currentTile->YPos + ymovement];
-					inBetweenTile->Raised = false;
-					wall = inBetweenTile->getWall();
-					if (wall)
-					{
-						wall->hide();
-					}
-				}
-
-				currentTile = tile;
-
-				currentTile->Raised = false;
-				wall = currentTile->getWall();
-				if (wall)
-				{
-					wall->hide();
-				}
 			}
-			else if (m_TileStack.size() != 0)
-			{
-				currentTile = m_TileStack.top();
-				m_TileStack.pop();
-			}
-
-		} while (m_TileStack.size() != 0);
-	}
-
-	std::vector<std::shared_ptr<MazeTile>> MazeGenerator::getNeighbours(std::vector<std::vector<std::shared_ptr<MazeTile>>> & a_Maze, MazeTile& a_Tile)
-	{
-		std::vector<std::shared_ptr<MazeTile>> neighbours;
-		size_t x = static_cast<size_t>(a_Tile.XPos);
-		size_t y = static_cast<size_t>(a_Tile.YPos);
-
-
-		//check if the neighbour is not out of bounds, and is not visited, else add to neighbours
-		if (x > 1 && a_Maze[x - 2][y]->Raised)
-		{
-			neighbours.push_back(a_Maze[x - 2][y]);
 		}
-		if (x < a_Maze.size() - 2 && a_Maze[x + 2][y]->Raised)
-		{
-			neighbours.push_back(a_Maze[x + 2][y]);
-		}
-		if (y > 1 && a_Maze[x][y - 2]->Raised)
-		{
-			neighbours.push_back(a_Maze[x][y - 2]);
-		}
-		if (y < a_Maze[0].size() - 2 && a_Maze[x][y + 2]->Raised)
-		{
-			neighbours.push_back(a_Maze[x][y + 2]);
-		}
-
-		return neighbours;
 	}
 
 	MazeGenerator::~MazeGenerator()
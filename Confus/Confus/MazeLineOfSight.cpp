@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "MazeLineOfSight.h"
+
+namespace Confus
+{
+    MazeLineOfSight::MazeLineOfSight(const Maze& a_Maze)
+        : m_Maze(a_Maze)
+    {
+        m_Width = static_cast<irr::s32>(m_Maze.MazeTiles.size());
+        m_Height = m_Maze.MazeTiles.empty() ? 0 : static_cast<irr::s32>(m_Maze.MazeTiles[0].size());
+        m_Opaque.assign(static_cast<size_t>(m_Width * m_Height), 0u);
+
+        //The walls are still at their raised position while the maze is being set up
+        for(irr::s32 x = 0; x < m_Width && m_WallTop == 0.0f; ++x)
+        {
+            for(irr::s32 y = 0; y < m_Height; ++y)
+            {
+                MoveableWall* wall = m_Maze.MazeTiles[x][y]->getWall();
+                if(wall != nullptr)
+                {
+                    auto node = wall->getMeshNode();
+                    m_WallTop = node->getPosition().Y + node->getBoundingBox().MaxEdge.Y * node->getScale().Y;
+                    break;
+                }
+            }
+        }
+
+        updateOccluders();
+    }
+
+    void MazeLineOfSight::updateOccluders()
+    {
+        bool changed = false;
+        for(irr::s32 x = 0; x < m_Width; ++x)
+        {
+            for(irr::s32 y = 0; y < m_Height; ++y)
+            {
+                MoveableWall* wall = m_Maze.MazeTiles[x][y]->getWall();
+                irr::u8 opaque = m_Maze.MazeTiles[x][y]->Raised && wall != nullptr && !wall->isTransitioning() ? 1u : 0u;
+                irr::u8& current = m_Opaque[y * m_Width + x];
+                if(current != opaque)
+                {
+                    current = opaque;
+                    changed = true;
+                }
+            }
+        }
+        if(changed)
+        {
+            ++m_Revision;
+        }
+    }
+
+    irr::u32 MazeLineOfSight::getRevision() const
+    {
+        return m_Revision;
+    }
+
+    bool MazeLineOfSight::isVisible(const irr::core::vector3df& a_From, const irr::core::vector3df& a_To) const
+    {
+        return !isBlocked(m_Maze.getGridPosition(a_From), a_From.Y, m_Maze.getGridPosition(a_To), a_To.Y);
+    }
+
+    void MazeLineOfSight::areVisible(const std::vector<LineOfSightQuery>& a_Queries, std::vector<irr::u8>& a_Results) const
+    {
+        a_Results.resize(a_Queries.size());
+        for(size_t i = 0; i < a_Queries.size(); ++i)
+        {
+            a_Results[i] = isVisible(a_Queries[i].From, a_Queries[i].To) ? 1u : 0u;
+        }
+    }
+
+    bool MazeLineOfSight::isOpaque(irr::s32 a_X, irr::s32 a_Y) const
+    {
+        if(a_X < 0 || a_Y < 0 || a_X >= m_Width || a_Y >= m_Height)
+        {
+            return false;
+        }
+        return m_Opaque[a_Y * m_Width + a_X] != 0u;
+    }
+
+    irr::f32 MazeLineOfSight::getWallTop() const
+    {
+        return m_WallTop;
+    }
+
+    irr::s32 MazeLineOfSight::getWidth() const
+    {
+        return m_Width;
+    }
+
+    irr::s32 MazeLineOfSight::getHeight() const
+    {
+        return m_Height;
+    }
+
+    bool MazeLineOfSight::isBlocked(const irr::core::vector2df& a_Start, irr::f32 a_StartHeight, const irr::core::vector2df& a_End, irr::f32 a_EndHeight) const
+    {
+        //Segments that stay above the walls can never be blocked
+        if(a_StartHeight >= m_WallTop && a_EndHeight >= m_WallTop)
+        {
+            return false;
+        }
+
+        irr::s32 x = static_cast<irr::s32>(std::floor(a_Start.X));
+        irr::s32 y = static_cast<irr::s32>(std::floor(a_Start.Y));
+        irr::s32 endX = static_cast<irr::s32>(std::floor(a_End.X));
+        irr::s32 endY = static_cast<irr::s32>(std::floor(a_End.Y));
+        irr::f32 deltaX = a_End.X - a_Start.X;
+        irr::f32 deltaY = a_End.Y - a_Start.Y;
+
+        //The segment parameter at which the next tile border is crossed along each axis, and the step between borders
+        const irr::f32 infinity = std::numeric_limits<irr::f32>::infinity();
+        irr::s32 stepX = deltaX > 0.0f ? 1 : -1;
+        irr::s32 stepY = deltaY > 0.0f ? 1 : -1;
+        irr::f32 borderStepX = deltaX != 0.0f ? std::abs(1.0f / deltaX) : infinity;
+        irr::f32 borderStepY = deltaY != 0.0f ? std::abs(1.0f / deltaY) : infinity;
+        irr::f32 nextBorderX = deltaX > 0.0f ? (x + 1 - a_Start.X) / deltaX : (deltaX < 0.0f ? (a_Start.X - x) / -deltaX : infinity);
+        irr::f32 nextBorderY = deltaY > 0.0f ? (y + 1 - a_Start.Y) / deltaY : (deltaY < 0.0f ? (a_Start.Y - y) / -deltaY : infinity);
+
+        irr::s32 stepCount = std::abs(endX - x) + std::abs(endY - y);
+        irr::f32 enter = 0.0f;
+        for(irr::s32 step = 0; step <= stepCount; ++step)
+        {
+            irr::f32 exit = std::min(std::min(nextBorderX, nextBorderY), 1.0f);
+            if(step > 0 && step < stepCount && isOpaque(x, y))
+            {
+                irr::f32 enterHeight = a_StartHeight + (a_EndHeight - a_StartHeight) * enter;
+                irr::f32 exitHeight = a_StartHeight + (a_EndHeight - a_StartHeight) * exit;
+                if(std::min(enterHeight, exitHeight) < m_WallTop)
+                {
+                    return true;
+                }
+            }
+
+            if(nextBorderX < nextBorderY)
+            {
+                x += stepX;
+                enter = nextBorderX;
+                nextBorderX += borderStepX;
+            }
+            else
+            {
+                y += stepY;
+                enter = nextBorderY;
+                nextBorderY += borderStepY;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <vector>
+
+#include "Maze.h"
+
+namespace Confus
+{
+    /// <summary>
+    /// A line of sight to test, between two world positions
+    /// </summary>
+    struct LineOfSightQuery
+    {
+        irr::core::vector3df From;
+        irr::core::vector3df To;
+    };
+
+    /// <summary>
+    /// Answers whether two positions can see each other through the maze, using the fully raised walls as occluders.
+    /// Segments are walked tile by tile over the maze grid with a DDA traversal, so a query needs no memory of its own
+    /// and only visits the tiles it crosses. A raised wall only blocks the segment if it passes below the top of the wall.
+    /// </summary>
+    /// <remarks>
+    /// Used for culling what the camera cannot see and for muffling sounds behind walls.
+    /// The occluders are read from the maze once per fixed update, the queries themselves never touch the maze tiles.
+    /// </remarks>
+    class MazeLineOfSight
+    {
+    private:
+        const Maze& m_Maze;
+        /// <summary>
+        /// The size of the tile grid, cached at construction
+        /// </summary>
+        irr::s32 m_Width;
+        irr::s32 m_Height;
+        /// <summary>
+        /// The height of the top of the raised walls, above which a segment passes over them
+        /// </summary>
+        irr::f32 m_WallTop = 0.0f;
+        /// <summary>
+        /// Whether each tile blocks the line of sight, stored row by row
+        /// </summary>
+        std::vector<irr::u8> m_Opaque;
+        /// <summary>
+        /// Incremented whenever a tile starts or stops blocking the line of sight
+        /// </summary>
+        irr::u32 m_Revision = 0;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="MazeLineOfSight"/> class, reading the current occluders.
+        /// </summary>
+        /// <param name="a_Maze">The maze whose walls block the line of sight, which has to outlive this.</param>
+        MazeLineOfSight(const Maze& a_Maze);
+
+        /// <summary>
+        /// Reads which tiles block the line of sight from the maze, to be called after the walls have moved.
+        /// Walls only occlude once they have fully risen, and stop doing so as soon as they start lowering.
+        /// </summary>
+        void updateOccluders();
+
+        /// <summary>
+        /// Gets a number that changes whenever the occluders change, so results can be cached until it does.
+        /// </summary>
+        irr::u32 getRevision() const;
+
+        /// <summary>
+        /// Gets whether two world positions can see each other.
+        /// </summary>
+        bool isVisible(const irr::core::vector3df& a_From, const irr::core::vector3df& a_To) const;
+
+        /// <summary>
+        /// Answers a batch of queries at once.
+        /// </summary>
+        /// <param name="a_Queries">The segments to test.</param>
+        /// <param name="a_Results">Filled with 1 for every segment that is unobstructed and 0 for every one that is not.</param>
+        void areVisible(const std::vector<LineOfSightQuery>& a_Queries, std::vector<irr::u8>& a_Results) const;
+
+        /// <summary>
+        /// Gets whether a tile blocks the line of sight, tiles outside of the maze never do.
+        /// </summary>
+        bool isOpaque(irr::s32 a_X, irr::s32 a_Y) const;
+
+        /// <summary>
+        /// Gets the height of the top of the raised walls.
+        /// </summary>
+        irr::f32 getWallTop() const;
+
+        /// <summary>
+        /// Gets the size of the tile grid along the X axis.
+        /// </summary>
+        irr::s32 getWidth() const;
+
+        /// <summary>
+        /// Gets the size of the tile grid along the Y axis.
+        /// </summary>
+        irr::s32 getHeight() const;
+    private:
+        /// <summary>
+        /// Walks the tiles a segment crosses on the grid, stopping at the first raised wall it passes below the top of.
+        /// The tiles the segment starts and ends on are skipped, as those hold whatever is testing the line of sight.
+        /// </summary>
+        /// <param name="a_Start">The start of the segment in grid coordinates.</param>
+        /// <param name="a_StartHeight">The world height at the start of the segment.</param>
+        /// <param name="a_End">The end of the segment in grid coordinates.</param>
+        /// <param name="a_EndHeight">The world height at the end of the segment.</param>
+        /// <returns>Whether the segment is blocked.</returns>
+        bool isBlocked(const irr::core::vector2df& a_Start, irr::f32 a_StartHeight, const irr::core::vector2df& a_End, irr::f32 a_EndHeight) const;
+    };
+}
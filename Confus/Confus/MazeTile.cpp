@@ -9,10 +9,6 @@ namespace Confus
 	{
 	}
 
-	void MazeTile::fixedUpdate()
-	{
-	}
-
 	MoveableWall* MazeTile::getWall()
 	{
 		return nullptr;
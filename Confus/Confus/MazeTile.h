@@ -32,11 +32,6 @@ namespace Confus
 		/// </summary>
 		MazeTile();
 
-		/// <summary>
-		/// Virtual method, does nothing.
-		/// </summary>
-		virtual void fixedUpdate();
-
 		/// <summary>
 		/// Virtual method, returns nullptr
 		/// </summary>
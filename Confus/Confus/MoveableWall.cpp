@@ -1,39 +1,43 @@
-#include <IrrAssimp/IrrAssimp.h>
-
 #include "MoveableWall.h"
 #include "Game.h"
 
 namespace Confus
 {
-    MoveableWall::MoveableWall(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_RegularPosition,
-        irr::core::vector3df a_HiddenPosition)
-        : m_RegularPosition(a_RegularPosition),
-        HiddenPosition(a_HiddenPosition)
+    MoveableWall::MoveableWall(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, WallAnimator& a_Animator,
+        irr::core::vector3df a_RegularPosition, irr::core::vector3df a_HiddenPosition)
+        : HiddenPosition(a_HiddenPosition),
+        m_AssetRegistry(a_AssetRegistry),
+        m_Animator(a_Animator),
+        m_AnimatorId(a_Animator.addWall(this)),
+        m_RegularPosition(a_RegularPosition)
     {
         loadMesh(a_Device->getSceneManager());
-        loadTextures(a_Device->getVideoDriver());
+        loadTextures();
         m_MeshNode->setPosition(m_RegularPosition);
         solidify();
     }
 
     MoveableWall::~MoveableWall()
     {
-        //m_MeshNode->drop();
-        //m_TriangleSelector->drop();
-        //m_RegularTexture->drop();
-        //m_TransparentTexture->drop();
+        m_Animator.removeWall(m_AnimatorId);
+        //The scene manager owns the node and the wall owns the selector it created, the assets belong to the registry
+        m_MeshNode->remove();
+        m_TriangleSelector->drop();
+        m_AssetRegistry.release(m_Mesh);
+        m_AssetRegistry.release(m_RegularTexture);
+        m_AssetRegistry.release(m_TransparentTexture);
     }
 
-    void MoveableWall::loadTextures(irr::video::IVideoDriver* a_VideoDriver)
+    void MoveableWall::loadTextures()
     {
-        m_RegularTexture = a_VideoDriver->getTexture("Media/Textures/SquareWall.jpg");
-        m_TransparentTexture = a_VideoDriver->getTexture("Media/Textures/SquareWallTransparent.png");
+        m_RegularTexture = m_AssetRegistry.acquireTexture("Media/Textures/SquareWall.jpg");
+        m_TransparentTexture = m_AssetRegistry.acquireTexture("Media/Textures/SquareWallTransparent.png");
     }
 
     void MoveableWall::loadMesh(irr::scene::ISceneManager* a_SceneManager)
     {
-        IrrAssimp importer(a_SceneManager);
-        m_MeshNode = a_SceneManager->addAnimatedMeshSceneNode(a_SceneManager->getMesh("Media/Meshes/WallMeshSquare.irrmesh"));
+        m_Mesh = m_AssetRegistry.acquireMesh("Media/Meshes/WallMeshSquare.irrmesh");
+        m_MeshNode = a_SceneManager->addAnimatedMeshSceneNode(m_AssetRegistry.get(m_Mesh));
         m_TriangleSelector = a_SceneManager->createTriangleSelector(m_MeshNode);
     }
 
@@ -41,30 +45,45 @@ namespace Confus
     {
 		m_MeshNode->setMaterialType(irr::video::E_MATERIAL_TYPE::EMT_TRANSPARENT_ALPHA_CHANNEL);
         m_TargetPosition = HiddenPosition;
-        m_Transitioning = true;
+        startTransition();
     }
 
     void MoveableWall::rise()
     {
         m_TargetPosition = m_RegularPosition;
+        startTransition();
+		m_Shown = true;
+		updateVisibility();
+    }
+
+    void MoveableWall::startTransition()
+    {
         m_Transitioning = true;
-		m_MeshNode->setVisible(true);
+        irr::f32 solidHeight = HiddenPosition.Y + (m_RegularPosition.Y - HiddenPosition.Y) * SolifyPoint;
+        m_Animator.startTransition(m_AnimatorId, m_MeshNode->getPosition().Y, m_TargetPosition.Y, TransitionSpeed, solidHeight, m_Solid);
     }
 
-    void MoveableWall::fixedUpdate()
+    void MoveableWall::setCulled(bool a_Culled)
     {
-        if(m_Transitioning)
-        {
-            updatePosition();
-            updateTransparency();
-        }
+        m_Culled = a_Culled;
+        updateVisibility();
     }
 
-    void MoveableWall::updateTransparency()
+    void MoveableWall::updateVisibility()
     {
-        auto distance = (HiddenPosition - m_MeshNode->getPosition()).getLength();
-        auto deltaDistance = distance / (HiddenPosition - m_RegularPosition).getLength();
-        if(deltaDistance >= SolifyPoint)
+        m_MeshNode->setVisible(m_Shown && !m_Culled);
+    }
+
+    void MoveableWall::setHeight(irr::f32 a_Height)
+    {
+        irr::core::vector3df position = m_MeshNode->getPosition();
+        position.Y = a_Height;
+        m_MeshNode->setPosition(position);
+    }
+
+    void MoveableWall::setSolid(bool a_Solid)
+    {
+        if(a_Solid)
         {
             solidify();
         }
@@ -74,16 +93,34 @@ namespace Confus
         }
     }
 
+    void MoveableWall::finishTransition()
+    {
+        m_Transitioning = false;
+        if(m_TargetPosition.Y == HiddenPosition.Y)
+        {
+            m_Shown = false;
+            updateVisibility();
+            m_Raised = false;
+        }
+        else
+        {
+            m_Raised = true;
+            m_MeshNode->setMaterialType(irr::video::E_MATERIAL_TYPE::EMT_SOLID);
+        }
+    }
+
     void MoveableWall::solidify()
     {
-        m_MeshNode->setMaterialTexture(0, m_RegularTexture);
+        m_MeshNode->setMaterialTexture(0, m_AssetRegistry.get(m_RegularTexture));
         enableCollision();
+        m_Solid = true;
     }
 
     void MoveableWall::makeTransparent()
     {
-        m_MeshNode->setMaterialTexture(0, m_TransparentTexture);
+        m_MeshNode->setMaterialTexture(0, m_AssetRegistry.get(m_TransparentTexture));
         disableCollision();
+        m_Solid = false;
     }
 
     void MoveableWall::enableCollision()
@@ -95,27 +132,4 @@ namespace Confus
     {
         m_MeshNode->setTriangleSelector(nullptr);
     }
-
-    void MoveableWall::updatePosition()
-    {
-        auto distance = (m_TargetPosition - m_MeshNode->getPosition()).getLength();
-        if(distance > 0.0f)
-        {
-            auto clampedSpeed = irr::core::clamp(TransitionSpeed, 0.0f, distance);
-            auto velocity = ((m_TargetPosition - m_MeshNode->getPosition()) / distance) * clampedSpeed;
-            m_MeshNode->setPosition(m_MeshNode->getPosition() + velocity);
-        }
-        else if(m_Raised)
-        {
-            m_Transitioning = false;
-			m_MeshNode->setVisible(false);
-			m_Raised = false;
-        }
-		else if (!m_Raised)
-		{
-			m_Raised = true;
-			m_Transitioning = false;
-			m_MeshNode->setMaterialType(irr::video::E_MATERIAL_TYPE::EMT_SOLID);
-		}
-    }
 }
@@ -1,6 +1,9 @@
 #pragma once
 #include <Irrlicht/irrlicht.h>
 
+#include "Assets\AssetRegistry.h"
+#include "WallAnimator.h"
+
 namespace Confus
 {    
     /// <summary>
@@ -8,6 +11,10 @@ namespace Confus
     /// </summary>
     class MoveableWall
     {
+        /// <summary>
+        /// Moves the wall during its transitions and calls back when its state changes
+        /// </summary>
+        friend class WallAnimator;
     public:
         /// <summary>
         /// The, maximum, speed at which the wall transitions
@@ -25,6 +32,21 @@ namespace Confus
 		/// </summary>
 		irr::core::vector3d<float> HiddenPosition;
     private:        
+        /// <summary>
+        /// The registry the mesh and textures of the wall are acquired from, shared with every other wall
+        /// </summary>
+        Assets::AssetRegistry& m_AssetRegistry;
+
+        /// <summary>
+        /// The animator that moves this wall along with the other walls of the maze
+        /// </summary>
+        WallAnimator& m_Animator;
+
+        /// <summary>
+        /// The id of this wall in the animator
+        /// </summary>
+        irr::u32 m_AnimatorId;
+
         /// <summary>
         /// The scenenode to represent the wall in Irrlicht
         /// </summary>
@@ -42,21 +64,31 @@ namespace Confus
         /// </summary>
         irr::core::vector3d<float> m_TargetPosition;
 
+        /// <summary>
+        /// The wall mesh, shared with every other wall
+        /// </summary>
+        Assets::MeshHandle m_Mesh;
+
         /// <summary>
         /// The texture used when the wall is solid present in the maze
         /// </summary>
-        irr::video::ITexture* m_RegularTexture;
+        Assets::TextureHandle m_RegularTexture;
 
         /// <summary>
         /// The texture for when the wall is translucent and is transitioning or hidden
         /// </summary>
-        irr::video::ITexture* m_TransparentTexture;    
+        Assets::TextureHandle m_TransparentTexture;    
 
         /// <summary>
         /// Whether the wall is currently transitioning
         /// </summary>
         bool m_Transitioning = false;
 
+        /// <summary>
+        /// Whether the wall currently uses its regular texture and collider
+        /// </summary>
+        bool m_Solid = false;
+
         /// <summary>
         /// The triangle selector used for collision detection
         /// </summary>
@@ -67,20 +99,35 @@ namespace Confus
 		/// </summary>
 		bool m_Raised = true;
 
+		/// <summary>
+		/// Whether the wall itself wants to be drawn, false once it has fully lowered
+		/// </summary>
+		bool m_Shown = true;
+
+		/// <summary>
+		/// Whether the wall has been culled by the maze visibility, regardless of its own state
+		/// </summary>
+		bool m_Culled = false;
+
     public:        
         /// <summary>
         /// Initializes a new instance of the <see cref="MoveableWall"/> class.
         /// </summary>
         /// <param name="a_Device">The current Irrlicht device.</param>
+        /// <param name="a_AssetRegistry">The registry to acquire the mesh and textures from.</param>
+        /// <param name="a_Animator">The animator to move the wall with.</param>
         /// <param name="a_RegularPosition">The position of the wall when present in the maze.</param>
         /// <param name="a_HiddenPosition">The position of the wall when out of the maze.</param>
-        MoveableWall(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_RegularPosition,
-            irr::core::vector3df a_HiddenPosition);      
+        MoveableWall(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, WallAnimator& a_Animator,
+            irr::core::vector3df a_RegularPosition, irr::core::vector3df a_HiddenPosition);      
 
         /// <summary>
-        /// Finalizes an instance of the <see cref="MoveableWall"/> class, cleans up Irrlicht resources
+        /// Finalizes an instance of the <see cref="MoveableWall"/> class, removes the scene node, releases the assets
+        /// and stops its transition
         /// </summary>
         ~MoveableWall();
+        MoveableWall(const MoveableWall&) = delete;
+        MoveableWall& operator=(const MoveableWall&) = delete;
 
         /// <summary>
         /// Starts the hiding transition
@@ -88,38 +135,58 @@ namespace Confus
         void hide();
 
 		const irr::scene::IAnimatedMeshSceneNode* getMeshNode() const { return m_MeshNode; }
+
+		/// <summary>
+		/// Whether the wall is moving into or out of the maze
+		/// </summary>
+		bool isTransitioning() const { return m_Transitioning; }
+
+		/// <summary>
+		/// Hides the wall from rendering when it cannot be seen, without affecting its transitions
+		/// </summary>
+		/// <param name="a_Culled">Whether the wall should not be drawn.</param>
+		void setCulled(bool a_Culled);
 		
 		/// <summary>
 		/// Starts the rising up transition, for moving into the maze
 		/// </summary>
         void rise();   
-
-        /// <summary>
-        /// The fixed update used to update the state of the wall
-        /// </summary>
-        void fixedUpdate();
     private:        
         /// <summary>
-        /// Loads the necessary textures
+        /// Acquires the necessary textures
         /// </summary>
-        /// <param name="a_VideoDriver">The current driver.</param>
-        void loadTextures(irr::video::IVideoDriver* a_VideoDriver);
+        void loadTextures();
 
         /// <summary>
-        /// Loads the wall mesh into the scene
+        /// Acquires the wall mesh and adds it to the scene
         /// </summary>
         /// <param name="a_SceneManager">The current scene manager.</param>
         void loadMesh(irr::scene::ISceneManager* a_SceneManager);
 
         /// <summary>
-        /// Updates the position when transitioning
+        /// Shows the scene node if the wall is both shown and not culled
+        /// </summary>
+        void updateVisibility();
+
+        /// <summary>
+        /// Hands the target of the transition to the animator
+        /// </summary>
+        void startTransition();
+
+        /// <summary>
+        /// Moves the scene node to the height given by the animator
+        /// </summary>
+        void setHeight(irr::f32 a_Height);
+
+        /// <summary>
+        /// Switches the texture and collider when the animator moves the wall past the solidify point
         /// </summary>
-        void updatePosition();
+        void setSolid(bool a_Solid);
 
         /// <summary>
-        /// Updates the transparency, including collision state, when transitioning
+        /// Hides the wall once it has fully lowered, or makes it opaque once it has fully risen
         /// </summary>
-        void updateTransparency();    
+        void finishTransition();
 
         /// <summary>
         /// Makes the wall solid and enables the collider
@@ -1,6 +1,7 @@
 #include <iostream>
-#include <vector>
+#include <stdexcept>
 #include <RakNet/BitStream.h>
+#include <RakNet/GetTime.h>
 #include <RakNet/MessageIdentifiers.h>
 
 #include "ClientConnection.h"
@@ -28,8 +29,11 @@ namespace Confus
 
         ClientConnection::~ClientConnection()
         {
-			//True is sent to notify the server so we can exit gracefully
-			m_Interface->CloseConnection(getServerAddress(), true);
+			if(m_Sessions.has(m_Server))
+			{
+				//True is sent to notify the server so we can exit gracefully
+				m_Interface->CloseConnection(getServerAddress(), true);
+			}
             RakNet::RakPeerInterface::DestroyInstance(m_Interface);
         }
 
@@ -41,27 +45,67 @@ namespace Confus
 				if(packet->data[0] == ID_CONNECTION_REQUEST_ACCEPTED)
 				{
 					std::cout << "Connected to the server!\n";
+					m_Server = m_Sessions.open(packet->systemAddress, packet->guid.g).Handle;
 					dispatchStalledMessages();
-					m_Connected = true;
+				}
+				else if(packet->data[0] == ID_DISCONNECTION_NOTIFICATION || packet->data[0] == ID_CONNECTION_LOST)
+				{
+					std::cout << "Lost the connection to the server\n";
+					m_Sessions.close(m_Server);
+					m_Server = ConfusShared::PeerHandle();
+					m_Clock.reset();
+					m_InputHistory.clear();
+					m_CharacterTransforms.clear();
+				}
+				else if(packet->data[0] == static_cast<unsigned char>(EPacketType::TimeResponse))
+				{
+					handleTimeResponse(packet);
+				}
+				else if(packet->data[0] == static_cast<unsigned char>(EPacketType::Transforms))
+				{
+					handleTransforms(packet);
+				}
+				else if(packet->data[0] == static_cast<unsigned char>(EPacketType::Batch))
+				{
+					handleBatch(packet->data, packet->length);
+				}
+				else if(packet->data[0] == static_cast<unsigned char>(EPacketType::CompressedBatch))
+				{
+					m_DecompressedDatagram.assign(1, static_cast<unsigned char>(EPacketType::Batch));
+					try
+					{
+						m_Compressor.decompress(packet->data + 1, packet->length - 1, m_DecompressedDatagram);
+						handleBatch(m_DecompressedDatagram.data(), m_DecompressedDatagram.size());
+					}
+					catch(std::invalid_argument& exception)
+					{
+						std::cout << "Dropped a compressed batch: " << exception.what() << std::endl;
+					}
 				}
 				else
 				{
-					std::cout << "Message: \"" << packet->data  << " has arrived \"" << std::endl;					
+					handleMessage(packet->data, packet->length);
 				}
                 m_Interface->DeallocatePacket(packet);
                 packet = m_Interface->Receive();
             }
+
+			if(m_Sessions.has(m_Server))
+			{
+				double localTime = getLocalTime();
+				m_Clock.update(localTime);
+				if(localTime - m_LastTimeRequest >= m_Clock.getRequestInterval())
+				{
+					sendTimeRequest(localTime);
+				}
+			}
         }
 
 		void ClientConnection::sendMessage(const std::string& a_Message)
 		{
-			if(m_Connected)
+			if(m_Sessions.has(m_Server))
 			{
-				RakNet::BitStream stream;
-				stream.Write(static_cast<RakNet::MessageID>(EPacketType::Message));
-				stream.Write(a_Message.c_str());
-				m_Interface->Send(&stream, PacketPriority::HIGH_PRIORITY,
-					PacketReliability::RELIABLE_ORDERED, 0, getServerAddress(), false);
+				queueMessage(a_Message);
 			}
 			else
 			{
@@ -69,39 +113,187 @@ namespace Confus
 			}
 		}
 
-		unsigned short ClientConnection::getConnectionCount() const
-        {
-            unsigned short openConnections = 0;
-            m_Interface->GetConnectionList(nullptr, &openConnections);
-            return openConnections;
-        }
+		void ClientConnection::flushMessages()
+		{
+			if(!m_Sessions.has(m_Server))
+			{
+				return;
+			}
+
+			auto& server = m_Sessions.get(m_Server);
+			size_t maxDatagramSize = static_cast<size_t>(m_Interface->GetMTUSize(server.Address) - DatagramOverhead);
+			server.Outbox.flush(static_cast<unsigned char>(EPacketType::Batch), maxDatagramSize,
+				[this](const unsigned char* a_Datagram, size_t a_Size) { sendBatch(a_Datagram, a_Size); });
+		}
 
-		RakNet::SystemAddress ClientConnection::getServerAddress() const
+		void ClientConnection::sendInput(const ConfusShared::PlayerInput& a_Input)
 		{
-			auto connectionCount = getConnectionCount();
-			std::vector<RakNet::SystemAddress>
-				openConnections(static_cast<size_t>(connectionCount));
-			auto serverID = m_Interface->GetConnectionList(openConnections.data(),
-				&connectionCount);
+			ConfusShared::InputCodec::record(m_InputHistory, a_Input);
+			if(!m_Sessions.has(m_Server))
+			{
+				return;
+			}
+
+			RakNet::BitStream stream;
+			stream.Write(static_cast<RakNet::MessageID>(EPacketType::Input));
+			ConfusShared::InputCodec::write(stream, m_InputHistory);
+			//Inputs are sequenced on a channel of their own, so a late packet is dropped as the next one holds its inputs already
+			m_Interface->Send(&stream, PacketPriority::HIGH_PRIORITY, PacketReliability::UNRELIABLE_SEQUENCED, 1, getServerAddress(), false);
+		}
+
+		void ClientConnection::setCompressionEnabled(bool a_Enabled)
+		{
+			m_CompressionEnabled = a_Enabled;
+		}
+
+		bool ClientConnection::isClockSynchronized() const
+		{
+			return m_Sessions.has(m_Server) && m_Clock.isSynchronized();
+		}
 
-			if(connectionCount <= 0)
+		double ClientConnection::getServerTime() const
+		{
+			return m_Clock.getServerTime(getLocalTime());
+		}
+
+		std::uint32_t ClientConnection::getServerTick() const
+		{
+			return m_Clock.getServerTick(getLocalTime());
+		}
+
+		const std::vector<ClientConnection::CharacterTransform>& ClientConnection::getCharacterTransforms() const
+		{
+			return m_CharacterTransforms;
+		}
+
+		std::uint32_t ClientConnection::getCharacterTick() const
+		{
+			return m_CharacterTick;
+		}
+
+		double ClientConnection::getLocalTime() const
+		{
+			return RakNet::GetTimeUS() / 1000000.0;
+		}
+
+		void ClientConnection::sendTimeRequest(double a_LocalTime)
+		{
+			RakNet::BitStream request;
+			request.Write(static_cast<RakNet::MessageID>(EPacketType::TimeRequest));
+			request.Write(a_LocalTime);
+			m_Interface->Send(&request, PacketPriority::IMMEDIATE_PRIORITY, PacketReliability::UNRELIABLE, 0, getServerAddress(), false);
+			m_LastTimeRequest = a_LocalTime;
+		}
+
+		void ClientConnection::handleTimeResponse(RakNet::Packet* a_Packet)
+		{
+			RakNet::BitStream response(a_Packet->data, a_Packet->length, false);
+			double requestTime;
+			double serverTime;
+			response.IgnoreBytes(sizeof(RakNet::MessageID));
+			if(response.Read(requestTime) && response.Read(serverTime))
+			{
+				m_Clock.addSample(requestTime, serverTime, getLocalTime());
+			}
+		}
+
+		void ClientConnection::handleTransforms(RakNet::Packet* a_Packet)
+		{
+			RakNet::BitStream stream(a_Packet->data, a_Packet->length, false);
+			std::uint32_t tick;
+			std::uint16_t count;
+			stream.IgnoreBytes(sizeof(RakNet::MessageID));
+			if(!stream.Read(tick) || !stream.Read(count))
+			{
+				return;
+			}
+
+			std::vector<CharacterTransform> transforms(count);
+			try
+			{
+				for(auto& character : transforms)
+				{
+					if(!stream.Read(character.Client))
+					{
+						throw std::invalid_argument("The packet ends before the transform does");
+					}
+					character.Transform = ConfusShared::TransformCodec::dequantize(ConfusShared::TransformCodec::read(stream));
+				}
+			}
+			catch(std::invalid_argument& exception)
+			{
+				std::cout << "Dropped the transforms of tick " << tick << ": " << exception.what() << std::endl;
+				return;
+			}
+			m_CharacterTransforms.swap(transforms);
+			m_CharacterTick = tick;
+		}
+
+		void ClientConnection::sendBatch(const unsigned char* a_Datagram, size_t a_Size)
+		{
+			m_CompressedDatagram.assign(1, static_cast<unsigned char>(EPacketType::CompressedBatch));
+			//The packet id stays uncompressed, so RakNet and the receiver can still tell what the datagram is
+			if(m_CompressionEnabled && m_Compressor.compress(a_Datagram + 1, a_Size - 1, m_CompressedDatagram))
+			{
+				a_Datagram = m_CompressedDatagram.data();
+				a_Size = m_CompressedDatagram.size();
+			}
+			m_Interface->Send(reinterpret_cast<const char*>(a_Datagram), static_cast<int>(a_Size), PacketPriority::HIGH_PRIORITY,
+				PacketReliability::RELIABLE_ORDERED, 0, getServerAddress(), false);
+		}
+
+		void ClientConnection::handleBatch(const unsigned char* a_Datagram, size_t a_Size)
+		{
+			try
+			{
+				ConfusShared::MessageBatch::unpack(a_Datagram, a_Size,
+					[this](const unsigned char* a_Message, size_t a_MessageSize) { handleMessage(a_Message, a_MessageSize); });
+			}
+			catch(std::invalid_argument& exception)
+			{
+				std::cout << "Dropped the rest of a batch: " << exception.what() << std::endl;
+			}
+		}
+
+		void ClientConnection::queueMessage(const std::string& a_Message)
+		{
+			RakNet::BitStream stream;
+			stream.Write(static_cast<RakNet::MessageID>(EPacketType::Message));
+			stream.Write(a_Message.c_str());
+			m_Sessions.get(m_Server).Outbox.add(stream.GetData(), stream.GetNumberOfBytesUsed());
+		}
+
+		void ClientConnection::handleMessage(const unsigned char* a_Data, size_t a_Size)
+		{
+			if(a_Data[0] == static_cast<unsigned char>(EPacketType::Message))
+			{
+				RakNet::BitStream stream(const_cast<unsigned char*>(a_Data), static_cast<unsigned int>(a_Size), false);
+				RakNet::RakString contents;
+				stream.IgnoreBytes(sizeof(RakNet::MessageID));
+				stream.Read(contents);
+				std::cout << "Message: \"" << contents << "\" has arrived" << std::endl;
+			}
+			else
+			{
+				std::cout << "Message arrived with id " << static_cast<int>(a_Data[0]) << std::endl;
+			}
+		}
+
+		const RakNet::SystemAddress& ClientConnection::getServerAddress() const
+		{
+			if(!m_Sessions.has(m_Server))
 			{
-				throw new std::logic_error("There is no connected server");
+				throw std::logic_error("There is no connected server");
 			}
-			//We assume there is at most one connection, so it is safe to say that this
-			//is the server connection
-			return openConnections[0];
+			return m_Sessions.get(m_Server).Address;
 		}
 
 		void ClientConnection::dispatchStalledMessages()
 		{
+			//The stalled messages go out with the first batch, instead of a packet each
 			while(!m_StalledMessages.empty())
 			{
-				RakNet::BitStream stream;
-				stream.Write(static_cast<RakNet::MessageID>(EPacketType::Message));
-				stream.Write(m_StalledMessages.front().c_str());
-				m_Interface->Send(&stream, PacketPriority::HIGH_PRIORITY,
-					PacketReliability::RELIABLE_ORDERED, 0, getServerAddress(), false);
+				queueMessage(m_StalledMessages.front());
 				m_StalledMessages.pop();
 			}
 		}
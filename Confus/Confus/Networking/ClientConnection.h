@@ -3,6 +3,13 @@
 #include <RakNet/MessageIdentifiers.h>
 #include <string>
 #include <queue>
+#include <vector>
+
+#include "ConfusShared/ClockSync.h"
+#include "ConfusShared/InputCodec.h"
+#include "ConfusShared/PacketCompressor.h"
+#include "ConfusShared/SessionTable.h"
+#include "ConfusShared/TransformCodec.h"
 
 namespace Confus
 {
@@ -21,19 +28,58 @@ namespace Confus
         /// </remarks>
         class ClientConnection
         {
+		public:
+			/// <summary> Where the server put the character of a client </summary>
+			struct CharacterTransform
+			{
+				/// <summary> The slot of the client on the server, which stays the same while it is connected </summary>
+				std::uint16_t Client;
+				ConfusShared::PlayerTransform Transform;
+			};
 		private:
 			/// <summary> The type of packet </summary>
 			enum class EPacketType : unsigned char
 			{
-				Message = 1 + ID_USER_PACKET_ENUM
+				Message = 1 + ID_USER_PACKET_ENUM,
+				Batch, ///< Several messages packed into a single datagram
+				CompressedBatch, ///< A batch compressed with the packet compressor
+				TimeRequest, ///< Asks the server for the time on the shared timeline
+				TimeResponse, ///< The time on the shared timeline, with the local time it was asked at
+				Input, ///< The last few inputs of the player, newest first
+				Transforms ///< Where the character of every client is after a tick
 			};
 
+			/// <summary>
+			/// The bytes of a datagram taken by the IP and UDP headers and the headers RakNet adds for a reliable ordered message,
+			/// which leave the rest of the MTU for the batched messages
+			/// </summary>
+			static const int DatagramOverhead = 64;
+
             /// <summary> The RakNet interface for interacting with RakNet </summary>
 			RakNet::RakPeerInterface* m_Interface = RakNet::RakPeerInterface::GetInstance();
 			/// <summary> The messages it was not able to send yet due to not having a connection established </summary>
 			std::queue<std::string> m_StalledMessages;
-			/// <summary> Whether we are connected to a server</summary>
-			bool m_Connected = false;
+			/// <summary> The session of the server, the only peer a client talks to </summary>
+			ConfusShared::SessionTable<RakNet::SystemAddress> m_Sessions{ 1 };
+			/// <summary> The handle of the server, invalid while we are not connected to it </summary>
+			ConfusShared::PeerHandle m_Server;
+			/// <summary> Compresses the batches sent and decompresses the ones received </summary>
+			ConfusShared::PacketCompressor m_Compressor;
+			/// <summary> Whether batches are sent compressed when that makes them smaller </summary>
+			bool m_CompressionEnabled = true;
+			/// <summary> The buffers datagrams are compressed into and decompressed into, kept to reuse their memory </summary>
+			std::vector<unsigned char> m_CompressedDatagram;
+			std::vector<unsigned char> m_DecompressedDatagram;
+			/// <summary> The estimate of the time on the server's timeline </summary>
+			ConfusShared::ClockSync m_Clock;
+			/// <summary> The local time the last time request was sent at </summary>
+			double m_LastTimeRequest = 0.0;
+			/// <summary> The last inputs of the player, every one of which is sent along with each new input </summary>
+			ConfusShared::InputCodec::History m_InputHistory;
+			/// <summary> The characters of every client as of the newest transforms the server sent </summary>
+			std::vector<CharacterTransform> m_CharacterTransforms;
+			/// <summary> The tick of the server the character transforms are from </summary>
+			std::uint32_t m_CharacterTick = 0;
 
         public:
             /// <summary> Initializes a new instance of the <see cref="ClientConnection"/> class. </summary>
@@ -52,16 +98,89 @@ namespace Confus
 			/// </summary>
 			/// <param name="a_Message">The message contents</param>
 			void sendMessage(const std::string& a_Message);
+			/// <summary>
+			/// Sends the messages queued since the last flush, packed into as few datagrams as possible.
+			/// Meant to be called once per tick.
+			/// </summary>
+			void flushMessages();
+			/// <summary>
+			/// Sends the input of the player for a tick along with the inputs of the ticks before it, straight away and unreliably,
+			/// so a lost packet is made up for by the next one instead of holding up the inputs after it.
+			/// Meant to be called once per tick.
+			/// </summary>
+			/// <param name="a_Input">The input, which has to be quantized with the input codec</param>
+			void sendInput(const ConfusShared::PlayerInput& a_Input);
+			/// <summary>
+			/// Sets whether batches are sent compressed, compressed batches are received either way.
+			/// </summary>
+			/// <param name="a_Enabled">Whether to compress.</param>
+			void setCompressionEnabled(bool a_Enabled);
+			/// <summary>
+			/// Gets whether the time on the shared timeline is known well enough to run the game on.
+			/// </summary>
+			bool isClockSynchronized() const;
+			/// <summary>
+			/// Gets the estimated time on the shared timeline, which only goes forward and does not jump once synchronized.
+			/// </summary>
+			double getServerTime() const;
+			/// <summary>
+			/// Gets the tick of the shared timeline the server is estimated to be in.
+			/// </summary>
+			std::uint32_t getServerTick() const;
+			/// <summary>
+			/// Gets where the server last put the character of every client, including the one of this client.
+			/// </summary>
+			const std::vector<CharacterTransform>& getCharacterTransforms() const;
+			/// <summary>
+			/// Gets the tick of the server the character transforms are from.
+			/// </summary>
+			std::uint32_t getCharacterTick() const;
 		private:
-			/// <summary> Gets the amount of clients connected to this server instance </summary>
-			/// <returns> The amount of clients connected </returns>
-			unsigned short getConnectionCount() const;
-			/// <summary> Closes the connection to the server gracefully </summary>
-			/// <remarks> 
-			/// This function assumes that there is at most one open connection at this time,
-			/// which means that there can be no connections to other servers or clients.
-			/// </remarks>
-			RakNet::SystemAddress getServerAddress() const;			
+			/// <summary> Gets the address of the server we are connected to </summary>
+			/// <exception cref="std::logic_error">There is no connected server.</exception>
+			const RakNet::SystemAddress& getServerAddress() const;
+			/// <summary>
+			/// Queues a message in the batch for the server, which has to be connected
+			/// </summary>
+			/// <param name="a_Message">The message contents</param>
+			void queueMessage(const std::string& a_Message);
+			/// <summary>
+			/// Gets the local time in seconds that the clock synchronization is measured in
+			/// </summary>
+			double getLocalTime() const;
+			/// <summary>
+			/// Asks the server for the time on the shared timeline, straight away as waiting for a batch would skew the answer
+			/// </summary>
+			/// <param name="a_LocalTime">The local time to send along, which the answer returns</param>
+			void sendTimeRequest(double a_LocalTime);
+			/// <summary>
+			/// Adds the answer of the server to a time request to the clock estimate
+			/// </summary>
+			/// <param name="a_Packet">The answer.</param>
+			void handleTimeResponse(RakNet::Packet* a_Packet);
+			/// <summary>
+			/// Replaces the character transforms with the ones the server sent, unless the packet is cut off
+			/// </summary>
+			/// <param name="a_Packet">The transforms.</param>
+			void handleTransforms(RakNet::Packet* a_Packet);
+			/// <summary>
+			/// Sends a batch to the server, compressed if compression is enabled and makes it smaller
+			/// </summary>
+			/// <param name="a_Datagram">The batch, starting with its packet id</param>
+			/// <param name="a_Size">The size of the batch in bytes</param>
+			void sendBatch(const unsigned char* a_Datagram, size_t a_Size);
+			/// <summary>
+			/// Handles every message in a batch received from the server
+			/// </summary>
+			/// <param name="a_Datagram">The batch, starting with its packet id</param>
+			/// <param name="a_Size">The size of the batch in bytes</param>
+			void handleBatch(const unsigned char* a_Datagram, size_t a_Size);
+			/// <summary>
+			/// Prints a message received from the server
+			/// </summary>
+			/// <param name="a_Data">The message, starting with its packet id</param>
+			/// <param name="a_Size">The size of the message in bytes</param>
+			void handleMessage(const unsigned char* a_Data, size_t a_Size);
 			/// <summary>
 			/// Dispatches the messages that the connection was not able to send yet
 			/// due to waiting for the connection to be established
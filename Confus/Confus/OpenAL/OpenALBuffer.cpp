@@ -0,0 +1,138 @@
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "OpenALBuffer.h"
+#include "OpenALSoundPack.h"
+#include "Framework/CWaves.h"
+
+namespace Confus {
+    namespace
+    {
+        /// <summary>
+        /// The buffers currently in use, keyed by wave file.
+        /// Weak references are stored so that a buffer is released once no source uses it anymore.
+        /// </summary>
+        std::unordered_map<std::string, std::weak_ptr<OpenALBuffer>> LoadedBuffers;
+
+        /// <summary>
+        /// Gets the buffer of a wave file if a source still uses it.
+        /// </summary>
+        /// <returns>The buffer, or nullptr if it has to be loaded, in which case it is only added to the cache once loading succeeded.</returns>
+        std::shared_ptr<OpenALBuffer> findLoaded(const std::string& a_WaveFileString) {
+            auto iterator = LoadedBuffers.find(a_WaveFileString);
+            return iterator != LoadedBuffers.end() ? iterator->second.lock() : nullptr;
+        }
+
+        /// <summary>
+        /// Gets the sound pack, mapping it the first time a wave file is read.
+        /// </summary>
+        /// <remarks>
+        /// The asset loader reads wave files on several threads at once, the initialization of a local static
+        /// makes sure the pack is mapped exactly once and that every thread waits until it has been.
+        /// </remarks>
+        /// <returns>The sound pack, or nullptr if it has not been built, in which case wave files are loaded one by one.</returns>
+        const OpenALSoundPack* getSoundPack() {
+            static const std::unique_ptr<OpenALSoundPack> soundPack = []() -> std::unique_ptr<OpenALSoundPack> {
+                try {
+                    return std::unique_ptr<OpenALSoundPack>(new OpenALSoundPack(OpenALSoundPack::DefaultPackFile));
+                }
+                catch(std::invalid_argument&) {
+                    return nullptr;
+                }
+            }();
+            return soundPack.get();
+        }
+    }
+
+    OpenALBuffer::OpenALBuffer(const std::string& a_WaveFileString, const OpenALWaveData& a_WaveData) : m_WaveFileString(a_WaveFileString) {
+        alGenBuffers(1, &m_Buffer);
+        alGetError();
+        alBufferData(m_Buffer, a_WaveData.Format, a_WaveData.Data, a_WaveData.Size, a_WaveData.Frequency);
+        if(alGetError() != AL_NO_ERROR)
+        {
+            alDeleteBuffers(1, &m_Buffer);
+            throw std::invalid_argument("Wave data was invalid");
+        }
+
+        ALint size, channels, bits, frequency;
+        alGetBufferi(m_Buffer, AL_SIZE, &size);
+        alGetBufferi(m_Buffer, AL_CHANNELS, &channels);
+        alGetBufferi(m_Buffer, AL_BITS, &bits);
+        alGetBufferi(m_Buffer, AL_FREQUENCY, &frequency);
+        if(channels > 0 && bits > 0 && frequency > 0) {
+            m_Duration = static_cast<float>(size) / (channels * (bits / 8) * frequency);
+        }
+    }
+
+    OpenALBuffer::~OpenALBuffer() {
+        alDeleteBuffers(1, &m_Buffer);
+
+        auto iterator = LoadedBuffers.find(m_WaveFileString);
+        if(iterator != LoadedBuffers.end() && iterator->second.expired()) {
+            LoadedBuffers.erase(iterator);
+        }
+    }
+
+    std::shared_ptr<OpenALBuffer> OpenALBuffer::load(const std::string& a_WaveFileString) {
+        auto buffer = findLoaded(a_WaveFileString);
+        if(buffer == nullptr) {
+            OpenALWaveData waveData;
+            if(!read(a_WaveFileString, waveData)) {
+                throw std::invalid_argument("Path was invalid");
+            }
+            buffer = std::shared_ptr<OpenALBuffer>(new OpenALBuffer(a_WaveFileString, waveData));
+            LoadedBuffers[a_WaveFileString] = buffer;
+        }
+        return buffer;
+    }
+
+    std::shared_ptr<OpenALBuffer> OpenALBuffer::load(const std::string& a_WaveFileString, const OpenALWaveData& a_WaveData) {
+        auto buffer = findLoaded(a_WaveFileString);
+        if(buffer == nullptr) {
+            buffer = std::shared_ptr<OpenALBuffer>(new OpenALBuffer(a_WaveFileString, a_WaveData));
+            LoadedBuffers[a_WaveFileString] = buffer;
+        }
+        return buffer;
+    }
+
+    bool OpenALBuffer::read(const std::string& a_WaveFileString, OpenALWaveData& a_WaveData) {
+        auto soundPack = getSoundPack();
+        if(soundPack != nullptr && soundPack->getWaveData(a_WaveFileString, a_WaveData)) {
+            return true;
+        }
+
+        //Every call uses its own loader, so that wave files can be read on several threads at once
+        CWaves waveLoader;
+        WAVEID waveID;
+        unsigned long size, frequency, format, bytesRead = 0;
+        if(!SUCCEEDED(waveLoader.OpenWaveFile(("Media\\" + a_WaveFileString).c_str(), &waveID))) {
+            return false;
+        }
+        bool succeeded = SUCCEEDED(waveLoader.GetWaveSize(waveID, &size)) &&
+            SUCCEEDED(waveLoader.GetWaveFrequency(waveID, &frequency)) &&
+            SUCCEEDED(waveLoader.GetWaveALBufferFormat(waveID, &alGetEnumValue, &format));
+        if(succeeded) {
+            a_WaveData.OwnedData.resize(size);
+            succeeded = SUCCEEDED(waveLoader.ReadWaveData(waveID, a_WaveData.OwnedData.data(), size, &bytesRead)) && bytesRead == size;
+        }
+        waveLoader.DeleteWaveFile(waveID);
+        if(!succeeded) {
+            return false;
+        }
+
+        a_WaveData.Format = static_cast<ALenum>(format);
+        a_WaveData.Frequency = static_cast<ALsizei>(frequency);
+        a_WaveData.Data = a_WaveData.OwnedData.data();
+        a_WaveData.Size = static_cast<ALsizei>(size);
+        return true;
+    }
+
+    ALuint OpenALBuffer::getBufferID() const {
+        return m_Buffer;
+    }
+
+    float OpenALBuffer::getDuration() const {
+        return m_Duration;
+    }
+}
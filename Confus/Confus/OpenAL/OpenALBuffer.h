@@ -0,0 +1,94 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Framework/Framework.h"
+
+namespace Confus {
+    /// <summary>
+    /// The PCM data of a wave file, ready to be uploaded into a buffer.
+    /// It can be moved but not copied, as the data may point into its own storage.
+    /// </summary>
+    struct OpenALWaveData {
+        ALenum Format = 0;
+        ALsizei Frequency = 0;
+        /// <summary>
+        /// The PCM data, pointing into the sound pack or into OwnedData
+        /// </summary>
+        const char* Data = nullptr;
+        ALsizei Size = 0;
+        /// <summary>
+        /// The storage of the PCM data when it was read from a .wav file instead of the sound pack
+        /// </summary>
+        std::vector<char> OwnedData;
+
+        OpenALWaveData() = default;
+        OpenALWaveData(OpenALWaveData&&) = default;
+        OpenALWaveData& operator=(OpenALWaveData&&) = default;
+        OpenALWaveData(const OpenALWaveData&) = delete;
+        OpenALWaveData& operator=(const OpenALWaveData&) = delete;
+    };
+
+    /// <summary>
+    /// OpenAL Sound Buffer class, holding the loaded contents of a single wave file.
+    /// Buffers are shared between every source that plays the same file, so each file is only loaded once.
+    /// The wave data is taken from the sound pack when it has been built, the .wav file is only parsed as a fallback.
+    /// </summary>
+    class OpenALBuffer {
+    private:
+        /// <summary>
+        /// The OpenAL buffer name the wave data is uploaded to
+        /// </summary>
+        ALuint m_Buffer;
+        /// <summary>
+        /// The play length of the loaded wave data in seconds, at normal pitch
+        /// </summary>
+        float m_Duration = 0.0f;
+        /// <summary>
+        /// The wave file this buffer was loaded from, used as the key in the buffer cache
+        /// </summary>
+        std::string m_WaveFileString;
+    private:
+        /// <summary>
+        /// Uploads the wave data into a new OpenAL buffer.
+        /// </summary>
+        /// <param name="a_WaveFileString">The wave file the data was read from, relative to the media folder.</param>
+        /// <param name="a_WaveData">The PCM data to upload.</param>
+        OpenALBuffer(const std::string& a_WaveFileString, const OpenALWaveData& a_WaveData);
+    public:
+        /// <summary>
+        /// Gets the buffer for the given wave file, loading it only if no other source is using it yet.
+        /// </summary>
+        /// <param name="a_WaveFileString">The wave file, relative to the media folder.</param>
+        /// <returns>The shared buffer, which is released once the last source drops it.</returns>
+        static std::shared_ptr<OpenALBuffer> load(const std::string& a_WaveFileString);
+        /// <summary>
+        /// Gets the buffer for the given wave file, uploading the already read wave data only if no other source is using it yet.
+        /// </summary>
+        /// <param name="a_WaveFileString">The wave file, relative to the media folder.</param>
+        /// <param name="a_WaveData">The PCM data of the wave file, as read by <see cref="OpenALBuffer::read"/>.</param>
+        /// <returns>The shared buffer, which is released once the last source drops it.</returns>
+        static std::shared_ptr<OpenALBuffer> load(const std::string& a_WaveFileString, const OpenALWaveData& a_WaveData);
+        /// <summary>
+        /// Reads the PCM data of a wave file from the sound pack, or from the .wav file if it is not packed.
+        /// Unlike loading, this does not touch OpenAL and may be called from any thread.
+        /// </summary>
+        /// <param name="a_WaveFileString">The wave file, relative to the media folder.</param>
+        /// <param name="a_WaveData">The wave data to fill.</param>
+        /// <returns>Whether the wave file could be read.</returns>
+        static bool read(const std::string& a_WaveFileString, OpenALWaveData& a_WaveData);
+        /// <summary>
+        /// Gets the OpenAL buffer name, to be attached to sources.
+        /// </summary>
+        ALuint getBufferID() const;
+        /// <summary>
+        /// Gets the play length of the buffer in seconds, at normal pitch.
+        /// </summary>
+        float getDuration() const;
+        /// <summary>
+        /// Deletes the OpenAL buffer and removes it from the cache.
+        /// </summary>
+        ~OpenALBuffer();
+    };
+}
@@ -3,10 +3,13 @@
 #include "OpenALListener.h"
 
 namespace Confus {
+    const float OpenALListener::PositionUpdateThreshold = 0.05f;
 
     OpenALListener::OpenALListener()
     {
         init();
+        //Match the orientation that update() assumes for a zero rotation
+        setDirection(0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f);
     }
 
     void OpenALListener::init()
@@ -62,4 +65,17 @@ namespace Confus {
     void OpenALListener::setVelocity(irr::core::vector3df a_Velocity) {
         alListener3f(AL_VELOCITY, a_Velocity.X, a_Velocity.Y, a_Velocity.Z);
     }
+
+    void OpenALListener::update(irr::core::vector3df a_Position, irr::core::vector3df a_Rotation) {
+        if(a_Position.getDistanceFromSQ(m_Position) >= PositionUpdateThreshold * PositionUpdateThreshold) {
+            m_Position = a_Position;
+            setPosition(m_Position);
+        }
+
+        if(!a_Rotation.equals(m_Rotation)) {
+            m_Rotation = a_Rotation;
+            irr::core::quaternion rotation(m_Rotation * irr::core::DEGTORAD);
+            setDirection(rotation * irr::core::vector3df(0, 0, 1), rotation * irr::core::vector3df(0, 1, 0));
+        }
+    }
 }
\ No newline at end of file
@@ -6,6 +6,19 @@
 
 namespace Confus {
 	class OpenALListener {
+    private:
+        /// <summary>
+        /// The distance the listener has to move before its position is sent to OpenAL again.
+        /// </summary>
+        static const float PositionUpdateThreshold;
+        /// <summary>
+        /// The position as last sent to OpenAL.
+        /// </summary>
+        irr::core::vector3df m_Position;
+        /// <summary>
+        /// The rotation the direction was last calculated from.
+        /// </summary>
+        irr::core::vector3df m_Rotation;
 	public:        
         /// <summary>
         /// Initializes a new instance of the <see cref="OpenALListener"/> class.
@@ -28,6 +41,12 @@ namespace Confus {
 		/// </summary>
 		void setDirection(float a_AtX = 0.0f, float a_AtY = 0.0f, float a_AtZ = 0.0f, float a_UpX = 0.0f, float a_UpY = 0.0f, float a_UpZ = 0.0f);
         void setDirection(irr::core::vector3df a_ForwardVector, irr::core::vector3df a_UpVector);
+        /// <summary>
+        /// Moves and orients the listener, only sending the values to OpenAL that have changed noticeably.
+        /// </summary>
+        /// <param name="a_Position">The world position of the listener.</param>
+        /// <param name="a_Rotation">The rotation of the listener in degrees, as used by Irrlicht scene nodes.</param>
+        void update(irr::core::vector3df a_Position, irr::core::vector3df a_Rotation);
         void dispose();
         void init();
 	};
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "OpenALSoundPack.h"
+#include "Framework/CWaves.h"
+
+namespace Confus {
+    const char* const OpenALSoundPack::DefaultPackFile = "Media\\Audio.pack";
+    const uint32_t OpenALSoundPack::PackVersion = 1;
+    const uint64_t OpenALSoundPack::DataAlignment = 64;
+
+    OpenALSoundPack::OpenALSoundPack(const std::string& a_PackFile) : m_File(a_PackFile) {
+        const char* data = m_File.getData();
+        uint64_t size = m_File.getSize();
+        auto header = reinterpret_cast<const Header*>(data);
+        if(size < sizeof(Header) || std::memcmp(header->Magic, "CSPK", 4) != 0 || header->Version != PackVersion) {
+            throw std::invalid_argument("Invalid sound pack");
+        }
+        uint64_t indexEnd = sizeof(Header) + static_cast<uint64_t>(header->EntryCount) * sizeof(Entry);
+        if(indexEnd > size) {
+            throw std::invalid_argument("Invalid sound pack");
+        }
+        m_Entries = reinterpret_cast<const Entry*>(data + sizeof(Header));
+        m_EntryCount = header->EntryCount;
+
+        for(uint32_t i = 0; i < m_EntryCount; ++i) {
+            if(m_Entries[i].Offset < indexEnd || m_Entries[i].Offset > size || m_Entries[i].Size > size - m_Entries[i].Offset) {
+                throw std::invalid_argument("Invalid sound pack");
+            }
+        }
+    }
+
+    bool OpenALSoundPack::getWaveData(const std::string& a_WaveFileString, OpenALWaveData& a_WaveData) const {
+        const Entry* entry = findEntry(a_WaveFileString);
+        if(entry == nullptr) {
+            return false;
+        }
+
+        if(entry->Channels == 1) {
+            a_WaveData.Format = entry->BitsPerSample == 8 ? AL_FORMAT_MONO8 : AL_FORMAT_MONO16;
+        }
+        else {
+            a_WaveData.Format = entry->BitsPerSample == 8 ? AL_FORMAT_STEREO8 : AL_FORMAT_STEREO16;
+        }
+        a_WaveData.Frequency = static_cast<ALsizei>(entry->Frequency);
+        a_WaveData.Data = m_File.getData() + entry->Offset;
+        a_WaveData.Size = static_cast<ALsizei>(entry->Size);
+        return true;
+    }
+
+    const OpenALSoundPack::Entry* OpenALSoundPack::findEntry(const std::string& a_WaveFileString) const {
+        auto end = m_Entries + m_EntryCount;
+        auto entry = std::lower_bound(m_Entries, end, a_WaveFileString, [](const Entry& a_Entry, const std::string& a_Name) {
+            return std::strcmp(a_Entry.Name, a_Name.c_str()) < 0;
+        });
+        if(entry == end || a_WaveFileString != entry->Name) {
+            return nullptr;
+        }
+        return entry;
+    }
+
+    bool OpenALSoundPack::build(const std::string& a_MediaFolder, const std::string& a_PackFile) {
+        std::vector<std::string> waveFiles;
+        WIN32_FIND_DATAA findData;
+        HANDLE findHandle = FindFirstFileA((a_MediaFolder + "*.wav").c_str(), &findData);
+        if(findHandle != INVALID_HANDLE_VALUE) {
+            do {
+                if(std::strlen(findData.cFileName) < sizeof(Entry::Name)) {
+                    waveFiles.push_back(findData.cFileName);
+                }
+                else {
+                    std::cout << "Skipping " << findData.cFileName << ", the name is too long" << std::endl;
+                }
+            } while(FindNextFileA(findHandle, &findData));
+            FindClose(findHandle);
+        }
+        std::sort(waveFiles.begin(), waveFiles.end(), [](const std::string& a_Left, const std::string& a_Right) {
+            return std::strcmp(a_Left.c_str(), a_Right.c_str()) < 0;
+        });
+
+        CWaves waveLoader;
+        std::vector<Entry> entries;
+        std::vector<WAVEID> waveIDs;
+        for(auto& waveFile : waveFiles) {
+            WAVEID waveID;
+            WAVEFORMATEX format;
+            if(!SUCCEEDED(waveLoader.LoadWaveFile((a_MediaFolder + waveFile).c_str(), &waveID))) {
+                std::cout << "Skipping " << waveFile << ", it could not be loaded" << std::endl;
+                continue;
+            }
+
+            Entry entry = {};
+            unsigned long size;
+            waveLoader.GetWaveFormatExHeader(waveID, &format);
+            waveLoader.GetWaveSize(waveID, &size);
+            if((format.nChannels != 1 && format.nChannels != 2) || (format.wBitsPerSample != 8 && format.wBitsPerSample != 16)) {
+                std::cout << "Skipping " << waveFile << ", only mono and stereo 8 or 16 bit PCM can be packed" << std::endl;
+                waveLoader.DeleteWaveFile(waveID);
+                continue;
+            }
+            std::strcpy(entry.Name, waveFile.c_str());
+            entry.Channels = format.nChannels;
+            entry.BitsPerSample = format.wBitsPerSample;
+            entry.Frequency = format.nSamplesPerSec;
+            entry.Size = size;
+            entries.push_back(entry);
+            waveIDs.push_back(waveID);
+        }
+
+        uint64_t offset = sizeof(Header) + entries.size() * sizeof(Entry);
+        for(auto& entry : entries) {
+            offset = (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+            entry.Offset = offset;
+            offset += entry.Size;
+        }
+
+        std::ofstream packStream(a_PackFile, std::ios::binary | std::ios::trunc);
+        if(packStream) {
+            Header header = {};
+            std::memcpy(header.Magic, "CSPK", 4);
+            header.Version = PackVersion;
+            header.EntryCount = static_cast<uint32_t>(entries.size());
+            packStream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            packStream.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+
+            for(size_t i = 0; i < entries.size(); ++i) {
+                char* data;
+                waveLoader.GetWaveData(waveIDs[i], reinterpret_cast<void**>(&data));
+                static const char padding[DataAlignment] = {};
+                packStream.write(padding, static_cast<std::streamsize>(entries[i].Offset - static_cast<uint64_t>(packStream.tellp())));
+                packStream.write(data, static_cast<std::streamsize>(entries[i].Size));
+            }
+        }
+
+        for(auto waveID : waveIDs) {
+            waveLoader.DeleteWaveFile(waveID);
+        }
+        if(!packStream) {
+            std::cout << "Failed to write " << a_PackFile << std::endl;
+            return false;
+        }
+        std::cout << "Packed " << entries.size() << " wave files into " << a_PackFile << std::endl;
+        return true;
+    }
+}
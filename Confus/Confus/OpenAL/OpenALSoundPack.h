@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Framework/Framework.h"
+#include "../MappedFile.h"
+#include "OpenALBuffer.h"
+
+namespace Confus {
+    /// <summary>
+    /// OpenAL Sound Pack class, a single file holding the PCM data of every wave file in the media folder.
+    /// The pack is built offline with <see cref="OpenALSoundPack::build"/>, so no wave headers have to be parsed at runtime.
+    /// At runtime the pack is memory mapped and buffers are filled straight from the mapping.
+    /// </summary>
+    class OpenALSoundPack {
+    public:
+        /// <summary>
+        /// The pack file that is built from and loaded next to the media folder
+        /// </summary>
+        static const char* const DefaultPackFile;
+    private:
+        /// <summary>
+        /// The header at the start of the pack file
+        /// </summary>
+        struct Header {
+            /// <summary> Identifies the file as a sound pack, always "CSPK" </summary>
+            char Magic[4];
+            /// <summary> The version of the pack layout, rejected if it does not match <see cref="PackVersion"/> </summary>
+            uint32_t Version;
+            /// <summary> The amount of entries following the header </summary>
+            uint32_t EntryCount;
+            /// <summary> Unused, keeps the entries 8 byte aligned </summary>
+            uint32_t Reserved;
+        };
+
+        /// <summary>
+        /// The index entry of a single wave file, entries are sorted by name
+        /// </summary>
+        struct Entry {
+            /// <summary> The wave file relative to the media folder, zero terminated </summary>
+            char Name[48];
+            /// <summary> The amount of interleaved channels, 1 or 2 </summary>
+            uint16_t Channels;
+            /// <summary> The bits per sample, 8 or 16 </summary>
+            uint16_t BitsPerSample;
+            /// <summary> The sample rate in Hz </summary>
+            uint32_t Frequency;
+            /// <summary> The offset of the PCM data from the start of the file, a multiple of <see cref="DataAlignment"/> </summary>
+            uint64_t Offset;
+            /// <summary> The size of the PCM data in bytes </summary>
+            uint64_t Size;
+        };
+
+        static const uint32_t PackVersion;
+        /// <summary>
+        /// The alignment of the PCM data of each entry within the pack
+        /// </summary>
+        static const uint64_t DataAlignment;
+
+        /// <summary>
+        /// The mapped pack file, which the index and PCM data are read from in place
+        /// </summary>
+        MappedFile m_File;
+        const Entry* m_Entries = nullptr;
+        uint32_t m_EntryCount = 0;
+    public:
+        /// <summary>
+        /// Maps the pack file into memory and validates its index.
+        /// </summary>
+        /// <param name="a_PackFile">The path of the pack file.</param>
+        /// <exception cref="std::invalid_argument">The file could not be mapped or is not a valid pack.</exception>
+        OpenALSoundPack(const std::string& a_PackFile);
+        /// <summary>
+        /// Gets the PCM data of the given wave file, pointing directly into the mapping.
+        /// </summary>
+        /// <param name="a_WaveFileString">The wave file, relative to the media folder.</param>
+        /// <param name="a_WaveData">The wave data to fill.</param>
+        /// <returns>Whether the wave file is in the pack.</returns>
+        bool getWaveData(const std::string& a_WaveFileString, OpenALWaveData& a_WaveData) const;
+        /// <summary>
+        /// Converts every .wav wave file in the media folder into a pack.
+        /// This is an offline step, run with the --pack-audio command line switch whenever the wave files change.
+        /// </summary>
+        /// <param name="a_MediaFolder">The folder to read the wave files from, ending in a path separator.</param>
+        /// <param name="a_PackFile">The path of the pack file to write.</param>
+        /// <returns>Whether the pack was written.</returns>
+        static bool build(const std::string& a_MediaFolder, const std::string& a_PackFile);
+    private:
+        /// <summary>
+        /// Finds the entry of the given wave file using a binary search over the sorted index.
+        /// </summary>
+        /// <returns>The entry, or nullptr if the wave file is not in the pack.</returns>
+        const Entry* findEntry(const std::string& a_WaveFileString) const;
+    };
+}
@@ -15,18 +15,12 @@ namespace Confus {
 
     void OpenALSource::init(std::string a_WaveFileString) {
         m_WaveFileString = a_WaveFileString;
-        m_Buffer = new ALuint;
+        m_Buffer = OpenALBuffer::load(m_WaveFileString);
         m_Source = new ALuint;
         m_PlayingState = new ALint;
-        alGenBuffers(1, m_Buffer);
-
-        if(!OpenAL::ALFWLoadWaveToBuffer((char*)OpenAL::ALFWaddMediaPath(m_WaveFileString.c_str()), *m_Buffer))
-        {
-            throw std::invalid_argument("Path was invalid");
-        }
 
         alGenSources(1, m_Source);
-        alSourcei(*m_Source, AL_BUFFER, *m_Buffer);
+        alSourcei(*m_Source, AL_BUFFER, m_Buffer->getBufferID());
     }
 
     void OpenALSource::setPosition(float a_PositionX, float a_PositionY, float a_PositionZ) {
@@ -116,9 +110,8 @@ namespace Confus {
     void OpenALSource::dispose() {
         alSourceStop(*m_Source);
         alDeleteSources(1, m_Source);
-        alDeleteBuffers(1, m_Buffer);
+        m_Buffer.reset();
         delete(m_Source);
-        delete(m_Buffer);
         delete(m_PlayingState);
     }
 
@@ -2,16 +2,19 @@
 #include <Irrlicht\irrlicht.h>
 
 #include "Framework/Framework.h"
+#include "OpenALBuffer.h"
+#include <memory>
 #include <string>
 
 namespace Confus {
 	/// <summary>
 	/// OpenAL Sound Source class.
 	/// Needs the init() function to load a wave file.
+	/// The loaded wave data is shared with every other source playing the same file.
 	/// </summary>
 	class OpenALSource {
     private:
-        ALuint* m_Buffer;
+        std::shared_ptr<OpenALBuffer> m_Buffer;
         ALuint* m_Source;
         ALint* m_PlayingState;
         std::string m_WaveFileString;
@@ -21,7 +24,7 @@ namespace Confus {
         /// </summary>
 		void dispose();
         /// <summary>
-        /// Load the .wav wave file and set up the source + buffer.
+        /// Get the (shared) buffer for the .wav wave file and set up the source.
         /// </summary>
         void init(std::string a_WaveFileString = "stereo.wav");
 	public:
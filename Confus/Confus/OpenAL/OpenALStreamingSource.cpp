@@ -0,0 +1,200 @@
+#include <stdexcept>
+#include <string>
+
+#include "OpenALStreamingSource.h"
+
+namespace Confus {
+    const size_t OpenALStreamingSource::ChunkSize = 16384;
+    const size_t OpenALStreamingSource::MaxDecodedChunks = 4;
+
+    OpenALStreamingSource::OpenALStreamingSource(std::string a_WaveFileString)
+        : m_Streaming(false), m_EndOfFile(false), m_Looping(false) {
+        unsigned long frequency, format;
+        if(!SUCCEEDED(m_WaveLoader.OpenWaveFile(OpenAL::ALFWaddMediaPath(a_WaveFileString.c_str()), &m_WaveID)) ||
+            !SUCCEEDED(m_WaveLoader.GetWaveFrequency(m_WaveID, &frequency)) ||
+            !SUCCEEDED(m_WaveLoader.GetWaveALBufferFormat(m_WaveID, &alGetEnumValue, &format)))
+        {
+            throw std::invalid_argument("Path was invalid");
+        }
+        m_Frequency = static_cast<ALsizei>(frequency);
+        m_Format = static_cast<ALenum>(format);
+
+        alGenSources(1, &m_Source);
+        alGenBuffers(BufferCount, m_Buffers);
+        m_IdleBuffers.reserve(BufferCount);
+
+        //One chunk more than can be read ahead, for the chunk the background thread is reading into
+        m_FreeChunks.resize(MaxDecodedChunks + 1);
+        for(auto& chunk : m_FreeChunks) {
+            chunk.reserve(ChunkSize);
+        }
+    }
+
+    OpenALStreamingSource::~OpenALStreamingSource() {
+        stop();
+        alDeleteSources(1, &m_Source);
+        alDeleteBuffers(BufferCount, m_Buffers);
+        m_WaveLoader.DeleteWaveFile(m_WaveID);
+    }
+
+    void OpenALStreamingSource::setVolume(float a_Volume) {
+        alSourcef(m_Source, AL_GAIN, a_Volume);
+    }
+
+    void OpenALStreamingSource::enableLoop() {
+        m_Looping = true;
+    }
+
+    void OpenALStreamingSource::disableLoop() {
+        m_Looping = false;
+    }
+
+    void OpenALStreamingSource::play() {
+        if(m_Streaming) {
+            return;
+        }
+
+        m_WaveLoader.SetWaveDataOffset(m_WaveID, 0);
+        m_EndOfFile = false;
+
+        //The first buffers are filled right away so that the sound starts without waiting on the background thread
+        auto& chunk = m_FreeChunks.back();
+        ALsizei queuedBuffers = 0;
+        while(queuedBuffers < static_cast<ALsizei>(BufferCount) && !m_EndOfFile) {
+            readChunk(chunk);
+            if(chunk.empty()) {
+                break;
+            }
+            alBufferData(m_Buffers[queuedBuffers], m_Format, chunk.data(), static_cast<ALsizei>(chunk.size()), m_Frequency);
+            ++queuedBuffers;
+        }
+        if(queuedBuffers == 0) {
+            return;
+        }
+
+        alSourceQueueBuffers(m_Source, queuedBuffers, m_Buffers);
+        for(size_t i = static_cast<size_t>(queuedBuffers); i < BufferCount; ++i) {
+            m_IdleBuffers.push_back(m_Buffers[i]);
+        }
+        alSourcePlay(m_Source);
+
+        m_Streaming = true;
+        m_DecodeThread = std::thread(&OpenALStreamingSource::decode, this);
+    }
+
+    bool OpenALStreamingSource::isPlaying() const {
+        return m_Streaming;
+    }
+
+    void OpenALStreamingSource::stop() {
+        stopDecoding();
+        alSourceStop(m_Source);
+        //Detaching the buffer unqueues every buffer from the stopped source
+        alSourcei(m_Source, AL_BUFFER, 0);
+        m_IdleBuffers.clear();
+
+        while(!m_DecodedChunks.empty()) {
+            m_FreeChunks.push_back(std::move(m_DecodedChunks.front()));
+            m_DecodedChunks.pop_front();
+        }
+    }
+
+    void OpenALStreamingSource::update() {
+        if(!m_Streaming) {
+            return;
+        }
+
+        ALint processedBuffers = 0;
+        alGetSourcei(m_Source, AL_BUFFERS_PROCESSED, &processedBuffers);
+        while(processedBuffers-- > 0) {
+            ALuint buffer;
+            alSourceUnqueueBuffers(m_Source, 1, &buffer);
+            m_IdleBuffers.push_back(buffer);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_ChunkMutex);
+            while(!m_IdleBuffers.empty() && !m_DecodedChunks.empty()) {
+                auto& chunk = m_DecodedChunks.front();
+                if(!chunk.empty()) {
+                    ALuint buffer = m_IdleBuffers.back();
+                    m_IdleBuffers.pop_back();
+                    alBufferData(buffer, m_Format, chunk.data(), static_cast<ALsizei>(chunk.size()), m_Frequency);
+                    alSourceQueueBuffers(m_Source, 1, &buffer);
+                }
+                m_FreeChunks.push_back(std::move(chunk));
+                m_DecodedChunks.pop_front();
+            }
+        }
+        m_ChunkCondition.notify_one();
+
+        if(m_IdleBuffers.size() == BufferCount) {
+            if(m_EndOfFile) {
+                //Every buffer has played and nothing is left to read
+                stop();
+            }
+            return;
+        }
+
+        //Restart the source if it ran dry because the background thread could not keep up
+        ALint state;
+        alGetSourcei(m_Source, AL_SOURCE_STATE, &state);
+        if(state != AL_PLAYING) {
+            alSourcePlay(m_Source);
+        }
+    }
+
+    void OpenALStreamingSource::readChunk(std::vector<char>& a_Chunk) {
+        a_Chunk.resize(ChunkSize);
+        size_t bytesFilled = 0;
+        bool rewound = false;
+        while(bytesFilled < ChunkSize) {
+            unsigned long bytesRead = 0;
+            m_WaveLoader.ReadWaveData(m_WaveID, a_Chunk.data() + bytesFilled, static_cast<unsigned long>(ChunkSize - bytesFilled), &bytesRead);
+            bytesFilled += bytesRead;
+            if(bytesFilled < ChunkSize) {
+                //Stop at the end of the file, or if the file turns out to be empty after starting over
+                if(!m_Looping || (rewound && bytesRead == 0)) {
+                    m_EndOfFile = true;
+                    break;
+                }
+                m_WaveLoader.SetWaveDataOffset(m_WaveID, 0);
+                rewound = true;
+            }
+        }
+        a_Chunk.resize(bytesFilled);
+    }
+
+    void OpenALStreamingSource::decode() {
+        while(!m_EndOfFile) {
+            std::vector<char> chunk;
+            {
+                std::unique_lock<std::mutex> lock(m_ChunkMutex);
+                m_ChunkCondition.wait(lock, [this]() {
+                    return !m_Streaming || (m_DecodedChunks.size() < MaxDecodedChunks && !m_FreeChunks.empty());
+                });
+                if(!m_Streaming) {
+                    return;
+                }
+                chunk = std::move(m_FreeChunks.back());
+                m_FreeChunks.pop_back();
+            }
+
+            readChunk(chunk);
+
+            std::lock_guard<std::mutex> lock(m_ChunkMutex);
+            m_DecodedChunks.push_back(std::move(chunk));
+        }
+    }
+
+    void OpenALStreamingSource::stopDecoding() {
+        {
+            std::lock_guard<std::mutex> lock(m_ChunkMutex);
+            m_Streaming = false;
+        }
+        m_ChunkCondition.notify_all();
+        if(m_DecodeThread.joinable()) {
+            m_DecodeThread.join();
+        }
+    }
+}
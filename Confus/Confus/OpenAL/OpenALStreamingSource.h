@@ -0,0 +1,132 @@
+#pragma once
+#include <Irrlicht\irrlicht.h>
+
+#include "Framework/Framework.h"
+#include "Framework/CWaves.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Confus {
+	/// <summary>
+	/// OpenAL Streaming Sound Source class, for music, ambience and long loops.
+	/// Instead of loading the whole file, the wave data is read in small chunks on a background thread
+	/// and played through a few rotating OpenAL buffers, so the memory used stays the same for any file length.
+	/// update() has to be called every frame while the source plays.
+	/// </summary>
+	class OpenALStreamingSource {
+    private:
+        /// <summary>
+        /// The amount of OpenAL buffers that are queued on the source in turn
+        /// </summary>
+        static const size_t BufferCount = 4;
+        /// <summary>
+        /// The size in bytes of a single chunk of wave data
+        /// </summary>
+        static const size_t ChunkSize;
+        /// <summary>
+        /// The amount of chunks the background thread may read ahead
+        /// </summary>
+        static const size_t MaxDecodedChunks;
+
+        ALuint m_Source;
+        ALuint m_Buffers[BufferCount];
+        /// <summary>
+        /// The buffers that have finished playing and are waiting for the next chunk of wave data
+        /// </summary>
+        std::vector<ALuint> m_IdleBuffers;
+        /// <summary>
+        /// The wave loader used to read the file, owned by this source so it can be used from the background thread
+        /// </summary>
+        CWaves m_WaveLoader;
+        WAVEID m_WaveID;
+        ALenum m_Format;
+        ALsizei m_Frequency;
+
+        /// <summary>
+        /// The background thread that reads the wave data
+        /// </summary>
+        std::thread m_DecodeThread;
+        /// <summary>
+        /// Guards the decoded and free chunks
+        /// </summary>
+        std::mutex m_ChunkMutex;
+        /// <summary>
+        /// Wakes up the background thread when a chunk has been consumed or streaming stops
+        /// </summary>
+        std::condition_variable m_ChunkCondition;
+        /// <summary>
+        /// The chunks that have been read and are waiting to be queued on the source
+        /// </summary>
+        std::deque<std::vector<char>> m_DecodedChunks;
+        /// <summary>
+        /// Chunks that have been queued and can be reused, so no memory is allocated while streaming
+        /// </summary>
+        std::vector<std::vector<char>> m_FreeChunks;
+        /// <summary>
+        /// Whether the source is currently streaming
+        /// </summary>
+        std::atomic<bool> m_Streaming;
+        /// <summary>
+        /// Whether the end of a non-looping file has been read
+        /// </summary>
+        std::atomic<bool> m_EndOfFile;
+        /// <summary>
+        /// Whether the file starts over once its end has been read
+        /// </summary>
+        std::atomic<bool> m_Looping;
+	private:
+        /// <summary>
+        /// Reads the next chunk of wave data, starting over at the end of the file if looping
+        /// </summary>
+        /// <param name="a_Chunk">The chunk to fill, resized to the amount of bytes read.</param>
+        void readChunk(std::vector<char>& a_Chunk);
+        /// <summary>
+        /// Keeps reading chunks ahead until streaming stops or the end of the file is reached, run on the background thread
+        /// </summary>
+        void decode();
+        /// <summary>
+        /// Stops the background thread and waits for it to finish
+        /// </summary>
+        void stopDecoding();
+	public:
+		/// <summary>
+		/// Opens the .wav wave file for streaming and sets up the source + buffers.
+		/// </summary>
+		/// <param name="a_WaveFileString">The wave file, relative to the media folder.</param>
+		OpenALStreamingSource(std::string a_WaveFileString);
+		~OpenALStreamingSource();
+		/// <summary>
+		/// Set the volume of the source.
+		/// </summary>
+		void setVolume(float a_Volume);
+		/// <summary>
+		/// Enables Looping
+		/// </summary>
+		void enableLoop();
+		/// <summary>
+		/// Disables Looping
+		/// </summary>
+		void disableLoop();
+		/// <summary>
+		/// Start playing the sound from the beginning if it's not
+		/// </summary>
+		void play();
+		/// <summary>
+		/// Returns if the sound is currently playing
+		/// </summary>
+		bool isPlaying() const;
+		/// <summary>
+		/// Stop playing and rewind
+		/// </summary>
+		void stop();
+		/// <summary>
+		/// Requeues the buffers that have finished playing with the next chunks of wave data
+		/// </summary>
+		void update();
+	};
+}
@@ -3,17 +3,19 @@
 #include "Player.h"
 #include "EventManager.h"
 #include "Flag.h"
+#include "Entities\CharacterSystem.h"
+#include "Entities\RespawnSystem.h"
 
 namespace Confus
 {
     const irr::u32 Player::WeaponJointIndex = 14u;
     const unsigned Player::LightAttackDamage = 10u;
     const unsigned Player::HeavyAttackDamage = 30u;
-	Player::Player(irr::IrrlichtDevice* a_Device, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer)
+	Player::Player(irr::IrrlichtDevice* a_Device, Entities::EntityStore& a_EntityStore, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer, Audio::VoicePool& a_VoicePool)
 		: m_Weapon(a_Device->getSceneManager(), irr::core::vector3df(1.0f, 1.0f, 4.0f)),
 		irr::scene::ISceneNode(nullptr, a_Device->getSceneManager(), a_id),
-		TeamIdentifier(new ETeamIdentifier(a_TeamIdentifier)),
-		CarryingFlag(new EFlagEnum(EFlagEnum::None))
+		m_EntityStore(a_EntityStore),
+		m_Entity(a_EntityStore.create())
     {
         auto sceneManager = a_Device->getSceneManager();
         auto videoDriver = a_Device->getVideoDriver();
@@ -49,28 +51,40 @@ namespace Confus
         m_KeyMap[4].Action = irr::EKA_JUMP_UP;
         m_KeyMap[4].KeyCode = irr::KEY_SPACE;
 
+        //The camera only turns with the mouse, the character system moves it along with the character each frame
         if(a_MainPlayer) 
         {
-            CameraNode = sceneManager->addCameraSceneNodeFPS(0, 100.0f, 0.01f, 1, m_KeyMap, 5, true, 0.5f, false, true);
+            CameraNode = sceneManager->addCameraSceneNodeFPS(0, 100.0f, 0.0f, 1, m_KeyMap, 5, true, 0.0f, false, true);
             CameraNode->setFOV(70.f);
             CameraNode->setNearValue(0.1f);
         }
         else 
         {
-            CameraNode = sceneManager->addCameraSceneNodeFPS(0, 100.0f, 0.01f, 1, m_KeyMap, 5, true, 0.5f, false, false);
-        }
-        if(a_TeamIdentifier == ETeamIdentifier::TeamBlue)
-        {
-            CameraNode->setPosition(irr::core::vector3df(0.f, 10.f, 11.f));
-        }
-        else if(a_TeamIdentifier == ETeamIdentifier::TeamRed)
-        {
-            CameraNode->setPosition(irr::core::vector3df(0.f, 10.f, -85.f));
+            CameraNode = sceneManager->addCameraSceneNodeFPS(0, 100.0f, 0.0f, 1, m_KeyMap, 5, true, 0.0f, false, false);
         }
+        irr::scene::ITriangleSelector* selector = sceneManager->createTriangleSelector(PlayerNode);
+        CameraNode->setTriangleSelector(selector);
+        selector->drop();
+
+        //The spawn points are where the camera used to start, the eyes of the character
+        Entities::RespawnComponent respawnComponent;
+        ConfusShared::SpawnPoint spawnPoint = ConfusShared::getSpawnPoint(a_TeamIdentifier);
+        respawnComponent.SpawnPosition = ConfusShared::getSpawnPosition(a_TeamIdentifier, ConfusShared::CharacterSettings().EyeHeight);
+        Entities::CharacterComponent characterComponent;
+        characterComponent.Camera = CameraNode;
+        Entities::CharacterSystem::teleport(characterComponent, respawnComponent.SpawnPosition);
+        CameraNode->setPosition(irr::core::vector3df(spawnPoint.X, spawnPoint.Y, spawnPoint.Z));
+
+        m_EntityStore.Transforms.add(m_Entity, { PlayerNode });
+        m_EntityStore.Teams.add(m_Entity, { a_TeamIdentifier });
+        m_EntityStore.Healths.add(m_Entity, Health());
+        m_EntityStore.FlagCarriers.add(m_Entity, Entities::FlagCarrierComponent());
+        m_EntityStore.Respawns.add(m_Entity, respawnComponent);
+        m_EntityStore.Characters.add(m_Entity, characterComponent);
 	    PlayerNode->setParent(this);
 		setParent(CameraNode);
 
-        createAudioEmitter();
+        createAudioEmitter(a_VoicePool);
         startWalking();
 
         m_Weapon.setParent(PlayerNode->getJointNode(WeaponJointIndex));
@@ -78,10 +92,20 @@ namespace Confus
     }
 
 	Player::~Player() {
-		delete(CarryingFlag);
-		delete(TeamIdentifier);
+		delete(m_SoundEmitter);
+		m_EntityStore.destroy(m_Entity);
 	}
 
+    Entities::Entity Player::getEntity() const
+    {
+        return m_Entity;
+    }
+
+    Health& Player::getHealth()
+    {
+        return m_EntityStore.Healths.get(m_Entity);
+    }
+
     const irr::core::aabbox3d<irr::f32>& Player::getBoundingBox() const
     {
         return m_Mesh->getBoundingBox();
@@ -102,20 +126,34 @@ namespace Confus
         }
     }
 
+    ConfusShared::PlayerInput Player::sampleInput(const EventManager& a_EventManager, std::uint32_t a_Tick) const
+    {
+        ConfusShared::PlayerInput input;
+        input.Tick = a_Tick;
+        input.setHeld(ConfusShared::EInputButton::MoveForward, a_EventManager.IsKeyDown(m_KeyMap[0].KeyCode));
+        input.setHeld(ConfusShared::EInputButton::MoveBackward, a_EventManager.IsKeyDown(m_KeyMap[1].KeyCode));
+        input.setHeld(ConfusShared::EInputButton::MoveLeft, a_EventManager.IsKeyDown(m_KeyMap[2].KeyCode));
+        input.setHeld(ConfusShared::EInputButton::MoveRight, a_EventManager.IsKeyDown(m_KeyMap[3].KeyCode));
+        input.setHeld(ConfusShared::EInputButton::Jump, a_EventManager.IsKeyDown(m_KeyMap[4].KeyCode));
+        input.setHeld(ConfusShared::EInputButton::LightAttack, a_EventManager.IsLeftMouseDown());
+        input.setHeld(ConfusShared::EInputButton::HeavyAttack, a_EventManager.IsRightMouseDown());
+
+        //The camera pitches down for a positive rotation around X and keeps it in [0, 360), the input pitches up from -90 to 90
+        irr::core::vector3df rotation = CameraNode->getRotation();
+        float pitch = rotation.X > 180.0f ? rotation.X - 360.0f : rotation.X;
+        input.Yaw = rotation.Y;
+        input.Pitch = -pitch;
+        return input;
+    }
+
     void Player::render()
     {
 
     }
 
-    void Player::setLevelCollider(irr::scene::ISceneManager* a_SceneManager,
-        irr::scene::ITriangleSelector* a_Level)
+    void Player::setInput(const ConfusShared::PlayerInput& a_Input)
     {
-        CameraNode->addAnimator(a_SceneManager->createCollisionResponseAnimator(a_Level, PlayerNode, {0.1f, 0.2f, 0.1f}, { 0, -1, 0 }, {0, 1.5f, 0}));
-        
-        irr::scene::ITriangleSelector* selector = nullptr;
-        selector = a_SceneManager->createTriangleSelector(PlayerNode);
-        CameraNode->setTriangleSelector(selector);
-        selector->drop();
+        m_EntityStore.Characters.get(m_Entity).Input = a_Input;
     }
 
     void Player::startWalking() const
@@ -168,56 +206,20 @@ namespace Confus
 
     void Player::update()
     {
-        m_SoundEmitter->updatePosition();
-
         int frameNumber = static_cast<int>(PlayerNode->getFrameNr());
         if(frameNumber == 0 || frameNumber == 6)
         {
             m_SoundEmitter->playFootStepSound();
         }
-
-        if(PlayerHealth.getHealth() <= 0) {
-            respawn();
-			if (FlagPointer != nullptr) {
-				FlagPointer->drop(this);
-			}
-        }
-
-        if(CameraNode->getPosition().Y <= -10) {
-            respawn();
-			if (FlagPointer != nullptr) {
-				FlagPointer->returnToStartPosition();
-			}
-        }
     }
 
     void Player::respawn()
     {
-        irr::scene::ISceneNodeAnimatorCollisionResponse * animator = 0;
-
-        irr::core::list<irr::scene::ISceneNodeAnimator*>::ConstIterator iterator = CameraNode->getAnimators().begin();
-
-        for(; iterator != CameraNode->getAnimators().end(); ++iterator)
-        {
-            animator = (irr::scene::ISceneNodeAnimatorCollisionResponse*)(*iterator);
-            if(animator->getType() == irr::scene::ESNAT_COLLISION_RESPONSE)
-                break;
-        }
-
-        if(*TeamIdentifier == ETeamIdentifier::TeamBlue)
-        {
-             CameraNode->setPosition(irr::core::vector3df(0.f, 10.f, 11.f));
-             animator->setTargetNode(CameraNode);
-        }
-        else if(*TeamIdentifier == ETeamIdentifier::TeamRed)
-        {
-            CameraNode->setPosition(irr::core::vector3df(0.f, 10.f, -85.f));
-            animator->setTargetNode(CameraNode);
-        }
+        Entities::RespawnSystem::respawn(m_EntityStore.Respawns.get(m_Entity), m_EntityStore.Characters.get(m_Entity));
     }
 
-    void Player::createAudioEmitter()
+    void Player::createAudioEmitter(Audio::VoicePool& a_VoicePool)
     {
-        m_SoundEmitter = new Audio::PlayerAudioEmitter(PlayerNode);
+        m_SoundEmitter = new Audio::PlayerAudioEmitter(PlayerNode, a_VoicePool);
     }
 }
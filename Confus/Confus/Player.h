@@ -1,8 +1,10 @@
 #pragma once
 #include <irrlicht/irrlicht.h>
 
+#include "ConfusShared/PlayerInput.h"
+
 #include "Audio\PlayerAudioEmitter.h"
-#include "Health.h"
+#include "Entities\EntityStore.h"
 #include "Weapon.h"
 
 namespace Confus 
@@ -11,12 +13,10 @@ namespace Confus
 	namespace Audio 
     {
 		class PlayerAudioEmitter;
+		class VoicePool;
 	}
 
-    enum class EFlagEnum;
-	enum class ETeamIdentifier;
     class EventManager;
-    class Flag;
 
     class Player : irr::scene::IAnimationEndCallBack, public irr::scene::ISceneNode
     {   
@@ -24,14 +24,14 @@ namespace Confus
 		/// <summary> The IAnimatedMeshSceneNode for the player </summary>
         irr::scene::IAnimatedMeshSceneNode* PlayerNode;
         irr::scene::ICameraSceneNode* CameraNode = nullptr;
-		EFlagEnum* CarryingFlag;
-		ETeamIdentifier* TeamIdentifier;    
-        Flag* FlagPointer = nullptr;
-		Health PlayerHealth;
 	private:
+        /// <summary> The store holding the team, health, flag and respawn state of the player </summary>
+        Entities::EntityStore& m_EntityStore;
+        /// <summary> The player's entity </summary>
+        Entities::Entity m_Entity;
         Audio::PlayerAudioEmitter* m_SoundEmitter;
 
-        void createAudioEmitter();
+        void createAudioEmitter(Audio::VoicePool& a_VoicePool);
         /// <summary> The weapon bone index of the animation for the weapon </summary>
         static const irr::u32 WeaponJointIndex;
         static const unsigned LightAttackDamage;
@@ -43,19 +43,29 @@ namespace Confus
         /// <summary> The player's mesh </summary>
         irr::scene::IAnimatedMesh* m_Mesh;
     public:
-        Player(irr::IrrlichtDevice* a_Device, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer);
+        Player(irr::IrrlichtDevice* a_Device, Entities::EntityStore& a_EntityStore, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer, Audio::VoicePool& a_VoicePool);
 		~Player();
         void fixedUpdate();
         void update();
         ///<summary> Respawns the player to their base, public so round resets etc. can call this </summary>
         void respawn();
+        /// <summary> Gets the player's entity, to look up its components with </summary>
+        Entities::Entity getEntity() const;
+        /// <summary> Gets the player's health, stored in the entity store </summary>
+        Health& getHealth();
         virtual void render();
         /// <summary> Returns the bounding box of the player's mesh </summary>
         virtual const irr::core::aabbox3d<irr::f32> & getBoundingBox() const;
         /// <summary> Handles the input based actions </summary>
         /// <param name="a_EventManager">The current event manager</param>
         void handleInput(EventManager& a_EventManager);
-        void setLevelCollider(irr::scene::ISceneManager* a_SceneManager, irr::scene::ITriangleSelector* a_Level);
+        /// <summary> Samples what the player does during a tick, which only the main player can do as it needs the camera </summary>
+        /// <param name="a_EventManager">The current event manager</param>
+        /// <param name="a_Tick">The tick the input is sampled in</param>
+        ConfusShared::PlayerInput sampleInput(const EventManager& a_EventManager, std::uint32_t a_Tick) const;
+        /// <summary> Sets the input the player's character moves by in the next fixed update </summary>
+        /// <param name="a_Input">The input, quantized the way it is sent so the server moves the character the same</param>
+        void setInput(const ConfusShared::PlayerInput& a_Input);
     private:
         /// <summary> Starts the walking animation, which is the default animation </summary>
         void startWalking() const;
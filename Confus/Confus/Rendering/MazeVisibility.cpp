@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cmath>
+
+#include "MazeVisibility.h"
+
+namespace Confus
+{
+    namespace Rendering
+    {
+        MazeVisibility::MazeVisibility(Maze& a_Maze, const MazeLineOfSight& a_LineOfSight)
+            : m_Maze(a_Maze), m_LineOfSight(a_LineOfSight)
+        {
+            m_Width = m_LineOfSight.getWidth();
+            m_Height = m_LineOfSight.getHeight();
+
+            size_t tileCount = static_cast<size_t>(m_Width * m_Height);
+            m_VisibleStamps.assign(tileCount, 0u);
+            //Every wall starts out shown, so the first update hides all walls that are not visible
+            m_WallsShown.assign(tileCount, 1u);
+            m_PreviousVisibleTiles.reserve(tileCount);
+            m_VisibleTiles.reserve(tileCount);
+            for(irr::u32 tile = 0; tile < tileCount; ++tile)
+            {
+                m_PreviousVisibleTiles.push_back(tile);
+            }
+        }
+
+        void MazeVisibility::addDynamicNode(irr::scene::ISceneNode* a_Node)
+        {
+            m_DynamicNodes.push_back(a_Node);
+        }
+
+        void MazeVisibility::update(const irr::core::vector3df& a_EyePosition)
+        {
+            //The field of view is cast from the four tiles whose centers surround the eye, as it may be anywhere within its tile
+            irr::core::vector2df gridPosition = m_Maze.getGridPosition(a_EyePosition);
+            irr::s32 originX = static_cast<irr::s32>(std::floor(gridPosition.X - 0.5f));
+            irr::s32 originY = static_cast<irr::s32>(std::floor(gridPosition.Y - 0.5f));
+            bool aboveWalls = a_EyePosition.Y > m_LineOfSight.getWallTop();
+
+            if(m_Dirty || m_LineOfSight.getRevision() != m_LastRevision || originX != m_LastOriginX || originY != m_LastOriginY || aboveWalls != m_LastAboveWalls)
+            {
+                m_PreviousVisibleTiles.swap(m_VisibleTiles);
+                m_VisibleTiles.clear();
+                if(++m_CurrentStamp == 0)
+                {
+                    std::fill(m_VisibleStamps.begin(), m_VisibleStamps.end(), 0u);
+                    m_CurrentStamp = 1;
+                }
+
+                if(aboveWalls)
+                {
+                    markAll(originX, originY);
+                }
+                else
+                {
+                    for(irr::s32 y = 0; y < 2; ++y)
+                    {
+                        for(irr::s32 x = 0; x < 2; ++x)
+                        {
+                            castFieldOfView(originX + x, originY + y);
+                        }
+                    }
+                }
+                applyWallVisibility();
+
+                m_LastOriginX = originX;
+                m_LastOriginY = originY;
+                m_LastAboveWalls = aboveWalls;
+                m_LastRevision = m_LineOfSight.getRevision();
+                m_Dirty = false;
+            }
+
+            m_NodeQueries.resize(m_DynamicNodes.size());
+            for(size_t i = 0; i < m_DynamicNodes.size(); ++i)
+            {
+                m_NodeQueries[i].From = a_EyePosition;
+                m_NodeQueries[i].To = m_DynamicNodes[i]->getAbsolutePosition();
+            }
+            m_LineOfSight.areVisible(m_NodeQueries, m_NodeResults);
+
+            irr::f32 drawDistanceSquared = NodeDrawDistance * NodeDrawDistance;
+            for(size_t i = 0; i < m_DynamicNodes.size(); ++i)
+            {
+                bool inRange = m_NodeQueries[i].To.getDistanceFromSQ(a_EyePosition) <= drawDistanceSquared;
+                m_DynamicNodes[i]->setVisible(inRange && m_NodeResults[i] != 0u);
+            }
+        }
+
+        bool MazeVisibility::isVisible(const irr::core::vector3df& a_Position) const
+        {
+            irr::core::vector2df gridPosition = m_Maze.getGridPosition(a_Position);
+            irr::s32 x = static_cast<irr::s32>(std::floor(gridPosition.X));
+            irr::s32 y = static_cast<irr::s32>(std::floor(gridPosition.Y));
+            if(x < 0 || y < 0 || x >= m_Width || y >= m_Height)
+            {
+                return true;
+            }
+            return m_VisibleStamps[y * m_Width + x] == m_CurrentStamp;
+        }
+
+        size_t MazeVisibility::getVisibleTileCount() const
+        {
+            return m_VisibleTiles.size();
+        }
+
+        void MazeVisibility::castFieldOfView(irr::s32 a_OriginX, irr::s32 a_OriginY)
+        {
+            //The transformations of the first octant onto each of the eight octants around the origin
+            static const irr::s32 Octants[4][8] = {
+                { 1, 0, 0, -1, -1, 0, 0, 1 },
+                { 0, 1, -1, 0, 0, -1, 1, 0 },
+                { 0, 1, 1, 0, 0, -1, -1, 0 },
+                { 1, 0, 0, 1, -1, 0, 0, -1 }
+            };
+
+            markVisible(a_OriginX, a_OriginY);
+            for(irr::u32 octant = 0; octant < 8; ++octant)
+            {
+                castOctant(a_OriginX, a_OriginY, 1, 1.0f, 0.0f,
+                    Octants[0][octant], Octants[1][octant], Octants[2][octant], Octants[3][octant]);
+            }
+        }
+
+        void MazeVisibility::castOctant(irr::s32 a_OriginX, irr::s32 a_OriginY, irr::s32 a_Row, irr::f32 a_StartSlope, irr::f32 a_EndSlope,
+            irr::s32 a_XX, irr::s32 a_XY, irr::s32 a_YX, irr::s32 a_YY)
+        {
+            if(a_StartSlope < a_EndSlope)
+            {
+                return;
+            }
+
+            irr::s32 radius = static_cast<irr::s32>(WallDrawDistance);
+            irr::f32 nextStartSlope = 0.0f;
+            for(irr::s32 row = a_Row; row <= radius; ++row)
+            {
+                bool blocked = false;
+                irr::s32 deltaY = -row;
+                for(irr::s32 deltaX = -row; deltaX <= 0; ++deltaX)
+                {
+                    irr::s32 x = a_OriginX + deltaX * a_XX + deltaY * a_XY;
+                    irr::s32 y = a_OriginY + deltaX * a_YX + deltaY * a_YY;
+                    //The slopes through the corners of the tile, as seen from the center of the origin
+                    irr::f32 leftSlope = (deltaX - 0.5f) / (deltaY + 0.5f);
+                    irr::f32 rightSlope = (deltaX + 0.5f) / (deltaY - 0.5f);
+                    if(a_StartSlope < rightSlope)
+                    {
+                        continue;
+                    }
+                    if(a_EndSlope > leftSlope)
+                    {
+                        break;
+                    }
+
+                    if(deltaX * deltaX + deltaY * deltaY <= radius * radius)
+                    {
+                        markVisible(x, y);
+                    }
+
+                    bool opaque = m_LineOfSight.isOpaque(x, y);
+                    if(blocked)
+                    {
+                        if(opaque)
+                        {
+                            nextStartSlope = rightSlope;
+                        }
+                        else
+                        {
+                            blocked = false;
+                            a_StartSlope = nextStartSlope;
+                        }
+                    }
+                    else if(opaque && row < radius)
+                    {
+                        //The light is split around this tile, so the part before it is continued in a new scan
+                        blocked = true;
+                        castOctant(a_OriginX, a_OriginY, row + 1, a_StartSlope, leftSlope, a_XX, a_XY, a_YX, a_YY);
+                        nextStartSlope = rightSlope;
+                    }
+                }
+                if(blocked)
+                {
+                    break;
+                }
+            }
+        }
+
+        void MazeVisibility::markAll(irr::s32 a_OriginX, irr::s32 a_OriginY)
+        {
+            irr::s32 radius = static_cast<irr::s32>(WallDrawDistance);
+            for(irr::s32 y = std::max(a_OriginY - radius, 0); y < std::min(a_OriginY + radius + 2, m_Height); ++y)
+            {
+                for(irr::s32 x = std::max(a_OriginX - radius, 0); x < std::min(a_OriginX + radius + 2, m_Width); ++x)
+                {
+                    markVisible(x, y);
+                }
+            }
+        }
+
+        void MazeVisibility::markVisible(irr::s32 a_X, irr::s32 a_Y)
+        {
+            if(a_X < 0 || a_Y < 0 || a_X >= m_Width || a_Y >= m_Height)
+            {
+                return;
+            }
+            irr::u32 tile = static_cast<irr::u32>(a_Y * m_Width + a_X);
+            if(m_VisibleStamps[tile] != m_CurrentStamp)
+            {
+                m_VisibleStamps[tile] = m_CurrentStamp;
+                m_VisibleTiles.push_back(tile);
+            }
+        }
+
+        void MazeVisibility::applyWallVisibility()
+        {
+            for(irr::u32 tile : m_VisibleTiles)
+            {
+                if(!m_WallsShown[tile])
+                {
+                    MoveableWall* wall = getWall(tile % m_Width, tile / m_Width);
+                    if(wall != nullptr)
+                    {
+                        wall->setCulled(false);
+                    }
+                    m_WallsShown[tile] = 1u;
+                }
+            }
+            for(irr::u32 tile : m_PreviousVisibleTiles)
+            {
+                if(m_VisibleStamps[tile] != m_CurrentStamp && m_WallsShown[tile])
+                {
+                    MoveableWall* wall = getWall(tile % m_Width, tile / m_Width);
+                    if(wall != nullptr)
+                    {
+                        wall->setCulled(true);
+                    }
+                    m_WallsShown[tile] = 0u;
+                }
+            }
+        }
+
+        MoveableWall* MazeVisibility::getWall(irr::s32 a_X, irr::s32 a_Y) const
+        {
+            return m_Maze.MazeTiles[a_X][a_Y]->getWall();
+        }
+    }
+}
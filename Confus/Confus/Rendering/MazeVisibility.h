@@ -0,0 +1,139 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <vector>
+
+#include "../MazeLineOfSight.h"
+
+namespace Confus
+{
+    namespace Rendering
+    {
+        /// <summary>
+        /// Class MazeVisibility hides the maze walls and dynamic nodes the camera cannot see before the scene is drawn.
+        /// The raised tiles of the maze are used as occluders: a field of view is cast over the tile grid from the camera's cell,
+        /// so only the walls with a line of sight to the camera, and within the draw distance, are submitted to the driver.
+        /// Dynamic nodes are tested with a single batch of line of sight queries.
+        /// </summary>
+        /// <remarks>
+        /// The wall mesh is a single box and the player mesh ships with a single level of detail,
+        /// so the level of detail of both is chosen between drawing them in full and not at all.
+        /// </remarks>
+        class MazeVisibility
+        {
+        public:
+            /// <summary>
+            /// The distance in tiles beyond which walls are not drawn
+            /// </summary>
+            irr::u32 WallDrawDistance = 64;
+
+            /// <summary>
+            /// The distance in world units beyond which dynamic nodes are not drawn
+            /// </summary>
+            irr::f32 NodeDrawDistance = 64.0f;
+        private:
+            Maze& m_Maze;
+            /// <summary>
+            /// The occluders of the maze, shared with the other systems that need a line of sight
+            /// </summary>
+            const MazeLineOfSight& m_LineOfSight;
+            /// <summary>
+            /// The size of the tile grid, cached at construction
+            /// </summary>
+            irr::s32 m_Width;
+            irr::s32 m_Height;
+            /// <summary>
+            /// The update in which each tile was last found to be visible
+            /// </summary>
+            std::vector<irr::u32> m_VisibleStamps;
+            irr::u32 m_CurrentStamp = 0;
+            /// <summary>
+            /// Whether the wall on each tile is currently shown, to only touch the walls whose visibility changed
+            /// </summary>
+            std::vector<irr::u8> m_WallsShown;
+            /// <summary>
+            /// The tiles found visible in the current and the previous update
+            /// </summary>
+            std::vector<irr::u32> m_VisibleTiles;
+            std::vector<irr::u32> m_PreviousVisibleTiles;
+            /// <summary>
+            /// The nodes that are culled by their position, such as the other players
+            /// </summary>
+            std::vector<irr::scene::ISceneNode*> m_DynamicNodes;
+            /// <summary>
+            /// The line of sight queries of the dynamic nodes and their results, kept to avoid allocating every frame
+            /// </summary>
+            std::vector<LineOfSightQuery> m_NodeQueries;
+            std::vector<irr::u8> m_NodeResults;
+            /// <summary>
+            /// The inputs of the last field of view, which is only cast again when one of them changes
+            /// </summary>
+            irr::s32 m_LastOriginX = 0x7FFFFFFF;
+            irr::s32 m_LastOriginY = 0x7FFFFFFF;
+            bool m_LastAboveWalls = false;
+            irr::u32 m_LastRevision = 0;
+            bool m_Dirty = true;
+        public:
+            /// <summary>
+            /// Initializes a new instance of the <see cref="MazeVisibility"/> class.
+            /// </summary>
+            /// <param name="a_Maze">The rendered maze whose walls are culled.</param>
+            /// <param name="a_LineOfSight">The occluders of the maze, which are updated by the owner.</param>
+            MazeVisibility(Maze& a_Maze, const MazeLineOfSight& a_LineOfSight);
+
+            /// <summary>
+            /// Adds a node that is hidden when its position cannot be seen from the camera.
+            /// </summary>
+            /// <param name="a_Node">The node to cull, which has to outlive the visibility.</param>
+            void addDynamicNode(irr::scene::ISceneNode* a_Node);
+
+            /// <summary>
+            /// Culls the walls and dynamic nodes for the current camera position, to be called before the scene is drawn.
+            /// </summary>
+            /// <param name="a_EyePosition">The world position of the camera.</param>
+            void update(const irr::core::vector3df& a_EyePosition);
+
+            /// <summary>
+            /// Gets whether a world position was visible from the camera in the last update.
+            /// Positions outside of the maze are always visible, those in the maze beyond the wall draw distance never are.
+            /// </summary>
+            bool isVisible(const irr::core::vector3df& a_Position) const;
+
+            /// <summary>
+            /// Gets the amount of tiles whose wall is drawn after the last update
+            /// </summary>
+            size_t getVisibleTileCount() const;
+        private:
+            /// <summary>
+            /// Marks the tiles in the field of view of an origin tile, which may lie outside of the maze.
+            /// </summary>
+            void castFieldOfView(irr::s32 a_OriginX, irr::s32 a_OriginY);
+
+            /// <summary>
+            /// Marks the tiles in a single octant of the field of view, using recursive shadowcasting.
+            /// Rows are scanned outwards from the origin, and every opaque tile narrows the slopes the next rows are lit between.
+            /// </summary>
+            void castOctant(irr::s32 a_OriginX, irr::s32 a_OriginY, irr::s32 a_Row, irr::f32 a_StartSlope, irr::f32 a_EndSlope,
+                irr::s32 a_XX, irr::s32 a_XY, irr::s32 a_YX, irr::s32 a_YY);
+
+            /// <summary>
+            /// Marks every tile within the draw distance, for when the camera looks over the walls.
+            /// </summary>
+            void markAll(irr::s32 a_OriginX, irr::s32 a_OriginY);
+
+            /// <summary>
+            /// Marks a tile as visible, ignoring tiles outside of the maze.
+            /// </summary>
+            void markVisible(irr::s32 a_X, irr::s32 a_Y);
+
+            /// <summary>
+            /// Shows the walls that became visible and hides those that no longer are.
+            /// </summary>
+            void applyWallVisibility();
+
+            /// <summary>
+            /// Gets the wall on a tile, or nullptr if the tile has none.
+            /// </summary>
+            MoveableWall* getWall(irr::s32 a_X, irr::s32 a_Y) const;
+        };
+    }
+}
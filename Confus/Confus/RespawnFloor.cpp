@@ -2,17 +2,20 @@
 
 namespace Confus
 {
-    RespawnFloor::RespawnFloor(irr::IrrlichtDevice* a_Device)
+    RespawnFloor::RespawnFloor(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, const SolidityEvents& a_SolidityEvents)
+        : m_AssetRegistry(a_AssetRegistry),
+        m_SolidityEvents(a_SolidityEvents)
     {
         auto sceneManager = a_Device->getSceneManager();
-        auto videoDriver = a_Device->getVideoDriver();
 
-        m_RegularTexture = videoDriver->getTexture("Media/Textures/SquareWall.jpg");
-        m_TransparentTexture = videoDriver->getTexture("Media/Textures/SquareWallTransparent.png");
+        //The floors use the same textures as the maze walls, which the registry only loads once
+        m_RegularTexture = m_AssetRegistry.acquireTexture("Media/Textures/SquareWall.jpg");
+        m_TransparentTexture = m_AssetRegistry.acquireTexture("Media/Textures/SquareWallTransparent.png");
+        m_Mesh = m_AssetRegistry.acquireMesh("Media/BaseGlassFloor.irrmesh");
 
-        m_FloorNode = sceneManager->addAnimatedMeshSceneNode(sceneManager->getMesh("Media/BaseGlassFloor.irrmesh"), nullptr);
+        m_FloorNode = sceneManager->addAnimatedMeshSceneNode(m_AssetRegistry.get(m_Mesh), nullptr);
         m_FloorNode->setMaterialType(irr::video::E_MATERIAL_TYPE::EMT_SOLID);
-        m_FloorNode->setMaterialTexture(0, m_RegularTexture);
+        m_FloorNode->setMaterialTexture(0, m_AssetRegistry.get(m_RegularTexture));
         m_FloorNode->setScale(irr::core::vector3df(5.5f, 0.1f, 10.f));
         m_TriangleSelector = sceneManager->createTriangleSelector(m_FloorNode);
         m_FloorNode->setTriangleSelector(m_TriangleSelector);
@@ -21,6 +24,11 @@ namespace Confus
 
     RespawnFloor::~RespawnFloor()
     {
+        m_FloorNode->remove();
+        m_TriangleSelector->drop();
+        m_AssetRegistry.release(m_Mesh);
+        m_AssetRegistry.release(m_RegularTexture);
+        m_AssetRegistry.release(m_TransparentTexture);
     }
 
     void RespawnFloor::setPosition(irr::core::vector3df a_NewPosition)
@@ -30,16 +38,29 @@ namespace Confus
 
     void RespawnFloor::enableCollision()
     {
+        //The floor is only switched when its state actually changes, no matter how often this is called
+        if(m_Solid)
+        {
+            return;
+        }
+        m_Solid = true;
         m_FloorNode->setMaterialType(irr::video::E_MATERIAL_TYPE::EMT_SOLID);
         m_FloorNode->setTriangleSelector(m_TriangleSelector);
-        m_FloorNode->setMaterialTexture(0, m_RegularTexture);
+        m_FloorNode->setMaterialTexture(0, m_AssetRegistry.get(m_RegularTexture));
+        m_SolidityEvents.publish({ m_TriangleSelector, ESolidityChange::BecameSolid });
     }
 
     void RespawnFloor::disableCollision()
     {
+        if(!m_Solid)
+        {
+            return;
+        }
+        m_Solid = false;
         m_FloorNode->setMaterialType(irr::video::E_MATERIAL_TYPE::EMT_TRANSPARENT_ALPHA_CHANNEL);
         m_FloorNode->setTriangleSelector(nullptr);
-        m_FloorNode->setMaterialTexture(0, m_TransparentTexture);
+        m_FloorNode->setMaterialTexture(0, m_AssetRegistry.get(m_TransparentTexture));
+        m_SolidityEvents.publish({ m_TriangleSelector, ESolidityChange::BecamePassable });
     }
 }
 
@@ -2,18 +2,27 @@
 
 #include <irrlicht/irrlicht.h>
 
+#include "Assets\AssetRegistry.h"
+#include "SolidityEvents.h"
+
 namespace Confus 
 {
     class RespawnFloor
     {
     private:
+        Assets::AssetRegistry& m_AssetRegistry;
+        const SolidityEvents& m_SolidityEvents;
         irr::scene::IAnimatedMeshSceneNode* m_FloorNode;
         irr::scene::ITriangleSelector* m_TriangleSelector;
-        irr::video::ITexture* m_RegularTexture;
-        irr::video::ITexture* m_TransparentTexture;
+        Assets::MeshHandle m_Mesh;
+        Assets::TextureHandle m_RegularTexture;
+        Assets::TextureHandle m_TransparentTexture;
+        bool m_Solid = true;
     public:
-        RespawnFloor(irr::IrrlichtDevice* a_Device);
+        RespawnFloor(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, const SolidityEvents& a_SolidityEvents);
         ~RespawnFloor();
+        RespawnFloor(const RespawnFloor&) = delete;
+        RespawnFloor& operator=(const RespawnFloor&) = delete;
         void setPosition(irr::core::vector3df a_NewPosition);
         void enableCollision();
         void disableCollision();
@@ -1,13 +1,11 @@
-#include <IrrAssimp/IrrAssimp.h>
-
 #include "StaticWall.h"
 
 namespace Confus
 {
-    StaticWall::StaticWall(irr::IrrlichtDevice* a_Device, irr::core::vector3d<float> a_Position, irr::core::vector3d<float> a_Rotation, irr::scene::ICameraSceneNode* a_Camera)
+    StaticWall::StaticWall(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, irr::core::vector3d<float> a_Position, irr::core::vector3d<float> a_Rotation, irr::scene::ICameraSceneNode* a_Camera)
+        : m_AssetRegistry(a_AssetRegistry)
     {
         m_SceneManager = a_Device->getSceneManager();
-        m_VideoDriver = a_Device->getVideoDriver();
         m_Camera = a_Camera;
 
         loadMesh();
@@ -19,26 +17,28 @@ namespace Confus
 
     StaticWall::~StaticWall()
     {
-        m_MeshNode->drop();
-        m_SceneNode->drop();
+        //Neither the node nor the mesh were grabbed by the wall, so they are removed and released instead of dropped
+        m_SceneNode->remove();
+        m_AssetRegistry.release(m_Mesh);
+        m_AssetRegistry.release(m_Texture);
     }
 
     void StaticWall::loadMesh()
     {
-        IrrAssimp irrAssimp(m_SceneManager);
-        m_MeshNode = irrAssimp.getMesh("Media/Models/Wall.3DS");
+        m_Mesh = m_AssetRegistry.acquireMesh("Media/Models/Wall.3DS");
     }
 
     void StaticWall::setSceneNode(irr::core::vector3d<float> a_Position, irr::core::vector3d<float> a_Rotation)
     {
-        m_SceneNode = m_SceneManager->addOctreeSceneNode(m_MeshNode->getMesh(0), 0, -1, 1024);
+        m_SceneNode = m_SceneManager->addOctreeSceneNode(m_AssetRegistry.get(m_Mesh)->getMesh(0), 0, -1, 1024);
         m_SceneNode->setPosition(a_Position);
         m_SceneNode->setRotation(a_Rotation);
     }
 
     void StaticWall::setTexture()
     {
-        m_SceneNode->setMaterialTexture(0, m_VideoDriver->getTexture("Media/Textures/Wall_texture.png"));
+        m_Texture = m_AssetRegistry.acquireTexture("Media/Textures/Wall_texture.png");
+        m_SceneNode->setMaterialTexture(0, m_AssetRegistry.get(m_Texture));
         // Enable dynamic lighting.
         m_SceneNode->setMaterialFlag(irr::video::EMF_LIGHTING, true);
     }
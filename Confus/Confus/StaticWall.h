@@ -1,6 +1,8 @@
 #pragma once
 #include <Irrlicht/irrlicht.h>
 
+#include "Assets\AssetRegistry.h"
+
 namespace Confus 
 {
     /// <summary>
@@ -9,31 +11,38 @@ namespace Confus
     class StaticWall
     {
         irr::scene::ISceneManager* m_SceneManager;
-        irr::scene::IAnimatedMesh* m_MeshNode;
+        /// <summary>
+        /// The registry the mesh and texture are acquired from, shared with every other wall
+        /// </summary>
+        Assets::AssetRegistry& m_AssetRegistry;
+        Assets::MeshHandle m_Mesh;
+        Assets::TextureHandle m_Texture;
         irr::scene::ISceneNode* m_SceneNode;
         irr::scene::ICameraSceneNode* m_Camera;
-        irr::video::IVideoDriver* m_VideoDriver;
 
     public:
         /// <summary>
         /// Initializes a new instance of the <see cref="StaticWall"/> class.
         /// </summary>
         /// <param name="a_Device">The active irrlichtdevice in this context.</param>
+        /// <param name="a_AssetRegistry">The registry to acquire the mesh and texture from.</param>
         /// <param name="a_Position">The position of the wall in the world.</param>
         /// <param name="a_Rotation">The rotation of the wall in the world.</param>
         /// <param name="a_Camera">The player camera to create an automatic collision with.</param>
-        StaticWall(irr::IrrlichtDevice* a_Device, irr::core::vector3d<float> a_Position, irr::core::vector3d<float> a_Rotation, irr::scene::ICameraSceneNode* a_Camera);
+        StaticWall(irr::IrrlichtDevice* a_Device, Assets::AssetRegistry& a_AssetRegistry, irr::core::vector3d<float> a_Position, irr::core::vector3d<float> a_Rotation, irr::scene::ICameraSceneNode* a_Camera);
         /// <summary>
-        /// Finalizes an instance of the <see cref="StaticWall"/> class.
+        /// Finalizes an instance of the <see cref="StaticWall"/> class, removes the scene node and releases the assets.
         /// </summary>
         ~StaticWall();
+        StaticWall(const StaticWall&) = delete;
+        StaticWall& operator=(const StaticWall&) = delete;
 
         /// <summary>
-        /// Loads the mesh.
+        /// Acquires the mesh.
         /// </summary>
         void loadMesh();
         /// <summary>
-        /// Assigns the texture to the scene node.
+        /// Acquires the texture and assigns it to the scene node.
         /// </summary>
         void setTexture();
         /// <summary>
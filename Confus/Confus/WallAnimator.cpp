@@ -0,0 +1,168 @@
+#include <xmmintrin.h>
+#include <algorithm>
+#include <cmath>
+
+#include "WallAnimator.h"
+#include "MoveableWall.h"
+
+namespace Confus
+{
+    const irr::u32 WallAnimator::InactiveSlot = 0xFFFFFFFF;
+
+    WallAnimator::WallAnimator(const SolidityEvents& a_SolidityEvents)
+        : m_SolidityEvents(a_SolidityEvents)
+    {
+    }
+
+    irr::u32 WallAnimator::addWall(MoveableWall* a_Wall)
+    {
+        irr::u32 wallId;
+        if(m_FreeIds.empty())
+        {
+            wallId = static_cast<irr::u32>(m_Walls.size());
+            m_Walls.push_back(a_Wall);
+            m_Slots.push_back(InactiveSlot);
+        }
+        else
+        {
+            wallId = m_FreeIds.back();
+            m_FreeIds.pop_back();
+            m_Walls[wallId] = a_Wall;
+            m_Slots[wallId] = InactiveSlot;
+        }
+        return wallId;
+    }
+
+    void WallAnimator::removeWall(irr::u32 a_WallId)
+    {
+        if(m_Slots[a_WallId] != InactiveSlot)
+        {
+            removeSlot(m_Slots[a_WallId]);
+        }
+        m_Walls[a_WallId] = nullptr;
+        m_FreeIds.push_back(a_WallId);
+    }
+
+    void WallAnimator::startTransition(irr::u32 a_WallId, irr::f32 a_Height, irr::f32 a_TargetHeight, irr::f32 a_Speed, irr::f32 a_SolidHeight, bool a_Solid)
+    {
+        irr::u32 slot = m_Slots[a_WallId];
+        if(slot == InactiveSlot)
+        {
+            slot = static_cast<irr::u32>(m_SlotWalls.size());
+            m_Slots[a_WallId] = slot;
+            m_SlotWalls.push_back(a_WallId);
+            m_Heights.push_back(a_Height);
+            m_TargetHeights.push_back(a_TargetHeight);
+            m_Speeds.push_back(a_Speed);
+            m_SolidHeights.push_back(a_SolidHeight);
+            m_Solid.push_back(a_Solid ? 1u : 0u);
+        }
+        else
+        {
+            m_TargetHeights[slot] = a_TargetHeight;
+            m_Speeds[slot] = a_Speed;
+            m_SolidHeights[slot] = a_SolidHeight;
+        }
+    }
+
+    void WallAnimator::fixedUpdate()
+    {
+        if(m_SlotWalls.empty())
+        {
+            return;
+        }
+
+        integrate();
+
+        //Walked backwards, so a finished wall can be replaced by the last slot, which has already been handled
+        for(size_t slot = m_SlotWalls.size(); slot-- > 0;)
+        {
+            MoveableWall* wall = m_Walls[m_SlotWalls[slot]];
+            if(m_Arrived[slot])
+            {
+                removeSlot(static_cast<irr::u32>(slot));
+                wall->finishTransition();
+                continue;
+            }
+
+            wall->setHeight(m_Heights[slot]);
+            if(m_NewSolid[slot] != m_Solid[slot])
+            {
+                m_Solid[slot] = m_NewSolid[slot];
+                bool solid = m_Solid[slot] != 0u;
+                wall->setSolid(solid);
+                m_SolidityEvents.publish({ wall->m_TriangleSelector,
+                    solid ? ESolidityChange::BecameSolid : ESolidityChange::BecamePassable });
+            }
+        }
+    }
+
+    size_t WallAnimator::getTransitioningCount() const
+    {
+        return m_SlotWalls.size();
+    }
+
+    void WallAnimator::integrate()
+    {
+        size_t count = m_SlotWalls.size();
+        m_NewSolid.resize(count);
+        m_Arrived.resize(count);
+
+        size_t slot = 0;
+        const __m128 zero = _mm_setzero_ps();
+        for(; slot + 4 <= count; slot += 4)
+        {
+            __m128 height = _mm_loadu_ps(&m_Heights[slot]);
+            __m128 targetHeight = _mm_loadu_ps(&m_TargetHeights[slot]);
+            __m128 speed = _mm_loadu_ps(&m_Speeds[slot]);
+            __m128 solidHeight = _mm_loadu_ps(&m_SolidHeights[slot]);
+
+            __m128 delta = _mm_sub_ps(targetHeight, height);
+            __m128 step = _mm_min_ps(_mm_max_ps(delta, _mm_sub_ps(zero, speed)), speed);
+            //Walls within a step of their target are snapped onto it, so they arrive exactly
+            __m128 reached = _mm_cmple_ps(_mm_max_ps(delta, _mm_sub_ps(zero, delta)), speed);
+            __m128 newHeight = _mm_or_ps(_mm_and_ps(reached, targetHeight), _mm_andnot_ps(reached, _mm_add_ps(height, step)));
+            _mm_storeu_ps(&m_Heights[slot], newHeight);
+
+            int arrived = _mm_movemask_ps(_mm_cmpeq_ps(delta, zero));
+            int solid = _mm_movemask_ps(_mm_cmpge_ps(newHeight, solidHeight));
+            for(size_t lane = 0; lane < 4; ++lane)
+            {
+                m_Arrived[slot + lane] = static_cast<irr::u8>((arrived >> lane) & 1);
+                m_NewSolid[slot + lane] = static_cast<irr::u8>((solid >> lane) & 1);
+            }
+        }
+
+        for(; slot < count; ++slot)
+        {
+            irr::f32 delta = m_TargetHeights[slot] - m_Heights[slot];
+            irr::f32 speed = m_Speeds[slot];
+            irr::f32 newHeight = std::abs(delta) <= speed ? m_TargetHeights[slot] : m_Heights[slot] + std::min(std::max(delta, -speed), speed);
+            m_Heights[slot] = newHeight;
+            m_Arrived[slot] = delta == 0.0f ? 1u : 0u;
+            m_NewSolid[slot] = newHeight >= m_SolidHeights[slot] ? 1u : 0u;
+        }
+    }
+
+    void WallAnimator::removeSlot(irr::u32 a_Slot)
+    {
+        irr::u32 last = static_cast<irr::u32>(m_SlotWalls.size() - 1);
+        m_Slots[m_SlotWalls[a_Slot]] = InactiveSlot;
+        if(a_Slot != last)
+        {
+            m_SlotWalls[a_Slot] = m_SlotWalls[last];
+            m_Heights[a_Slot] = m_Heights[last];
+            m_TargetHeights[a_Slot] = m_TargetHeights[last];
+            m_Speeds[a_Slot] = m_Speeds[last];
+            m_SolidHeights[a_Slot] = m_SolidHeights[last];
+            m_Solid[a_Slot] = m_Solid[last];
+            m_Slots[m_SlotWalls[a_Slot]] = a_Slot;
+        }
+        m_SlotWalls.pop_back();
+        m_Heights.pop_back();
+        m_TargetHeights.pop_back();
+        m_Speeds.pop_back();
+        m_SolidHeights.pop_back();
+        m_Solid.pop_back();
+    }
+}
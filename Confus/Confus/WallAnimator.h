@@ -0,0 +1,96 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include <vector>
+
+#include "SolidityEvents.h"
+
+namespace Confus
+{
+    class MoveableWall;
+
+    /// <summary>
+    /// Moves every transitioning wall of a maze in a single pass per fixed update.
+    /// Walls only move along Y, so the height, target height, speed and solidify height of each transitioning wall
+    /// are kept in packed float arrays and integrated four at a time with SSE.
+    /// A wall is only called back when it crosses its solidify height or finishes its transition, besides having its height set.
+    /// Crossing the solidify height is also published as a solidity event.
+    /// </summary>
+    class WallAnimator
+    {
+    private:
+        static const irr::u32 InactiveSlot;
+
+        /// <summary> Where the walls crossing their solidify height are published </summary>
+        const SolidityEvents& m_SolidityEvents;
+
+        /// <summary> Every registered wall by id, nullptr for ids that are free </summary>
+        std::vector<MoveableWall*> m_Walls;
+        /// <summary> The slot in the packed arrays of each wall id, InactiveSlot while it is not transitioning </summary>
+        std::vector<irr::u32> m_Slots;
+        /// <summary> The ids of walls that have been removed, to be reused </summary>
+        std::vector<irr::u32> m_FreeIds;
+
+        /// <summary> The packed state of the transitioning walls, one entry per slot </summary>
+        std::vector<irr::f32> m_Heights;
+        std::vector<irr::f32> m_TargetHeights;
+        std::vector<irr::f32> m_Speeds;
+        /// <summary> The height above which each wall is solid </summary>
+        std::vector<irr::f32> m_SolidHeights;
+        /// <summary> Whether each wall was solid as of the last update </summary>
+        std::vector<irr::u8> m_Solid;
+        /// <summary> The wall id in each slot </summary>
+        std::vector<irr::u32> m_SlotWalls;
+
+        /// <summary> The results of the vectorized pass, whether each wall is solid and whether it had already arrived </summary>
+        std::vector<irr::u8> m_NewSolid;
+        std::vector<irr::u8> m_Arrived;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="WallAnimator"/> class.
+        /// </summary>
+        /// <param name="a_SolidityEvents">Where the walls becoming solid or passable are published, which has to outlive this.</param>
+        WallAnimator(const SolidityEvents& a_SolidityEvents);
+
+        /// <summary>
+        /// Registers a wall, which starts out not transitioning.
+        /// </summary>
+        /// <returns>The id of the wall, to start its transitions with.</returns>
+        irr::u32 addWall(MoveableWall* a_Wall);
+
+        /// <summary>
+        /// Unregisters a wall, stopping its transition.
+        /// </summary>
+        void removeWall(irr::u32 a_WallId);
+
+        /// <summary>
+        /// Starts moving a wall towards a target height, or retargets it if it is already moving.
+        /// </summary>
+        /// <param name="a_WallId">The id of the wall.</param>
+        /// <param name="a_Height">The current height of the wall, only used if it was not already moving.</param>
+        /// <param name="a_TargetHeight">The height to move to.</param>
+        /// <param name="a_Speed">The maximum distance to move per fixed update.</param>
+        /// <param name="a_SolidHeight">The height at and above which the wall is solid.</param>
+        /// <param name="a_Solid">Whether the wall is currently solid.</param>
+        void startTransition(irr::u32 a_WallId, irr::f32 a_Height, irr::f32 a_TargetHeight, irr::f32 a_Speed, irr::f32 a_SolidHeight, bool a_Solid);
+
+        /// <summary>
+        /// Moves every transitioning wall and calls back the walls whose state changed.
+        /// </summary>
+        void fixedUpdate();
+
+        /// <summary>
+        /// Gets the amount of walls that are currently transitioning.
+        /// </summary>
+        size_t getTransitioningCount() const;
+    private:
+        /// <summary>
+        /// Integrates the heights of all slots and fills in the solid and arrived results.
+        /// </summary>
+        void integrate();
+
+        /// <summary>
+        /// Removes a slot from the packed arrays by moving the last slot into it.
+        /// </summary>
+        void removeSlot(irr::u32 a_Slot);
+    };
+}
@@ -18,14 +18,11 @@ namespace Confus
 		/// Constructor that creates a moveableWall in a mazeTile
 		/// </summary>
 		/// <param name="a_Device">The current Irrlicht device.</param>
+		/// <param name="a_AssetRegistry">The registry the wall acquires its assets from.</param>
+		/// <param name="a_WallAnimator">The animator that moves the wall.</param>
 		/// <param name="a_RealPosition">The position of the wall when it is raised</param>
 		/// <param name="a_HiddenPosition">The position of the wall when it is lowered</param>
-		WalledMazeTile(irr::IrrlichtDevice * a_Device, irr::core::vector3df a_RealPosition, irr::core::vector3df a_HiddenPosition);
-
-		/// <summary>
-		/// The fixed update used to update the state of the walledMazeTile
-		/// </summary>
-		virtual void fixedUpdate() override;
+		WalledMazeTile(irr::IrrlichtDevice * a_Device, Assets::AssetRegistry& a_AssetRegistry, WallAnimator& a_WallAnimator, irr::core::vector3df a_RealPosition, irr::core::vector3df a_HiddenPosition);
 
 		/// <summary>
 		/// Getter for the MoveableWall, returns a pointer to the containing Wall.
@@ -0,0 +1,37 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+
+#include "ConfusShared/EntityStore.h"
+
+namespace ConfusServer
+{
+    class Flag;
+
+    using ConfusShared::ETeamIdentifier;
+    using ConfusShared::EFlagEnum;
+    using ConfusShared::Health;
+
+    namespace Entities
+    {
+        using ConfusShared::Entity;
+        using ConfusShared::TeamComponent;
+
+        /// <summary>
+        /// Where an entity is in the world, read from the scene node that represents it
+        /// </summary>
+        struct TransformComponent
+        {
+            irr::scene::ISceneNode* Node = nullptr;
+        };
+
+        /// <summary>
+        /// Whether an entity that can pick up flags is carrying one, and which
+        /// </summary>
+        struct FlagCarrierComponent
+        {
+            EFlagEnum Status = EFlagEnum::None;
+            /// <summary> The flag being carried, nullptr once it has been dropped, returned or scored </summary>
+            Flag* CarriedFlag = nullptr;
+        };
+    }
+}
@@ -0,0 +1,14 @@
+#include "EntityStore.h"
+
+namespace ConfusServer
+{
+    namespace Entities
+    {
+        void EntityStore::removeComponents(Entity a_Entity)
+        {
+            ConfusShared::EntityStore::removeComponents(a_Entity);
+            Transforms.remove(a_Entity);
+            FlagCarriers.remove(a_Entity);
+        }
+    }
+}
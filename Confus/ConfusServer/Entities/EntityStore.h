@@ -0,0 +1,23 @@
+#pragma once
+#include "ConfusShared/EntityStore.h"
+#include "Components.h"
+
+namespace ConfusServer
+{
+    namespace Entities
+    {
+        using ConfusShared::ComponentArray;
+
+        /// <summary>
+        /// The entities of the server, with the components that refer to its scene next to the ones shared with the client.
+        /// </summary>
+        class EntityStore : public ConfusShared::EntityStore
+        {
+        public:
+            ComponentArray<TransformComponent> Transforms;
+            ComponentArray<FlagCarrierComponent> FlagCarriers;
+        protected:
+            virtual void removeComponents(Entity a_Entity) override;
+        };
+    }
+}
@@ -8,16 +8,12 @@
 
 namespace ConfusServer {
 
-	Flag::Flag(irr::IrrlichtDevice* a_Device, ETeamIdentifier a_TeamIdentifier) : m_TeamIdentifier(new ETeamIdentifier(a_TeamIdentifier)),
-				m_FlagStatus(new EFlagEnum(EFlagEnum::FlagBase)) {
+	Flag::Flag(irr::IrrlichtDevice* a_Device, Entities::EntityStore& a_EntityStore, ETeamIdentifier a_TeamIdentifier)
+        : m_EntityStore(a_EntityStore), m_Entity(a_EntityStore.create()) {
         //Get drivers to load model
         auto sceneManager = a_Device->getSceneManager();
         auto videoDriver = a_Device->getVideoDriver();
 
-		//Flags
-		m_StartPosition = new irr::core::vector3df();
-		m_StartRotation = new irr::core::vector3df();
-
         //Load model
         IrrAssimp irrAssimp(sceneManager);
         irr::scene::IAnimatedMesh* mesh = sceneManager->getMesh("Media/Meshes/Flag.3ds");
@@ -28,6 +24,8 @@ namespace ConfusServer {
         m_FlagNode->setDebugDataVisible(irr::scene::EDS_BBOX_ALL);
 
         m_FlagOldParent = m_FlagNode->getParent();
+        m_EntityStore.Transforms.add(m_Entity, { m_FlagNode });
+        m_EntityStore.Teams.add(m_Entity, { a_TeamIdentifier });
 
         //Set Color
 		setColor(videoDriver);
@@ -36,6 +34,11 @@ namespace ConfusServer {
         initParticleSystem(sceneManager);
 	}
 
+    irr::scene::ISceneNode* Flag::getNode() const
+    {
+        return m_FlagNode;
+    }
+
     void Flag::setCollisionTriangleSelector(irr::scene::ISceneManager* a_SceneManager, irr::scene::ITriangleSelector* a_TriangleSelector) 
     {
         auto animator = a_SceneManager->createCollisionResponseAnimator(a_TriangleSelector, m_FlagNode, { 1.25f, 1.f, 1.25f });
@@ -44,7 +47,7 @@ namespace ConfusServer {
         {
             if(Player* player = dynamic_cast<Player*>(a_CollidedNode->getParent())) 
             {
-                captureFlag(player);
+                captureFlag(player->getEntity());
                 return true;
             }
             else if(a_CollidedNode->getID() == 1) 
@@ -61,23 +64,23 @@ namespace ConfusServer {
 	//Set color & position based on color of flag
 	void Flag::setColor(irr::video::IVideoDriver* a_VideoDriver) 
 	{
-		switch (*m_TeamIdentifier)
+		switch (getTeam())
 		{
 		case ETeamIdentifier::TeamBlue:
             m_FlagNode->setMaterialTexture(0, a_VideoDriver->getTexture("Media/Textures/Flag/FLAG_BLUE.png"));
-			m_StartPosition->set({ -2.0f, 15.f, -2.f });
-			m_StartRotation->set({ 0.f, 0.f, 0.f });
+			m_StartPosition.set({ -2.0f, 15.f, -2.f });
+			m_StartRotation.set({ 0.f, 0.f, 0.f });
 			returnToStartPosition();
 			break;
 		case ETeamIdentifier::TeamRed:
             m_FlagNode->setMaterialTexture(0, a_VideoDriver->getTexture("Media/Textures/Flag/FLAG_RED.png"));
-			m_StartPosition->set({ 1.5f, 15.f, -72.f });
-			m_StartRotation->set({ 0.f, 180.f, 0.f });
+			m_StartPosition.set({ 1.5f, 15.f, -72.f });
+			m_StartRotation.set({ 0.f, 180.f, 0.f });
             returnToStartPosition();
 			break;
 		default:
-			m_StartPosition->set({ 0, 0, 0 });
-			m_StartRotation->set({ 0, 0, 0 });
+			m_StartPosition.set({ 0, 0, 0 });
+			m_StartRotation.set({ 0, 0, 0 });
 			break;
 		}
 	}
@@ -117,7 +120,7 @@ namespace ConfusServer {
 
     irr::video::SColor Flag::getColor() 
     {
-        switch(*m_TeamIdentifier)
+        switch(getTeam())
         {
         case ETeamIdentifier::TeamBlue:
             return { 255, 0, 0, 255 };
@@ -129,41 +132,42 @@ namespace ConfusServer {
     }
 
 	//This class handles what to do on collision
-	void Flag::captureFlag(Player* a_PlayerObject) 
+	void Flag::captureFlag(Entities::Entity a_Carrier) 
     {
 		//Somebody is already carrying the flag
-		if (*m_FlagStatus == EFlagEnum::FlagTaken) 
+		if (m_FlagStatus == EFlagEnum::FlagTaken) 
 		{
 			return;
 		}
 
-
-		if (*a_PlayerObject->TeamIdentifier != *m_TeamIdentifier && *a_PlayerObject->CarryingFlag == EFlagEnum::None) 
+        ETeamIdentifier carrierTeam = m_EntityStore.Teams.get(a_Carrier).Team;
+        Entities::FlagCarrierComponent& carrier = m_EntityStore.FlagCarriers.get(a_Carrier);
+		if (carrierTeam != getTeam() && carrier.Status == EFlagEnum::None) 
         {
             // Capturing flag if player has no flag
-            m_FlagNode->setParent(a_PlayerObject->PlayerNode);            
-            *m_FlagStatus = EFlagEnum::FlagTaken;
-            a_PlayerObject->FlagPointer = this;
-            *a_PlayerObject->CarryingFlag = EFlagEnum::FlagTaken;
+            m_FlagNode->setParent(m_EntityStore.Transforms.get(a_Carrier).Node);            
+            m_FlagStatus = EFlagEnum::FlagTaken;
+            m_Carrier = a_Carrier;
+            carrier.CarriedFlag = this;
+            carrier.Status = EFlagEnum::FlagTaken;
 		}
-		else if (*a_PlayerObject->TeamIdentifier == *m_TeamIdentifier) 
+		else if (carrierTeam == getTeam()) 
         {
 			//If flag has been dropped return flag to base
- 			if (*m_FlagStatus == EFlagEnum::FlagDropped) 
+ 			if (m_FlagStatus == EFlagEnum::FlagDropped) 
             {
                 returnToStartPosition();
 			}
 			//If flag is at base and player is carrying a flag
-			else if (*m_FlagStatus == EFlagEnum::FlagBase) 
+			else if (m_FlagStatus == EFlagEnum::FlagBase) 
             {
-				if (*a_PlayerObject->CarryingFlag == EFlagEnum::FlagTaken) 
+				if (carrier.Status == EFlagEnum::FlagTaken) 
                 {					
-                    if(a_PlayerObject->FlagPointer != nullptr) 
+                    if(carrier.CarriedFlag != nullptr) 
 					{
                         // Player scored a point!
-                        a_PlayerObject->FlagPointer->returnToStartPosition();
-                        a_PlayerObject->FlagPointer = nullptr;
-                        score(a_PlayerObject);
+                        carrier.CarriedFlag->returnToStartPosition();
+                        score(a_Carrier);
                     }
 					else
 					{
@@ -175,44 +179,57 @@ namespace ConfusServer {
 	}
 
 	//TODO Score points to team of a_PlayerObject
-	void Flag::score(Player* a_PlayerObject) 
+	void Flag::score(Entities::Entity a_Carrier) 
     {
-        *a_PlayerObject->CarryingFlag = EFlagEnum::None;
+        m_EntityStore.FlagCarriers.get(a_Carrier).Status = EFlagEnum::None;
 	}
 
-
-	void Flag::drop(Player* a_PlayerObject) 
+	void Flag::drop(Entities::Entity a_Carrier) 
     {
         m_FlagNode->setParent(m_FlagOldParent);
-        m_FlagNode->setPosition(a_PlayerObject->PlayerNode->getAbsolutePosition());
-        a_PlayerObject->FlagPointer = nullptr;
-        *m_FlagStatus = EFlagEnum::FlagDropped;
-        *a_PlayerObject->CarryingFlag = EFlagEnum::None;
+        m_FlagNode->setPosition(m_EntityStore.Transforms.get(a_Carrier).Node->getAbsolutePosition());
+        releaseCarrier();
+        m_FlagStatus = EFlagEnum::FlagDropped;
 	}
 
     void Flag::setStartPosition(irr::core::vector3df a_Position) 
     {
-        m_StartPosition->set(a_Position);
+        m_StartPosition.set(a_Position);
     }
 
     void Flag::setStartRotation(irr::core::vector3df a_Rotation) 
     {
-        m_StartRotation->set(a_Rotation);
+        m_StartRotation.set(a_Rotation);
     }
 
     void Flag::returnToStartPosition() {
         m_FlagNode->setParent(m_FlagOldParent);
-        m_FlagNode->setPosition(*m_StartPosition);
-        m_FlagNode->setRotation(*m_StartRotation);
-		*m_FlagStatus = EFlagEnum::FlagBase;
+        m_FlagNode->setPosition(m_StartPosition);
+        m_FlagNode->setRotation(m_StartRotation);
+        releaseCarrier();
+		m_FlagStatus = EFlagEnum::FlagBase;
+    }
+
+    ETeamIdentifier Flag::getTeam() const
+    {
+        return m_EntityStore.Teams.get(m_Entity).Team;
+    }
+
+    void Flag::releaseCarrier()
+    {
+        //The carrier may have been destroyed while carrying the flag
+        if(m_EntityStore.FlagCarriers.has(m_Carrier))
+        {
+            Entities::FlagCarrierComponent& carrier = m_EntityStore.FlagCarriers.get(m_Carrier);
+            carrier.CarriedFlag = nullptr;
+            carrier.Status = EFlagEnum::None;
+        }
+        m_Carrier = Entities::Entity();
     }
 
 	Flag::~Flag() {
         m_FlagNode->setParent(m_FlagOldParent);
 		delete(m_Collider);
-		delete(m_TeamIdentifier);
-		delete(m_FlagStatus);
-		delete(m_StartPosition);
-        delete(m_StartRotation);
+        m_EntityStore.destroy(m_Entity);
 	}
 }
\ No newline at end of file
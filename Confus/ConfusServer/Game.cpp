@@ -1,6 +1,6 @@
 #include <Irrlicht/irrlicht.h>
-#include <time.h>
 #include <iostream>
+#include <vector>
 
 #include "Game.h"
 #include "Player.h"
@@ -10,19 +10,58 @@
 
 namespace ConfusServer
 {
-    const double Game::FixedUpdateInterval = 0.02;
+    namespace
+    {
+        /// <summary>
+        /// Adds the triangles a selector has in world space to the collision world as a body.
+        /// </summary>
+        std::uint32_t addCollisionBody(ConfusShared::CollisionWorld& a_World, irr::scene::ITriangleSelector* a_Selector)
+        {
+            std::vector<irr::core::triangle3df> triangles(static_cast<size_t>(a_Selector->getTriangleCount()));
+            irr::s32 count = 0;
+            a_Selector->getTriangles(triangles.data(), static_cast<irr::s32>(triangles.size()), count);
+
+            std::vector<ConfusShared::Triangle> converted;
+            converted.reserve(static_cast<size_t>(count));
+            for(irr::s32 i = 0; i < count; ++i)
+            {
+                const irr::core::triangle3df& triangle = triangles[i];
+                converted.push_back({ { triangle.pointA.X, triangle.pointA.Y, triangle.pointA.Z },
+                    { triangle.pointB.X, triangle.pointB.Y, triangle.pointB.Z },
+                    { triangle.pointC.X, triangle.pointC.Y, triangle.pointC.Z } });
+            }
+            return a_World.addBody(converted.data(), converted.size());
+        }
+    }
+
+    const double Game::FixedUpdateInterval = ConfusShared::TickInterval;
     const double Game::MaxFixedUpdateInterval = 0.1;
 
 	const double Game::ProcessPacketsInterval = 0.03;
+    const size_t Game::CharactersPerJob = 16;
 
     Game::Game()
         : m_Device(irr::createDevice(irr::video::E_DRIVER_TYPE::EDT_NULL)),
-		m_MazeGenerator(m_Device, irr::core::vector3df(0.0f, 0.0f, 0.0f),(19+20+21+22+23+24)), // magic number is just so everytime the first maze is generated it looks the same, not a specific number is chosen
-        m_PlayerNode(m_Device, 1, ETeamIdentifier::TeamRed, true),        
-        m_SecondPlayerNode(m_Device, 1, ETeamIdentifier::TeamRed, false),
-        m_BlueFlag(m_Device, ETeamIdentifier::TeamBlue),
-        m_RedFlag(m_Device, ETeamIdentifier::TeamRed)
+		m_MazeSchedule(ConfusShared::MazeSchedule::MatchSeed),
+		m_MazeGenerator(m_Device, m_SolidityEvents, irr::core::vector3df(0.0f, 0.0f, 0.0f), m_MazeSchedule.getSeed(), m_FrameArena),
+        m_PlayerNode(m_Device, m_EntityStore, 1, ETeamIdentifier::TeamRed, true),        
+        m_SecondPlayerNode(m_Device, m_EntityStore, 1, ETeamIdentifier::TeamRed, false),
+        m_BlueFlag(m_Device, m_EntityStore, ETeamIdentifier::TeamBlue),
+        m_RedFlag(m_Device, m_EntityStore, ETeamIdentifier::TeamRed),
+        m_BlueRespawnFloor(m_Device, m_SolidityEvents),
+        m_RedRespawnFloor(m_Device, m_SolidityEvents),
+        m_FixedSystems(m_WorkerPool)
+    {
+        registerSystems();
+    }
+
+    void Game::registerSystems()
     {
+        using Component = ESystemComponent;
+        m_FixedSystems.addSystem("MazeSchedule", {}, { Component::MazeSchedule, Component::MazeWalls }, [this]() { updateMazeSchedule(); });
+        //The walls and floors set their bodies in the collision world as they change, so the characters read the maze after them
+        m_FixedSystems.addSystem("MazeWalls", {}, { Component::MazeWalls }, [this]() { m_MazeGenerator.fixedUpdate(); });
+        m_FixedSystems.addSystem("Characters", { Component::MazeWalls }, { Component::Characters }, [this]() { updateCharacters(); });
     }
 
     void Game::run()
@@ -35,8 +74,11 @@ namespace ConfusServer
         sceneManager->loadScene("Media/IrrlichtScenes/Bases 2.irr", nullptr, m_LevelRootNode);
         m_LevelRootNode->setScale(irr::core::vector3df(1.0f, 1.0f, 1.0f));
         m_LevelRootNode->setVisible(true);
+        m_BlueRespawnFloor.setPosition(irr::core::vector3df(0.f, 3.45f, 11.f));
+        m_RedRespawnFloor.setPosition(irr::core::vector3df(0.f, 3.45f, -83.f));
         
         processTriangleSelectors();
+        m_SolidityEvents.addListener([this](const SolidityEvent& a_Event) { updateLevelCollision(a_Event); });
 
         m_PlayerNode.setLevelCollider(m_Device->getSceneManager(), m_LevelRootNode->getTriangleSelector());
         m_SecondPlayerNode.setLevelCollider(m_Device->getSceneManager(), m_LevelRootNode->getTriangleSelector());
@@ -65,8 +107,10 @@ namespace ConfusServer
 		m_ConnectionUpdateTimer += m_DeltaTime;
 		if (m_ConnectionUpdateTimer >= ProcessPacketsInterval)
 		{
+			m_Connection->processPackets(getTime());
+			m_Connection->updateSendRates(static_cast<float>(m_ConnectionUpdateTimer));
+			m_Connection->flushMessages();
 			m_ConnectionUpdateTimer = 0;
-			m_Connection->processPackets();
 		}
 	}
 
@@ -82,13 +126,26 @@ namespace ConfusServer
             irr::scene::ISceneNode* node = nodes[i];
             irr::scene::ITriangleSelector* selector = nullptr;
             node->setDebugDataVisible(irr::scene::EDS_BBOX_ALL);
+            //Parents come before their children, so the selectors read the world positions the nodes will have once drawn
+            node->updateAbsolutePosition();
 
             switch(node->getType())
             {
             case irr::scene::ESNT_CUBE:
-            case irr::scene::ESNT_ANIMATED_MESH:
                 selector = m_Device->getSceneManager()->createTriangleSelectorFromBoundingBox(node);
                 break;
+            case irr::scene::ESNT_ANIMATED_MESH:
+                //Walls and floors that can become passable collide through their own selector, the same triangles the client collides with
+                selector = node->getTriangleSelector();
+                if(selector)
+                {
+                    selector->grab();
+                }
+                else
+                {
+                    selector = m_Device->getSceneManager()->createTriangleSelectorFromBoundingBox(node);
+                }
+                break;
             case irr::scene::ESNT_MESH:
             case irr::scene::ESNT_SPHERE:
                 selector = sceneManager->createTriangleSelector(((irr::scene::IMeshSceneNode*)node)->getMesh(), node);
@@ -106,10 +163,42 @@ namespace ConfusServer
             if(selector)
             {
                 metatriangleSelector->addTriangleSelector(selector);
+                if(!isMovingNode(node))
+                {
+                    std::uint32_t body = addCollisionBody(m_CollisionWorld, selector);
+                    //Only the maze walls and respawn floors have their own selector set at this point, which they take away while they are passable
+                    if(node->getType() == irr::scene::ESNT_ANIMATED_MESH && node->getTriangleSelector() != nullptr)
+                    {
+                        m_WallBodies[node->getTriangleSelector()] = body;
+                    }
+                }
                 selector->drop();
             }
         }
         m_LevelRootNode->setTriangleSelector(metatriangleSelector);
+        m_CollisionWorld.build();
+    }
+
+    bool Game::isMovingNode(irr::scene::ISceneNode* a_Node) const
+    {
+        for(irr::scene::ISceneNode* node = a_Node; node != nullptr; node = node->getParent())
+        {
+            //The players hang below the cameras that move them
+            if(node->getType() == irr::scene::ESNT_CAMERA || node == m_BlueFlag.getNode() || node == m_RedFlag.getNode())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Game::updateLevelCollision(const SolidityEvent& a_Event)
+    {
+        auto body = m_WallBodies.find(a_Event.Collider);
+        if(body != m_WallBodies.end())
+        {
+            m_CollisionWorld.setBodySolid(body->second, a_Event.Change == ESolidityChange::BecameSolid);
+        }
     }
 
     void Game::handleInput()
@@ -131,6 +220,7 @@ namespace ConfusServer
         irr::core::vector3df upVector = playerRotation * irr::core::vector3df( 0, 1, 0 );
         irr::core::vector3df forwardVector = playerRotation * irr::core::vector3df(0, 0, 1);
         m_Listener.setDirection(forwardVector, upVector);     
+        m_FrameArena.reset();
     }
 
     void Game::processFixedUpdates()
@@ -146,14 +236,58 @@ namespace ConfusServer
 
     void Game::fixedUpdate()
     {
-		static float timer = 0.0f;
-		timer += static_cast<float>(m_DeltaTime);
-		if (timer >= 9.0f)
-		{
-			timer = 0.0f;
-			m_MazeGenerator.refillMainMaze(static_cast<int>(time(0)));
-		}
-		m_MazeGenerator.fixedUpdate();
+        m_Connection->consumeInputs();
+        m_FixedSystems.run();
+        m_Connection->sendTransforms(m_Tick);
+        m_FrameArena.reset();
+        ++m_Tick;
+    }
+
+    void Game::updateCharacters()
+    {
+        //The collision world is only read from here on and every job writes its own sessions, so the jobs never conflict
+        auto& sessions = m_Connection->getSessions();
+        m_WorkerPool.parallelFor(sessions.size(), CharactersPerJob, [this, &sessions](size_t a_Begin, size_t a_End)
+        {
+            for(size_t i = a_Begin; i < a_End; ++i)
+            {
+                auto& session = sessions.at(i);
+                if(!session.HasInput)
+                {
+                    continue;
+                }
+                m_CharacterController.simulate(session.Character, session.Input, m_CollisionWorld, static_cast<float>(FixedUpdateInterval));
+                //The same rule as the respawn system of the client, right after the move like there, so both respawn in the same tick
+                if(session.Character.Position.Y <= ConfusShared::FallHeight)
+                {
+                    session.Character = ConfusShared::CharacterState();
+                    session.Character.Position = ConfusShared::getSpawnPosition(session.Team, m_CharacterController.getSettings().EyeHeight);
+                }
+            }
+        });
+    }
+
+    double Game::getTime() const
+    {
+        return m_Tick * FixedUpdateInterval + m_FixedUpdateTimer;
+    }
+
+    void Game::updateMazeSchedule()
+    {
+        if(m_MazeSchedule.fixedUpdate(FixedUpdateInterval))
+        {
+            m_MazeGenerator.refillMainMaze(m_MazeSchedule.getSeed());
+        }
+        if(m_MazeSchedule.areRespawnFloorsSolid())
+        {
+            m_BlueRespawnFloor.enableCollision();
+            m_RedRespawnFloor.enableCollision();
+        }
+        else
+        {
+            m_BlueRespawnFloor.disableCollision();
+            m_RedRespawnFloor.disableCollision();
+        }
     }
 
     void Game::render()
@@ -1,6 +1,14 @@
 #pragma once
 #include <Irrlicht/irrlicht.h>
 #include <RakNet/BitStream.h>
+#include <unordered_map>
+#include <vector>
+#include "ConfusShared/CharacterController.h"
+#include "ConfusShared/ClockSync.h"
+#include "ConfusShared/CollisionWorld.h"
+#include "ConfusShared/FrameArena.h"
+#include "ConfusShared/MazeSchedule.h"
+#include "ConfusShared/SystemScheduler.h"
 
 #include "Networking/Connection.h"
 #include "MazeGenerator.h"
@@ -9,6 +17,8 @@
 #include "Audio\PlayerAudioEmitter.h"
 #include "EventManager.h"
 #include "Flag.h"
+#include "RespawnFloor.h"
+#include "SolidityEvents.h"
 
 namespace ConfusServer
 {    
@@ -20,6 +30,16 @@ namespace ConfusServer
     class Game
     {
     private:
+        /// <summary>
+        /// What the systems of the server read and write, so the ones that do not conflict can run in parallel
+        /// </summary>
+        enum class ESystemComponent
+        {
+            MazeSchedule, ///< The timeline of refills.
+            MazeWalls, ///< The maze tiles and the walls on them.
+            Characters ///< The characters of the clients, moved by their input.
+        };
+
         /// <summary>
         /// The rate at which fixed updates are carried out
         /// </summary>
@@ -32,6 +52,10 @@ namespace ConfusServer
 		/// The interval at which packets queue before processed
 		/// </summary>
 		static const double ProcessPacketsInterval;
+        /// <summary>
+        /// The most characters a single job simulates, so a handful of clients stays on one thread and a full server uses every core
+        /// </summary>
+        static const size_t CharactersPerJob;
 
         /// <summary>
         /// The instance of the IrrlichtDevice
@@ -39,6 +63,18 @@ namespace ConfusServer
         /// </summary>
         irr::IrrlichtDevice* m_Device;
         /// <summary>
+        /// The memory for containers that only live during a single update, reset at the end of every update and fixed update
+        /// </summary>
+        ConfusShared::FrameArena m_FrameArena;
+        /// <summary>
+        /// When the maze is refilled and with which seed, advanced each fixed update
+        /// </summary>
+        ConfusShared::MazeSchedule m_MazeSchedule;
+        /// <summary>
+        /// Where the maze walls and respawn floors publish becoming solid or passable, which has to outlive them
+        /// </summary>
+        SolidityEvents m_SolidityEvents;
+        /// <summary>
         /// MazeGenerator that hasa accesible maze
         /// </summary>
         MazeGenerator m_MazeGenerator;
@@ -48,6 +84,10 @@ namespace ConfusServer
         OpenALListener m_Listener;
         EventManager m_EventManager;
         /// <summary>
+        /// The entities of the players and flags, which has to outlive them
+        /// </summary>
+        Entities::EntityStore m_EntityStore;
+        /// <summary>
         /// The Players to test with.
         /// </summary>
         Player m_PlayerNode;
@@ -61,9 +101,18 @@ namespace ConfusServer
         /// </summary>
         Flag m_RedFlag;
         /// <summary>
+        /// The floors above the spawns, at the same place as on the client so the characters collide with the same level
+        /// </summary>
+        RespawnFloor m_BlueRespawnFloor;
+        RespawnFloor m_RedRespawnFloor;
+        /// <summary>
         /// The delay between the last and future fixed update
         /// </summary>
         double m_FixedUpdateTimer = 0.0;
+        /// <summary>
+        /// The tick of the shared timeline that the next fixed update simulates
+        /// </summary>
+        std::uint32_t m_Tick = 0;
 		/// <summary>
 		/// The delay between the last and future packet update
 		/// </summary>
@@ -83,6 +132,26 @@ namespace ConfusServer
         /// <summary> The connection to the clients of this server</summary>
         std::unique_ptr<Networking::Connection> m_Connection;
         irr::scene::ISceneNode* m_LevelRootNode;
+        /// <summary>
+        /// The level the characters collide with, built from the level selectors once the level is loaded
+        /// </summary>
+        ConfusShared::CollisionWorld m_CollisionWorld;
+        /// <summary>
+        /// The body in the collision world of every maze wall and respawn floor, by the selector they publish their solidity changes with
+        /// </summary>
+        std::unordered_map<irr::scene::ITriangleSelector*, std::uint32_t> m_WallBodies;
+        /// <summary>
+        /// Moves the characters of the clients, the same way the clients predict their own
+        /// </summary>
+        ConfusShared::CharacterController m_CharacterController;
+        /// <summary>
+        /// The threads the systems run on, which has to outlive the scheduler
+        /// </summary>
+        ConfusShared::WorkerPool m_WorkerPool;
+        /// <summary>
+        /// The systems run once per fixed update
+        /// </summary>
+        ConfusShared::SystemScheduler m_FixedSystems;
     public:
         /// <summary>
         /// Initializes a new instance of the <see cref="Game"/> class.
@@ -98,6 +167,10 @@ namespace ConfusServer
         /// </summary>
         void run();
     private:
+        /// <summary>
+        /// Registers the work done each fixed update as systems, with what each of them reads and writes.
+        /// </summary>
+        void registerSystems();
         /// <summary>
         /// Opens the connections for clients.
         /// </summary>
@@ -108,6 +181,21 @@ namespace ConfusServer
         void processTriangleSelectors();
         irr::scene::IMetaTriangleSelector* processLevelMetaTriangles();
         /// <summary>
+        /// Gets whether a scene node is, or is attached to, a player or a flag, which move and so are not part of the level
+        /// </summary>
+        /// <param name="a_Node">The scene node.</param>
+        bool isMovingNode(irr::scene::ISceneNode* a_Node) const;
+        /// <summary>
+        /// Makes the body of a wall or floor solid or passable in the collision world, the same way the client does
+        /// </summary>
+        /// <param name="a_Event">The change of the wall or floor.</param>
+        void updateLevelCollision(const SolidityEvent& a_Event);
+        /// <summary>
+        /// Moves the character of every client that has an input for this tick, sending the ones that fell out of the level back to their spawn.
+        /// The walls and floors already updated their bodies as they changed this tick.
+        /// </summary>
+        void updateCharacters();
+        /// <summary>
         /// Processes the input data
         /// </summary>
         void handleInput();
@@ -124,6 +212,14 @@ namespace ConfusServer
         /// </summary>
         void fixedUpdate();
         /// <summary>
+        /// Gets the time on the shared timeline, which is how far the simulation has come since the server started
+        /// </summary>
+        double getTime() const;
+        /// <summary>
+        /// Advances the maze schedule, refilling the maze and opening or closing the respawn floors when it is time to
+        /// </summary>
+        void updateMazeSchedule();
+        /// <summary>
         /// Renders the objects in the game
         /// </summary>
         void render();
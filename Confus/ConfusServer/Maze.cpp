@@ -3,8 +3,8 @@
 
 namespace ConfusServer
 {
-	Maze::Maze(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_StartPosition, bool a_NeedRender)
-		:m_MazeSizeX(60), m_MazeSizeY(60)
+	Maze::Maze(irr::IrrlichtDevice* a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_StartPosition, bool a_NeedRender)
+		:m_SolidityEvents(a_SolidityEvents), m_MazeSizeX(60), m_MazeSizeY(60)
 	{
 		m_IrrDevice = a_Device;
 		resetMaze(irr::core::vector2df(30, -7), a_NeedRender);
@@ -21,7 +21,7 @@ namespace ConfusServer
 			{
 				if (a_NeedRender)
 				{
-					std::shared_ptr<WalledMazeTile> mazeTile = std::make_shared<WalledMazeTile>(m_IrrDevice, irr::core::vector3df(static_cast<float>(-x + a_Offset.X), 0.5f, static_cast<float>(-y + a_Offset.Y)),
+					std::shared_ptr<WalledMazeTile> mazeTile = std::make_shared<WalledMazeTile>(m_IrrDevice, m_SolidityEvents, irr::core::vector3df(static_cast<float>(-x + a_Offset.X), 0.5f, static_cast<float>(-y + a_Offset.Y)),
 															 irr::core::vector3df(static_cast<float>(-x + a_Offset.X), 0.5f, static_cast<float>(-y + a_Offset.Y)));
 					const irr::scene::IAnimatedMeshSceneNode* wallMeshNode = mazeTile->getWall()->getMeshNode();
 					irr::core::vector3df boundingBox = wallMeshNode->getBoundingBox().getExtent();
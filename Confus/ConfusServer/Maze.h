@@ -22,6 +22,11 @@ namespace ConfusServer
 		/// </summary>
 		irr::IrrlichtDevice* m_IrrDevice;
 
+		/// <summary>
+		/// Where the walls of the maze publish becoming solid or passable.
+		/// </summary>
+		const SolidityEvents& m_SolidityEvents;
+
 		/// <summary>
 		/// the X size of the maze
 		/// </summary>
@@ -47,9 +52,10 @@ namespace ConfusServer
 		/// Constructor for this class
 		/// </summary>
 		/// <param name="a_Device">The current Irrlicht device.</param>
+		/// <param name="a_SolidityEvents">Where the walls becoming solid or passable are published.</param>
 		/// <param name="a_StartPosition">Startposition is passed on in the constructor so we might be able to adjust the position where the maze is drawn</param>
 		/// <param name="a_NeedRender">Boolean that states if this maze needs to be rendered or not</param>
-		Maze(irr::IrrlichtDevice * a_Device, irr::core::vector3df a_StartPosition, bool a_NeedRender = false);
+		Maze(irr::IrrlichtDevice * a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_StartPosition, bool a_NeedRender = false);
 
 		/// <summary>
 		/// Resets the 2d vector, raising all mazetiles in it or making it a rendered maze
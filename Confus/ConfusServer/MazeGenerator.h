@@ -1,6 +1,5 @@
 #pragma once
-#include <stack>
-
+#include "ConfusShared/MazeLayout.h"
 #include "Maze.h"
 namespace ConfusServer
 {
@@ -22,9 +21,14 @@ namespace ConfusServer
 		Maze m_ReplacementMaze;
 
 		/// <summary>
-		/// This stack is used by the maze generating algorithm to keep track of mazeTiles that might still have neighbours that can be accesed
+		/// Which tiles are raised in the last generated maze, shared with the client so both generate the same layout from a seed.
+		/// </summary>
+		ConfusShared::MazeLayout m_Layout;
+
+		/// <summary>
+		/// The memory the generation works in, which is reset after every update.
 		/// </summary>
-		std::stack<MazeTile, std::vector<std::shared_ptr<MazeTile>>> m_TileStack;
+		ConfusShared::FrameArena& m_Scratch;
 
 		/// <summary>
 		/// The seed used to randomly chose an available neighbour and thus the seed that determines the layout of the maze.
@@ -35,9 +39,11 @@ namespace ConfusServer
 		/// Loads the necessary textures
 		/// </summary>
 		/// <param name="a_Device"> The instance of the IrrlichtDevice </param>
+		/// <param name="a_SolidityEvents">Where the walls becoming solid or passable are published.</param>
 		/// <param name="a_StartPosition">The startposition for walls.</param>
 		/// <param name="a_InitialSeed">The initial seed used to generate the first maze.</param>
-		MazeGenerator(irr::IrrlichtDevice * a_Device, irr::core::vector3df a_StartPosition, int a_InitialSeed);
+		/// <param name="a_Scratch">The memory the generation works in, which has to outlive this.</param>
+		MazeGenerator(irr::IrrlichtDevice * a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_StartPosition, int a_InitialSeed, ConfusShared::FrameArena& a_Scratch);
 
 		/// <summary>
 		/// The fixed update used to update the state of the main maze
@@ -56,14 +62,8 @@ namespace ConfusServer
 		~MazeGenerator();
 	private:
 		/// <summary>
-		/// Loads the necessary textures
-		/// </summary>
-		/// <param name="a_Maze">The 2d vector to be used to check for neighbours.</param>
-		/// <param name="a_Tile">The tile in the 2d vector that is checked for neighbours.</param>
-		std::vector<std::shared_ptr<MazeTile>> getNeighbours(std::vector<std::vector<std::shared_ptr<MazeTile>>> & a_Maze, MazeTile& a_Tile);
-
-		/// <summary>
-		/// Using a depth first search algorithm generates a maze for the given 2d vector maze with a seed
+		/// Generates the layout for a seed and lowers the walls of the given 2d vector maze that are not raised in it.
+		/// The maze is expected to have all its walls raised.
 		/// </summary>
 		/// <param name="a_Maze">The 2d maze that is going to be used in the generation.</param>
 		/// <param name="a_Seed">The seed that is going to be used in the generation.</param>
@@ -5,10 +5,11 @@
 
 namespace ConfusServer
 {
-    MoveableWall::MoveableWall(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_RegularPosition,
+    MoveableWall::MoveableWall(irr::IrrlichtDevice* a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_RegularPosition,
         irr::core::vector3df a_HiddenPosition)
         : m_RegularPosition(a_RegularPosition),
-        HiddenPosition(a_HiddenPosition)
+        HiddenPosition(a_HiddenPosition),
+        m_SolidityEvents(a_SolidityEvents)
     {
         loadMesh(a_Device->getSceneManager());
         loadTextures(a_Device->getVideoDriver());
@@ -76,14 +77,27 @@ namespace ConfusServer
 
     void MoveableWall::solidify()
     {
+        //Called every fixed update of a transition, so the wall only switches when it crosses the solidify point
+        if(m_Solid)
+        {
+            return;
+        }
+        m_Solid = true;
         m_MeshNode->setMaterialTexture(0, m_RegularTexture);
         enableCollision();
+        m_SolidityEvents.publish({ m_TriangleSelector, ESolidityChange::BecameSolid });
     }
 
     void MoveableWall::makeTransparent()
     {
+        if(!m_Solid)
+        {
+            return;
+        }
+        m_Solid = false;
         m_MeshNode->setMaterialTexture(0, m_TransparentTexture);
         disableCollision();
+        m_SolidityEvents.publish({ m_TriangleSelector, ESolidityChange::BecamePassable });
     }
 
     void MoveableWall::enableCollision()
@@ -1,5 +1,6 @@
 #pragma once
 #include <Irrlicht/irrlicht.h>
+#include "SolidityEvents.h"
 
 namespace ConfusServer
 {    
@@ -67,14 +68,25 @@ namespace ConfusServer
 		/// </summary>
 		bool m_Raised = true;
 
+        /// <summary>
+        /// Whether the wall currently blocks movement, so it only switches and publishes when that changes
+        /// </summary>
+        bool m_Solid = false;
+
+        /// <summary>
+        /// Where the wall publishes becoming solid or passable
+        /// </summary>
+        const SolidityEvents& m_SolidityEvents;
+
     public:        
         /// <summary>
         /// Initializes a new instance of the <see cref="MoveableWall"/> class.
         /// </summary>
         /// <param name="a_Device">The current Irrlicht device.</param>
+        /// <param name="a_SolidityEvents">Where the wall becoming solid or passable is published, which has to outlive this.</param>
         /// <param name="a_RegularPosition">The position of the wall when present in the maze.</param>
         /// <param name="a_HiddenPosition">The position of the wall when out of the maze.</param>
-        MoveableWall(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_RegularPosition,
+        MoveableWall(irr::IrrlichtDevice* a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_RegularPosition,
             irr::core::vector3df a_HiddenPosition);      
 
         /// <summary>
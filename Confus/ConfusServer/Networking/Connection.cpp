@@ -1,7 +1,10 @@
 #include <iostream>
-#include <vector>
+#include <stdexcept>
 #include <string>
 #include <RakNet/BitStream.h>
+#include <RakNet/RakNetStatistics.h>
+
+#include "ConfusShared/Teams.h"
 
 #include "Connection.h"
 
@@ -12,7 +15,7 @@ namespace ConfusServer
         Connection::Connection()
         {
             RakNet::SocketDescriptor socketDescriptor(60000, nullptr);
-            auto result = m_Interface->Startup(5, &socketDescriptor, 1);
+            auto result = m_Interface->Startup(MaxClients, &socketDescriptor, 1);
 			if(result != RakNet::StartupResult::RAKNET_STARTED)
 			{
 				throw std::logic_error("Could not start RakNet, errorcode " +
@@ -28,8 +31,9 @@ namespace ConfusServer
             RakNet::RakPeerInterface::DestroyInstance(m_Interface);
         }
 
-        void Connection::processPackets()
+        void Connection::processPackets(double a_Time)
         {
+            m_Time = a_Time;
             RakNet::Packet* packet = m_Interface->Receive();
             while(packet != nullptr)
             {
@@ -39,6 +43,141 @@ namespace ConfusServer
             }
         }
 
+        void Connection::updateSendRates(float a_DeltaTime)
+        {
+            RakNet::RakNetStatistics statistics;
+            for(size_t i = 0; i < m_Sessions.size(); ++i)
+            {
+                Session& session = m_Sessions.at(i);
+                int averagePing = m_Interface->GetAveragePing(session.Address);
+                if(averagePing >= 0)
+                {
+                    session.RoundTripTime = averagePing / 1000.0f;
+                }
+                if(m_Interface->GetStatistics(session.Address, &statistics) == nullptr)
+                {
+                    continue;
+                }
+
+                ConfusShared::LinkStatistics link;
+                link.RoundTripTime = session.RoundTripTime;
+                link.PacketLoss = statistics.packetlossLastSecond;
+                link.BytesInFlight = statistics.bytesInResendBuffer;
+                bool wasCongested = session.SendRate.isCongested();
+                session.SendRate.update(link, a_DeltaTime);
+                if(session.SendRate.isCongested() && !wasCongested)
+                {
+                    std::cout << "Client " << session.Handle.Index << " is congested, sending at most "
+                        << session.SendRate.getBandwidthBudget() / 1024 << " KiB/s" << std::endl;
+                }
+            }
+        }
+
+        void Connection::sendMessage(ConfusShared::PeerHandle a_Client, const std::string& a_Message, bool a_Droppable)
+        {
+            if(!m_Sessions.has(a_Client))
+            {
+                return;
+            }
+
+            RakNet::BitStream stream;
+            stream.Write(static_cast<RakNet::MessageID>(EPacketType::Message));
+            stream.Write(a_Message.c_str());
+            m_Sessions.get(a_Client).Outbox.add(stream.GetData(), stream.GetNumberOfBytesUsed(), a_Droppable);
+        }
+
+        void Connection::flushMessages()
+        {
+            for(size_t i = 0; i < m_Sessions.size(); ++i)
+            {
+                Session& session = m_Sessions.at(i);
+                size_t maxDatagramSize = static_cast<size_t>(m_Interface->GetMTUSize(session.Address) - DatagramOverhead);
+                session.Outbox.flush(static_cast<unsigned char>(EPacketType::Batch), maxDatagramSize,
+                    [&session]() { return session.SendRate.canSend(); },
+                    [this, &session](const unsigned char* a_Datagram, size_t a_Size)
+                {
+                    session.SendRate.onSent(sendBatch(session.Address, a_Datagram, a_Size));
+                });
+            }
+        }
+
+        void Connection::sendTransforms(std::uint32_t a_Tick)
+        {
+            if(m_Sessions.size() == 0)
+            {
+                return;
+            }
+
+            //Every client is sent the same characters, so they are quantized and written once
+            RakNet::BitStream stream;
+            stream.Write(static_cast<RakNet::MessageID>(EPacketType::Transforms));
+            stream.Write(a_Tick);
+            stream.Write(static_cast<std::uint16_t>(m_Sessions.size()));
+            for(size_t i = 0; i < m_Sessions.size(); ++i)
+            {
+                const Session& session = m_Sessions.at(i);
+                ConfusShared::PlayerTransform transform;
+                transform.X = session.Character.Position.X;
+                transform.Y = session.Character.Position.Y;
+                transform.Z = session.Character.Position.Z;
+                transform.Yaw = session.Input.Yaw;
+                transform.Pitch = session.Input.Pitch;
+                stream.Write(session.Handle.Index);
+                ConfusShared::TransformCodec::write(stream, ConfusShared::TransformCodec::quantize(transform));
+            }
+
+            for(size_t i = 0; i < m_Sessions.size(); ++i)
+            {
+                Session& session = m_Sessions.at(i);
+                if(!session.SendRate.canSend())
+                {
+                    continue;
+                }
+                //Sequenced on a channel of their own, so transforms that arrive after newer ones are dropped
+                m_Interface->Send(&stream, PacketPriority::HIGH_PRIORITY, PacketReliability::UNRELIABLE_SEQUENCED, 1, session.Address, false);
+                session.SendRate.onSent(stream.GetNumberOfBytesUsed());
+            }
+        }
+
+        void Connection::consumeInputs()
+        {
+            for(size_t i = 0; i < m_Sessions.size(); ++i)
+            {
+                Session& session = m_Sessions.at(i);
+                std::uint32_t targetDepth = session.Inputs.getTargetDepth();
+                session.HasInput = session.Inputs.consume(session.Input);
+                if(session.Inputs.getTargetDepth() != targetDepth)
+                {
+                    std::cout << "Client " << session.Handle.Index << " now buffers " << session.Inputs.getTargetDepth()
+                        << " ticks of input, " << session.Inputs.getMissedCount() << " inputs were late so far" << std::endl;
+                }
+            }
+        }
+
+        void Connection::setCompressionEnabled(bool a_Enabled)
+        {
+            m_CompressionEnabled = a_Enabled;
+        }
+
+        size_t Connection::sendBatch(const RakNet::SystemAddress& a_Address, const unsigned char* a_Datagram, size_t a_Size)
+        {
+            m_CompressedDatagram.assign(1, static_cast<unsigned char>(EPacketType::CompressedBatch));
+            //The packet id stays uncompressed, so RakNet and the receiver can still tell what the datagram is
+            if(m_CompressionEnabled && m_Compressor.compress(a_Datagram + 1, a_Size - 1, m_CompressedDatagram))
+            {
+                a_Datagram = m_CompressedDatagram.data();
+                a_Size = m_CompressedDatagram.size();
+            }
+            m_Interface->Send(reinterpret_cast<const char*>(a_Datagram), static_cast<int>(a_Size), PacketPriority::HIGH_PRIORITY,
+                PacketReliability::RELIABLE_ORDERED, 0, a_Address, false);
+            return a_Size;
+        }
+
+        Connection::SessionTable& Connection::getSessions()
+        {
+            return m_Sessions;
+        }
+
         unsigned short Connection::getConnectionCount() const
         {
             unsigned short openConnections = 0;
@@ -49,15 +188,14 @@ namespace ConfusServer
 
         void Connection::closeAllConnections()
         {
-            auto connectionCount = getConnectionCount();
-            std::vector<RakNet::SystemAddress>
-                openConnections(static_cast<size_t>(connectionCount));
-            auto serverID = m_Interface->GetConnectionList(openConnections.data(),
-                &connectionCount);
-
-            for(unsigned short i = 0u; i < connectionCount; ++i)
+            //Walking the connection slots directly avoids copying the connection list
+            for(unsigned int i = 0u; i < m_Interface->GetMaximumNumberOfPeers(); ++i)
             {
-                m_Interface->CloseConnection(openConnections[i], true);
+                RakNet::SystemAddress address = m_Interface->GetSystemAddressFromIndex(i);
+                if(address != RakNet::UNASSIGNED_SYSTEM_ADDRESS)
+                {
+                    m_Interface->CloseConnection(address, true);
+                }
             }
         }
 
@@ -65,15 +203,125 @@ namespace ConfusServer
 		{
 			switch(static_cast<unsigned char>(a_Packet->data[0]))
 			{
-			case static_cast<unsigned char>(EPacketType::Message) :
-				printMessage(RakNet::BitStream(a_Packet->data, a_Packet->length, false));
+			case ID_NEW_INCOMING_CONNECTION:
+				openSession(a_Packet);
+				break;
+			case ID_DISCONNECTION_NOTIFICATION:
+			case ID_CONNECTION_LOST:
+				closeSession(a_Packet);
+				break;
+			case static_cast<unsigned char>(EPacketType::TimeRequest) :
+				answerTimeRequest(a_Packet);
+				break;
+			case static_cast<unsigned char>(EPacketType::Input) :
+				handleInput(a_Packet);
+				break;
+			case static_cast<unsigned char>(EPacketType::Batch) :
+				handleBatch(a_Packet->data, a_Packet->length);
+				break;
+			case static_cast<unsigned char>(EPacketType::CompressedBatch) :
+				m_DecompressedDatagram.assign(1, static_cast<unsigned char>(EPacketType::Batch));
+				try
+				{
+					m_Compressor.decompress(a_Packet->data + 1, a_Packet->length - 1, m_DecompressedDatagram);
+					handleBatch(m_DecompressedDatagram.data(), m_DecompressedDatagram.size());
+				}
+				catch(std::invalid_argument& exception)
+				{
+					std::cout << "Dropped a compressed batch: " << exception.what() << std::endl;
+				}
 				break;
 			default:
-				std::cout << "Message arrived with id " << static_cast<int>(a_Packet->data[0])
+				handleMessage(a_Packet->data, a_Packet->length);
+			}
+		}
+
+		void Connection::answerTimeRequest(RakNet::Packet* a_Packet)
+		{
+			RakNet::BitStream request(a_Packet->data, a_Packet->length, false);
+			double requestTime;
+			request.IgnoreBytes(sizeof(RakNet::MessageID));
+			if(!request.Read(requestTime))
+			{
+				return;
+			}
+
+			RakNet::BitStream response;
+			response.Write(static_cast<RakNet::MessageID>(EPacketType::TimeResponse));
+			response.Write(requestTime);
+			response.Write(m_Time);
+			//A late answer is useless, so it is not resent, the client asks again soon enough
+			m_Interface->Send(&response, PacketPriority::IMMEDIATE_PRIORITY, PacketReliability::UNRELIABLE, 0, a_Packet->systemAddress, false);
+		}
+
+		void Connection::handleInput(RakNet::Packet* a_Packet)
+		{
+			ConfusShared::PeerHandle client = m_Sessions.find(a_Packet->guid.g);
+			if(!client.isValid())
+			{
+				return;
+			}
+
+			Session& session = m_Sessions.get(client);
+			RakNet::BitStream stream(a_Packet->data, a_Packet->length, false);
+			stream.IgnoreBytes(sizeof(RakNet::MessageID));
+			try
+			{
+				ConfusShared::InputCodec::read(stream, [&session](const ConfusShared::PlayerInput& a_Input) { session.Inputs.receive(a_Input); });
+			}
+			catch(std::invalid_argument& exception)
+			{
+				std::cout << "Dropped the rest of the inputs of client " << client.Index << ": " << exception.what() << std::endl;
+			}
+		}
+
+		void Connection::handleBatch(const unsigned char* a_Datagram, size_t a_Size)
+		{
+			try
+			{
+				ConfusShared::MessageBatch::unpack(a_Datagram, a_Size,
+					[this](const unsigned char* a_Message, size_t a_MessageSize) { handleMessage(a_Message, a_MessageSize); });
+			}
+			catch(std::invalid_argument& exception)
+			{
+				std::cout << "Dropped the rest of a batch: " << exception.what() << std::endl;
+			}
+		}
+
+		void Connection::handleMessage(const unsigned char* a_Data, size_t a_Size)
+		{
+			if(a_Data[0] == static_cast<unsigned char>(EPacketType::Message))
+			{
+				RakNet::BitStream stream(const_cast<unsigned char*>(a_Data), static_cast<unsigned int>(a_Size), false);
+				printMessage(stream);
+			}
+			else
+			{
+				std::cout << "Message arrived with id " << static_cast<int>(a_Data[0])
 					<< std::endl;
 			}
 		}
 
+		void Connection::openSession(RakNet::Packet* a_Packet)
+		{
+			Session& session = m_Sessions.open(a_Packet->systemAddress, a_Packet->guid.g);
+			//Teams are not picked over the connection yet and every client plays its own player on the blue team,
+			//so the character starts where the client predicts it
+			session.Team = ConfusShared::ETeamIdentifier::TeamBlue;
+			session.Character.Position = ConfusShared::getSpawnPosition(session.Team, ConfusShared::CharacterSettings().EyeHeight);
+			std::cout << "Client " << session.Handle.Index << " connected from " << a_Packet->systemAddress.ToString() << std::endl;
+		}
+
+		void Connection::closeSession(RakNet::Packet* a_Packet)
+		{
+			ConfusShared::PeerHandle client = m_Sessions.find(a_Packet->guid.g);
+			if(client.isValid())
+			{
+				std::cout << "Client " << client.Index << " disconnected" << std::endl;
+				m_Sessions.close(client);
+			}
+		}
+
 		void Connection::printMessage(RakNet::BitStream& a_InputStream)
 		{
 			RakNet::RakString contents;
@@ -2,6 +2,13 @@
 #include <RakNet/RakPeerInterface.h>
 #include <RakNet/RakNetTypes.h>
 #include <RakNet/MessageIdentifiers.h>
+#include <string>
+#include <vector>
+
+#include "ConfusShared/InputCodec.h"
+#include "ConfusShared/PacketCompressor.h"
+#include "ConfusShared/SessionTable.h"
+#include "ConfusShared/TransformCodec.h"
 
 namespace ConfusServer
 {
@@ -18,15 +25,44 @@ namespace ConfusServer
         /// </remarks>
         class Connection
         {
+        public:
+            using SessionTable = ConfusShared::SessionTable<RakNet::SystemAddress>;
+            using Session = SessionTable::SessionType;
 		private:
 			/// <summary> The type of packet </summary>
 			enum class EPacketType : unsigned char
 			{
-				Message = 1 + ID_USER_PACKET_ENUM
+				Message = 1 + ID_USER_PACKET_ENUM,
+				Batch, ///< Several messages packed into a single datagram
+				CompressedBatch, ///< A batch compressed with the packet compressor
+				TimeRequest, ///< A client asking for the time on the shared timeline
+				TimeResponse, ///< The time on the shared timeline, with the local time of the client that asked
+				Input, ///< The last few inputs of a player, newest first
+				Transforms ///< Where the character of every client is after a tick
 			};
 
+            /// <summary>
+            /// The bytes of a datagram taken by the IP and UDP headers and the headers RakNet adds for a reliable ordered message,
+            /// which leave the rest of the MTU for the batched messages
+            /// </summary>
+            static const int DatagramOverhead = 64;
+
+            /// <summary> The amount of clients that can be connected at once </summary>
+            static const unsigned short MaxClients = 5;
+
             /// <summary> The RakNet interface for interacting with RakNet </summary>
             RakNet::RakPeerInterface* m_Interface = RakNet::RakPeerInterface::GetInstance();
+            /// <summary> A session for every connected client, which the rest of the server addresses them by </summary>
+            SessionTable m_Sessions{ MaxClients };
+            /// <summary> Compresses the batches sent and decompresses the ones received </summary>
+            ConfusShared::PacketCompressor m_Compressor;
+            /// <summary> Whether batches are sent compressed when that makes them smaller </summary>
+            bool m_CompressionEnabled = true;
+            /// <summary> The buffers datagrams are compressed into and decompressed into, kept to reuse their memory </summary>
+            std::vector<unsigned char> m_CompressedDatagram;
+            std::vector<unsigned char> m_DecompressedDatagram;
+            /// <summary> The time on the shared timeline while the current packets are processed </summary>
+            double m_Time = 0.0;
 
         public:
             /// <summary> Initializes a new instance of the <see cref="Connection"/> class. </summary>
@@ -37,7 +73,47 @@ namespace ConfusServer
             /// Processes the incoming packets from the clients to delegate them to the 
             /// requesting services
             /// </summary>
-            void processPackets();
+            /// <param name="a_Time">The time on the shared timeline, which time requests are answered with.</param>
+            void processPackets(double a_Time);
+            /// <summary>
+            /// Measures the link to every client and adjusts how much it may be sent accordingly.
+            /// </summary>
+            /// <param name="a_DeltaTime">The time in seconds since the send rates were last updated.</param>
+            void updateSendRates(float a_DeltaTime);
+            /// <summary>
+            /// Sends a message to a connected client.
+            /// </summary>
+            /// <param name="a_Client">The client to send to, nothing is sent if it has disconnected.</param>
+            /// <param name="a_Message">The message contents.</param>
+            /// <param name="a_Droppable">Whether the message may be dropped unsent when the client falls too far behind, like state a later message replaces.</param>
+            void sendMessage(ConfusShared::PeerHandle a_Client, const std::string& a_Message, bool a_Droppable = false);
+            /// <summary>
+            /// Sends the messages queued for every client, packed into as few datagrams as possible.
+            /// Sending to a client stops as soon as it has used up its send budget, the rest stays queued until a later flush.
+            /// Meant to be called once per network tick.
+            /// </summary>
+            void flushMessages();
+            /// <summary>
+            /// Sends every client where the characters of all clients are after a tick, straight away and unreliably,
+            /// as the transforms of the next tick replace them. A client that has used up its send budget is skipped.
+            /// Meant to be called once per fixed update, after the characters moved.
+            /// </summary>
+            /// <param name="a_Tick">The tick the characters were simulated up to.</param>
+            void sendTransforms(std::uint32_t a_Tick);
+            /// <summary>
+            /// Takes the input every client simulates this tick out of its jitter buffer into <see cref="Session::Input"/>.
+            /// Meant to be called once per fixed update, so the inputs are used up at the rate the clients sample them.
+            /// </summary>
+            void consumeInputs();
+            /// <summary>
+            /// Sets whether batches are sent compressed, compressed batches are received either way.
+            /// </summary>
+            /// <param name="a_Enabled">Whether to compress.</param>
+            void setCompressionEnabled(bool a_Enabled);
+            /// <summary>
+            /// Gets the sessions of the connected clients.
+            /// </summary>
+            SessionTable& getSessions();
 		private:
 			/// <summary> Gets the amount of clients connected to this server instance </summary>
 			/// <returns>The amount of clients connected</returns>
@@ -47,11 +123,52 @@ namespace ConfusServer
 			/// </summary>
 			void closeAllConnections();			
 			/// <summary>
+			/// Opens a session for a client that connected.
+			/// </summary>
+			/// <param name="a_Packet">The packet announcing the connection.</param>
+			void openSession(RakNet::Packet* a_Packet);
+			/// <summary>
+			/// Closes the session of a client that disconnected or timed out.
+			/// </summary>
+			/// <param name="a_Packet">The packet announcing the disconnection.</param>
+			void closeSession(RakNet::Packet* a_Packet);
+			/// <summary>
 			/// Handles the incoming packet
 			/// </summary>
 			/// <param name="a_Packet">The packet.</param>
 			void handlePacket(RakNet::Packet* a_Packet);			
 			/// <summary>
+			/// Answers a client asking for the time on the shared timeline, straight away as the answer is only accurate
+			/// when it is not held up.
+			/// </summary>
+			/// <param name="a_Packet">The request.</param>
+			void answerTimeRequest(RakNet::Packet* a_Packet);
+			/// <summary>
+			/// Adds the inputs sent by a client to its jitter buffer, the ones it already has are ignored.
+			/// </summary>
+			/// <param name="a_Packet">The inputs.</param>
+			void handleInput(RakNet::Packet* a_Packet);
+			/// <summary>
+			/// Sends a batch to a client, compressed if compression is enabled and makes it smaller
+			/// </summary>
+			/// <param name="a_Address">The address of the client.</param>
+			/// <param name="a_Datagram">The batch, starting with its packet id.</param>
+			/// <param name="a_Size">The size of the batch in bytes.</param>
+			/// <returns>The size of the datagram that was sent.</returns>
+			size_t sendBatch(const RakNet::SystemAddress& a_Address, const unsigned char* a_Datagram, size_t a_Size);
+			/// <summary>
+			/// Handles every message in a batch sent by a client
+			/// </summary>
+			/// <param name="a_Datagram">The batch, starting with its packet id.</param>
+			/// <param name="a_Size">The size of the batch in bytes.</param>
+			void handleBatch(const unsigned char* a_Datagram, size_t a_Size);
+			/// <summary>
+			/// Handles a message sent by a client, on its own or as part of a batch
+			/// </summary>
+			/// <param name="a_Data">The message, starting with its packet id.</param>
+			/// <param name="a_Size">The size of the message in bytes.</param>
+			void handleMessage(const unsigned char* a_Data, size_t a_Size);
+			/// <summary>
 			/// Prints the message.
 			/// </summary>
 			/// <param name="a_Message">The a_ message.</param>
@@ -9,11 +9,11 @@ namespace ConfusServer
     const irr::u32 Player::WeaponJointIndex = 14u;
     const unsigned Player::LightAttackDamage = 10u;
     const unsigned Player::HeavyAttackDamage = 30u;
-	Player::Player(irr::IrrlichtDevice* a_Device, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer)
-		: m_Weapon(a_Device->getSceneManager(), irr::core::vector3df(1.0f, 1.0f, 4.0f)),
-		irr::scene::ISceneNode(nullptr, a_Device->getSceneManager(), a_id),
-		TeamIdentifier(new ETeamIdentifier(a_TeamIdentifier)),
-		CarryingFlag(new EFlagEnum(EFlagEnum::None))
+	Player::Player(irr::IrrlichtDevice* a_Device, Entities::EntityStore& a_EntityStore, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer)
+		: irr::scene::ISceneNode(nullptr, a_Device->getSceneManager(), a_id),
+		m_EntityStore(a_EntityStore),
+		m_Entity(a_EntityStore.create()),
+		m_Weapon(a_Device->getSceneManager(), irr::core::vector3df(1.0f, 1.0f, 4.0f))
     {
         auto sceneManager = a_Device->getSceneManager();
         auto videoDriver = a_Device->getVideoDriver();
@@ -43,6 +43,11 @@ namespace ConfusServer
             PlayerNode->setMaterialTexture(0, videoDriver->getTexture("Media/nskinrd.jpg"));
         }
 
+        m_EntityStore.Transforms.add(m_Entity, { PlayerNode });
+        m_EntityStore.Teams.add(m_Entity, { a_TeamIdentifier });
+        m_EntityStore.Healths.add(m_Entity, Health());
+        m_EntityStore.FlagCarriers.add(m_Entity, Entities::FlagCarrierComponent());
+
         m_KeyMap[0].Action = irr::EKA_MOVE_FORWARD;
         m_KeyMap[0].KeyCode = irr::KEY_KEY_W;
 
@@ -73,10 +78,14 @@ namespace ConfusServer
     }
 
 	Player::~Player() {
-		delete(CarryingFlag);
-		delete(TeamIdentifier);
+		m_EntityStore.destroy(m_Entity);
 	}
 
+    Entities::Entity Player::getEntity() const
+    {
+        return m_Entity;
+    }
+
     const irr::core::aabbox3d<irr::f32>& Player::getBoundingBox() const
     {
         return m_Mesh->getBoundingBox();
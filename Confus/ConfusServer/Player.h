@@ -1,6 +1,6 @@
 #pragma once
 #include <irrlicht/irrlicht.h>
-#include "Health.h"
+#include "Entities\EntityStore.h"
 #include "Weapon.h"
 
 namespace ConfusServer {
@@ -10,10 +10,7 @@ namespace ConfusServer {
 		class PlayerAudioEmitter;
 	}
 
-    enum class EFlagEnum;
-	enum class ETeamIdentifier;
     class EventManager;
-    class Flag;
 
     class Player : irr::scene::IAnimationEndCallBack, public irr::scene::ISceneNode
     {   
@@ -21,10 +18,11 @@ namespace ConfusServer {
 		/// <summary> The IAnimatedMeshSceneNode for the player </summary>
         irr::scene::IAnimatedMeshSceneNode* PlayerNode;
         irr::scene::ICameraSceneNode* CameraNode = nullptr;
-		EFlagEnum* CarryingFlag;
-		ETeamIdentifier* TeamIdentifier;    
-        Flag* FlagPointer;
 	private:
+        /// <summary> The store holding the team, health and flag state of the player </summary>
+        Entities::EntityStore& m_EntityStore;
+        /// <summary> The player's entity </summary>
+        Entities::Entity m_Entity;
         Audio::PlayerAudioEmitter* m_FootstepSoundEmitter;
 
         void createAudioEmitter();
@@ -32,7 +30,6 @@ namespace ConfusServer {
         static const irr::u32 WeaponJointIndex;
         static const unsigned LightAttackDamage;
         static const unsigned HeavyAttackDamage;
-	    Health PlayerHealth;
         /// <summary> The player's weapon </summary>
         Weapon m_Weapon;
         /// <summary> Whether the player is currently attacking or not </summary>
@@ -40,8 +37,10 @@ namespace ConfusServer {
         /// <summary> The player's mesh </summary>
         irr::scene::IAnimatedMesh* m_Mesh;
     public:
-        Player(irr::IrrlichtDevice* a_Device, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer);
+        Player(irr::IrrlichtDevice* a_Device, Entities::EntityStore& a_EntityStore, irr::s32 a_id, ETeamIdentifier a_TeamIdentifier, bool a_MainPlayer);
 		~Player();
+        /// <summary> Gets the entity holding the team, health and flag state of the player </summary>
+        Entities::Entity getEntity() const;
         void fixedUpdate();
         void update();
         virtual void render();
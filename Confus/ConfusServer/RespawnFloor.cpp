@@ -0,0 +1,48 @@
+#include "RespawnFloor.h"
+
+namespace ConfusServer
+{
+    RespawnFloor::RespawnFloor(irr::IrrlichtDevice* a_Device, const SolidityEvents& a_SolidityEvents)
+        : m_SolidityEvents(a_SolidityEvents)
+    {
+        auto sceneManager = a_Device->getSceneManager();
+        m_FloorNode = sceneManager->addAnimatedMeshSceneNode(sceneManager->getMesh("Media/BaseGlassFloor.irrmesh"), nullptr);
+        m_FloorNode->setScale(irr::core::vector3df(5.5f, 0.1f, 10.f));
+        m_TriangleSelector = sceneManager->createTriangleSelector(m_FloorNode);
+        m_FloorNode->setTriangleSelector(m_TriangleSelector);
+    }
+
+    RespawnFloor::~RespawnFloor()
+    {
+        m_FloorNode->remove();
+        m_TriangleSelector->drop();
+    }
+
+    void RespawnFloor::setPosition(irr::core::vector3df a_NewPosition)
+    {
+        m_FloorNode->setPosition(a_NewPosition);
+    }
+
+    void RespawnFloor::enableCollision()
+    {
+        //The floor is only switched when its state actually changes, no matter how often this is called
+        if(m_Solid)
+        {
+            return;
+        }
+        m_Solid = true;
+        m_FloorNode->setTriangleSelector(m_TriangleSelector);
+        m_SolidityEvents.publish({ m_TriangleSelector, ESolidityChange::BecameSolid });
+    }
+
+    void RespawnFloor::disableCollision()
+    {
+        if(!m_Solid)
+        {
+            return;
+        }
+        m_Solid = false;
+        m_FloorNode->setTriangleSelector(nullptr);
+        m_SolidityEvents.publish({ m_TriangleSelector, ESolidityChange::BecamePassable });
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include "SolidityEvents.h"
+
+namespace ConfusServer
+{
+    /// <summary>
+    /// The glass floor above the spawn of a team, which is passable while the maze schedule has it open.
+    /// Like the maze walls it collides through its own selector, which it takes away while it is passable.
+    /// </summary>
+    class RespawnFloor
+    {
+    private:
+        const SolidityEvents& m_SolidityEvents;
+        irr::scene::IAnimatedMeshSceneNode* m_FloorNode;
+        irr::scene::ITriangleSelector* m_TriangleSelector;
+        bool m_Solid = true;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="RespawnFloor"/> class, with the same mesh and scale as the floor of the client.
+        /// </summary>
+        /// <param name="a_Device">The active irrlichtdevice in this context.</param>
+        /// <param name="a_SolidityEvents">Where the floor becoming solid or passable is published, which has to outlive this.</param>
+        RespawnFloor(irr::IrrlichtDevice* a_Device, const SolidityEvents& a_SolidityEvents);
+        /// <summary>
+        /// Finalizes an instance of the <see cref="RespawnFloor"/> class.
+        /// </summary>
+        ~RespawnFloor();
+        RespawnFloor(const RespawnFloor&) = delete;
+        RespawnFloor& operator=(const RespawnFloor&) = delete;
+
+        void setPosition(irr::core::vector3df a_NewPosition);
+        void enableCollision();
+        void disableCollision();
+    };
+}
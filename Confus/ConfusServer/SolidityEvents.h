@@ -0,0 +1,13 @@
+#pragma once
+#include <Irrlicht/irrlicht.h>
+#include "ConfusShared/SolidityEvents.h"
+
+namespace ConfusServer
+{
+    using ConfusShared::ESolidityChange;
+    /// <summary>
+    /// The solidity changes of the level, which the walls and floors publish with the triangle selector they collide through
+    /// </summary>
+    using SolidityEvents = ConfusShared::SolidityEvents<irr::scene::ITriangleSelector*>;
+    using SolidityEvent = SolidityEvents::Event;
+}
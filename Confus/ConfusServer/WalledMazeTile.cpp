@@ -3,8 +3,8 @@
 namespace ConfusServer
 {
 
-	WalledMazeTile::WalledMazeTile(irr::IrrlichtDevice* a_Device, irr::core::vector3df a_RealPosition, irr::core::vector3df a_HiddenPosition)
-		:m_Wall(a_Device, a_RealPosition, a_HiddenPosition)
+	WalledMazeTile::WalledMazeTile(irr::IrrlichtDevice* a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_RealPosition, irr::core::vector3df a_HiddenPosition)
+		:m_Wall(a_Device, a_SolidityEvents, a_RealPosition, a_HiddenPosition)
 	{
 	}
 
@@ -18,9 +18,10 @@ namespace ConfusServer
 		/// Constructor that creates a moveableWall in a mazeTile
 		/// </summary>
 		/// <param name="a_Device">The current Irrlicht device.</param>
+		/// <param name="a_SolidityEvents">Where the walls becoming solid or passable are published.</param>
 		/// <param name="a_RealPosition">The position of the wall when it is raised</param>
 		/// <param name="a_HiddenPosition">The position of the wall when it is lowered</param>
-		WalledMazeTile(irr::IrrlichtDevice * a_Device, irr::core::vector3df a_RealPosition, irr::core::vector3df a_HiddenPosition);
+		WalledMazeTile(irr::IrrlichtDevice * a_Device, const SolidityEvents& a_SolidityEvents, irr::core::vector3df a_RealPosition, irr::core::vector3df a_HiddenPosition);
 
 		/// <summary>
 		/// The fixed update used to update the state of the walledMazeTile
@@ -0,0 +1,174 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "ConfusShared/CharacterController.h"
+#include "ConfusShared/Random.h"
+
+namespace
+{
+    using ConfusShared::Triangle;
+    using ConfusShared::Vector3;
+
+    const float TickLength = 0.02f;
+
+    void addQuad(std::vector<Triangle>& a_Triangles, const Vector3& a_A, const Vector3& a_B, const Vector3& a_C, const Vector3& a_D)
+    {
+        a_Triangles.push_back({ a_A, a_B, a_C });
+        a_Triangles.push_back({ a_A, a_C, a_D });
+    }
+
+    void addBox(std::vector<Triangle>& a_Triangles, const Vector3& a_Minimum, const Vector3& a_Maximum)
+    {
+        const Vector3& n = a_Minimum;
+        const Vector3& x = a_Maximum;
+        addQuad(a_Triangles, { n.X, x.Y, n.Z }, { n.X, x.Y, x.Z }, { x.X, x.Y, x.Z }, { x.X, x.Y, n.Z });
+        addQuad(a_Triangles, { n.X, n.Y, n.Z }, { x.X, n.Y, n.Z }, { x.X, n.Y, x.Z }, { n.X, n.Y, x.Z });
+        addQuad(a_Triangles, { n.X, n.Y, n.Z }, { n.X, x.Y, n.Z }, { x.X, x.Y, n.Z }, { x.X, n.Y, n.Z });
+        addQuad(a_Triangles, { n.X, n.Y, x.Z }, { x.X, n.Y, x.Z }, { x.X, x.Y, x.Z }, { n.X, x.Y, x.Z });
+        addQuad(a_Triangles, { n.X, n.Y, n.Z }, { n.X, n.Y, x.Z }, { n.X, x.Y, x.Z }, { n.X, x.Y, n.Z });
+        addQuad(a_Triangles, { x.X, n.Y, n.Z }, { x.X, x.Y, n.Z }, { x.X, x.Y, x.Z }, { x.X, n.Y, x.Z });
+    }
+
+    /// <summary>
+    /// Builds a level like the real one: a walled in floor with a maze of wall blocks on it, and along its edge a staircase and two ramps
+    /// that each lead up onto a platform.
+    /// Every fourth wall is a body of its own that is made passable, like a lowered maze wall.
+    /// </summary>
+    void buildLevel(ConfusShared::CollisionWorld& a_World)
+    {
+        std::vector<Triangle> triangles;
+        addQuad(triangles, { -60.0f, 0.0f, -60.0f }, { -60.0f, 0.0f, 60.0f }, { 60.0f, 0.0f, 60.0f }, { 60.0f, 0.0f, -60.0f });
+        addBox(triangles, { -61.0f, 0.0f, -61.0f }, { 61.0f, 5.0f, -60.0f });
+        addBox(triangles, { -61.0f, 0.0f, 60.0f }, { 61.0f, 5.0f, 61.0f });
+        addBox(triangles, { -61.0f, 0.0f, -60.0f }, { -60.0f, 5.0f, 60.0f });
+        addBox(triangles, { 60.0f, 0.0f, -60.0f }, { 61.0f, 5.0f, 60.0f });
+        for(int step = 0; step < 10; ++step)
+        {
+            addBox(triangles, { -50.0f + step * 0.5f, 0.0f, 50.0f }, { -49.5f + step * 0.5f, 0.3f * (step + 1), 58.0f });
+        }
+        addBox(triangles, { -45.0f, 0.0f, 50.0f }, { -35.0f, 3.0f, 58.0f });
+        addQuad(triangles, { 0.0f, 0.0f, 50.0f }, { 0.0f, 0.0f, 58.0f }, { 10.0f, 5.77f, 58.0f }, { 10.0f, 5.77f, 50.0f });
+        addBox(triangles, { 10.0f, 0.0f, 50.0f }, { 20.0f, 5.77f, 58.0f });
+        addQuad(triangles, { 30.0f, 0.0f, 50.0f }, { 30.0f, 0.0f, 58.0f }, { 33.0f, 5.2f, 58.0f }, { 33.0f, 5.2f, 50.0f });
+        addBox(triangles, { 33.0f, 0.0f, 50.0f }, { 43.0f, 5.2f, 58.0f });
+        a_World.addBody(triangles.data(), triangles.size());
+
+        int wall = 0;
+        for(float x = -48.0f; x < 48.0f; x += 6.0f)
+        {
+            for(float z = -48.0f; z < 40.0f; z += 6.0f, ++wall)
+            {
+                triangles.clear();
+                addBox(triangles, { x, 0.0f, z }, { x + 3.0f, 3.0f, z + 0.5f });
+                a_World.addBody(triangles.data(), triangles.size(), wall % 4 != 0);
+            }
+        }
+        a_World.build();
+    }
+
+    /// <summary>
+    /// Simulates every character for the given amount of ticks, each steering somewhere else now and then.
+    /// </summary>
+    void simulate(const ConfusShared::CharacterController& a_Controller, const ConfusShared::CollisionWorld& a_World,
+        std::vector<ConfusShared::CharacterState>& a_States, std::size_t a_TickCount, std::uint32_t a_Seed)
+    {
+        ConfusShared::Random random(a_Seed);
+        std::vector<ConfusShared::PlayerInput> inputs(a_States.size());
+        for(std::size_t tick = 0; tick < a_TickCount; ++tick)
+        {
+            for(std::size_t i = 0; i < a_States.size(); ++i)
+            {
+                ConfusShared::PlayerInput& input = inputs[i];
+                if(random.nextBelow(30) == 0)
+                {
+                    input.Buttons = static_cast<std::uint16_t>(random.nextBelow(32));
+                    input.Yaw = static_cast<float>(random.nextBelow(360));
+                }
+                input.Tick = static_cast<std::uint32_t>(tick);
+                a_Controller.simulate(a_States[i], input, a_World, TickLength);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Walks a single character forward from a position and gets where it ends up.
+    /// </summary>
+    ConfusShared::CharacterState walk(const ConfusShared::CharacterController& a_Controller, const ConfusShared::CollisionWorld& a_World,
+        const Vector3& a_Start, float a_Yaw, std::size_t a_TickCount)
+    {
+        ConfusShared::CharacterState state;
+        state.Position = a_Start;
+        ConfusShared::PlayerInput input;
+        input.Yaw = a_Yaw;
+        input.setHeld(ConfusShared::EInputButton::MoveForward, true);
+        for(std::size_t tick = 0; tick < a_TickCount; ++tick)
+        {
+            a_Controller.simulate(state, input, a_World, TickLength);
+        }
+        return state;
+    }
+}
+
+/// <summary>
+/// Measures how many characters a single core simulates per tick, checks that two runs from the same state end up
+/// in exactly the same place, and checks that characters climb stairs and shallow ramps but not steep ones.
+/// </summary>
+int main()
+{
+    const std::size_t CharacterCount = 500;
+    const std::size_t TickCount = 1000;
+
+    ConfusShared::CollisionWorld world;
+    buildLevel(world);
+    ConfusShared::CharacterController controller;
+
+    std::vector<ConfusShared::CharacterState> states(CharacterCount);
+    ConfusShared::Random random(42u);
+    for(ConfusShared::CharacterState& state : states)
+    {
+        state.Position = Vector3(static_cast<float>(random.nextBelow(100)) - 50.0f, 1.0f, static_cast<float>(random.nextBelow(90)) - 50.0f);
+    }
+    std::vector<ConfusShared::CharacterState> replay = states;
+
+    auto start = std::chrono::steady_clock::now();
+    simulate(controller, world, states, TickCount, 7u);
+    auto time = std::chrono::steady_clock::now() - start;
+    simulate(controller, world, replay, TickCount, 7u);
+
+    std::size_t fallenThrough = 0;
+    for(std::size_t i = 0; i < CharacterCount; ++i)
+    {
+        if(std::memcmp(&states[i].Position, &replay[i].Position, sizeof(Vector3)) != 0
+            || std::memcmp(&states[i].Velocity, &replay[i].Velocity, sizeof(Vector3)) != 0)
+        {
+            std::cerr << "Character " << i << " did not end up in the same place twice" << std::endl;
+            return 1;
+        }
+        if(states[i].Position.Y < -0.01f)
+        {
+            ++fallenThrough;
+        }
+    }
+
+    double nanosecondsPerTick = std::chrono::duration<double, std::nano>(time).count() / (CharacterCount * TickCount);
+    std::cout << "Simulated " << CharacterCount << " characters for " << TickCount << " ticks against "
+        << world.getTriangleCount() << " triangles" << std::endl;
+    std::cout << "  " << nanosecondsPerTick / 1000.0 << " us per character per tick, "
+        << static_cast<std::size_t>(TickLength * 1e9 / nanosecondsPerTick) << " characters per core at 50 ticks per second" << std::endl;
+    std::cout << "  " << fallenThrough << " characters fell through the floor" << std::endl;
+
+    float stairsHeight = walk(controller, world, Vector3(-52.0f, 0.0f, 54.0f), 90.0f, 50).Position.Y;
+    float shallowHeight = walk(controller, world, Vector3(-2.0f, 0.0f, 54.0f), 90.0f, 50).Position.Y;
+    float steepHeight = walk(controller, world, Vector3(28.0f, 0.0f, 54.0f), 90.0f, 50).Position.Y;
+    std::cout << "  Walking forward for a second ends up " << stairsHeight << " high on the stairs, "
+        << shallowHeight << " on the 30 degree ramp and " << steepHeight << " on the 60 degree ramp" << std::endl;
+    if(fallenThrough > 0 || stairsHeight < 2.9f || shallowHeight < 4.0f || steepHeight > 0.5f)
+    {
+        std::cerr << "The characters did not move through the level as they should" << std::endl;
+        return 1;
+    }
+    return 0;
+}
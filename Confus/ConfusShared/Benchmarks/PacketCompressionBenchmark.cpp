@@ -0,0 +1,162 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ConfusShared/BitBuffer.h"
+#include "ConfusShared/FrameArena.h"
+#include "ConfusShared/MazeLayout.h"
+#include "ConfusShared/MessageBatch.h"
+#include "ConfusShared/PacketCompressor.h"
+#include "ConfusShared/Random.h"
+#include "ConfusShared/Teams.h"
+#include "ConfusShared/TransformCodec.h"
+
+namespace
+{
+    /// <summary> The packet ids of the connections, the first id RakNet leaves to the game is 134 </summary>
+    const std::uint8_t MessageId = 135;
+    const std::uint8_t BatchId = 136;
+    const std::size_t MaxDatagramSize = 1400;
+
+    /// <summary>
+    /// Builds the datagrams a server would send a single client during a match: a snapshot of every player each tick,
+    /// the layout of the maze whenever it is refilled and now and then a chat line.
+    /// </summary>
+    std::vector<std::vector<std::uint8_t>> simulateTraffic(std::uint32_t a_Seed, std::size_t a_TickCount)
+    {
+        const std::size_t PlayerCount = 10;
+        ConfusShared::Random random(a_Seed);
+        ConfusShared::FrameArena arena;
+        ConfusShared::MazeLayout maze(60, 60);
+        ConfusShared::MessageBatch batch;
+        std::vector<std::vector<std::uint8_t>> datagrams;
+        std::vector<ConfusShared::QuantizedTransform> transforms(PlayerCount);
+        std::vector<ConfusShared::QuantizedTransform> baselines(PlayerCount);
+        std::vector<std::uint8_t> message;
+
+        for(std::size_t tick = 0; tick < a_TickCount; ++tick)
+        {
+            ConfusShared::BitBuffer snapshot;
+            for(std::size_t player = 0; player < PlayerCount; ++player)
+            {
+                ConfusShared::QuantizedTransform& transform = transforms[player];
+                transform.X = (transform.X + random.nextBelow(5) - 2) & 0x1FFF;
+                transform.Z = (transform.Z + random.nextBelow(5) - 2) & 0x1FFF;
+                transform.Yaw = (transform.Yaw + random.nextBelow(3) - 1) & 0xFF;
+                transform.Pitch = (transform.Pitch + random.nextBelow(3) - 1) & 0x1F;
+                ConfusShared::writeBits(snapshot, static_cast<std::uint32_t>(player < PlayerCount / 2
+                    ? ConfusShared::ETeamIdentifier::TeamRed : ConfusShared::ETeamIdentifier::TeamBlue), 2);
+                ConfusShared::writeBits(snapshot, static_cast<std::uint32_t>(player == 0
+                    ? ConfusShared::EFlagEnum::FlagTaken : ConfusShared::EFlagEnum::None), 2);
+                ConfusShared::TransformCodec::writeDelta(snapshot, transform, baselines[player]);
+            }
+            //The client acknowledges a snapshot about every 6 ticks, which moves the baseline along
+            if(tick % 6 == 0)
+            {
+                baselines = transforms;
+            }
+            message.assign({ MessageId, static_cast<std::uint8_t>(tick), static_cast<std::uint8_t>(tick >> 8), 0, 0 });
+            message.insert(message.end(), snapshot.getData(), snapshot.getData() + snapshot.getWrittenBytes());
+            batch.add(message.data(), message.size());
+
+            if(tick % 540 == 0)
+            {
+                maze.generate(static_cast<std::int32_t>(random.next() & 0x7FFFFFFF), arena);
+                ConfusShared::BitBuffer layout;
+                for(std::size_t x = 0; x < maze.getWidth(); ++x)
+                {
+                    for(std::size_t y = 0; y < maze.getHeight(); ++y)
+                    {
+                        ConfusShared::writeBits(layout, maze.isRaised(x, y) ? 1u : 0u, 1);
+                    }
+                }
+                arena.reset();
+                message.assign({ MessageId });
+                message.insert(message.end(), layout.getData(), layout.getData() + layout.getWrittenBytes());
+                batch.add(message.data(), message.size());
+            }
+            if(random.nextBelow(120) == 0)
+            {
+                std::string line = "Player " + std::to_string(random.nextBelow(PlayerCount)) + " has taken the flag";
+                message.assign({ MessageId });
+                message.insert(message.end(), line.begin(), line.end());
+                batch.add(message.data(), message.size());
+            }
+
+            batch.flush(BatchId, MaxDatagramSize, [&datagrams](const std::uint8_t* a_Datagram, std::size_t a_Size)
+            {
+                datagrams.emplace_back(a_Datagram, a_Datagram + a_Size);
+            });
+        }
+        return datagrams;
+    }
+}
+
+/// <summary>
+/// Measures how much the packet compressor saves on simulated match traffic and what it costs.
+/// Run with --train to print the byte frequencies of the traffic, to replace the default model with.
+/// </summary>
+int main(int a_ArgumentCount, char** a_Arguments)
+{
+    const std::size_t TickCount = 60 * 60 * 5;
+
+    if(a_ArgumentCount > 1 && std::strcmp(a_Arguments[1], "--train") == 0)
+    {
+        ConfusShared::PacketCompressor::Frequencies frequencies = {};
+        for(const auto& datagram : simulateTraffic(1u, TickCount))
+        {
+            //The packet id is not compressed, so it is left out of the model
+            ConfusShared::PacketCompressor::train(datagram.data() + 1, datagram.size() - 1, frequencies);
+        }
+        for(std::size_t i = 0; i < frequencies.size(); ++i)
+        {
+            std::cout << frequencies[i] << (i + 1 < frequencies.size() ? (i % 16 == 15 ? ",\n" : ", ") : "\n");
+        }
+        return 0;
+    }
+
+    //Measured on other traffic than the default model was trained on
+    std::vector<std::vector<std::uint8_t>> datagrams = simulateTraffic(2u, TickCount);
+    ConfusShared::PacketCompressor compressor;
+    std::vector<std::uint8_t> compressed;
+    std::vector<std::uint8_t> decompressed;
+    std::size_t originalBytes = 0;
+    std::size_t sentBytes = 0;
+    std::size_t compressedCount = 0;
+    std::chrono::steady_clock::duration compressTime(0);
+    std::chrono::steady_clock::duration decompressTime(0);
+    for(const auto& datagram : datagrams)
+    {
+        compressed.clear();
+        auto start = std::chrono::steady_clock::now();
+        bool wasCompressed = compressor.compress(datagram.data() + 1, datagram.size() - 1, compressed);
+        compressTime += std::chrono::steady_clock::now() - start;
+        originalBytes += datagram.size();
+        sentBytes += 1 + (wasCompressed ? compressed.size() : datagram.size() - 1);
+        if(!wasCompressed)
+        {
+            continue;
+        }
+
+        ++compressedCount;
+        decompressed.clear();
+        start = std::chrono::steady_clock::now();
+        compressor.decompress(compressed.data(), compressed.size(), decompressed);
+        decompressTime += std::chrono::steady_clock::now() - start;
+        if(decompressed.size() != datagram.size() - 1 || !std::equal(decompressed.begin(), decompressed.end(), datagram.begin() + 1))
+        {
+            std::cerr << "A datagram did not survive compression" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << datagrams.size() << " datagrams, " << compressedCount << " compressed" << std::endl;
+    std::cout << originalBytes << " bytes sent as " << sentBytes << " bytes, "
+        << 100.0 * (originalBytes - sentBytes) / originalBytes << "% saved" << std::endl;
+    std::cout << std::chrono::duration<double, std::nano>(compressTime).count() / originalBytes << " ns per byte to compress, "
+        << std::chrono::duration<double, std::nano>(decompressTime).count() / originalBytes << " ns per byte to decompress" << std::endl;
+    return 0;
+}
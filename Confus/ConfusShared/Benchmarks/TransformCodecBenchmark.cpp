@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "ConfusShared/BitBuffer.h"
+#include "ConfusShared/Random.h"
+#include "ConfusShared/TransformCodec.h"
+
+namespace
+{
+    float nextFloat(ConfusShared::Random& a_Random, float a_Minimum, float a_Maximum)
+    {
+        return a_Minimum + (a_Maximum - a_Minimum) * (a_Random.nextBelow(1u << 20) / static_cast<float>(1u << 20));
+    }
+
+    float getAngleError(float a_First, float a_Second)
+    {
+        float difference = std::fabs(std::fmod(a_First - a_Second + 540.0f, 360.0f) - 180.0f);
+        return difference;
+    }
+
+    double getNanosecondsPer(std::chrono::steady_clock::duration a_Duration, std::size_t a_Count)
+    {
+        return std::chrono::duration<double, std::nano>(a_Duration).count() / a_Count;
+    }
+}
+
+/// <summary>
+/// Measures how fast player transforms are encoded and decoded, how many bits they take and how much precision is lost.
+/// The transforms follow players walking around the level, so the deltas between ticks are as small as in a match.
+/// </summary>
+int main()
+{
+    using ConfusShared::TransformCodec;
+    const std::size_t PlayerCount = 10;
+    const std::size_t TickCount = 20000;
+
+    ConfusShared::Random random(1234u);
+    std::vector<ConfusShared::PlayerTransform> transforms(PlayerCount * TickCount);
+    for(std::size_t player = 0; player < PlayerCount; ++player)
+    {
+        ConfusShared::PlayerTransform transform;
+        transform.X = nextFloat(random, TransformCodec::MinimumX, TransformCodec::MaximumX);
+        transform.Y = 3.45f;
+        transform.Z = nextFloat(random, TransformCodec::MinimumZ, TransformCodec::MaximumZ);
+        for(std::size_t tick = 0; tick < TickCount; ++tick)
+        {
+            //About 5 units per second at 60 ticks per second, turning and looking around a little every tick
+            transform.X = std::min(std::max(transform.X + nextFloat(random, -0.08f, 0.08f), TransformCodec::MinimumX), TransformCodec::MaximumX);
+            transform.Z = std::min(std::max(transform.Z + nextFloat(random, -0.08f, 0.08f), TransformCodec::MinimumZ), TransformCodec::MaximumZ);
+            transform.Yaw = std::fmod(transform.Yaw + nextFloat(random, -3.0f, 3.0f) + 360.0f, 360.0f);
+            transform.Pitch = std::min(std::max(transform.Pitch + nextFloat(random, -2.0f, 2.0f), -89.0f), 89.0f);
+            transforms[tick * PlayerCount + player] = transform;
+        }
+    }
+
+    ConfusShared::BitBuffer buffer;
+    std::vector<ConfusShared::QuantizedTransform> quantized(transforms.size());
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < transforms.size(); ++i)
+    {
+        quantized[i] = TransformCodec::quantize(transforms[i]);
+        TransformCodec::write(buffer, quantized[i]);
+    }
+    auto encodeTime = std::chrono::steady_clock::now() - start;
+    std::size_t fullBits = buffer.getWrittenBits();
+
+    float largestPositionError = 0.0f;
+    float largestAngleError = 0.0f;
+    start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < transforms.size(); ++i)
+    {
+        ConfusShared::PlayerTransform decoded = TransformCodec::dequantize(TransformCodec::read(buffer));
+        largestPositionError = std::max({ largestPositionError, std::fabs(decoded.X - transforms[i].X),
+            std::fabs(decoded.Y - transforms[i].Y), std::fabs(decoded.Z - transforms[i].Z) });
+        largestAngleError = std::max({ largestAngleError, getAngleError(decoded.Yaw, transforms[i].Yaw),
+            std::fabs(decoded.Pitch - transforms[i].Pitch) });
+    }
+    auto decodeTime = std::chrono::steady_clock::now() - start;
+
+    buffer.clear();
+    start = std::chrono::steady_clock::now();
+    for(std::size_t i = PlayerCount; i < quantized.size(); ++i)
+    {
+        TransformCodec::writeDelta(buffer, quantized[i], quantized[i - PlayerCount]);
+    }
+    auto deltaEncodeTime = std::chrono::steady_clock::now() - start;
+    std::size_t deltaBits = buffer.getWrittenBits();
+    start = std::chrono::steady_clock::now();
+    for(std::size_t i = PlayerCount; i < quantized.size(); ++i)
+    {
+        if(TransformCodec::readDelta(buffer, quantized[i - PlayerCount]) != quantized[i])
+        {
+            std::cerr << "Transform " << i << " did not survive delta encoding" << std::endl;
+            return 1;
+        }
+    }
+    auto deltaDecodeTime = std::chrono::steady_clock::now() - start;
+    std::size_t deltaCount = quantized.size() - PlayerCount;
+
+    float largestRotationError = 0.0f;
+    for(std::size_t i = 0; i < 10000; ++i)
+    {
+        ConfusShared::Quaternion rotation;
+        rotation.X = nextFloat(random, -1.0f, 1.0f);
+        rotation.Y = nextFloat(random, -1.0f, 1.0f);
+        rotation.Z = nextFloat(random, -1.0f, 1.0f);
+        rotation.W = nextFloat(random, -1.0f, 1.0f);
+        float length = std::sqrt(rotation.X * rotation.X + rotation.Y * rotation.Y + rotation.Z * rotation.Z + rotation.W * rotation.W);
+        rotation.X /= length;
+        rotation.Y /= length;
+        rotation.Z /= length;
+        rotation.W /= length;
+        buffer.clear();
+        TransformCodec::writeRotation(buffer, rotation);
+        ConfusShared::Quaternion decoded = TransformCodec::readRotation(buffer);
+        //The angle between two rotations follows from the dot product of their quaternions
+        float dot = std::fabs(rotation.X * decoded.X + rotation.Y * decoded.Y + rotation.Z * decoded.Z + rotation.W * decoded.W);
+        largestRotationError = std::max(largestRotationError, 2.0f * std::acos(std::min(dot, 1.0f)) * 57.2957795f);
+    }
+
+    std::cout << "Full transforms:  " << fullBits / static_cast<double>(transforms.size()) << " bits, "
+        << getNanosecondsPer(encodeTime, transforms.size()) << " ns to encode, "
+        << getNanosecondsPer(decodeTime, transforms.size()) << " ns to decode" << std::endl;
+    std::cout << "Delta transforms: " << deltaBits / static_cast<double>(deltaCount) << " bits, "
+        << getNanosecondsPer(deltaEncodeTime, deltaCount) << " ns to encode, "
+        << getNanosecondsPer(deltaDecodeTime, deltaCount) << " ns to decode" << std::endl;
+    std::cout << "Largest error: " << largestPositionError << " units, " << largestAngleError << " degrees, "
+        << largestRotationError << " degrees for rotations in " << 2 + 3 * TransformCodec::RotationComponentBits << " bits" << std::endl;
+    return 0;
+}
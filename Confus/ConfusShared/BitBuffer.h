@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A stream with the WriteBits and ReadBits of RakNet::BitStream, so the codecs can be measured and tested without RakNet
+    /// </summary>
+    class BitBuffer
+    {
+    private:
+        std::vector<std::uint64_t> m_Words;
+        std::size_t m_WrittenBits = 0;
+        std::size_t m_ReadBits = 0;
+    public:
+        /// <summary> Writes up to 32 bits, which is all the codec writes at once </summary>
+        void WriteBits(const unsigned char* a_Data, std::size_t a_Bits, bool)
+        {
+            std::uint64_t value = 0;
+            for(std::size_t byte = 0; byte * 8 < a_Bits; ++byte)
+            {
+                value |= static_cast<std::uint64_t>(a_Data[byte]) << (8 * byte);
+            }
+            value &= (1ull << a_Bits) - 1ull;
+
+            std::size_t offset = m_WrittenBits % 64;
+            if(offset == 0)
+            {
+                m_Words.push_back(0);
+            }
+            m_Words.back() |= value << offset;
+            if(offset + a_Bits > 64)
+            {
+                m_Words.push_back(value >> (64 - offset));
+            }
+            m_WrittenBits += a_Bits;
+        }
+
+        bool ReadBits(unsigned char* a_Data, std::size_t a_Bits, bool)
+        {
+            if(m_ReadBits + a_Bits > m_WrittenBits)
+            {
+                return false;
+            }
+            std::size_t offset = m_ReadBits % 64;
+            std::uint64_t value = m_Words[m_ReadBits / 64] >> offset;
+            if(offset + a_Bits > 64)
+            {
+                value |= m_Words[m_ReadBits / 64 + 1] << (64 - offset);
+            }
+            value &= (1ull << a_Bits) - 1ull;
+            for(std::size_t byte = 0; byte * 8 < a_Bits; ++byte)
+            {
+                a_Data[byte] = static_cast<unsigned char>(value >> (8 * byte));
+            }
+            m_ReadBits += a_Bits;
+            return true;
+        }
+
+        /// <summary> Copies the first bits that were written, as a packet that was cut off after them </summary>
+        /// <param name="a_Bits">The number of bits to copy, at most the number of written bits.</param>
+        BitBuffer getPrefix(std::size_t a_Bits) const
+        {
+            if(a_Bits > m_WrittenBits)
+            {
+                throw std::invalid_argument("Can not copy more bits than were written");
+            }
+            BitBuffer prefix;
+            prefix.m_Words.assign(m_Words.begin(), m_Words.begin() + (a_Bits + 63) / 64);
+            if(a_Bits % 64 != 0)
+            {
+                prefix.m_Words.back() &= (1ull << (a_Bits % 64)) - 1ull;
+            }
+            prefix.m_WrittenBits = a_Bits;
+            return prefix;
+        }
+
+        void clear()
+        {
+            m_Words.clear();
+            m_WrittenBits = 0;
+            m_ReadBits = 0;
+        }
+
+        /// <summary> Gets the written bytes, which are in the order they were written on a little endian machine </summary>
+        const std::uint8_t* getData() const
+        {
+            return reinterpret_cast<const std::uint8_t*>(m_Words.data());
+        }
+
+        /// <summary> Gets the size of the written bits in whole bytes </summary>
+        std::size_t getWrittenBytes() const
+        {
+            return (m_WrittenBits + 7) / 8;
+        }
+
+        std::size_t getWrittenBits() const
+        {
+            return m_WrittenBits;
+        }
+    };
+}
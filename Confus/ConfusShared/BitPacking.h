@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Writes the lowest bits of a value. The stream is anything with the WriteBits of RakNet::BitStream, so values go
+    /// straight into the packet being built without the shared code depending on RakNet.
+    /// </summary>
+    /// <param name="a_Stream">The stream to write to.</param>
+    /// <param name="a_Value">The value, of which the bits above a_Bits have to be zero.</param>
+    /// <param name="a_Bits">The amount of bits to write, up to 32.</param>
+    template<typename TBitStream>
+    void writeBits(TBitStream& a_Stream, std::uint32_t a_Value, unsigned a_Bits)
+    {
+        if(a_Bits == 0)
+        {
+            return;
+        }
+        //The bytes are spelled out lowest first, so the layout on the wire does not depend on the endianness of the machine
+        const unsigned char bytes[4] =
+        {
+            static_cast<unsigned char>(a_Value),
+            static_cast<unsigned char>(a_Value >> 8),
+            static_cast<unsigned char>(a_Value >> 16),
+            static_cast<unsigned char>(a_Value >> 24)
+        };
+        a_Stream.WriteBits(bytes, a_Bits, true);
+    }
+
+    /// <summary>
+    /// Reads a value written by <see cref="writeBits"/>.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">The stream ends before the value does.</exception>
+    template<typename TBitStream>
+    std::uint32_t readBits(TBitStream& a_Stream, unsigned a_Bits)
+    {
+        if(a_Bits == 0)
+        {
+            return 0;
+        }
+        unsigned char bytes[4] = {};
+        if(!a_Stream.ReadBits(bytes, a_Bits, true))
+        {
+            throw std::invalid_argument("The stream ended before the value did.");
+        }
+        return static_cast<std::uint32_t>(bytes[0]) | static_cast<std::uint32_t>(bytes[1]) << 8
+            | static_cast<std::uint32_t>(bytes[2]) << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    }
+
+    /// <summary>
+    /// Writes a value with a variable length, in groups of a_GroupBits that are each followed by a bit telling whether
+    /// another group follows. Small values take a single group, so this suits deltas that are mostly small.
+    /// </summary>
+    /// <param name="a_Stream">The stream to write to.</param>
+    /// <param name="a_Value">The value.</param>
+    /// <param name="a_GroupBits">The bits per group, from 1 up to 31.</param>
+    template<typename TBitStream>
+    void writeVarBits(TBitStream& a_Stream, std::uint32_t a_Value, unsigned a_GroupBits)
+    {
+        const std::uint32_t groupMask = (1u << a_GroupBits) - 1u;
+        while(a_Value > groupMask)
+        {
+            writeBits(a_Stream, (a_Value & groupMask) | (1u << a_GroupBits), a_GroupBits + 1);
+            a_Value >>= a_GroupBits;
+        }
+        writeBits(a_Stream, a_Value, a_GroupBits + 1);
+    }
+
+    /// <summary>
+    /// Reads a value written by <see cref="writeVarBits"/> with the same group size.
+    /// </summary>
+    /// <exception cref="std::invalid_argument">The stream ends before the value does, or the value does not fit 32 bits.</exception>
+    template<typename TBitStream>
+    std::uint32_t readVarBits(TBitStream& a_Stream, unsigned a_GroupBits)
+    {
+        const std::uint32_t groupMask = (1u << a_GroupBits) - 1u;
+        std::uint32_t value = 0;
+        for(unsigned shift = 0; shift < 32; shift += a_GroupBits)
+        {
+            std::uint32_t group = readBits(a_Stream, a_GroupBits + 1);
+            value |= (group & groupMask) << shift;
+            if((group >> a_GroupBits) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::invalid_argument("The variable length value does not fit in 32 bits.");
+    }
+}
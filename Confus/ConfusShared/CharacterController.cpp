@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "CharacterController.h"
+
+namespace ConfusShared
+{
+    namespace
+    {
+        const float DegreesToRadians = 3.14159265358979f / 180.0f;
+
+        float getHorizontalDistanceSquared(const Vector3& a_From, const Vector3& a_To)
+        {
+            float x = a_To.X - a_From.X;
+            float z = a_To.Z - a_From.Z;
+            return x * x + z * z;
+        }
+    }
+
+    const int CharacterController::MaxResolveIterations = 4;
+    const int CharacterController::MaxSubsteps = 16;
+
+    CharacterController::CharacterController(const CharacterSettings& a_Settings)
+        : m_Settings(a_Settings)
+    {
+        if(!(a_Settings.Radius > 0.0f) || a_Settings.Height < 2.0f * a_Settings.Radius)
+        {
+            throw std::invalid_argument("A character has to have a radius, and be at least as tall as it is wide.");
+        }
+    }
+
+    void CharacterController::simulate(CharacterState& a_State, const PlayerInput& a_Input, const CollisionWorld& a_World, float a_DeltaTime) const
+    {
+        if(!(a_DeltaTime > 0.0f))
+        {
+            throw std::invalid_argument("A character can only be simulated for a tick that takes time.");
+        }
+
+        Vector3& velocity = a_State.Velocity;
+        Vector3 wishVelocity = getWishDirection(a_Input) * m_Settings.WalkSpeed;
+        if(a_State.Grounded)
+        {
+            //On the ground the character goes where it is steered straight away, like the camera it replaces did
+            velocity.X = wishVelocity.X;
+            velocity.Z = wishVelocity.Z;
+            if(a_Input.isHeld(EInputButton::Jump))
+            {
+                velocity.Y = m_Settings.JumpSpeed;
+                a_State.Grounded = false;
+            }
+        }
+        else
+        {
+            float blend = std::min(m_Settings.AirControl * a_DeltaTime, 1.0f);
+            velocity.X += (wishVelocity.X - velocity.X) * blend;
+            velocity.Z += (wishVelocity.Z - velocity.Z) * blend;
+        }
+        velocity.Y = std::max(velocity.Y - m_Settings.Gravity * a_DeltaTime, -m_Settings.MaxFallSpeed);
+
+        const Vector3 start = a_State.Position;
+        const Vector3 horizontal(velocity.X * a_DeltaTime, 0.0f, velocity.Z * a_DeltaTime);
+        MoveResult walked = move(start, horizontal, a_World);
+        if(a_State.Grounded && walked.HitWall && m_Settings.StepHeight > 0.0f)
+        {
+            //Walking into something low enough is tried again from above it, and kept if that gets further and ends on the ground
+            MoveResult raised = move(start, Vector3(0.0f, m_Settings.StepHeight, 0.0f), a_World);
+            MoveResult across = move(raised.Position, horizontal, a_World);
+            MoveResult lowered = move(across.Position, Vector3(0.0f, start.Y - raised.Position.Y, 0.0f), a_World);
+            if(lowered.HitGround && getHorizontalDistanceSquared(start, lowered.Position) > getHorizontalDistanceSquared(start, walked.Position))
+            {
+                walked = lowered;
+            }
+        }
+
+        MoveResult fallen = move(walked.Position, Vector3(0.0f, velocity.Y * a_DeltaTime, 0.0f), a_World);
+        bool grounded = fallen.HitGround && velocity.Y <= 0.0f;
+        if(!grounded && a_State.Grounded && velocity.Y <= 0.0f)
+        {
+            //Walking down a slope or stairs moves away from the ground faster than gravity pulls, so the character is put back on it
+            MoveResult snapped = move(fallen.Position, Vector3(0.0f, -m_Settings.StepHeight, 0.0f), a_World);
+            if(snapped.HitGround)
+            {
+                fallen.Position = snapped.Position;
+                grounded = true;
+            }
+        }
+
+        if(grounded || (fallen.HitCeiling && velocity.Y > 0.0f))
+        {
+            velocity.Y = 0.0f;
+        }
+        if(!grounded && walked.HitWall)
+        {
+            //In the air the character keeps its momentum, but not the part of it that a wall took away
+            velocity.X = (walked.Position.X - start.X) / a_DeltaTime;
+            velocity.Z = (walked.Position.Z - start.Z) / a_DeltaTime;
+        }
+        a_State.Position = fallen.Position;
+        a_State.Grounded = grounded;
+    }
+
+    Capsule CharacterController::getCapsule(const Vector3& a_Feet) const
+    {
+        Capsule capsule;
+        capsule.Bottom = Vector3(a_Feet.X, a_Feet.Y + m_Settings.Radius, a_Feet.Z);
+        capsule.Top = Vector3(a_Feet.X, a_Feet.Y + m_Settings.Height - m_Settings.Radius, a_Feet.Z);
+        capsule.Radius = m_Settings.Radius;
+        return capsule;
+    }
+
+    Vector3 CharacterController::getEyePosition(const CharacterState& a_State) const
+    {
+        return a_State.Position + Vector3(0.0f, m_Settings.EyeHeight, 0.0f);
+    }
+
+    const CharacterSettings& CharacterController::getSettings() const
+    {
+        return m_Settings;
+    }
+
+    Vector3 CharacterController::getWishDirection(const PlayerInput& a_Input)
+    {
+        float forward = (a_Input.isHeld(EInputButton::MoveForward) ? 1.0f : 0.0f) - (a_Input.isHeld(EInputButton::MoveBackward) ? 1.0f : 0.0f);
+        float right = (a_Input.isHeld(EInputButton::MoveRight) ? 1.0f : 0.0f) - (a_Input.isHeld(EInputButton::MoveLeft) ? 1.0f : 0.0f);
+        if(forward == 0.0f && right == 0.0f)
+        {
+            return Vector3();
+        }
+
+        //A yaw of zero looks along Z, and turning right turns towards X
+        float sine = std::sin(a_Input.Yaw * DegreesToRadians);
+        float cosine = std::cos(a_Input.Yaw * DegreesToRadians);
+        Vector3 direction(sine * forward + cosine * right, 0.0f, cosine * forward - sine * right);
+        return direction * (1.0f / direction.getLength());
+    }
+
+    CharacterController::MoveResult CharacterController::move(const Vector3& a_Start, const Vector3& a_Movement, const CollisionWorld& a_World) const
+    {
+        MoveResult result;
+        result.Position = a_Start;
+
+        //Steps of half the radius cannot pass through anything, as the capsule is pushed back out after each of them
+        float length = a_Movement.getLength();
+        int steps = static_cast<int>(std::ceil(length / (m_Settings.Radius * 0.5f)));
+        steps = std::min(std::max(steps, 1), MaxSubsteps);
+        Vector3 step = a_Movement * (1.0f / steps);
+        for(int i = 0; i < steps; ++i)
+        {
+            result.Position += step;
+            resolve(result, a_World);
+        }
+        return result;
+    }
+
+    void CharacterController::resolve(MoveResult& a_Result, const CollisionWorld& a_World) const
+    {
+        Contact contact;
+        for(int i = 0; i < MaxResolveIterations && a_World.findDeepestContact(getCapsule(a_Result.Position), contact); ++i)
+        {
+            const Vector3& normal = contact.Normal;
+            if(normal.Y >= m_Settings.MinGroundNormalY)
+            {
+                a_Result.Position.Y += contact.Depth / normal.Y;
+                a_Result.HitGround = true;
+            }
+            else if(normal.Y <= -m_Settings.MinGroundNormalY)
+            {
+                a_Result.Position += normal * contact.Depth;
+                a_Result.HitCeiling = true;
+            }
+            else
+            {
+                //The normal has a horizontal part of at least the square root of 1 - MinGroundNormalY squared here
+                Vector3 flat(normal.X, 0.0f, normal.Z);
+                a_Result.Position += flat * (contact.Depth / flat.getLengthSquared());
+                a_Result.HitWall = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "CollisionWorld.h"
+#include "PlayerInput.h"
+#include "Vector3.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// How a character moves and how large it is, the same for the client and the server
+    /// </summary>
+    struct CharacterSettings
+    {
+        /// <summary> The radius of the capsule the character collides as </summary>
+        float Radius = 0.3f;
+        /// <summary> The height of the capsule from the feet to the top of the head </summary>
+        float Height = 1.8f;
+        /// <summary> The height of the eyes above the feet, where the camera goes </summary>
+        float EyeHeight = 1.7f;
+        /// <summary> The speed in units per second the character walks at, in any direction </summary>
+        float WalkSpeed = 10.0f;
+        /// <summary> The upward speed in units per second a jump starts with </summary>
+        float JumpSpeed = 5.0f;
+        /// <summary> The downward acceleration in units per second squared </summary>
+        float Gravity = 15.0f;
+        /// <summary> The fastest the character falls, in units per second </summary>
+        float MaxFallSpeed = 30.0f;
+        /// <summary> How quickly the character turns its velocity towards where it is steered while in the air, per second </summary>
+        float AirControl = 3.0f;
+        /// <summary> The highest ledge the character walks onto without jumping </summary>
+        float StepHeight = 0.35f;
+        /// <summary> The lowest vertical component of the normal of a surface the character can stand on, about 45 degrees of slope </summary>
+        float MinGroundNormalY = 0.7f;
+    };
+
+    /// <summary>
+    /// Where a character is and how it moves, everything the controller needs to continue from one tick to the next
+    /// </summary>
+    struct CharacterState
+    {
+        /// <summary> The position of the feet </summary>
+        Vector3 Position;
+        /// <summary> The velocity in units per second </summary>
+        Vector3 Velocity;
+        /// <summary> Whether the character stands on something it can walk on </summary>
+        bool Grounded = false;
+    };
+
+    /// <summary>
+    /// Moves characters through the level one fixed tick at a time, from their input alone, so the client predicting its
+    /// own player and the server simulating it arrive at the same position. The character is a vertical capsule that is moved
+    /// in steps smaller than its radius, and pushed out of the level after every step, which makes it slide along walls.
+    /// It walks up ledges up to the step height, stays on the ground walking down slopes and stairs, and falls and jumps with gravity.
+    /// </summary>
+    /// <remarks>
+    /// The controller keeps no state of its own and the world is only read, so a single controller simulates any amount of
+    /// characters, from several threads at once. The result only depends on the state, the input, the world and the tick length,
+    /// so both ends agree as long as they run the same build.
+    /// </remarks>
+    class CharacterController
+    {
+    public:
+        /// <summary> The most times a single step pushes the capsule out of the level, a contact per time </summary>
+        static const int MaxResolveIterations;
+        /// <summary> The most steps a single move is split into, for very fast moves the steps grow beyond half the radius </summary>
+        static const int MaxSubsteps;
+    private:
+        /// <summary>
+        /// What a move ran into
+        /// </summary>
+        struct MoveResult
+        {
+            Vector3 Position;
+            bool HitGround = false;
+            bool HitCeiling = false;
+            bool HitWall = false;
+        };
+
+        CharacterSettings m_Settings;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CharacterController"/> class.
+        /// </summary>
+        /// <param name="a_Settings">How the characters move, with a radius above zero and a height of at least twice the radius.</param>
+        explicit CharacterController(const CharacterSettings& a_Settings = CharacterSettings());
+
+        /// <summary>
+        /// Moves a character for a single tick.
+        /// </summary>
+        /// <param name="a_State">The state of the character, which is updated.</param>
+        /// <param name="a_Input">The input of the tick, of which the move buttons, jump and yaw are used.</param>
+        /// <param name="a_World">The level.</param>
+        /// <param name="a_DeltaTime">The length of a tick in seconds, which has to be above zero.</param>
+        void simulate(CharacterState& a_State, const PlayerInput& a_Input, const CollisionWorld& a_World, float a_DeltaTime) const;
+
+        /// <summary>
+        /// Gets the capsule of a character standing at a position.
+        /// </summary>
+        /// <param name="a_Feet">The position of the feet.</param>
+        Capsule getCapsule(const Vector3& a_Feet) const;
+
+        /// <summary>
+        /// Gets where the character looks from.
+        /// </summary>
+        Vector3 getEyePosition(const CharacterState& a_State) const;
+
+        const CharacterSettings& getSettings() const;
+    private:
+        /// <summary>
+        /// Gets the horizontal direction the input steers in, of unit length or zero.
+        /// </summary>
+        static Vector3 getWishDirection(const PlayerInput& a_Input);
+
+        /// <summary>
+        /// Moves the capsule in steps, pushing it out of the level after every step.
+        /// </summary>
+        MoveResult move(const Vector3& a_Start, const Vector3& a_Movement, const CollisionWorld& a_World) const;
+
+        /// <summary>
+        /// Pushes the capsule out of the level, up off walkable ground and sideways off walls so it neither slides
+        /// down slopes it stands on nor climbs slopes that are too steep.
+        /// </summary>
+        void resolve(MoveResult& a_Result, const CollisionWorld& a_World) const;
+    };
+}
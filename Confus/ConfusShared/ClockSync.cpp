@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cmath>
+
+#include "ClockSync.h"
+
+namespace ConfusShared
+{
+    const double ClockSync::MaxSlewRate = 0.05;
+    const double ClockSync::SnapThreshold = 0.25;
+    const double ClockSync::InitialRequestInterval = 0.1;
+    const double ClockSync::RequestInterval = 1.0;
+
+    void ClockSync::addSample(double a_RequestTime, double a_ServerTime, double a_ResponseTime)
+    {
+        Sample sample;
+        sample.RoundTripTime = std::max(a_ResponseTime - a_RequestTime, 0.0);
+        sample.Offset = a_ServerTime + sample.RoundTripTime / 2.0 - a_ResponseTime;
+        if(m_Samples.full())
+        {
+            m_Samples.pop();
+        }
+        m_Samples.push(sample);
+
+        const Sample* best = &m_Samples.front();
+        for(std::size_t i = 1; i < m_Samples.size(); ++i)
+        {
+            if(m_Samples.at(i).RoundTripTime < best->RoundTripTime)
+            {
+                best = &m_Samples.at(i);
+            }
+        }
+        m_TargetOffset = best->Offset;
+        m_RoundTripTime = best->RoundTripTime;
+
+        //Until then nothing runs on the estimate yet, so it may as well jump to the best guess so far
+        if(++m_SampleCount <= SamplesToSynchronize)
+        {
+            m_Offset = m_TargetOffset;
+        }
+    }
+
+    void ClockSync::update(double a_LocalTime)
+    {
+        double deltaTime = std::max(a_LocalTime - m_LastUpdateTime, 0.0);
+        m_LastUpdateTime = a_LocalTime;
+
+        double error = m_TargetOffset - m_Offset;
+        if(std::fabs(error) > SnapThreshold)
+        {
+            m_Offset = m_TargetOffset;
+            return;
+        }
+        double maxCorrection = MaxSlewRate * deltaTime;
+        m_Offset += std::min(std::max(error, -maxCorrection), maxCorrection);
+    }
+
+    void ClockSync::reset()
+    {
+        *this = ClockSync();
+    }
+
+    double ClockSync::getServerTime(double a_LocalTime) const
+    {
+        return a_LocalTime + m_Offset;
+    }
+
+    std::uint32_t ClockSync::getServerTick(double a_LocalTime) const
+    {
+        return static_cast<std::uint32_t>(std::max(getServerTime(a_LocalTime), 0.0) / TickInterval);
+    }
+
+    bool ClockSync::isSynchronized() const
+    {
+        return m_SampleCount >= SamplesToSynchronize;
+    }
+
+    double ClockSync::getRoundTripTime() const
+    {
+        return m_RoundTripTime;
+    }
+
+    double ClockSync::getRequestInterval() const
+    {
+        return isSynchronized() ? RequestInterval : InitialRequestInterval;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+
+#include "FixedQueue.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// The time in seconds of a single tick of the timeline the client and the server share, which is the interval
+    /// of their fixed updates. Tick n of the timeline starts n ticks after the server started simulating.
+    /// </summary>
+    constexpr double TickInterval = 0.02;
+
+    /// <summary>
+    /// Estimates the time on the server's timeline from timestamped requests. Each request is answered with the time on
+    /// the server, which was the server time half a round trip before the answer came in.
+    /// </summary>
+    /// <remarks>
+    /// Of the recent samples, the one with the shortest round trip is trusted, as it spent the least time waiting in queues
+    /// along the way that may have delayed one direction more than the other.
+    /// Once the clock is synchronized, corrections are slewed in, speeding up or slowing down the estimate by a few percent,
+    /// so the estimate never goes back in time and never jumps unless it is far off.
+    /// </remarks>
+    class ClockSync
+    {
+    public:
+        /// <summary> The amount of recent samples the best one is picked from </summary>
+        static const std::size_t SampleWindow = 16;
+        /// <summary> The fraction by which the estimate may run fast or slow to correct itself </summary>
+        static const double MaxSlewRate;
+        /// <summary> The error in seconds above which the estimate jumps to the correct time instead of slewing </summary>
+        static const double SnapThreshold;
+        /// <summary> The time in seconds between requests until enough samples have come in </summary>
+        static const double InitialRequestInterval;
+        /// <summary> The time in seconds between requests once synchronized </summary>
+        static const double RequestInterval;
+        /// <summary> The amount of samples after which the clock counts as synchronized </summary>
+        static const std::size_t SamplesToSynchronize = 5;
+    private:
+        /// <summary>
+        /// The outcome of a single request
+        /// </summary>
+        struct Sample
+        {
+            double RoundTripTime;
+            /// <summary> The server time minus the local time </summary>
+            double Offset;
+        };
+
+        FixedQueue<Sample, SampleWindow> m_Samples;
+        std::size_t m_SampleCount = 0;
+        /// <summary> The offset of the best recent sample, which the applied offset is slewed towards </summary>
+        double m_TargetOffset = 0.0;
+        /// <summary> The offset applied to the local time to get the server time </summary>
+        double m_Offset = 0.0;
+        double m_RoundTripTime = 0.0;
+        /// <summary> The local time of the last update </summary>
+        double m_LastUpdateTime = 0.0;
+    public:
+        /// <summary>
+        /// Adds the answer to a request.
+        /// </summary>
+        /// <param name="a_RequestTime">The local time in seconds the request was sent at.</param>
+        /// <param name="a_ServerTime">The server time in seconds the request was answered at.</param>
+        /// <param name="a_ResponseTime">The local time in seconds the answer came in at.</param>
+        void addSample(double a_RequestTime, double a_ServerTime, double a_ResponseTime);
+
+        /// <summary>
+        /// Slews the estimate towards the best sample, meant to be called every frame.
+        /// </summary>
+        /// <param name="a_LocalTime">The local time in seconds.</param>
+        void update(double a_LocalTime);
+
+        /// <summary>
+        /// Forgets every sample, for when the connection to the server is lost.
+        /// </summary>
+        void reset();
+
+        /// <summary>
+        /// Gets the estimated time on the server.
+        /// </summary>
+        /// <param name="a_LocalTime">The local time in seconds.</param>
+        double getServerTime(double a_LocalTime) const;
+
+        /// <summary>
+        /// Gets the tick of the shared timeline the server is estimated to be in.
+        /// </summary>
+        /// <param name="a_LocalTime">The local time in seconds.</param>
+        std::uint32_t getServerTick(double a_LocalTime) const;
+
+        /// <summary>
+        /// Gets whether enough samples came in for the estimate to be trusted.
+        /// </summary>
+        bool isSynchronized() const;
+
+        /// <summary>
+        /// Gets the round trip time in seconds of the best recent sample.
+        /// </summary>
+        double getRoundTripTime() const;
+
+        /// <summary>
+        /// Gets the time in seconds to wait between requests, which is shorter until the clock is synchronized.
+        /// </summary>
+        double getRequestInterval() const;
+    };
+}
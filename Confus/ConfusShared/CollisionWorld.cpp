@@ -0,0 +1,426 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "CollisionWorld.h"
+
+namespace ConfusShared
+{
+    const float CollisionWorld::DefaultCellSize = 2.0f;
+    const std::size_t CollisionWorld::MaxCellCount = 1 << 20;
+    const float CollisionWorld::ContactTolerance = 0.0001f;
+
+    namespace
+    {
+        /// <summary> Below this squared length a direction is too short to normalize </summary>
+        const float DegenerateLengthSquared = 1e-12f;
+
+        float getAxis(const Vector3& a_Vector, std::uint32_t a_Axis)
+        {
+            return a_Axis == 0 ? a_Vector.X : (a_Axis == 1 ? a_Vector.Y : a_Vector.Z);
+        }
+
+        Vector3 getMinimum(const Vector3& a_First, const Vector3& a_Second)
+        {
+            return Vector3(std::min(a_First.X, a_Second.X), std::min(a_First.Y, a_Second.Y), std::min(a_First.Z, a_Second.Z));
+        }
+
+        Vector3 getMaximum(const Vector3& a_First, const Vector3& a_Second)
+        {
+            return Vector3(std::max(a_First.X, a_Second.X), std::max(a_First.Y, a_Second.Y), std::max(a_First.Z, a_Second.Z));
+        }
+
+        float clamp01(float a_Value)
+        {
+            return std::min(std::max(a_Value, 0.0f), 1.0f);
+        }
+
+        /// <summary>
+        /// Gets the point of a triangle closest to a point, by finding the region of the triangle the point projects onto.
+        /// </summary>
+        Vector3 getClosestPointOnTriangle(const Vector3& a_Point, const Triangle& a_Triangle)
+        {
+            const Vector3& a = a_Triangle.A;
+            const Vector3& b = a_Triangle.B;
+            const Vector3& c = a_Triangle.C;
+            Vector3 ab = b - a;
+            Vector3 ac = c - a;
+            Vector3 ap = a_Point - a;
+            float d1 = ab.dot(ap);
+            float d2 = ac.dot(ap);
+            if(d1 <= 0.0f && d2 <= 0.0f)
+            {
+                return a;
+            }
+
+            Vector3 bp = a_Point - b;
+            float d3 = ab.dot(bp);
+            float d4 = ac.dot(bp);
+            if(d3 >= 0.0f && d4 <= d3)
+            {
+                return b;
+            }
+
+            float vc = d1 * d4 - d3 * d2;
+            if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+            {
+                return a + ab * (d1 / (d1 - d3));
+            }
+
+            Vector3 cp = a_Point - c;
+            float d5 = ab.dot(cp);
+            float d6 = ac.dot(cp);
+            if(d6 >= 0.0f && d5 <= d6)
+            {
+                return c;
+            }
+
+            float vb = d5 * d2 - d1 * d6;
+            if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+            {
+                return a + ac * (d2 / (d2 - d6));
+            }
+
+            float va = d3 * d6 - d5 * d4;
+            if(va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+            {
+                return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+            }
+
+            float denominator = 1.0f / (va + vb + vc);
+            return a + ab * (vb * denominator) + ac * (vc * denominator);
+        }
+
+        /// <summary>
+        /// Gets the closest points of two segments.
+        /// </summary>
+        /// <returns>The squared distance between the points.</returns>
+        float getClosestPointsOnSegments(const Vector3& a_Start, const Vector3& a_End, const Vector3& a_OtherStart, const Vector3& a_OtherEnd,
+            Vector3& a_Point, Vector3& a_OtherPoint)
+        {
+            Vector3 direction = a_End - a_Start;
+            Vector3 otherDirection = a_OtherEnd - a_OtherStart;
+            Vector3 offset = a_Start - a_OtherStart;
+            float length = direction.getLengthSquared();
+            float otherLength = otherDirection.getLengthSquared();
+            float f = otherDirection.dot(offset);
+            float s = 0.0f;
+            float t = 0.0f;
+            if(length <= DegenerateLengthSquared)
+            {
+                t = otherLength <= DegenerateLengthSquared ? 0.0f : clamp01(f / otherLength);
+            }
+            else
+            {
+                float c = direction.dot(offset);
+                if(otherLength <= DegenerateLengthSquared)
+                {
+                    s = clamp01(-c / length);
+                }
+                else
+                {
+                    float b = direction.dot(otherDirection);
+                    float denominator = length * otherLength - b * b;
+                    //Parallel segments are closest anywhere along their overlap, so any point will do
+                    s = denominator != 0.0f ? clamp01((b * f - c * otherLength) / denominator) : 0.0f;
+                    t = (b * s + f) / otherLength;
+                    if(t < 0.0f)
+                    {
+                        t = 0.0f;
+                        s = clamp01(-c / length);
+                    }
+                    else if(t > 1.0f)
+                    {
+                        t = 1.0f;
+                        s = clamp01((b - c) / length);
+                    }
+                }
+            }
+            a_Point = a_Start + direction * s;
+            a_OtherPoint = a_OtherStart + otherDirection * t;
+            return (a_Point - a_OtherPoint).getLengthSquared();
+        }
+
+        /// <summary>
+        /// Gets how far a capsule reaches into a triangle.
+        /// </summary>
+        /// <returns>The depth, zero or below when they do not touch.</returns>
+        float getCapsuleContact(const Capsule& a_Capsule, const Triangle& a_Triangle, const Vector3& a_Normal, Vector3& a_ContactNormal)
+        {
+            const Vector3& bottom = a_Capsule.Bottom;
+            const Vector3& top = a_Capsule.Top;
+            float bottomDistance = a_Normal.dot(bottom - a_Triangle.A);
+            float topDistance = a_Normal.dot(top - a_Triangle.A);
+            if((bottomDistance <= 0.0f) != (topDistance <= 0.0f))
+            {
+                Vector3 crossing = bottom + (top - bottom) * (bottomDistance / (bottomDistance - topDistance));
+                if((getClosestPointOnTriangle(crossing, a_Triangle) - crossing).getLengthSquared() <= DegenerateLengthSquared)
+                {
+                    //The segment pierces the triangle, so the capsule leaves it on the side most of the segment is on
+                    bool bottomDeeper = std::fabs(bottomDistance) < std::fabs(topDistance);
+                    float side = (bottomDeeper ? topDistance : bottomDistance) > 0.0f ? 1.0f : -1.0f;
+                    a_ContactNormal = a_Normal * side;
+                    return std::min(std::fabs(bottomDistance), std::fabs(topDistance)) + a_Capsule.Radius;
+                }
+            }
+
+            Vector3 segmentPoint = bottom;
+            Vector3 trianglePoint = getClosestPointOnTriangle(bottom, a_Triangle);
+            float distanceSquared = (segmentPoint - trianglePoint).getLengthSquared();
+
+            Vector3 candidate = getClosestPointOnTriangle(top, a_Triangle);
+            float candidateDistance = (top - candidate).getLengthSquared();
+            if(candidateDistance < distanceSquared)
+            {
+                segmentPoint = top;
+                trianglePoint = candidate;
+                distanceSquared = candidateDistance;
+            }
+
+            const Vector3* corners[3] = { &a_Triangle.A, &a_Triangle.B, &a_Triangle.C };
+            for(int edge = 0; edge < 3; ++edge)
+            {
+                Vector3 onSegment;
+                Vector3 onEdge;
+                candidateDistance = getClosestPointsOnSegments(bottom, top, *corners[edge], *corners[(edge + 1) % 3], onSegment, onEdge);
+                if(candidateDistance < distanceSquared)
+                {
+                    segmentPoint = onSegment;
+                    trianglePoint = onEdge;
+                    distanceSquared = candidateDistance;
+                }
+            }
+
+            float radiusSquared = a_Capsule.Radius * a_Capsule.Radius;
+            if(distanceSquared >= radiusSquared)
+            {
+                return 0.0f;
+            }
+            float distance = std::sqrt(distanceSquared);
+            if(distanceSquared <= DegenerateLengthSquared)
+            {
+                //The segment lies in the plane of the triangle, which leaves the face normal as the only direction to go
+                a_ContactNormal = a_Normal;
+            }
+            else
+            {
+                a_ContactNormal = (segmentPoint - trianglePoint) * (1.0f / distance);
+            }
+            return a_Capsule.Radius - distance;
+        }
+    }
+
+    CollisionWorld::CollisionWorld(float a_CellSize)
+        : m_CellSize(a_CellSize)
+    {
+        if(!(a_CellSize > 0.0f))
+        {
+            throw std::invalid_argument("The cells of a collision world have to have a size.");
+        }
+    }
+
+    std::uint32_t CollisionWorld::addBody(const Triangle* a_Triangles, std::size_t a_Count, bool a_Solid)
+    {
+        std::uint32_t body = static_cast<std::uint32_t>(m_SolidBodies.size());
+        m_SolidBodies.push_back(a_Solid ? 1 : 0);
+        m_Entries.reserve(m_Entries.size() + a_Count);
+        for(std::size_t i = 0; i < a_Count; ++i)
+        {
+            const Triangle& triangle = a_Triangles[i];
+            Vector3 normal = (triangle.B - triangle.A).cross(triangle.C - triangle.A);
+            float lengthSquared = normal.getLengthSquared();
+            if(lengthSquared <= DegenerateLengthSquared)
+            {
+                continue;
+            }
+
+            Entry entry;
+            entry.Corners = triangle;
+            entry.Normal = normal * (1.0f / std::sqrt(lengthSquared));
+            entry.Minimum = getMinimum(getMinimum(triangle.A, triangle.B), triangle.C);
+            entry.Maximum = getMaximum(getMaximum(triangle.A, triangle.B), triangle.C);
+            entry.Body = body;
+            m_Entries.push_back(entry);
+        }
+        m_Built = false;
+        return body;
+    }
+
+    void CollisionWorld::setBodySolid(std::uint32_t a_Body, bool a_Solid)
+    {
+        if(a_Body >= m_SolidBodies.size())
+        {
+            throw std::invalid_argument("There is no body with the index in the collision world.");
+        }
+        m_SolidBodies[a_Body] = a_Solid ? 1 : 0;
+    }
+
+    bool CollisionWorld::isBodySolid(std::uint32_t a_Body) const
+    {
+        if(a_Body >= m_SolidBodies.size())
+        {
+            throw std::invalid_argument("There is no body with the index in the collision world.");
+        }
+        return m_SolidBodies[a_Body] != 0;
+    }
+
+    void CollisionWorld::build()
+    {
+        Vector3 minimum;
+        Vector3 maximum;
+        if(!m_Entries.empty())
+        {
+            minimum = m_Entries[0].Minimum;
+            maximum = m_Entries[0].Maximum;
+            for(const Entry& entry : m_Entries)
+            {
+                minimum = getMinimum(minimum, entry.Minimum);
+                maximum = getMaximum(maximum, entry.Maximum);
+            }
+        }
+
+        m_Origin = minimum;
+        std::size_t cellCount;
+        while(true)
+        {
+            cellCount = 1;
+            for(std::uint32_t axis = 0; axis < 3; ++axis)
+            {
+                m_CellCounts[axis] = static_cast<std::uint32_t>((getAxis(maximum, axis) - getAxis(minimum, axis)) / m_CellSize) + 1;
+                cellCount *= m_CellCounts[axis];
+            }
+            if(cellCount <= MaxCellCount)
+            {
+                break;
+            }
+            m_CellSize *= 2.0f;
+        }
+
+        //The entries are counted per cell first, so the cells can be laid out one after the other without gaps
+        m_CellStarts.assign(cellCount + 1, 0);
+        for(Entry& entry : m_Entries)
+        {
+            std::uint32_t lastCell[3];
+            for(std::uint32_t axis = 0; axis < 3; ++axis)
+            {
+                entry.FirstCell[axis] = getCell(getAxis(entry.Minimum, axis), axis);
+                lastCell[axis] = getCell(getAxis(entry.Maximum, axis), axis);
+            }
+            for(std::uint32_t z = entry.FirstCell[2]; z <= lastCell[2]; ++z)
+            {
+                for(std::uint32_t y = entry.FirstCell[1]; y <= lastCell[1]; ++y)
+                {
+                    for(std::uint32_t x = entry.FirstCell[0]; x <= lastCell[0]; ++x)
+                    {
+                        ++m_CellStarts[x + m_CellCounts[0] * (y + m_CellCounts[1] * z) + 1];
+                    }
+                }
+            }
+        }
+        for(std::size_t cell = 0; cell < cellCount; ++cell)
+        {
+            m_CellStarts[cell + 1] += m_CellStarts[cell];
+        }
+
+        m_CellEntries.resize(m_CellStarts[cellCount]);
+        std::vector<std::uint32_t> positions(m_CellStarts.begin(), m_CellStarts.end() - 1);
+        for(std::uint32_t index = 0; index < m_Entries.size(); ++index)
+        {
+            const Entry& entry = m_Entries[index];
+            std::uint32_t lastCell[3];
+            for(std::uint32_t axis = 0; axis < 3; ++axis)
+            {
+                lastCell[axis] = getCell(getAxis(entry.Maximum, axis), axis);
+            }
+            for(std::uint32_t z = entry.FirstCell[2]; z <= lastCell[2]; ++z)
+            {
+                for(std::uint32_t y = entry.FirstCell[1]; y <= lastCell[1]; ++y)
+                {
+                    for(std::uint32_t x = entry.FirstCell[0]; x <= lastCell[0]; ++x)
+                    {
+                        m_CellEntries[positions[x + m_CellCounts[0] * (y + m_CellCounts[1] * z)]++] = index;
+                    }
+                }
+            }
+        }
+        m_Built = true;
+    }
+
+    bool CollisionWorld::findDeepestContact(const Capsule& a_Capsule, Contact& a_Contact) const
+    {
+        if(!m_Built)
+        {
+            throw std::logic_error("The collision world has to be built after a body was added.");
+        }
+
+        Vector3 extent(a_Capsule.Radius, a_Capsule.Radius, a_Capsule.Radius);
+        Vector3 minimum = getMinimum(a_Capsule.Bottom, a_Capsule.Top) - extent;
+        Vector3 maximum = getMaximum(a_Capsule.Bottom, a_Capsule.Top) + extent;
+        std::uint32_t firstCell[3];
+        std::uint32_t lastCell[3];
+        for(std::uint32_t axis = 0; axis < 3; ++axis)
+        {
+            firstCell[axis] = getCell(getAxis(minimum, axis), axis);
+            lastCell[axis] = getCell(getAxis(maximum, axis), axis);
+        }
+
+        float deepest = ContactTolerance;
+        bool found = false;
+        for(std::uint32_t z = firstCell[2]; z <= lastCell[2]; ++z)
+        {
+            for(std::uint32_t y = firstCell[1]; y <= lastCell[1]; ++y)
+            {
+                for(std::uint32_t x = firstCell[0]; x <= lastCell[0]; ++x)
+                {
+                    std::size_t cell = x + m_CellCounts[0] * (y + m_CellCounts[1] * z);
+                    for(std::uint32_t i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; ++i)
+                    {
+                        const Entry& entry = m_Entries[m_CellEntries[i]];
+                        //A triangle in several of the cells is only tested in the first of them the query visits,
+                        //which keeps queries free of any bookkeeping so they can run side by side
+                        if(std::max(entry.FirstCell[0], firstCell[0]) != x || std::max(entry.FirstCell[1], firstCell[1]) != y
+                            || std::max(entry.FirstCell[2], firstCell[2]) != z || m_SolidBodies[entry.Body] == 0)
+                        {
+                            continue;
+                        }
+                        if(entry.Minimum.X > maximum.X || entry.Maximum.X < minimum.X || entry.Minimum.Y > maximum.Y
+                            || entry.Maximum.Y < minimum.Y || entry.Minimum.Z > maximum.Z || entry.Maximum.Z < minimum.Z)
+                        {
+                            continue;
+                        }
+
+                        Vector3 normal;
+                        float depth = getCapsuleContact(a_Capsule, entry.Corners, entry.Normal, normal);
+                        if(depth > deepest)
+                        {
+                            deepest = depth;
+                            a_Contact.Normal = normal;
+                            a_Contact.Depth = depth;
+                            found = true;
+                        }
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    std::size_t CollisionWorld::getTriangleCount() const
+    {
+        return m_Entries.size();
+    }
+
+    std::size_t CollisionWorld::getBodyCount() const
+    {
+        return m_SolidBodies.size();
+    }
+
+    std::uint32_t CollisionWorld::getCell(float a_Coordinate, std::uint32_t a_Axis) const
+    {
+        float cell = (a_Coordinate - getAxis(m_Origin, a_Axis)) / m_CellSize;
+        if(!(cell > 0.0f))
+        {
+            return 0;
+        }
+        return std::min(static_cast<std::uint32_t>(std::min(cell, 4294967040.0f)), m_CellCounts[a_Axis] - 1);
+    }
+}
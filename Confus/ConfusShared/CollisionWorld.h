@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Vector3.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A triangle of the level that characters collide with, which blocks from both sides
+    /// </summary>
+    struct Triangle
+    {
+        Vector3 A;
+        Vector3 B;
+        Vector3 C;
+    };
+
+    /// <summary>
+    /// A capsule, the segment between the centers of its end spheres grown by its radius
+    /// </summary>
+    struct Capsule
+    {
+        Vector3 Bottom;
+        Vector3 Top;
+        float Radius = 0.0f;
+    };
+
+    /// <summary>
+    /// How far a shape reaches into the level
+    /// </summary>
+    struct Contact
+    {
+        /// <summary> The direction that moves the shape out of the level the fastest </summary>
+        Vector3 Normal;
+        /// <summary> How far the shape has to move along the normal to stop touching </summary>
+        float Depth = 0.0f;
+    };
+
+    /// <summary>
+    /// The geometry characters collide with, as triangles bucketed into a uniform grid of cells so a query only tests
+    /// the triangles around the shape. Triangles are grouped into bodies that can be made passable and solid again,
+    /// such as the maze walls and respawn floors, without rebuilding the grid.
+    /// </summary>
+    /// <remarks>
+    /// Queries do not change the world, so any amount of characters can be simulated against it at once from several threads.
+    /// Bodies are added before the world is built, and the world has to be built again once another body is added.
+    /// </remarks>
+    class CollisionWorld
+    {
+    public:
+        /// <summary> The size of a cell along each axis, about the size of a character so a query only visits a few cells </summary>
+        static const float DefaultCellSize;
+        /// <summary> The most cells the grid holds, the cells grow when the level would need more </summary>
+        static const std::size_t MaxCellCount;
+        /// <summary> How deep a shape has to be in the level before it counts as touching, so resting on the floor is not a contact </summary>
+        static const float ContactTolerance;
+    private:
+        /// <summary>
+        /// A triangle along with what is needed to reject it quickly
+        /// </summary>
+        struct Entry
+        {
+            Triangle Corners;
+            /// <summary> The unit normal, following the winding of the corners </summary>
+            Vector3 Normal;
+            Vector3 Minimum;
+            Vector3 Maximum;
+            std::uint32_t Body;
+            /// <summary> The first cell the triangle is in along each axis </summary>
+            std::uint32_t FirstCell[3];
+        };
+
+        std::vector<Entry> m_Entries;
+        /// <summary> Whether each body blocks, as a byte per body so bodies can be looked up without bit twiddling </summary>
+        std::vector<std::uint8_t> m_SolidBodies;
+        float m_CellSize;
+        Vector3 m_Origin;
+        std::uint32_t m_CellCounts[3] = { 0, 0, 0 };
+        /// <summary> For each cell the index of its first entry in m_CellEntries, followed by the total amount of entries </summary>
+        std::vector<std::uint32_t> m_CellStarts;
+        /// <summary> The entries of every cell, stored cell after cell </summary>
+        std::vector<std::uint32_t> m_CellEntries;
+        bool m_Built = false;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="CollisionWorld"/> class without any geometry.
+        /// </summary>
+        /// <param name="a_CellSize">The size of a cell along each axis, which has to be above zero.</param>
+        explicit CollisionWorld(float a_CellSize = DefaultCellSize);
+
+        /// <summary>
+        /// Adds a body, a group of triangles that are solid or passable together. Triangles without an area are left out.
+        /// </summary>
+        /// <param name="a_Triangles">The triangles in world space.</param>
+        /// <param name="a_Count">The amount of triangles.</param>
+        /// <param name="a_Solid">Whether the body starts out solid.</param>
+        /// <returns>The index of the body.</returns>
+        std::uint32_t addBody(const Triangle* a_Triangles, std::size_t a_Count, bool a_Solid = true);
+
+        /// <summary>
+        /// Sets whether a body blocks movement.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">There is no body with the index.</exception>
+        void setBodySolid(std::uint32_t a_Body, bool a_Solid);
+
+        /// <summary>
+        /// Gets whether a body blocks movement.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">There is no body with the index.</exception>
+        bool isBodySolid(std::uint32_t a_Body) const;
+
+        /// <summary>
+        /// Buckets the triangles of every body into the grid, which has to be done before the world is queried.
+        /// </summary>
+        void build();
+
+        /// <summary>
+        /// Finds where a capsule reaches the deepest into the solid bodies.
+        /// </summary>
+        /// <param name="a_Capsule">The capsule.</param>
+        /// <param name="a_Contact">The deepest contact, left as it was if there is none.</param>
+        /// <returns>Whether the capsule reaches into a solid body by more than <see cref="ContactTolerance"/>.</returns>
+        /// <exception cref="std::logic_error">The world has not been built since the last body was added.</exception>
+        bool findDeepestContact(const Capsule& a_Capsule, Contact& a_Contact) const;
+
+        /// <summary>
+        /// Gets the amount of triangles in all bodies together.
+        /// </summary>
+        std::size_t getTriangleCount() const;
+
+        std::size_t getBodyCount() const;
+    private:
+        /// <summary>
+        /// Gets the cell a coordinate lies in along an axis, clamped to the grid.
+        /// </summary>
+        std::uint32_t getCell(float a_Coordinate, std::uint32_t a_Axis) const;
+    };
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "Entity.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Stores one kind of component for any number of entities in a single packed array, so systems can walk
+    /// all of them linearly. Removing a component moves the last one into its place, so the array never has holes
+    /// and the order of the components is not stable.
+    /// </summary>
+    /// <remarks> References to components are invalidated by adding or removing components of the same kind </remarks>
+    template<typename TComponent>
+    class ComponentArray
+    {
+    private:
+        static const std::uint32_t NoComponent = 0xFFFFFFFF;
+
+        /// <summary> The components, packed </summary>
+        std::vector<TComponent> m_Components;
+        /// <summary> The entity each packed component belongs to </summary>
+        std::vector<Entity> m_Entities;
+        /// <summary> The position in the packed array for every entity index, NoComponent if it has none </summary>
+        std::vector<std::uint32_t> m_Positions;
+    public:
+        /// <summary>
+        /// Adds a component to an entity, replacing the one it already had.
+        /// </summary>
+        /// <returns>The stored component.</returns>
+        TComponent& add(Entity a_Entity, const TComponent& a_Component)
+        {
+            if(a_Entity.Index >= m_Positions.size())
+            {
+                m_Positions.resize(a_Entity.Index + 1, NoComponent);
+            }
+
+            std::uint32_t& position = m_Positions[a_Entity.Index];
+            if(position != NoComponent)
+            {
+                m_Entities[position] = a_Entity;
+                m_Components[position] = a_Component;
+            }
+            else
+            {
+                position = static_cast<std::uint32_t>(m_Components.size());
+                m_Entities.push_back(a_Entity);
+                m_Components.push_back(a_Component);
+            }
+            return m_Components[position];
+        }
+
+        /// <summary>
+        /// Removes the component of an entity, if it has one.
+        /// </summary>
+        void remove(Entity a_Entity)
+        {
+            if(!has(a_Entity))
+            {
+                return;
+            }
+
+            std::uint32_t position = m_Positions[a_Entity.Index];
+            std::uint32_t last = static_cast<std::uint32_t>(m_Components.size() - 1);
+            if(position != last)
+            {
+                m_Components[position] = std::move(m_Components[last]);
+                m_Entities[position] = m_Entities[last];
+                m_Positions[m_Entities[position].Index] = position;
+            }
+            m_Components.pop_back();
+            m_Entities.pop_back();
+            m_Positions[a_Entity.Index] = NoComponent;
+        }
+
+        /// <summary>
+        /// Gets whether the entity has a component of this kind.
+        /// </summary>
+        bool has(Entity a_Entity) const
+        {
+            return a_Entity.Index < m_Positions.size() && m_Positions[a_Entity.Index] != NoComponent
+                && m_Entities[m_Positions[a_Entity.Index]].Generation == a_Entity.Generation;
+        }
+
+        /// <summary>
+        /// Gets the component of an entity.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">Thrown when the entity has no component of this kind.</exception>
+        TComponent& get(Entity a_Entity)
+        {
+            if(!has(a_Entity))
+            {
+                throw std::invalid_argument("The entity does not have this component.");
+            }
+            return m_Components[m_Positions[a_Entity.Index]];
+        }
+
+        /// <summary>
+        /// Gets the component of an entity.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">Thrown when the entity has no component of this kind.</exception>
+        const TComponent& get(Entity a_Entity) const
+        {
+            if(!has(a_Entity))
+            {
+                throw std::invalid_argument("The entity does not have this component.");
+            }
+            return m_Components[m_Positions[a_Entity.Index]];
+        }
+
+        /// <summary>
+        /// Gets the amount of packed components, for walking them with <see cref="at"/> and <see cref="getEntity"/>.
+        /// </summary>
+        std::size_t size() const
+        {
+            return m_Components.size();
+        }
+
+        /// <summary>
+        /// Gets a packed component by its position.
+        /// </summary>
+        TComponent& at(std::size_t a_Position)
+        {
+            return m_Components[a_Position];
+        }
+
+        /// <summary>
+        /// Gets a packed component by its position.
+        /// </summary>
+        const TComponent& at(std::size_t a_Position) const
+        {
+            return m_Components[a_Position];
+        }
+
+        /// <summary>
+        /// Gets the entity the packed component at the position belongs to.
+        /// </summary>
+        Entity getEntity(std::size_t a_Position) const
+        {
+            return m_Entities[a_Position];
+        }
+    };
+
+    template<typename TComponent>
+    const std::uint32_t ComponentArray<TComponent>::NoComponent;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Identifies a game object in the <see cref="EntityStore"/>, which is nothing more than the components stored for it.
+    /// The generation is bumped whenever an index is reused, so an entity that has been destroyed
+    /// never refers to whichever entity was created in its place.
+    /// </summary>
+    struct Entity
+    {
+        /// <summary> The index of the entity, InvalidIndex if it refers to nothing </summary>
+        std::uint32_t Index = InvalidIndex;
+        /// <summary> The generation of the index at the time the entity was created </summary>
+        std::uint32_t Generation = 0;
+
+        static const std::uint32_t InvalidIndex = 0xFFFFFFFF;
+
+        /// <summary>
+        /// Whether the entity was created by a store, it may have been destroyed since.
+        /// </summary>
+        bool isValid() const
+        {
+            return Index != InvalidIndex;
+        }
+
+        bool operator==(const Entity& a_Other) const
+        {
+            return Index == a_Other.Index && Generation == a_Other.Generation;
+        }
+
+        bool operator!=(const Entity& a_Other) const
+        {
+            return !(*this == a_Other);
+        }
+    };
+}
@@ -0,0 +1,49 @@
+#include "EntityStore.h"
+
+namespace ConfusShared
+{
+    Entity EntityStore::create()
+    {
+        Entity entity;
+        if(m_FreeIndices.empty())
+        {
+            entity.Index = static_cast<std::uint32_t>(m_Generations.size());
+            m_Generations.push_back(0);
+        }
+        else
+        {
+            entity.Index = m_FreeIndices.back();
+            m_FreeIndices.pop_back();
+        }
+        entity.Generation = m_Generations[entity.Index];
+        return entity;
+    }
+
+    void EntityStore::destroy(Entity a_Entity)
+    {
+        if(!isAlive(a_Entity))
+        {
+            return;
+        }
+
+        removeComponents(a_Entity);
+        ++m_Generations[a_Entity.Index];
+        m_FreeIndices.push_back(a_Entity.Index);
+    }
+
+    bool EntityStore::isAlive(Entity a_Entity) const
+    {
+        return a_Entity.Index < m_Generations.size() && m_Generations[a_Entity.Index] == a_Entity.Generation;
+    }
+
+    std::size_t EntityStore::getCount() const
+    {
+        return m_Generations.size() - m_FreeIndices.size();
+    }
+
+    void EntityStore::removeComponents(Entity a_Entity)
+    {
+        Teams.remove(a_Entity);
+        Healths.remove(a_Entity);
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ComponentArray.h"
+#include "Health.h"
+#include "Teams.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// The team an entity belongs to
+    /// </summary>
+    struct TeamComponent
+    {
+        ETeamIdentifier Team = ETeamIdentifier::None;
+    };
+
+    /// <summary>
+    /// Creates the entities of the game and stores each kind of their components in its own packed array.
+    /// Systems walk the arrays they need linearly instead of visiting every game object through its class.
+    /// This holds the components the client and the server both keep, each of them adds the ones that refer to its own scene.
+    /// </summary>
+    /// <remarks> The game objects that own an entity keep it as a plain value and look their state up in here </remarks>
+    class EntityStore
+    {
+    private:
+        /// <summary> The current generation of every entity index </summary>
+        std::vector<std::uint32_t> m_Generations;
+        /// <summary> The indices of destroyed entities, to be reused </summary>
+        std::vector<std::uint32_t> m_FreeIndices;
+    public:
+        ComponentArray<TeamComponent> Teams;
+        ComponentArray<Health> Healths;
+
+        virtual ~EntityStore() = default;
+
+        /// <summary>
+        /// Creates an entity without any components.
+        /// </summary>
+        Entity create();
+
+        /// <summary>
+        /// Removes every component of the entity and frees its index.
+        /// </summary>
+        void destroy(Entity a_Entity);
+
+        /// <summary>
+        /// Gets whether the entity has been created and not yet destroyed.
+        /// </summary>
+        bool isAlive(Entity a_Entity) const;
+
+        /// <summary>
+        /// Gets the amount of entities that are alive.
+        /// </summary>
+        std::size_t getCount() const;
+    protected:
+        /// <summary>
+        /// Removes every component of an entity that is being destroyed, overridden to also remove the components a store adds.
+        /// </summary>
+        virtual void removeComponents(Entity a_Entity);
+    };
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A first in, first out queue with a fixed capacity, stored inline as a ring so it never allocates.
+    /// </summary>
+    template<typename T, std::size_t Capacity>
+    class FixedQueue
+    {
+    private:
+        std::array<T, Capacity> m_Items;
+        /// <summary> The position of the oldest item </summary>
+        std::size_t m_Head = 0;
+        std::size_t m_Count = 0;
+    public:
+        /// <summary>
+        /// Adds an item at the back, if there is room.
+        /// </summary>
+        /// <returns>Whether the item was added.</returns>
+        bool push(const T& a_Item)
+        {
+            if(m_Count == Capacity)
+            {
+                return false;
+            }
+            m_Items[(m_Head + m_Count) % Capacity] = a_Item;
+            ++m_Count;
+            return true;
+        }
+
+        /// <summary>
+        /// Removes the oldest item.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The queue is empty.</exception>
+        void pop()
+        {
+            if(m_Count == 0)
+            {
+                throw std::invalid_argument("Cannot pop from an empty queue.");
+            }
+            m_Head = (m_Head + 1) % Capacity;
+            --m_Count;
+        }
+
+        /// <summary>
+        /// Gets the oldest item.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The queue is empty.</exception>
+        const T& front() const
+        {
+            return at(0);
+        }
+
+        /// <summary>
+        /// Gets an item by its position from the oldest one.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">There is no item at the position.</exception>
+        const T& at(std::size_t a_Position) const
+        {
+            if(a_Position >= m_Count)
+            {
+                throw std::invalid_argument("There is no item at the position in the queue.");
+            }
+            return m_Items[(m_Head + a_Position) % Capacity];
+        }
+
+        void clear()
+        {
+            m_Head = 0;
+            m_Count = 0;
+        }
+
+        std::size_t size() const
+        {
+            return m_Count;
+        }
+
+        bool empty() const
+        {
+            return m_Count == 0;
+        }
+
+        bool full() const
+        {
+            return m_Count == Capacity;
+        }
+    };
+}
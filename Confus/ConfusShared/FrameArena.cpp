@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "FrameArena.h"
+
+namespace ConfusShared
+{
+    const std::size_t FrameArena::DefaultBlockSize = 64 * 1024;
+
+    FrameArena::FrameArena(std::size_t a_BlockSize)
+        : m_BlockSize(a_BlockSize)
+    {
+    }
+
+    void* FrameArena::allocate(std::size_t a_Size, std::size_t a_Alignment)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        while(true)
+        {
+            if(m_BlockIndex < m_Blocks.size())
+            {
+                Block& block = m_Blocks[m_BlockIndex];
+                //The alignment is applied to the address, as the blocks themselves are only aligned for the fundamental types
+                std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.Memory.get()) + m_Offset;
+                std::size_t padding = static_cast<std::size_t>((a_Alignment - address % a_Alignment) % a_Alignment);
+                if(m_Offset + padding + a_Size <= block.Size)
+                {
+                    m_Offset += padding + a_Size;
+                    m_UsedBytes += padding + a_Size;
+                    m_PeakUsedBytes = std::max(m_PeakUsedBytes, m_UsedBytes);
+                    return block.Memory.get() + m_Offset - a_Size;
+                }
+
+                if(m_BlockIndex + 1 < m_Blocks.size())
+                {
+                    ++m_BlockIndex;
+                    m_Offset = 0;
+                    continue;
+                }
+            }
+
+            //Out of blocks, so one is added that is at least large enough for this allocation
+            Block block;
+            block.Size = std::max(m_BlockSize, a_Size + a_Alignment);
+            block.Memory.reset(new unsigned char[block.Size]);
+            m_Blocks.push_back(std::move(block));
+            m_BlockIndex = m_Blocks.size() - 1;
+            m_Offset = 0;
+        }
+    }
+
+    void FrameArena::reset()
+    {
+        m_BlockIndex = 0;
+        m_Offset = 0;
+        m_UsedBytes = 0;
+    }
+
+    std::size_t FrameArena::getUsedBytes() const
+    {
+        return m_UsedBytes;
+    }
+
+    std::size_t FrameArena::getPeakUsedBytes() const
+    {
+        return m_PeakUsedBytes;
+    }
+
+    std::size_t FrameArena::getCapacity() const
+    {
+        std::size_t capacity = 0;
+        for(const Block& block : m_Blocks)
+        {
+            capacity += block.Size;
+        }
+        return capacity;
+    }
+}
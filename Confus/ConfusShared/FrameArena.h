@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Memory for the containers that only live during a single frame or fixed update.
+    /// Allocating moves a pointer forward through a few large blocks and freeing does nothing,
+    /// all memory is handed back at once by <see cref="reset"/> at the end of the update.
+    /// The blocks are kept when resetting, so once the largest update has been seen no more memory is taken from the heap.
+    /// </summary>
+    /// <remarks>
+    /// Allocating is guarded by a lock, as the systems of an update may run on several threads.
+    /// Resetting is not, and may only happen while nothing is allocating.
+    /// </remarks>
+    class FrameArena
+    {
+    public:
+        /// <summary> The size in bytes of a block, unless a larger one is needed for a single allocation </summary>
+        static const std::size_t DefaultBlockSize;
+    private:
+        /// <summary>
+        /// A block of memory the allocations are taken from
+        /// </summary>
+        struct Block
+        {
+            std::unique_ptr<unsigned char[]> Memory;
+            std::size_t Size;
+        };
+
+        std::size_t m_BlockSize;
+        std::vector<Block> m_Blocks;
+        /// <summary> The block allocations are currently taken from </summary>
+        std::size_t m_BlockIndex = 0;
+        /// <summary> The offset of the first free byte in the current block </summary>
+        std::size_t m_Offset = 0;
+        /// <summary> The amount of bytes handed out since the last reset, including padding </summary>
+        std::size_t m_UsedBytes = 0;
+        /// <summary> The most bytes handed out between two resets so far </summary>
+        std::size_t m_PeakUsedBytes = 0;
+        std::mutex m_Mutex;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="FrameArena"/> class, which takes its first block on the first allocation.
+        /// </summary>
+        /// <param name="a_BlockSize">The size in bytes of a block.</param>
+        explicit FrameArena(std::size_t a_BlockSize = DefaultBlockSize);
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /// <summary>
+        /// Allocates memory that stays valid until the next reset.
+        /// </summary>
+        /// <param name="a_Size">The amount of bytes.</param>
+        /// <param name="a_Alignment">The alignment of the memory, which has to be a power of two.</param>
+        void* allocate(std::size_t a_Size, std::size_t a_Alignment);
+
+        /// <summary>
+        /// Hands back all memory allocated since the last reset, keeping the blocks for the next update.
+        /// </summary>
+        void reset();
+
+        /// <summary>
+        /// Gets the amount of bytes allocated since the last reset.
+        /// </summary>
+        std::size_t getUsedBytes() const;
+
+        /// <summary>
+        /// Gets the most bytes allocated between two resets so far.
+        /// </summary>
+        std::size_t getPeakUsedBytes() const;
+
+        /// <summary>
+        /// Gets the total size of the blocks taken from the heap.
+        /// </summary>
+        std::size_t getCapacity() const;
+    };
+
+    /// <summary>
+    /// Lets standard containers allocate from a <see cref="FrameArena"/>. Deallocating does nothing, so such containers
+    /// must not outlive the update they were created in.
+    /// </summary>
+    template<typename T>
+    class ArenaAllocator
+    {
+    private:
+        FrameArena* m_Arena;
+    public:
+        using value_type = T;
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="ArenaAllocator"/> class.
+        /// </summary>
+        /// <param name="a_Arena">The arena to allocate from, which has to outlive the containers using this.</param>
+        explicit ArenaAllocator(FrameArena& a_Arena)
+            : m_Arena(&a_Arena)
+        {
+        }
+
+        template<typename TOther>
+        ArenaAllocator(const ArenaAllocator<TOther>& a_Other)
+            : m_Arena(a_Other.getArena())
+        {
+        }
+
+        T* allocate(std::size_t a_Count)
+        {
+            return static_cast<T*>(m_Arena->allocate(a_Count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t)
+        {
+        }
+
+        FrameArena* getArena() const
+        {
+            return m_Arena;
+        }
+    };
+
+    template<typename T, typename TOther>
+    bool operator==(const ArenaAllocator<T>& a_Left, const ArenaAllocator<TOther>& a_Right)
+    {
+        return a_Left.getArena() == a_Right.getArena();
+    }
+
+    template<typename T, typename TOther>
+    bool operator!=(const ArenaAllocator<T>& a_Left, const ArenaAllocator<TOther>& a_Right)
+    {
+        return !(a_Left == a_Right);
+    }
+
+    /// <summary> A vector that lives for a single update </summary>
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
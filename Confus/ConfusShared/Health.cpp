@@ -0,0 +1,47 @@
+#include "Health.h"
+
+namespace ConfusShared
+{
+    Health::Health()
+    {
+        m_Health = m_MaxHealth;
+    }
+
+    void Health::damage(int a_Damage)
+    {
+        if(a_Damage > 0)
+        {
+            m_Health -= a_Damage;
+            if(m_Health <= 0)
+            {
+                m_Health = 0;
+                if(m_DeathCallback)
+                {
+                    m_DeathCallback();
+                }
+            }
+        }
+    }
+
+    void Health::heal(int a_Health)
+    {
+        if(a_Health > 0)
+        {
+            m_Health += a_Health;
+            if(m_Health > m_MaxHealth)
+            {
+                m_Health = m_MaxHealth;
+            }
+        }
+    }
+
+    void Health::setDeathCallback(const std::function<void()>& a_DeathCallback)
+    {
+        m_DeathCallback = a_DeathCallback;
+    }
+
+    int Health::getHealth() const
+    {
+        return m_Health;
+    }
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <functional>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// The health of anything that can be damaged, clamped between zero and its maximum
+    /// </summary>
+    class Health
+    {
+    private:
+        /// <summary> Called once the health drops to zero, may be empty </summary>
+        std::function<void()> m_DeathCallback;
+        int m_Health;
+        int m_MaxHealth = 100;
+    public:
+        Health();
+        void damage(int a_Damage);
+        void heal(int a_Health);
+        void setDeathCallback(const std::function<void()>& a_DeathCallback);
+        int getHealth() const;
+    };
+}
@@ -0,0 +1,38 @@
+#include "InputCodec.h"
+
+namespace ConfusShared
+{
+    const float InputCodec::MinimumPitch = -90.0f;
+    const float InputCodec::MaximumPitch = 90.0f;
+
+    PlayerInput InputCodec::quantize(const PlayerInput& a_Input)
+    {
+        PlayerInput quantized = a_Input;
+        quantized.Buttons = static_cast<std::uint16_t>(a_Input.Buttons & ((1u << ButtonBits) - 1u));
+        quantized.Yaw = unpackAngle(packAngle(a_Input.Yaw, YawBits), YawBits);
+        quantized.Pitch = dequantize(ConfusShared::quantize(a_Input.Pitch, MinimumPitch, MaximumPitch, PitchBits),
+            MinimumPitch, MaximumPitch, PitchBits);
+        return quantized;
+    }
+
+    void InputCodec::record(History& a_History, const PlayerInput& a_Input)
+    {
+        if(!a_History.empty() && a_History.at(a_History.size() - 1).Tick + 1 != a_Input.Tick)
+        {
+            a_History.clear();
+        }
+        if(a_History.full())
+        {
+            a_History.pop();
+        }
+        a_History.push(a_Input);
+    }
+
+    bool InputCodec::isSame(const PlayerInput& a_Input, const PlayerInput& a_Other)
+    {
+        return (a_Input.Buttons & ((1u << ButtonBits) - 1u)) == (a_Other.Buttons & ((1u << ButtonBits) - 1u))
+            && packAngle(a_Input.Yaw, YawBits) == packAngle(a_Other.Yaw, YawBits)
+            && ConfusShared::quantize(a_Input.Pitch, MinimumPitch, MaximumPitch, PitchBits)
+                == ConfusShared::quantize(a_Other.Pitch, MinimumPitch, MaximumPitch, PitchBits);
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "BitPacking.h"
+#include "FixedQueue.h"
+#include "PlayerInput.h"
+#include "Quantization.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Packs the inputs a client sends every tick. Each packet repeats the last few inputs, newest first, so an input
+    /// whose packet was lost still arrives with one of the next packets without waiting for a resend.
+    /// </summary>
+    /// <remarks>
+    /// The inputs of a packet are of consecutive ticks, so only the tick of the newest one is sent. An input equal to
+    /// the one sent before it, which is most of them as buttons are held for many ticks, takes a single bit.
+    /// The streams are anything with the WriteBits and ReadBits of RakNet::BitStream, see <see cref="writeBits"/>.
+    /// </remarks>
+    class InputCodec
+    {
+    public:
+        static const float MinimumPitch;
+        static const float MaximumPitch;
+
+        /// <summary> The most inputs a single packet repeats </summary>
+        static const std::size_t MaxInputs = 8;
+        static const unsigned CountBits = 3;
+        static const unsigned ButtonBits = 7;
+        /// <summary> The bits of the yaw, giving steps of 0.09 degrees, as the yaw decides where the player walks and hits </summary>
+        static const unsigned YawBits = 12;
+        /// <summary> The bits of the pitch, giving steps of 0.18 degrees </summary>
+        static const unsigned PitchBits = 10;
+        static const unsigned InputBits = ButtonBits + YawBits + PitchBits;
+
+        /// <summary> The inputs to send, oldest first, which have to be of consecutive ticks </summary>
+        using History = FixedQueue<PlayerInput, MaxInputs>;
+
+        /// <summary>
+        /// Rounds an input to what arrives at the other end, so the client can simulate exactly what the server will.
+        /// </summary>
+        static PlayerInput quantize(const PlayerInput& a_Input);
+
+        /// <summary>
+        /// Adds an input to the history, dropping the oldest one when it is full. When the input does not follow
+        /// the newest one, the history starts over as the inputs in between are never going to be sampled.
+        /// </summary>
+        static void record(History& a_History, const PlayerInput& a_Input);
+
+        /// <summary>
+        /// Writes the inputs of a history, newest first.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The history is empty.</exception>
+        template<typename TBitStream>
+        static void write(TBitStream& a_Stream, const History& a_History)
+        {
+            if(a_History.empty())
+            {
+                throw std::invalid_argument("There has to be an input to send.");
+            }
+
+            std::size_t newest = a_History.size() - 1;
+            writeBits(a_Stream, a_History.at(newest).Tick, 32);
+            writeBits(a_Stream, static_cast<std::uint32_t>(newest), CountBits);
+            writeInput(a_Stream, a_History.at(newest));
+            for(std::size_t i = newest; i-- > 0;)
+            {
+                bool same = isSame(a_History.at(i), a_History.at(i + 1));
+                writeBits(a_Stream, same ? 1u : 0u, 1);
+                if(!same)
+                {
+                    writeInput(a_Stream, a_History.at(i));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Reads the inputs written by <see cref="write"/>.
+        /// </summary>
+        /// <param name="a_Stream">The stream to read from.</param>
+        /// <param name="a_Handle">Called with every input, newest first.</param>
+        /// <exception cref="std::invalid_argument">The stream ends before the inputs do, the inputs before the error have been handled.</exception>
+        template<typename TBitStream, typename THandler>
+        static void read(TBitStream& a_Stream, THandler&& a_Handle)
+        {
+            PlayerInput input;
+            input.Tick = readBits(a_Stream, 32);
+            std::uint32_t older = readBits(a_Stream, CountBits);
+            readInput(a_Stream, input);
+            a_Handle(static_cast<const PlayerInput&>(input));
+            for(std::uint32_t i = 0; i < older; ++i)
+            {
+                --input.Tick;
+                if(readBits(a_Stream, 1) == 0)
+                {
+                    readInput(a_Stream, input);
+                }
+                a_Handle(static_cast<const PlayerInput&>(input));
+            }
+        }
+    private:
+        /// <summary>
+        /// Gets whether two inputs are sent the same, ignoring their ticks.
+        /// </summary>
+        static bool isSame(const PlayerInput& a_Input, const PlayerInput& a_Other);
+
+        template<typename TBitStream>
+        static void writeInput(TBitStream& a_Stream, const PlayerInput& a_Input)
+        {
+            writeBits(a_Stream, a_Input.Buttons & ((1u << ButtonBits) - 1u), ButtonBits);
+            writeBits(a_Stream, packAngle(a_Input.Yaw, YawBits), YawBits);
+            writeBits(a_Stream, ConfusShared::quantize(a_Input.Pitch, MinimumPitch, MaximumPitch, PitchBits), PitchBits);
+        }
+
+        template<typename TBitStream>
+        static void readInput(TBitStream& a_Stream, PlayerInput& a_Input)
+        {
+            a_Input.Buttons = static_cast<std::uint16_t>(readBits(a_Stream, ButtonBits));
+            a_Input.Yaw = unpackAngle(readBits(a_Stream, YawBits), YawBits);
+            a_Input.Pitch = dequantize(readBits(a_Stream, PitchBits), MinimumPitch, MaximumPitch, PitchBits);
+        }
+    };
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+
+#include "InputJitterBuffer.h"
+
+namespace ConfusShared
+{
+    const std::uint32_t InputJitterBuffer::MinTargetDepth = 1;
+    const std::uint32_t InputJitterBuffer::MaxTargetDepth = 8;
+    const std::uint32_t InputJitterBuffer::AdaptationWindow = 50;
+    const std::uint32_t InputJitterBuffer::MaxLateTicks = 16;
+
+    InputJitterBuffer::InputJitterBuffer()
+    {
+        m_Received.fill(false);
+    }
+
+    void InputJitterBuffer::receive(const PlayerInput& a_Input)
+    {
+        if(!m_HasInput)
+        {
+            m_NextTick = a_Input.Tick;
+            m_NewestTick = a_Input.Tick;
+            m_HasInput = true;
+        }
+        //Ticks are compared by their difference, so the comparison still holds when the tick counter wraps around
+        std::int32_t ahead = static_cast<std::int32_t>(a_Input.Tick - m_NextTick);
+        if(ahead < -static_cast<std::int32_t>(MaxLateTicks))
+        {
+            //The client went back in time, waiting for it to catch up again would repeat the last input all the while
+            restart(a_Input.Tick);
+        }
+        else if(ahead < 0)
+        {
+            return;
+        }
+        else if(ahead >= static_cast<std::int32_t>(Capacity))
+        {
+            //The client is too far ahead to catch up with tick by tick, so the buffer starts over just behind it
+            restart(a_Input.Tick);
+            ++m_SkippedCount;
+        }
+
+        std::size_t slot = a_Input.Tick % Capacity;
+        if(!m_Received[slot])
+        {
+            m_Inputs[slot] = a_Input;
+            m_Received[slot] = true;
+        }
+        if(static_cast<std::int32_t>(a_Input.Tick - m_NewestTick) > 0)
+        {
+            m_NewestTick = a_Input.Tick;
+        }
+    }
+
+    bool InputJitterBuffer::consume(PlayerInput& a_Input)
+    {
+        if(!m_Started)
+        {
+            if(!m_HasInput || getDepth() < m_TargetDepth)
+            {
+                return false;
+            }
+            m_Started = true;
+        }
+
+        std::size_t slot = m_NextTick % Capacity;
+        if(m_Received[slot])
+        {
+            m_LastInput = m_Inputs[slot];
+            advance();
+        }
+        else
+        {
+            //Holding on to what the player did last is the best guess, and usually right as buttons are held for many ticks
+            ++m_MissedCount;
+            ++m_WindowMisses;
+            //Every packet repeats the inputs before it, so when a newer input is here the missing one was lost for good.
+            //Otherwise it is late, and waiting for it makes the buffer a tick deeper.
+            if(getDepth() > 1)
+            {
+                advance();
+            }
+        }
+        a_Input = m_LastInput;
+
+        m_WindowMinimumDepth = std::min(m_WindowMinimumDepth, getDepth());
+        if(++m_WindowTicks == AdaptationWindow)
+        {
+            adapt();
+        }
+        return true;
+    }
+
+    void InputJitterBuffer::clear()
+    {
+        *this = InputJitterBuffer();
+    }
+
+    std::uint32_t InputJitterBuffer::getTargetDepth() const
+    {
+        return m_TargetDepth;
+    }
+
+    std::uint32_t InputJitterBuffer::getDepth() const
+    {
+        std::int32_t depth = static_cast<std::int32_t>(m_NewestTick - m_NextTick) + 1;
+        return m_HasInput && depth > 0 ? static_cast<std::uint32_t>(depth) : 0u;
+    }
+
+    std::uint64_t InputJitterBuffer::getMissedCount() const
+    {
+        return m_MissedCount;
+    }
+
+    std::uint64_t InputJitterBuffer::getSkippedCount() const
+    {
+        return m_SkippedCount;
+    }
+
+    void InputJitterBuffer::adapt()
+    {
+        if(m_WindowMisses > 0)
+        {
+            m_TargetDepth = std::min(m_TargetDepth + 1, MaxTargetDepth);
+            m_CleanWindows = 0;
+        }
+        else if(++m_CleanWindows >= 2 && m_TargetDepth > MinTargetDepth)
+        {
+            //Lowering the target only after a while without misses keeps it from going up and down every window
+            --m_TargetDepth;
+            m_CleanWindows = 0;
+        }
+
+        //The buffer never ran lower than this over the whole window, so the inputs beyond the target can be dropped without running dry.
+        //Dropping them all at once wins back the latency a stall piled up right away, instead of a tick per window.
+        for(std::uint32_t depth = std::min(m_WindowMinimumDepth, getDepth()); depth > m_TargetDepth; --depth)
+        {
+            std::size_t slot = m_NextTick % Capacity;
+            if(m_Received[slot])
+            {
+                m_LastInput = m_Inputs[slot];
+            }
+            advance();
+            ++m_SkippedCount;
+        }
+
+        m_WindowTicks = 0;
+        m_WindowMisses = 0;
+        m_WindowMinimumDepth = Capacity;
+    }
+
+    void InputJitterBuffer::restart(std::uint32_t a_Tick)
+    {
+        m_Received.fill(false);
+        m_NextTick = a_Tick - (m_TargetDepth - 1);
+        m_NewestTick = a_Tick;
+    }
+
+    void InputJitterBuffer::advance()
+    {
+        m_Received[m_NextTick % Capacity] = false;
+        ++m_NextTick;
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "PlayerInput.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Holds the inputs received from a single client until the server simulates them, one per tick, so a client whose
+    /// packets arrive in bursts or out of order still moves at a steady rate.
+    /// </summary>
+    /// <remarks>
+    /// The buffer aims to stay a few ticks ahead of what is simulated. When an input has not arrived by the time it is needed,
+    /// the last input is repeated in its place and the buffer grows its target depth, trading latency for smoothness.
+    /// When it has stayed deeper than needed for a while, it skips the inputs it holds beyond its target to win the latency back.
+    /// Inputs arrive several times over as every packet repeats the last few, duplicates are ignored.
+    /// An input from well before the ones buffered means the client went back in time, and the buffer starts over from it.
+    /// </remarks>
+    class InputJitterBuffer
+    {
+    public:
+        /// <summary> The amount of ticks an input may arrive ahead of the one to simulate next </summary>
+        static const std::uint32_t Capacity = 32;
+        static const std::uint32_t MinTargetDepth;
+        static const std::uint32_t MaxTargetDepth;
+        /// <summary> The amount of ticks over which misses and depth are gathered before the target depth is adjusted </summary>
+        static const std::uint32_t AdaptationWindow;
+        /// <summary>
+        /// The most ticks an input may be behind the one to simulate next and still be a repeat or a late arrival,
+        /// an input further behind means the client went back in time
+        /// </summary>
+        static const std::uint32_t MaxLateTicks;
+    private:
+        /// <summary> The buffered inputs, by their tick modulo the capacity </summary>
+        std::array<PlayerInput, Capacity> m_Inputs;
+        std::array<bool, Capacity> m_Received;
+        /// <summary> The tick of the input to simulate next </summary>
+        std::uint32_t m_NextTick = 0;
+        /// <summary> The tick of the newest input received </summary>
+        std::uint32_t m_NewestTick = 0;
+        std::uint32_t m_TargetDepth = 2;
+        /// <summary> Whether inputs are being handed out, which starts once the buffer first reached its target depth </summary>
+        bool m_Started = false;
+        bool m_HasInput = false;
+        /// <summary> The last input handed out, repeated when the next one is missing </summary>
+        PlayerInput m_LastInput;
+
+        std::uint32_t m_WindowTicks = 0;
+        std::uint32_t m_WindowMisses = 0;
+        std::uint32_t m_WindowMinimumDepth = Capacity;
+        /// <summary> The amount of windows in a row without a miss </summary>
+        std::uint32_t m_CleanWindows = 0;
+
+        std::uint64_t m_MissedCount = 0;
+        std::uint64_t m_SkippedCount = 0;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="InputJitterBuffer"/> class.
+        /// </summary>
+        InputJitterBuffer();
+
+        /// <summary>
+        /// Adds an input received from the client. Inputs that were simulated already or that are buffered already are ignored.
+        /// </summary>
+        void receive(const PlayerInput& a_Input);
+
+        /// <summary>
+        /// Takes the input to simulate this tick, meant to be called once every tick.
+        /// </summary>
+        /// <param name="a_Input">The input, the last one repeated, tick included, if it has not arrived in time.</param>
+        /// <returns>Whether there was an input, there is none until the buffer first filled up to its target depth.</returns>
+        bool consume(PlayerInput& a_Input);
+
+        /// <summary>
+        /// Forgets every input, for when the client starts over.
+        /// </summary>
+        void clear();
+
+        /// <summary>
+        /// Gets the amount of ticks the buffer aims to hold.
+        /// </summary>
+        std::uint32_t getTargetDepth() const;
+
+        /// <summary>
+        /// Gets the amount of ticks buffered ahead of the next one to simulate.
+        /// </summary>
+        std::uint32_t getDepth() const;
+
+        /// <summary>
+        /// Gets how often an input did not arrive in time.
+        /// </summary>
+        std::uint64_t getMissedCount() const;
+
+        /// <summary>
+        /// Gets how often an input was skipped to reduce the latency.
+        /// </summary>
+        std::uint64_t getSkippedCount() const;
+    private:
+        /// <summary>
+        /// Adjusts the target depth to the misses and depth of the last window, skipping the inputs buffered beyond the target.
+        /// </summary>
+        void adapt();
+
+        /// <summary>
+        /// Forgets the buffered inputs and continues just behind the given tick.
+        /// </summary>
+        void restart(std::uint32_t a_Tick);
+
+        /// <summary>
+        /// Moves past the next tick, dropping its input.
+        /// </summary>
+        void advance();
+    };
+}
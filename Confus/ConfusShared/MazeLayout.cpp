@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include "MazeLayout.h"
+#include "Random.h"
+
+namespace ConfusShared
+{
+    MazeLayout::MazeLayout(std::size_t a_Width, std::size_t a_Height)
+        : m_Width(a_Width), m_Height(a_Height), m_Raised(a_Width * a_Height, 1u)
+    {
+    }
+
+    void MazeLayout::generate(std::int32_t a_Seed, FrameArena& a_Scratch)
+    {
+        std::fill(m_Raised.begin(), m_Raised.end(), static_cast<std::uint8_t>(1u));
+        if(m_Width == 0 || m_Height == 0)
+        {
+            return;
+        }
+
+        Random random(static_cast<std::uint32_t>(a_Seed));
+        ArenaVector<std::size_t> tileStack{ ArenaAllocator<std::size_t>(a_Scratch) };
+        //The stack never holds more than every other tile along both axes
+        tileStack.reserve((m_Width / 2 + 1) * (m_Height / 2 + 1));
+        std::size_t neighbours[4];
+        std::size_t currentX = 0;
+        std::size_t currentY = 0;
+        carve(currentX, currentY);
+
+        do
+        {
+            //Neighbours are two tiles away, so a wall is left between the corridors
+            std::size_t neighbourCount = 0;
+            if(currentX > 1 && isRaised(currentX - 2, currentY))
+            {
+                neighbours[neighbourCount++] = (currentX - 2) * m_Height + currentY;
+            }
+            if(currentX + 2 < m_Width && isRaised(currentX + 2, currentY))
+            {
+                neighbours[neighbourCount++] = (currentX + 2) * m_Height + currentY;
+            }
+            if(currentY > 1 && isRaised(currentX, currentY - 2))
+            {
+                neighbours[neighbourCount++] = currentX * m_Height + currentY - 2;
+            }
+            if(currentY + 2 < m_Height && isRaised(currentX, currentY + 2))
+            {
+                neighbours[neighbourCount++] = currentX * m_Height + currentY + 2;
+            }
+
+            if(neighbourCount != 0)
+            {
+                tileStack.push_back(currentX * m_Height + currentY);
+                std::size_t neighbour = neighbours[random.nextBelow(static_cast<std::uint32_t>(neighbourCount))];
+                std::size_t nextX = neighbour / m_Height;
+                std::size_t nextY = neighbour % m_Height;
+                carve((currentX + nextX) / 2, (currentY + nextY) / 2);
+                carve(nextX, nextY);
+                currentX = nextX;
+                currentY = nextY;
+            }
+            else if(!tileStack.empty())
+            {
+                currentX = tileStack.back() / m_Height;
+                currentY = tileStack.back() % m_Height;
+                tileStack.pop_back();
+            }
+        } while(!tileStack.empty());
+    }
+
+    bool MazeLayout::isRaised(std::size_t a_X, std::size_t a_Y) const
+    {
+        return m_Raised[a_X * m_Height + a_Y] != 0u;
+    }
+
+    std::size_t MazeLayout::getWidth() const
+    {
+        return m_Width;
+    }
+
+    std::size_t MazeLayout::getHeight() const
+    {
+        return m_Height;
+    }
+
+    void MazeLayout::carve(std::size_t a_X, std::size_t a_Y)
+    {
+        m_Raised[a_X * m_Height + a_Y] = 0u;
+    }
+}
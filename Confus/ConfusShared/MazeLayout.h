@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FrameArena.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Which tiles of a maze have a raised wall, generated from a seed.
+    /// The generation only depends on the seed and the size, so the client and the server build the same maze
+    /// without sending its layout.
+    /// </summary>
+    class MazeLayout
+    {
+    private:
+        std::size_t m_Width;
+        std::size_t m_Height;
+        /// <summary> Whether each tile is raised, stored column by column </summary>
+        std::vector<std::uint8_t> m_Raised;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="MazeLayout"/> class with every tile raised.
+        /// </summary>
+        /// <param name="a_Width">The amount of tiles along X.</param>
+        /// <param name="a_Height">The amount of tiles along Y.</param>
+        MazeLayout(std::size_t a_Width, std::size_t a_Height);
+
+        /// <summary>
+        /// Raises every tile and carves a new maze into them with a depth first search, starting at tile (0, 0).
+        /// </summary>
+        /// <param name="a_Seed">The seed that determines the layout.</param>
+        /// <param name="a_Scratch">Where the tiles still to be visited are kept during the generation.</param>
+        void generate(std::int32_t a_Seed, FrameArena& a_Scratch);
+
+        /// <summary>
+        /// Gets whether the tile has a raised wall.
+        /// </summary>
+        bool isRaised(std::size_t a_X, std::size_t a_Y) const;
+
+        std::size_t getWidth() const;
+        std::size_t getHeight() const;
+    private:
+        /// <summary>
+        /// Lowers a tile.
+        /// </summary>
+        void carve(std::size_t a_X, std::size_t a_Y);
+    };
+}
@@ -0,0 +1,48 @@
+#include "MazeSchedule.h"
+
+namespace ConfusShared
+{
+    const double MazeSchedule::RefillInterval = 9.0;
+    const double MazeSchedule::FloorsSolidTime = 3.0;
+    //Not a specific number, just so the first maze of every match looks the same
+    const std::int32_t MazeSchedule::MatchSeed = 19 + 20 + 21 + 22 + 23 + 24;
+
+    MazeSchedule::MazeSchedule(std::int32_t a_InitialSeed)
+        : m_Seeds(static_cast<std::uint32_t>(a_InitialSeed)), m_Seed(a_InitialSeed)
+    {
+    }
+
+    bool MazeSchedule::fixedUpdate(double a_FixedDeltaTime)
+    {
+        m_Time += a_FixedDeltaTime;
+        if(m_Time < RefillInterval)
+        {
+            return false;
+        }
+
+        m_Time -= RefillInterval;
+        m_Seed = static_cast<std::int32_t>(m_Seeds.next() & 0x7FFFFFFFu);
+        ++m_RefillCount;
+        return true;
+    }
+
+    bool MazeSchedule::skip(std::uint32_t a_FixedUpdates, double a_FixedDeltaTime)
+    {
+        bool refilled = false;
+        for(std::uint32_t i = 0; i < a_FixedUpdates; ++i)
+        {
+            refilled |= fixedUpdate(a_FixedDeltaTime);
+        }
+        return refilled;
+    }
+
+    std::int32_t MazeSchedule::getSeed() const
+    {
+        return m_Seed;
+    }
+
+    bool MazeSchedule::areRespawnFloorsSolid() const
+    {
+        return m_RefillCount == 0 || m_Time >= FloorsSolidTime;
+    }
+}
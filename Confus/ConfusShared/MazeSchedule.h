@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+
+#include "Random.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Keeps the timeline of a round: when the maze is refilled, with which seed, and when the respawn floors are solid.
+    /// It only advances by the fixed update interval, so a client and server that start with the same seed
+    /// refill the same mazes at the same fixed update.
+    /// </summary>
+    class MazeSchedule
+    {
+    public:
+        /// <summary> The time in seconds between refills of the maze </summary>
+        static const double RefillInterval;
+        /// <summary> The time in seconds after a refill at which the respawn floors become solid again </summary>
+        static const double FloorsSolidTime;
+        /// <summary> The seed of the first maze of a match, the same on the client and the server </summary>
+        static const std::int32_t MatchSeed;
+    private:
+        /// <summary> Gives the seed of every next maze </summary>
+        Random m_Seeds;
+        /// <summary> The seed of the last maze </summary>
+        std::int32_t m_Seed;
+        /// <summary> The time since the last refill </summary>
+        double m_Time = 0.0;
+        /// <summary> How often the maze has been refilled </summary>
+        std::uint32_t m_RefillCount = 0;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="MazeSchedule"/> class.
+        /// </summary>
+        /// <param name="a_InitialSeed">The seed of the first maze, from which the seeds of the later mazes follow.</param>
+        explicit MazeSchedule(std::int32_t a_InitialSeed);
+
+        /// <summary>
+        /// Advances the schedule by one fixed update.
+        /// </summary>
+        /// <param name="a_FixedDeltaTime">The fixed update interval in seconds.</param>
+        /// <returns>Whether the maze has to be refilled with <see cref="getSeed"/> during this fixed update.</returns>
+        bool fixedUpdate(double a_FixedDeltaTime);
+
+        /// <summary>
+        /// Advances the schedule by many fixed updates at once, to catch up with a timeline that is further along.
+        /// </summary>
+        /// <param name="a_FixedUpdates">The amount of fixed updates to advance by.</param>
+        /// <param name="a_FixedDeltaTime">The fixed update interval in seconds.</param>
+        /// <returns>Whether the maze was refilled along the way, in which case it has to be refilled with <see cref="getSeed"/>.</returns>
+        bool skip(std::uint32_t a_FixedUpdates, double a_FixedDeltaTime);
+
+        /// <summary>
+        /// Gets the seed of the current maze.
+        /// </summary>
+        std::int32_t getSeed() const;
+
+        /// <summary>
+        /// Gets whether the respawn floors are solid, which they are from the start until the first refill
+        /// and from a while after each refill until the next.
+        /// </summary>
+        bool areRespawnFloorsSolid() const;
+    };
+}
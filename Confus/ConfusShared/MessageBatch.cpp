@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "MessageBatch.h"
+
+namespace ConfusShared
+{
+    namespace
+    {
+        /// <summary>
+        /// Reads a length prefix, seven bits per byte with the high bit set on all but the last byte.
+        /// </summary>
+        /// <returns>The amount of bytes the prefix took, zero if it runs past the end.</returns>
+        std::size_t readLength(const std::uint8_t* a_Data, std::size_t a_Size, std::size_t& a_Length)
+        {
+            a_Length = 0;
+            for(std::size_t i = 0; i < a_Size && i < sizeof(std::size_t); ++i)
+            {
+                a_Length |= static_cast<std::size_t>(a_Data[i] & 0x7F) << (7 * i);
+                if((a_Data[i] & 0x80) == 0)
+                {
+                    return i + 1;
+                }
+            }
+            return 0;
+        }
+    }
+
+    const std::size_t MessageBatch::DefaultByteLimit = 64 * 1024;
+
+    MessageBatch::MessageBatch(std::size_t a_ByteLimit)
+        : m_ByteLimit(a_ByteLimit)
+    {
+    }
+
+    void MessageBatch::add(const std::uint8_t* a_Data, std::size_t a_Size, bool a_Droppable)
+    {
+        if(a_Size == 0)
+        {
+            throw std::invalid_argument("A message has to hold at least its packet id.");
+        }
+
+        std::size_t length = a_Size;
+        while(length >= 0x80)
+        {
+            m_Messages.push_back(static_cast<std::uint8_t>(length | 0x80));
+            length >>= 7;
+        }
+        m_Messages.push_back(static_cast<std::uint8_t>(length));
+        m_Messages.insert(m_Messages.end(), a_Data, a_Data + a_Size);
+        m_Droppable.push_back(a_Droppable);
+        if(m_Messages.size() > m_ByteLimit)
+        {
+            dropOldest();
+        }
+    }
+
+    void MessageBatch::flush(std::uint8_t a_BatchId, std::size_t a_MaxDatagramSize, const DatagramSender& a_Send)
+    {
+        flush(a_BatchId, a_MaxDatagramSize, []() { return true; }, a_Send);
+    }
+
+    void MessageBatch::flush(std::uint8_t a_BatchId, std::size_t a_MaxDatagramSize, const SendPermission& a_MaySend, const DatagramSender& a_Send)
+    {
+        std::size_t position = 0;
+        std::size_t sentCount = 0;
+        while(position < m_Messages.size() && a_MaySend())
+        {
+            m_Datagram.resize(1);
+            m_Datagram[0] = a_BatchId;
+            while(position < m_Messages.size())
+            {
+                std::size_t length;
+                std::size_t prefixSize = readLength(&m_Messages[position], m_Messages.size() - position, length);
+                std::size_t recordSize = prefixSize + length;
+                //A datagram that already holds a message is sent before it would grow past the MTU
+                if(m_Datagram.size() > 1 && m_Datagram.size() + recordSize > a_MaxDatagramSize)
+                {
+                    break;
+                }
+                m_Datagram.insert(m_Datagram.end(), m_Messages.begin() + position, m_Messages.begin() + position + recordSize);
+                position += recordSize;
+                ++sentCount;
+            }
+            a_Send(m_Datagram.data(), m_Datagram.size());
+        }
+        m_Messages.erase(m_Messages.begin(), m_Messages.begin() + position);
+        m_Droppable.erase(m_Droppable.begin(), m_Droppable.begin() + sentCount);
+    }
+
+    void MessageBatch::dropOldest()
+    {
+        //The messages that are kept are moved forward over the dropped ones in a single pass
+        std::size_t excess = m_Messages.size() - m_ByteLimit;
+        std::size_t readPosition = 0;
+        std::size_t writePosition = 0;
+        std::size_t keptCount = 0;
+        for(std::size_t i = 0; i < m_Droppable.size(); ++i)
+        {
+            std::size_t length;
+            std::size_t recordSize = readLength(&m_Messages[readPosition], m_Messages.size() - readPosition, length) + length;
+            if(excess > 0 && m_Droppable[i])
+            {
+                excess -= std::min(excess, recordSize);
+            }
+            else
+            {
+                std::copy(m_Messages.begin() + readPosition, m_Messages.begin() + readPosition + recordSize, m_Messages.begin() + writePosition);
+                writePosition += recordSize;
+                m_Droppable[keptCount++] = m_Droppable[i];
+            }
+            readPosition += recordSize;
+        }
+        m_Messages.resize(writePosition);
+        m_Droppable.resize(keptCount);
+    }
+
+    void MessageBatch::clear()
+    {
+        m_Messages.clear();
+        m_Droppable.clear();
+    }
+
+    std::size_t MessageBatch::getMessageCount() const
+    {
+        return m_Droppable.size();
+    }
+
+    std::size_t MessageBatch::getQueuedBytes() const
+    {
+        return m_Messages.size();
+    }
+
+    void MessageBatch::unpack(const std::uint8_t* a_Datagram, std::size_t a_Size, const MessageHandler& a_Handle)
+    {
+        std::size_t position = 1;
+        while(position < a_Size)
+        {
+            std::size_t length;
+            std::size_t prefixSize = readLength(a_Datagram + position, a_Size - position, length);
+            if(prefixSize == 0 || length == 0 || length > a_Size - position - prefixSize)
+            {
+                throw std::invalid_argument("The batched message is truncated.");
+            }
+            position += prefixSize;
+            a_Handle(a_Datagram + position, length);
+            position += length;
+        }
+    }
+}
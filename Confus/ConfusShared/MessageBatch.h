@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Collects the messages for a single peer during a tick and packs them into as few datagrams as fit the path MTU.
+    /// A datagram starts with the id of the batch packet, followed by the messages, each prefixed with its length
+    /// as a variable length integer, so a message of up to 127 bytes costs a single byte of header.
+    /// </summary>
+    /// <remarks>
+    /// A message larger than a datagram is sent in a datagram of its own, which the networking library splits up.
+    /// The buffers are kept between flushes, so batching does not allocate once the busiest tick has been seen.
+    /// A flush may stop early when the peer may not be sent more, the messages left stay queued for the next flush.
+    /// So the queue cannot grow without bound meanwhile, the oldest droppable messages are dropped once it holds more than its byte limit.
+    /// </remarks>
+    class MessageBatch
+    {
+    public:
+        /// <summary> Sends a single datagram, given its bytes and its size </summary>
+        using DatagramSender = std::function<void(const std::uint8_t*, std::size_t)>;
+        /// <summary> Handles a single message unpacked from a datagram, given its bytes and its size </summary>
+        using MessageHandler = std::function<void(const std::uint8_t*, std::size_t)>;
+        /// <summary> Gets whether another datagram may be sent </summary>
+        using SendPermission = std::function<bool()>;
+
+        /// <summary> The bytes a batch queues at most before dropping droppable messages, unless it is given another limit </summary>
+        static const std::size_t DefaultByteLimit;
+    private:
+        /// <summary> The messages queued since the last flush, each prefixed with its length </summary>
+        std::vector<std::uint8_t> m_Messages;
+        /// <summary> The datagram being packed while flushing </summary>
+        std::vector<std::uint8_t> m_Datagram;
+        /// <summary> For every queued message, in order, whether it may be dropped when the queue grows past its limit </summary>
+        std::vector<bool> m_Droppable;
+        std::size_t m_ByteLimit;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="MessageBatch"/> class.
+        /// </summary>
+        /// <param name="a_ByteLimit">The bytes queued, including the length prefixes, above which the oldest droppable messages are dropped.</param>
+        explicit MessageBatch(std::size_t a_ByteLimit = DefaultByteLimit);
+
+        /// <summary>
+        /// Queues a message until the next flush.
+        /// </summary>
+        /// <param name="a_Data">The message, starting with its own packet id.</param>
+        /// <param name="a_Size">The size of the message in bytes, which has to be above zero.</param>
+        /// <param name="a_Droppable">
+        /// Whether the message may be dropped unsent when the queue grows past its limit,
+        /// which suits state that a newer message replaces anyway.
+        /// </param>
+        void add(const std::uint8_t* a_Data, std::size_t a_Size, bool a_Droppable = false);
+
+        /// <summary>
+        /// Packs the queued messages into datagrams and sends them, in the order the messages were queued.
+        /// </summary>
+        /// <param name="a_BatchId">The packet id every datagram starts with.</param>
+        /// <param name="a_MaxDatagramSize">The largest datagram to send, including the id.</param>
+        /// <param name="a_Send">Sends a packed datagram.</param>
+        void flush(std::uint8_t a_BatchId, std::size_t a_MaxDatagramSize, const DatagramSender& a_Send);
+
+        /// <summary>
+        /// Packs the queued messages into datagrams and sends them for as long as sending is permitted,
+        /// the messages that were not sent stay queued in order.
+        /// </summary>
+        /// <param name="a_BatchId">The packet id every datagram starts with.</param>
+        /// <param name="a_MaxDatagramSize">The largest datagram to send, including the id.</param>
+        /// <param name="a_MaySend">Asked before every datagram, so a datagram that has been started is always sent whole.</param>
+        /// <param name="a_Send">Sends a packed datagram.</param>
+        void flush(std::uint8_t a_BatchId, std::size_t a_MaxDatagramSize, const SendPermission& a_MaySend, const DatagramSender& a_Send);
+
+        /// <summary>
+        /// Drops the queued messages without sending them.
+        /// </summary>
+        void clear();
+
+        /// <summary>
+        /// Gets the amount of messages queued and not sent yet.
+        /// </summary>
+        std::size_t getMessageCount() const;
+
+        /// <summary>
+        /// Gets the amount of bytes queued and not sent yet, including the length prefixes.
+        /// </summary>
+        std::size_t getQueuedBytes() const;
+
+        /// <summary>
+        /// Splits a received datagram back into its messages.
+        /// </summary>
+        /// <param name="a_Datagram">The datagram, starting with the id of the batch packet.</param>
+        /// <param name="a_Size">The size of the datagram in bytes.</param>
+        /// <param name="a_Handle">Called for every message, in the order they were queued.</param>
+        /// <exception cref="std::invalid_argument">The datagram is truncated or malformed, the messages before the error have been handled.</exception>
+        static void unpack(const std::uint8_t* a_Datagram, std::size_t a_Size, const MessageHandler& a_Handle);
+    private:
+        /// <summary>
+        /// Drops the oldest droppable messages until the queue is back within its byte limit, or no droppable message is left.
+        /// </summary>
+        void dropOldest();
+    };
+}
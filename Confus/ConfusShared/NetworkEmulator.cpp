@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "NetworkEmulator.h"
+
+namespace ConfusShared
+{
+    namespace
+    {
+        LinkConditions makeConditions(double a_LatencyMilliseconds, double a_JitterMilliseconds, double a_LossPercentage,
+            std::uint32_t a_BandwidthKibibytes)
+        {
+            LinkConditions conditions;
+            conditions.Latency = a_LatencyMilliseconds / 1000.0;
+            conditions.Jitter = a_JitterMilliseconds / 1000.0;
+            conditions.Loss = a_LossPercentage / 100.0;
+            conditions.Bandwidth = a_BandwidthKibibytes * 1024;
+            return conditions;
+        }
+    }
+
+    LinkProfile::LinkProfile()
+        : LinkProfile(LinkConditions())
+    {
+    }
+
+    LinkProfile::LinkProfile(const LinkConditions& a_Conditions)
+    {
+        addStage(0.0, a_Conditions);
+    }
+
+    void LinkProfile::addStage(double a_StartTime, const LinkConditions& a_Conditions)
+    {
+        auto position = std::find_if(m_Stages.begin(), m_Stages.end(), [a_StartTime](const Stage& a_Stage)
+        {
+            return a_Stage.StartTime >= a_StartTime;
+        });
+        if(position != m_Stages.end() && position->StartTime == a_StartTime)
+        {
+            position->Conditions = a_Conditions;
+            return;
+        }
+        Stage stage;
+        stage.StartTime = a_StartTime;
+        stage.Conditions = a_Conditions;
+        m_Stages.insert(position, stage);
+    }
+
+    const LinkConditions& LinkProfile::getConditions(double a_Time) const
+    {
+        //Before the first stage the link is as the first stage describes
+        std::size_t stage = 0;
+        while(stage + 1 < m_Stages.size() && m_Stages[stage + 1].StartTime <= a_Time)
+        {
+            ++stage;
+        }
+        return m_Stages[stage].Conditions;
+    }
+
+    LinkProfile LinkProfile::parse(std::istream& a_Script)
+    {
+        LinkProfile profile;
+        std::string line;
+        for(int lineNumber = 1; std::getline(a_Script, line); ++lineNumber)
+        {
+            std::istringstream words(line.substr(0, line.find('#')));
+            std::string word;
+            if(!(words >> word))
+            {
+                continue;
+            }
+
+            double startTime;
+            if(word != "at" || !(words >> startTime))
+            {
+                throw std::invalid_argument("Line " + std::to_string(lineNumber) + " of the link profile does not start with \"at <seconds>\".");
+            }
+            LinkConditions conditions;
+            double value;
+            while(words >> word)
+            {
+                if(!(words >> value) || value < 0.0)
+                {
+                    throw std::invalid_argument("Line " + std::to_string(lineNumber) + " of the link profile has no valid value for " + word + ".");
+                }
+                if(word == "latency")
+                {
+                    conditions.Latency = value / 1000.0;
+                }
+                else if(word == "jitter")
+                {
+                    conditions.Jitter = value / 1000.0;
+                }
+                else if(word == "loss")
+                {
+                    conditions.Loss = value / 100.0;
+                }
+                else if(word == "duplicate")
+                {
+                    conditions.Duplication = value / 100.0;
+                }
+                else if(word == "reorder")
+                {
+                    conditions.Reordering = value / 100.0;
+                }
+                else if(word == "bandwidth")
+                {
+                    conditions.Bandwidth = static_cast<std::uint32_t>(value * 1024.0);
+                }
+                else if(word == "queue")
+                {
+                    conditions.QueueLimit = static_cast<std::uint32_t>(value * 1024.0);
+                }
+                else
+                {
+                    throw std::invalid_argument("Line " + std::to_string(lineNumber) + " of the link profile has an unknown condition " + word + ".");
+                }
+            }
+            profile.addStage(startTime, conditions);
+        }
+        return profile;
+    }
+
+    LinkProfile LinkProfile::getNamed(const std::string& a_Name)
+    {
+        if(a_Name == "lan")
+        {
+            return LinkProfile(makeConditions(1.0, 0.5, 0.0, 0));
+        }
+        if(a_Name == "broadband")
+        {
+            return LinkProfile(makeConditions(20.0, 3.0, 0.5, 1024));
+        }
+        if(a_Name == "mobile")
+        {
+            LinkConditions conditions = makeConditions(60.0, 25.0, 2.0, 128);
+            conditions.Duplication = 0.005;
+            conditions.Reordering = 0.01;
+            return LinkProfile(conditions);
+        }
+        if(a_Name == "congested")
+        {
+            LinkConditions conditions = makeConditions(40.0, 10.0, 3.0, 32);
+            conditions.QueueLimit = 16 * 1024;
+            return LinkProfile(conditions);
+        }
+        if(a_Name == "flaky")
+        {
+            //A broadband link that drops out for a few seconds, then comes back worse
+            LinkProfile profile(makeConditions(20.0, 3.0, 0.5, 1024));
+            profile.addStage(10.0, makeConditions(150.0, 50.0, 20.0, 64));
+            profile.addStage(15.0, makeConditions(20.0, 3.0, 0.5, 1024));
+            profile.addStage(25.0, makeConditions(60.0, 25.0, 2.0, 128));
+            return profile;
+        }
+        throw std::invalid_argument("There is no link profile named " + a_Name + ".");
+    }
+
+    EmulatedLink::EmulatedLink(const LinkProfile& a_Profile, std::uint32_t a_Seed)
+        : m_Profile(a_Profile), m_Random(a_Seed)
+    {
+    }
+
+    void EmulatedLink::send(const std::uint8_t* a_Data, std::size_t a_Size, double a_Time)
+    {
+        const LinkConditions& conditions = m_Profile.getConditions(a_Time);
+        ++m_Statistics.Sent;
+
+        //Every datagram draws the same amount of numbers, so one decision does not shift the draws of the next datagrams
+        double lossDraw = nextUnit();
+        double jitterDraw = nextUnit();
+        double duplicationDraw = nextUnit();
+        double duplicateDelayDraw = nextUnit();
+        double reorderingDraw = nextUnit();
+
+        double departureTime = std::max(a_Time, m_LinkFreeTime);
+        if(conditions.Bandwidth != 0)
+        {
+            double queuedBytes = (departureTime - a_Time) * conditions.Bandwidth;
+            if(queuedBytes + a_Size > conditions.QueueLimit)
+            {
+                ++m_Statistics.Overflowed;
+                return;
+            }
+            departureTime += static_cast<double>(a_Size) / conditions.Bandwidth;
+            m_LinkFreeTime = departureTime;
+        }
+        //A datagram lost on the way still took its time on the link
+        if(lossDraw < conditions.Loss)
+        {
+            ++m_Statistics.Lost;
+            return;
+        }
+
+        double arrivalTime = departureTime + std::max(conditions.Latency + (jitterDraw * 2.0 - 1.0) * conditions.Jitter, 0.0);
+        if(reorderingDraw < conditions.Reordering)
+        {
+            //Held back by a while, without moving the time the datagrams after it have to wait for
+            arrivalTime += conditions.Latency * 0.5 + conditions.Jitter + 0.001;
+            ++m_Statistics.Reordered;
+        }
+        else
+        {
+            arrivalTime = std::max(arrivalTime, m_LastArrivalTime);
+            m_LastArrivalTime = arrivalTime;
+        }
+        schedule(a_Data, a_Size, arrivalTime);
+
+        if(duplicationDraw < conditions.Duplication)
+        {
+            schedule(a_Data, a_Size, arrivalTime + duplicateDelayDraw * conditions.Jitter);
+            ++m_Statistics.Duplicated;
+        }
+    }
+
+    void EmulatedLink::deliver(double a_Time, const DatagramReceiver& a_Receive)
+    {
+        while(!m_InFlight.empty() && m_InFlight.front().DeliveryTime <= a_Time)
+        {
+            std::pop_heap(m_InFlight.begin(), m_InFlight.end(), arrivesLater);
+            InFlight datagram = std::move(m_InFlight.back());
+            m_InFlight.pop_back();
+            ++m_Statistics.Delivered;
+            a_Receive(datagram.Data.data(), datagram.Data.size());
+        }
+    }
+
+    double EmulatedLink::getNextArrivalTime() const
+    {
+        return m_InFlight.empty() ? std::numeric_limits<double>::infinity() : m_InFlight.front().DeliveryTime;
+    }
+
+    const EmulatedLink::Statistics& EmulatedLink::getStatistics() const
+    {
+        return m_Statistics;
+    }
+
+    double EmulatedLink::nextUnit()
+    {
+        return (m_Random.next() >> 8) / static_cast<double>(1u << 24);
+    }
+
+    void EmulatedLink::schedule(const std::uint8_t* a_Data, std::size_t a_Size, double a_DeliveryTime)
+    {
+        InFlight datagram;
+        datagram.DeliveryTime = a_DeliveryTime;
+        datagram.Sequence = m_NextSequence++;
+        datagram.Data.assign(a_Data, a_Data + a_Size);
+        m_InFlight.push_back(std::move(datagram));
+        std::push_heap(m_InFlight.begin(), m_InFlight.end(), arrivesLater);
+    }
+
+    bool EmulatedLink::arrivesLater(const InFlight& a_First, const InFlight& a_Second)
+    {
+        return a_First.DeliveryTime != a_Second.DeliveryTime ? a_First.DeliveryTime > a_Second.DeliveryTime : a_First.Sequence > a_Second.Sequence;
+    }
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "Random.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// How a link treats the datagrams sent over it in a single direction
+    /// </summary>
+    struct LinkConditions
+    {
+        /// <summary> The one way delay in seconds </summary>
+        double Latency = 0.0;
+        /// <summary> The most the delay of a datagram varies from the latency, in seconds </summary>
+        double Jitter = 0.0;
+        /// <summary> The chance a datagram is lost, from 0 to 1 </summary>
+        double Loss = 0.0;
+        /// <summary> The chance a datagram arrives twice, from 0 to 1 </summary>
+        double Duplication = 0.0;
+        /// <summary> The chance a datagram is held back long enough for the ones after it to overtake it, from 0 to 1 </summary>
+        double Reordering = 0.0;
+        /// <summary> The bytes per second the link carries, zero for no limit </summary>
+        std::uint32_t Bandwidth = 0;
+        /// <summary> The bytes that may wait for the link when it is at its bandwidth, the rest is dropped </summary>
+        std::uint32_t QueueLimit = 64 * 1024;
+    };
+
+    /// <summary>
+    /// A script of link conditions over time, so a test can for instance start on a good link, lose half its bandwidth
+    /// after ten seconds and recover after twenty.
+    /// </summary>
+    /// <remarks>
+    /// A script has a line per stage, starting with the time in seconds it takes effect, followed by the conditions
+    /// that differ from a perfect link: latency and jitter in milliseconds, loss, duplicate and reorder in percent,
+    /// bandwidth and queue in KiB(/s). Everything after a # is a comment.
+    /// <code>
+    /// at 0 latency 40 jitter 5 loss 1
+    /// at 10 latency 40 jitter 5 loss 1 bandwidth 32
+    /// </code>
+    /// </remarks>
+    class LinkProfile
+    {
+    public:
+        /// <summary>
+        /// The conditions of a link from a point in time until the next stage
+        /// </summary>
+        struct Stage
+        {
+            /// <summary> The time in seconds since the start of the emulation at which the stage begins </summary>
+            double StartTime = 0.0;
+            LinkConditions Conditions;
+        };
+    private:
+        /// <summary> The stages, ordered by when they begin </summary>
+        std::vector<Stage> m_Stages;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LinkProfile"/> class for a perfect link.
+        /// </summary>
+        LinkProfile();
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="LinkProfile"/> class with the same conditions all the time.
+        /// </summary>
+        explicit LinkProfile(const LinkConditions& a_Conditions);
+
+        /// <summary>
+        /// Adds a stage, which replaces any stage that begins at the same time.
+        /// </summary>
+        void addStage(double a_StartTime, const LinkConditions& a_Conditions);
+
+        /// <summary>
+        /// Gets the conditions at a point in time.
+        /// </summary>
+        /// <param name="a_Time">The time in seconds since the start of the emulation.</param>
+        const LinkConditions& getConditions(double a_Time) const;
+
+        /// <summary>
+        /// Reads a profile from a script.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">A line of the script could not be read.</exception>
+        static LinkProfile parse(std::istream& a_Script);
+
+        /// <summary>
+        /// Gets a built in profile: lan, broadband, mobile, congested or flaky.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">There is no profile with the name.</exception>
+        static LinkProfile getNamed(const std::string& a_Name);
+    };
+
+    /// <summary>
+    /// Emulates a single direction of a link: datagrams sent into it come out later, or not at all, as the conditions
+    /// of its <see cref="LinkProfile"/> dictate. Every random decision comes from a seeded generator, so the same datagrams
+    /// sent at the same times always come out the same way.
+    /// </summary>
+    /// <remarks>
+    /// Datagrams are sent onto the link one after another at its bandwidth, then take the latency plus or minus the jitter
+    /// to arrive. Unless a datagram is picked to be reordered, it never arrives before the datagrams sent before it.
+    /// </remarks>
+    class EmulatedLink
+    {
+    public:
+        /// <summary> Receives a datagram that came out of the link, given its bytes and its size </summary>
+        using DatagramReceiver = std::function<void(const std::uint8_t*, std::size_t)>;
+
+        /// <summary>
+        /// What happened to the datagrams sent over the link
+        /// </summary>
+        struct Statistics
+        {
+            std::uint64_t Sent = 0;
+            std::uint64_t Delivered = 0;
+            std::uint64_t Lost = 0;
+            /// <summary> The datagrams dropped because the queue of the link was full </summary>
+            std::uint64_t Overflowed = 0;
+            std::uint64_t Duplicated = 0;
+            std::uint64_t Reordered = 0;
+        };
+    private:
+        /// <summary>
+        /// A datagram on its way through the link
+        /// </summary>
+        struct InFlight
+        {
+            double DeliveryTime;
+            /// <summary> The order in which datagrams were scheduled, so ones due at the same time keep that order </summary>
+            std::uint64_t Sequence;
+            std::vector<std::uint8_t> Data;
+        };
+
+        LinkProfile m_Profile;
+        Random m_Random;
+        /// <summary> The datagrams in flight, as a heap with the first to arrive on top </summary>
+        std::vector<InFlight> m_InFlight;
+        std::uint64_t m_NextSequence = 0;
+        /// <summary> The time at which the link has sent everything that was queued on it </summary>
+        double m_LinkFreeTime = 0.0;
+        /// <summary> The arrival time of the last datagram that was not reordered </summary>
+        double m_LastArrivalTime = 0.0;
+        Statistics m_Statistics;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="EmulatedLink"/> class.
+        /// </summary>
+        /// <param name="a_Profile">The conditions of the link over time.</param>
+        /// <param name="a_Seed">The seed of every random decision the link makes.</param>
+        EmulatedLink(const LinkProfile& a_Profile, std::uint32_t a_Seed);
+
+        /// <summary>
+        /// Sends a datagram into the link.
+        /// </summary>
+        /// <param name="a_Data">The datagram.</param>
+        /// <param name="a_Size">The size of the datagram in bytes.</param>
+        /// <param name="a_Time">The current time in seconds since the start of the emulation, which may not go back.</param>
+        void send(const std::uint8_t* a_Data, std::size_t a_Size, double a_Time);
+
+        /// <summary>
+        /// Hands out every datagram that has arrived by now, in the order they arrived.
+        /// </summary>
+        /// <param name="a_Time">The current time in seconds since the start of the emulation.</param>
+        /// <param name="a_Receive">Receives each datagram.</param>
+        void deliver(double a_Time, const DatagramReceiver& a_Receive);
+
+        /// <summary>
+        /// Gets the time the next datagram arrives, infinity if there is none in flight.
+        /// </summary>
+        double getNextArrivalTime() const;
+
+        const Statistics& getStatistics() const;
+    private:
+        /// <summary>
+        /// Gets a random number in the range [0, 1).
+        /// </summary>
+        double nextUnit();
+
+        void schedule(const std::uint8_t* a_Data, std::size_t a_Size, double a_DeliveryTime);
+
+        /// <summary>
+        /// Orders the heap of datagrams in flight, with the first to arrive on top.
+        /// </summary>
+        static bool arrivesLater(const InFlight& a_First, const InFlight& a_Second);
+    };
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include "PacketCompressor.h"
+
+namespace ConfusShared
+{
+    namespace
+    {
+        /// <summary>
+        /// Byte frequencies counted on simulated match traffic: batched messages holding transform deltas,
+        /// maze bitmaps, team and flag states and chat. Printed by PacketCompressionBenchmark --train.
+        /// </summary>
+        const std::uint32_t DefaultModel[256] =
+        {
+            46206, 4256, 12681, 2895, 16014, 1815, 11534, 1629, 16759, 4574, 8038, 930, 14337, 785, 7368, 1223,
+            12160, 7953, 7240, 1040, 8076, 589, 3700, 390, 12845, 6804, 2418, 434, 8004, 527, 2516, 1400,
+            20012, 13359, 8973, 7574, 9229, 5521, 3594, 3821, 10986, 3508, 1753, 523, 3717, 428, 733, 347,
+            8879, 7001, 3592, 877, 2193, 460, 591, 356, 8618, 5995, 670, 436, 2169, 585, 625, 977,
+            8447, 11368, 4163, 7148, 6473, 3649, 644, 2928, 9703, 4164, 260, 1351, 905, 762, 98, 702,
+            4060, 4556, 2403, 681, 612, 273, 91, 245, 4042, 4168, 188, 187, 463, 91, 70, 84,
+            4767, 4655, 2464, 1641, 3114, 1074, 514, 474, 2640, 1084, 157, 268, 586, 90, 233, 78,
+            4030, 4382, 2633, 582, 553, 134, 152, 140, 2404, 3704, 339, 316, 362, 301, 73, 411,
+            2079, 6452, 11459, 5415, 1578, 3234, 9468, 21988, 9759, 2802, 5419, 1558, 116, 973, 5018, 1436,
+            9503, 3038, 3262, 678, 145, 335, 2058, 334, 1191, 1980, 911, 179, 78, 122, 855, 122,
+            2770, 2216, 2364, 902, 2296, 375, 561, 208, 1245, 404, 1000, 567, 106, 84, 680, 591,
+            1547, 2113, 1288, 215, 190, 95, 143, 76, 821, 1660, 649, 475, 138, 75, 572, 574,
+            2019, 6260, 2269, 4482, 5214, 2810, 495, 2567, 6290, 2750, 182, 1198, 247, 749, 116, 687,
+            660, 1444, 713, 417, 288, 254, 114, 223, 440, 1157, 147, 134, 294, 102, 145, 105,
+            2354, 2243, 1710, 916, 2520, 443, 372, 216, 423, 203, 918, 554, 342, 122, 620, 535,
+            691, 1198, 810, 217, 113, 236, 321, 251, 298, 1157, 649, 729, 230, 322, 931, 3714
+        };
+
+        /// <summary>
+        /// Gets the length of the Huffman code of every byte value.
+        /// </summary>
+        std::array<std::uint8_t, 256> getCodeLengths(const PacketCompressor::Frequencies& a_Frequencies)
+        {
+            using Node = std::pair<std::uint64_t, int>;
+            std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+            std::vector<int> parents(511, -1);
+            for(int symbol = 0; symbol < 256; ++symbol)
+            {
+                //Every byte value needs a code, as any of them may turn up in a datagram
+                queue.push(Node(static_cast<std::uint64_t>(a_Frequencies[symbol]) + 1u, symbol));
+            }
+            int nextNode = 256;
+            while(queue.size() > 1)
+            {
+                Node first = queue.top();
+                queue.pop();
+                Node second = queue.top();
+                queue.pop();
+                parents[first.second] = nextNode;
+                parents[second.second] = nextNode;
+                queue.push(Node(first.first + second.first, nextNode));
+                ++nextNode;
+            }
+
+            std::array<std::uint8_t, 256> lengths;
+            for(int symbol = 0; symbol < 256; ++symbol)
+            {
+                int length = 0;
+                for(int node = symbol; parents[node] != -1; node = parents[node])
+                {
+                    ++length;
+                }
+                lengths[symbol] = static_cast<std::uint8_t>(std::min(length, 255));
+            }
+            return lengths;
+        }
+
+        std::uint16_t reverseBits(std::uint16_t a_Code, unsigned a_Length)
+        {
+            std::uint16_t reversed = 0;
+            for(unsigned i = 0; i < a_Length; ++i)
+            {
+                reversed = static_cast<std::uint16_t>((reversed << 1) | ((a_Code >> i) & 1u));
+            }
+            return reversed;
+        }
+    }
+
+    PacketCompressor::PacketCompressor()
+        : PacketCompressor(getDefaultModel())
+    {
+    }
+
+    PacketCompressor::PacketCompressor(const Frequencies& a_Frequencies)
+        : m_DecodeTable(std::size_t(1) << MaxCodeLength)
+    {
+        //Flattening the frequencies until the longest code fits gives up a little compression on the rarest bytes
+        Frequencies frequencies = a_Frequencies;
+        m_CodeLengths = getCodeLengths(frequencies);
+        while(*std::max_element(m_CodeLengths.begin(), m_CodeLengths.end()) > MaxCodeLength)
+        {
+            for(auto& frequency : frequencies)
+            {
+                frequency /= 2;
+            }
+            m_CodeLengths = getCodeLengths(frequencies);
+        }
+
+        //Canonical codes are handed out by length and then by byte value
+        std::array<int, 256> symbols;
+        for(int symbol = 0; symbol < 256; ++symbol)
+        {
+            symbols[symbol] = symbol;
+        }
+        std::sort(symbols.begin(), symbols.end(), [this](int a_First, int a_Second)
+        {
+            return m_CodeLengths[a_First] != m_CodeLengths[a_Second] ? m_CodeLengths[a_First] < m_CodeLengths[a_Second] : a_First < a_Second;
+        });
+        std::uint32_t code = 0;
+        unsigned previousLength = m_CodeLengths[symbols[0]];
+        for(int symbol : symbols)
+        {
+            unsigned length = m_CodeLengths[symbol];
+            code <<= length - previousLength;
+            previousLength = length;
+            m_Codes[symbol] = reverseBits(static_cast<std::uint16_t>(code), length);
+            ++code;
+
+            //Every entry whose lowest bits are this code decodes to this byte, whatever the bits after it are
+            for(std::size_t entry = m_Codes[symbol]; entry < m_DecodeTable.size(); entry += std::size_t(1) << length)
+            {
+                m_DecodeTable[entry] = static_cast<std::uint16_t>(symbol | (length << 8));
+            }
+        }
+    }
+
+    bool PacketCompressor::compress(const std::uint8_t* a_Data, std::size_t a_Size, std::vector<std::uint8_t>& a_Output) const
+    {
+        const std::size_t start = a_Output.size();
+        std::size_t length = a_Size;
+        while(length >= 0x80)
+        {
+            a_Output.push_back(static_cast<std::uint8_t>(length | 0x80));
+            length >>= 7;
+        }
+        a_Output.push_back(static_cast<std::uint8_t>(length));
+
+        std::uint64_t bits = 0;
+        unsigned bitCount = 0;
+        for(std::size_t i = 0; i < a_Size; ++i)
+        {
+            bits |= static_cast<std::uint64_t>(m_Codes[a_Data[i]]) << bitCount;
+            bitCount += m_CodeLengths[a_Data[i]];
+            while(bitCount >= 8)
+            {
+                a_Output.push_back(static_cast<std::uint8_t>(bits));
+                bits >>= 8;
+                bitCount -= 8;
+            }
+            //Giving up as soon as the output is no smaller saves coding the rest of a datagram that does not compress
+            if(a_Output.size() - start >= a_Size)
+            {
+                a_Output.resize(start);
+                return false;
+            }
+        }
+        if(bitCount > 0)
+        {
+            a_Output.push_back(static_cast<std::uint8_t>(bits));
+        }
+        if(a_Output.size() - start >= a_Size)
+        {
+            a_Output.resize(start);
+            return false;
+        }
+        return true;
+    }
+
+    void PacketCompressor::decompress(const std::uint8_t* a_Data, std::size_t a_Size, std::vector<std::uint8_t>& a_Output) const
+    {
+        std::size_t originalSize = 0;
+        std::size_t position = 0;
+        for(unsigned shift = 0;; shift += 7)
+        {
+            if(position == a_Size || shift > 28)
+            {
+                throw std::invalid_argument("The size of the compressed datagram is malformed.");
+            }
+            originalSize |= static_cast<std::size_t>(a_Data[position] & 0x7F) << shift;
+            if((a_Data[position++] & 0x80) == 0)
+            {
+                break;
+            }
+        }
+        //Every byte takes at least a bit, which bounds the size before anything is allocated for it
+        if(originalSize > (a_Size - position) * 8)
+        {
+            throw std::invalid_argument("The compressed datagram is truncated.");
+        }
+
+        a_Output.reserve(a_Output.size() + originalSize);
+        std::uint64_t bits = 0;
+        unsigned bitCount = 0;
+        std::size_t availableBits = (a_Size - position) * 8;
+        std::size_t usedBits = 0;
+        const std::uint64_t lookupMask = (std::uint64_t(1) << MaxCodeLength) - 1u;
+        for(std::size_t i = 0; i < originalSize; ++i)
+        {
+            //Past the end the stream is padded with zeros, a code that reaches into them is caught below
+            while(bitCount <= 56)
+            {
+                std::uint64_t byte = position < a_Size ? a_Data[position] : 0u;
+                ++position;
+                bits |= byte << bitCount;
+                bitCount += 8;
+            }
+            std::uint16_t entry = m_DecodeTable[static_cast<std::size_t>(bits & lookupMask)];
+            unsigned length = entry >> 8;
+            usedBits += length;
+            if(usedBits > availableBits)
+            {
+                throw std::invalid_argument("The compressed datagram is truncated.");
+            }
+            a_Output.push_back(static_cast<std::uint8_t>(entry & 0xFF));
+            bits >>= length;
+            bitCount -= length;
+        }
+    }
+
+    void PacketCompressor::train(const std::uint8_t* a_Data, std::size_t a_Size, Frequencies& a_Frequencies)
+    {
+        for(std::size_t i = 0; i < a_Size; ++i)
+        {
+            ++a_Frequencies[a_Data[i]];
+        }
+    }
+
+    PacketCompressor::Frequencies PacketCompressor::getDefaultModel()
+    {
+        Frequencies frequencies;
+        std::copy(std::begin(DefaultModel), std::end(DefaultModel), frequencies.begin());
+        return frequencies;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Compresses datagrams with a static Huffman code over their bytes. The code is built from byte frequencies
+    /// counted offline on captured traffic, so nothing about the model is sent and every datagram compresses on its own,
+    /// which a lost or reordered datagram cannot get out of step.
+    /// </summary>
+    /// <remarks>
+    /// Codes are at most <see cref="MaxCodeLength"/> bits, so decoding takes a single table lookup per byte.
+    /// The compressed form starts with the size of the original as a variable length integer.
+    /// </remarks>
+    class PacketCompressor
+    {
+    public:
+        /// <summary> The amount of times each byte value was seen, by value </summary>
+        using Frequencies = std::array<std::uint32_t, 256>;
+        /// <summary> The longest code a byte is given </summary>
+        static const unsigned MaxCodeLength = 12;
+    private:
+        /// <summary> The code of every byte value, with its bits reversed so it can be written lowest bit first </summary>
+        std::array<std::uint16_t, 256> m_Codes;
+        /// <summary> The length of the code of every byte value </summary>
+        std::array<std::uint8_t, 256> m_CodeLengths;
+        /// <summary> The byte value and code length, by the next MaxCodeLength bits of a compressed stream </summary>
+        std::vector<std::uint16_t> m_DecodeTable;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PacketCompressor"/> class with the model trained on game traffic.
+        /// </summary>
+        PacketCompressor();
+
+        /// <summary>
+        /// Initializes a new instance of the <see cref="PacketCompressor"/> class.
+        /// </summary>
+        /// <param name="a_Frequencies">How often each byte value occurs, byte values that were not seen still get a code.</param>
+        explicit PacketCompressor(const Frequencies& a_Frequencies);
+
+        /// <summary>
+        /// Compresses a datagram, if that makes it smaller.
+        /// </summary>
+        /// <param name="a_Data">The datagram.</param>
+        /// <param name="a_Size">The size of the datagram in bytes.</param>
+        /// <param name="a_Output">The buffer the compressed datagram is appended to, left as it was if it would not be smaller.</param>
+        /// <returns>Whether the datagram was compressed.</returns>
+        bool compress(const std::uint8_t* a_Data, std::size_t a_Size, std::vector<std::uint8_t>& a_Output) const;
+
+        /// <summary>
+        /// Decompresses a datagram compressed with the same model.
+        /// </summary>
+        /// <param name="a_Data">The compressed datagram.</param>
+        /// <param name="a_Size">The size of the compressed datagram in bytes.</param>
+        /// <param name="a_Output">The buffer the original datagram is appended to.</param>
+        /// <exception cref="std::invalid_argument">The compressed datagram is truncated or malformed.</exception>
+        void decompress(const std::uint8_t* a_Data, std::size_t a_Size, std::vector<std::uint8_t>& a_Output) const;
+
+        /// <summary>
+        /// Counts the byte values of a captured datagram, to train a model with.
+        /// </summary>
+        /// <param name="a_Data">The datagram.</param>
+        /// <param name="a_Size">The size of the datagram in bytes.</param>
+        /// <param name="a_Frequencies">The counts to add to.</param>
+        static void train(const std::uint8_t* a_Data, std::size_t a_Size, Frequencies& a_Frequencies);
+
+        /// <summary>
+        /// Gets the byte frequencies of the model trained on game traffic.
+        /// </summary>
+        static Frequencies getDefaultModel();
+    };
+}
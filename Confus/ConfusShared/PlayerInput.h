@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+namespace ConfusShared
+{
+    /// <summary> The buttons a player can hold, as bits of <see cref="PlayerInput::Buttons"/> </summary>
+    enum class EInputButton : std::uint16_t
+    {
+        MoveForward = 1 << 0,
+        MoveBackward = 1 << 1,
+        MoveLeft = 1 << 2,
+        MoveRight = 1 << 3,
+        Jump = 1 << 4,
+        LightAttack = 1 << 5,
+        HeavyAttack = 1 << 6
+    };
+
+    /// <summary>
+    /// What a player did during a single fixed update, sent from the client to the server
+    /// </summary>
+    struct PlayerInput
+    {
+        /// <summary> The fixed update the input was sampled in </summary>
+        std::uint32_t Tick = 0;
+        /// <summary> The buttons held, one bit per <see cref="EInputButton"/> </summary>
+        std::uint16_t Buttons = 0;
+        /// <summary> Where the player looks, in degrees </summary>
+        float Yaw = 0.0f;
+        float Pitch = 0.0f;
+
+        bool isHeld(EInputButton a_Button) const
+        {
+            return (Buttons & static_cast<std::uint16_t>(a_Button)) != 0;
+        }
+
+        void setHeld(EInputButton a_Button, bool a_Held)
+        {
+            if(a_Held)
+            {
+                Buttons |= static_cast<std::uint16_t>(a_Button);
+            }
+            else
+            {
+                Buttons &= static_cast<std::uint16_t>(~static_cast<std::uint16_t>(a_Button));
+            }
+        }
+    };
+}
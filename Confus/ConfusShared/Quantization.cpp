@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Quantization.h"
+
+namespace ConfusShared
+{
+    namespace
+    {
+        /// <summary> The largest magnitude of the three smallest components of a unit quaternion, the square root of a half </summary>
+        const float SmallestThreeRange = 0.70710678f;
+
+        std::uint32_t getLargestValue(unsigned a_Bits)
+        {
+            return (1u << a_Bits) - 1u;
+        }
+    }
+
+    std::uint32_t quantize(float a_Value, float a_Minimum, float a_Maximum, unsigned a_Bits)
+    {
+        float normalized = (a_Value - a_Minimum) / (a_Maximum - a_Minimum);
+        normalized = std::min(std::max(normalized, 0.0f), 1.0f);
+        return static_cast<std::uint32_t>(normalized * getLargestValue(a_Bits) + 0.5f);
+    }
+
+    float dequantize(std::uint32_t a_Quantized, float a_Minimum, float a_Maximum, unsigned a_Bits)
+    {
+        return a_Minimum + (a_Maximum - a_Minimum) * (static_cast<float>(a_Quantized) / getLargestValue(a_Bits));
+    }
+
+    std::uint32_t packAngle(float a_Degrees, unsigned a_Bits)
+    {
+        float wrapped = std::fmod(a_Degrees, 360.0f);
+        if(wrapped < 0.0f)
+        {
+            wrapped += 360.0f;
+        }
+        //Rounding up from just below 360 gives the step count itself, which wraps back to 0
+        return static_cast<std::uint32_t>(wrapped / 360.0f * (1u << a_Bits) + 0.5f) & getLargestValue(a_Bits);
+    }
+
+    float unpackAngle(std::uint32_t a_Packed, unsigned a_Bits)
+    {
+        return static_cast<float>(a_Packed) * 360.0f / (1u << a_Bits);
+    }
+
+    std::uint32_t zigZagEncode(std::int32_t a_Value)
+    {
+        return (static_cast<std::uint32_t>(a_Value) << 1) ^ static_cast<std::uint32_t>(a_Value >> 31);
+    }
+
+    std::int32_t zigZagDecode(std::uint32_t a_Value)
+    {
+        return static_cast<std::int32_t>(a_Value >> 1) ^ -static_cast<std::int32_t>(a_Value & 1u);
+    }
+
+    std::uint32_t packQuaternion(const Quaternion& a_Rotation, unsigned a_Bits)
+    {
+        const float components[4] = { a_Rotation.X, a_Rotation.Y, a_Rotation.Z, a_Rotation.W };
+        std::uint32_t largest = 0;
+        for(std::uint32_t i = 1; i < 4; ++i)
+        {
+            if(std::fabs(components[i]) > std::fabs(components[largest]))
+            {
+                largest = i;
+            }
+        }
+
+        //A quaternion and its negation are the same rotation, so the left out component is made positive
+        float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+        std::uint32_t packed = largest;
+        for(std::uint32_t i = 0; i < 4; ++i)
+        {
+            if(i != largest)
+            {
+                packed = (packed << a_Bits) | quantize(components[i] * sign, -SmallestThreeRange, SmallestThreeRange, a_Bits);
+            }
+        }
+        return packed;
+    }
+
+    Quaternion unpackQuaternion(std::uint32_t a_Packed, unsigned a_Bits)
+    {
+        std::uint32_t largest = (a_Packed >> (3 * a_Bits)) & 3u;
+        float components[4];
+        float sumOfSquares = 0.0f;
+        unsigned shift = 3 * a_Bits;
+        for(std::uint32_t i = 0; i < 4; ++i)
+        {
+            if(i != largest)
+            {
+                shift -= a_Bits;
+                components[i] = dequantize((a_Packed >> shift) & getLargestValue(a_Bits), -SmallestThreeRange, SmallestThreeRange, a_Bits);
+                sumOfSquares += components[i] * components[i];
+            }
+        }
+        components[largest] = std::sqrt(std::max(1.0f - sumOfSquares, 0.0f));
+
+        Quaternion rotation;
+        rotation.X = components[0];
+        rotation.Y = components[1];
+        rotation.Z = components[2];
+        rotation.W = components[3];
+        return rotation;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A rotation as a unit quaternion, kept free of any engine type so the codecs do not depend on one
+    /// </summary>
+    struct Quaternion
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float W = 1.0f;
+    };
+
+    /// <summary>
+    /// Maps a value in a known range onto an integer of a fixed amount of bits, values outside the range are clamped.
+    /// </summary>
+    /// <param name="a_Value">The value to quantize.</param>
+    /// <param name="a_Minimum">The lowest value of the range.</param>
+    /// <param name="a_Maximum">The highest value of the range, which has to be above the lowest.</param>
+    /// <param name="a_Bits">The amount of bits, from 1 up to 24 as more than a float holds would not add precision.</param>
+    std::uint32_t quantize(float a_Value, float a_Minimum, float a_Maximum, unsigned a_Bits);
+
+    /// <summary>
+    /// Maps an integer given by <see cref="quantize"/> back onto the range, with an error of at most half a step.
+    /// </summary>
+    float dequantize(std::uint32_t a_Quantized, float a_Minimum, float a_Maximum, unsigned a_Bits);
+
+    /// <summary>
+    /// Maps an angle onto an integer of a fixed amount of bits. Angles wrap around, so unlike <see cref="quantize"/>
+    /// no step is spent on 360 degrees, which is the same as 0.
+    /// </summary>
+    /// <param name="a_Degrees">The angle in degrees, of any magnitude.</param>
+    /// <param name="a_Bits">The amount of bits, from 1 up to 24.</param>
+    std::uint32_t packAngle(float a_Degrees, unsigned a_Bits);
+
+    /// <summary>
+    /// Maps an integer given by <see cref="packAngle"/> back onto an angle in degrees, in the range [0, 360).
+    /// </summary>
+    float unpackAngle(std::uint32_t a_Packed, unsigned a_Bits);
+
+    /// <summary>
+    /// Maps a signed integer onto an unsigned one so small magnitudes of either sign become small values:
+    /// 0, -1, 1, -2, 2 become 0, 1, 2, 3, 4. Deltas are encoded like this before being written with a variable length.
+    /// </summary>
+    std::uint32_t zigZagEncode(std::int32_t a_Value);
+
+    /// <summary>
+    /// Reverses <see cref="zigZagEncode"/>.
+    /// </summary>
+    std::int32_t zigZagDecode(std::uint32_t a_Value);
+
+    /// <summary>
+    /// Packs a unit quaternion into 2 + 3 * a_Bits bits by leaving out its largest component, which follows from the
+    /// other three as the quaternion has a length of one. The other three lie within plus and minus the square root of a half.
+    /// </summary>
+    /// <param name="a_Rotation">The rotation, which has to be normalized.</param>
+    /// <param name="a_Bits">The bits per component that is kept, from 1 up to 10.</param>
+    std::uint32_t packQuaternion(const Quaternion& a_Rotation, unsigned a_Bits);
+
+    /// <summary>
+    /// Reverses <see cref="packQuaternion"/>. The result may be the negation of the packed quaternion,
+    /// which is the same rotation.
+    /// </summary>
+    Quaternion unpackQuaternion(std::uint32_t a_Packed, unsigned a_Bits);
+}
@@ -0,0 +1,27 @@
+#include "Random.h"
+
+namespace ConfusShared
+{
+    Random::Random(std::uint32_t a_Seed)
+    {
+        //The seed is scrambled so that nearby seeds do not start out with similar sequences, xorshift never leaves a zero state
+        std::uint32_t state = a_Seed + 0x9E3779B9u;
+        state = (state ^ (state >> 16)) * 0x85EBCA6Bu;
+        state = (state ^ (state >> 13)) * 0xC2B2AE35u;
+        state ^= state >> 16;
+        m_State = state != 0u ? state : 0x9E3779B9u;
+    }
+
+    std::uint32_t Random::next()
+    {
+        m_State ^= m_State << 13;
+        m_State ^= m_State >> 17;
+        m_State ^= m_State << 5;
+        return m_State;
+    }
+
+    std::uint32_t Random::nextBelow(std::uint32_t a_Bound)
+    {
+        return next() % a_Bound;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A small xorshift random number generator with a fixed algorithm, so the same seed gives the same numbers
+    /// on every platform and standard library. Unlike std::rand it has no global state that other code can reseed.
+    /// </summary>
+    class Random
+    {
+    private:
+        std::uint32_t m_State;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="Random"/> class.
+        /// </summary>
+        /// <param name="a_Seed">The seed, any value including zero is valid.</param>
+        explicit Random(std::uint32_t a_Seed);
+
+        /// <summary>
+        /// Gets the next number in the sequence.
+        /// </summary>
+        std::uint32_t next();
+
+        /// <summary>
+        /// Gets the next number in the sequence, reduced to the range [0, a_Bound).
+        /// </summary>
+        /// <param name="a_Bound">The exclusive upper bound, which has to be above zero.</param>
+        std::uint32_t nextBelow(std::uint32_t a_Bound);
+    };
+}
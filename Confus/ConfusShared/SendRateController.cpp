@@ -0,0 +1,103 @@
+#include <algorithm>
+
+#include "SendRateController.h"
+
+namespace ConfusShared
+{
+    const std::uint32_t SendRateController::DefaultBandwidthBudget = 32 * 1024;
+    const std::uint32_t SendRateController::MinBandwidthBudget = 4 * 1024;
+    const std::uint32_t SendRateController::MaxBandwidthBudget = 256 * 1024;
+    const std::uint32_t SendRateController::ProbeRate = 8 * 1024;
+    const float SendRateController::LossThreshold = 0.02f;
+    const float SendRateController::QueueingDelayThreshold = 0.05f;
+    const float SendRateController::BaseRoundTripWindow = 10.0f;
+    const float SendRateController::MaxBurstTime = 0.1f;
+
+    SendRateController::SendRateController(std::uint32_t a_InitialBudget)
+        : m_BandwidthBudget(std::min(std::max(a_InitialBudget, MinBandwidthBudget), MaxBandwidthBudget))
+    {
+        m_Credit = m_BandwidthBudget * MaxBurstTime;
+    }
+
+    void SendRateController::update(const LinkStatistics& a_Statistics, float a_DeltaTime)
+    {
+        float roundTripTime = a_Statistics.RoundTripTime;
+        updateBaseRoundTripTime(roundTripTime, a_DeltaTime);
+
+        //More than two round trips of unacknowledged data means it is piling up in a buffer somewhere along the link
+        float inFlightLimit = m_BandwidthBudget * std::max(2.0f * roundTripTime, 0.1f);
+        m_Congested = a_Statistics.PacketLoss > LossThreshold
+            || (m_BaseRoundTripTime > 0.0f && roundTripTime > m_BaseRoundTripTime + QueueingDelayThreshold)
+            || a_Statistics.BytesInFlight > inFlightLimit;
+
+        m_TimeSinceBackoff += a_DeltaTime;
+        if(m_Congested)
+        {
+            //The measurements lag a round trip behind, so backing off again sooner would react to the same congestion twice
+            if(m_TimeSinceBackoff >= roundTripTime)
+            {
+                m_BandwidthBudget = std::max(m_BandwidthBudget / 2, MinBandwidthBudget);
+                m_TimeSinceBackoff = 0.0f;
+            }
+        }
+        else
+        {
+            float grown = m_BandwidthBudget + ProbeRate * a_DeltaTime;
+            m_BandwidthBudget = static_cast<std::uint32_t>(std::min(grown, static_cast<float>(MaxBandwidthBudget)));
+        }
+
+        m_Credit = std::min(m_Credit + m_BandwidthBudget * a_DeltaTime, m_BandwidthBudget * MaxBurstTime);
+    }
+
+    bool SendRateController::canSend() const
+    {
+        return m_Credit > 0.0f;
+    }
+
+    void SendRateController::onSent(std::size_t a_Size)
+    {
+        m_Credit -= static_cast<float>(a_Size);
+    }
+
+    std::uint32_t SendRateController::getBandwidthBudget() const
+    {
+        return m_BandwidthBudget;
+    }
+
+    bool SendRateController::isCongested() const
+    {
+        return m_Congested;
+    }
+
+    float SendRateController::getBaseRoundTripTime() const
+    {
+        return m_BaseRoundTripTime;
+    }
+
+    void SendRateController::updateBaseRoundTripTime(float a_RoundTripTime, float a_DeltaTime)
+    {
+        m_BucketTime += a_DeltaTime;
+        if(m_BucketTime >= BaseRoundTripWindow / BaseRoundTripBuckets)
+        {
+            //The oldest part leaves the window, so its samples no longer hold the base down
+            m_CurrentBucket = (m_CurrentBucket + 1) % BaseRoundTripBuckets;
+            m_RoundTripMinima[m_CurrentBucket] = 0.0f;
+            m_BucketTime = 0.0f;
+        }
+
+        float& minimum = m_RoundTripMinima[m_CurrentBucket];
+        if(a_RoundTripTime > 0.0f && (minimum == 0.0f || a_RoundTripTime < minimum))
+        {
+            minimum = a_RoundTripTime;
+        }
+
+        m_BaseRoundTripTime = 0.0f;
+        for(float bucketMinimum : m_RoundTripMinima)
+        {
+            if(bucketMinimum > 0.0f && (m_BaseRoundTripTime == 0.0f || bucketMinimum < m_BaseRoundTripTime))
+            {
+                m_BaseRoundTripTime = bucketMinimum;
+            }
+        }
+    }
+}
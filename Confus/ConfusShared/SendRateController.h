@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// What the networking library measured about the link to a single peer
+    /// </summary>
+    struct LinkStatistics
+    {
+        /// <summary> The round trip time in seconds </summary>
+        float RoundTripTime = 0.0f;
+        /// <summary> The fraction of the packets lost over the last second, from 0 to 1 </summary>
+        float PacketLoss = 0.0f;
+        /// <summary> The bytes sent to the peer that it has not acknowledged yet </summary>
+        std::uint64_t BytesInFlight = 0;
+    };
+
+    /// <summary>
+    /// Decides how many bytes per second a single peer is sent, from how its link behaves.
+    /// The budget is halved at most once per round trip when the link shows congestion, which is packet loss,
+    /// a round trip time well above the lowest one of the last few seconds, or more unacknowledged bytes than a couple of round trips carry.
+    /// Otherwise the budget grows steadily to probe for bandwidth the link has to spare.
+    /// </summary>
+    /// <remarks>
+    /// Sending is metered by credit: every update adds the budget of the elapsed time, and every datagram sent takes its size.
+    /// A peer without credit is skipped until it has earned some back, so data waits in the sender's queue
+    /// instead of in the buffers along a congested link.
+    /// </remarks>
+    class SendRateController
+    {
+    public:
+        /// <summary> The budget in bytes per second a peer starts with </summary>
+        static const std::uint32_t DefaultBandwidthBudget;
+        /// <summary> The budget never drops below this, so a peer on a poor link still receives a trickle </summary>
+        static const std::uint32_t MinBandwidthBudget;
+        /// <summary> The budget never grows above this, as no peer needs more </summary>
+        static const std::uint32_t MaxBandwidthBudget;
+        /// <summary> The bytes per second the budget grows by every second the link is not congested </summary>
+        static const std::uint32_t ProbeRate;
+        /// <summary> The packet loss above which the link counts as congested </summary>
+        static const float LossThreshold;
+        /// <summary> The round trip time above the base round trip time, in seconds, at which the link counts as congested </summary>
+        static const float QueueingDelayThreshold;
+        /// <summary>
+        /// The seconds over which the lowest round trip time is taken as the base round trip time.
+        /// A route that got longer for good raises the base once the shorter samples fall out of the window.
+        /// </summary>
+        static const float BaseRoundTripWindow;
+        /// <summary> The number of parts the window is split in, each of which remembers the lowest round trip time it saw </summary>
+        static const std::size_t BaseRoundTripBuckets = 5;
+        /// <summary> The seconds of budget a peer may save up to send in a single burst </summary>
+        static const float MaxBurstTime;
+    private:
+        std::uint32_t m_BandwidthBudget;
+        /// <summary> The bytes that may still be sent, negative after a datagram larger than the credit that was left </summary>
+        float m_Credit = 0.0f;
+        /// <summary> The lowest round trip time of each part of the window, zero for a part without samples </summary>
+        std::array<float, BaseRoundTripBuckets> m_RoundTripMinima = {};
+        std::size_t m_CurrentBucket = 0;
+        /// <summary> The time since the current part of the window started </summary>
+        float m_BucketTime = 0.0f;
+        /// <summary> The lowest round trip time in the window, which is taken as the round trip time of an empty link </summary>
+        float m_BaseRoundTripTime = 0.0f;
+        /// <summary> The time since the budget was last decreased </summary>
+        float m_TimeSinceBackoff = 0.0f;
+        bool m_Congested = false;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="SendRateController"/> class.
+        /// </summary>
+        /// <param name="a_InitialBudget">The bytes per second the peer may be sent until its link has been measured.</param>
+        explicit SendRateController(std::uint32_t a_InitialBudget = DefaultBandwidthBudget);
+
+        /// <summary>
+        /// Adjusts the budget to the latest measurements of the link and earns the credit of the elapsed time.
+        /// </summary>
+        /// <param name="a_Statistics">The latest measurements of the link.</param>
+        /// <param name="a_DeltaTime">The time in seconds since the last update.</param>
+        void update(const LinkStatistics& a_Statistics, float a_DeltaTime);
+
+        /// <summary>
+        /// Gets whether the peer has credit left to be sent another datagram.
+        /// </summary>
+        bool canSend() const;
+
+        /// <summary>
+        /// Takes the size of a datagram sent to the peer from its credit.
+        /// </summary>
+        /// <param name="a_Size">The size of the datagram in bytes.</param>
+        void onSent(std::size_t a_Size);
+
+        /// <summary>
+        /// Gets the bytes per second the peer may be sent.
+        /// </summary>
+        std::uint32_t getBandwidthBudget() const;
+
+        /// <summary>
+        /// Gets whether the last update found the link congested.
+        /// </summary>
+        bool isCongested() const;
+
+        /// <summary>
+        /// Gets the lowest round trip time in seconds of the last <see cref="BaseRoundTripWindow"/> seconds.
+        /// </summary>
+        float getBaseRoundTripTime() const;
+    private:
+        /// <summary>
+        /// Adds a round trip time sample to the window and moves the window along by the elapsed time.
+        /// </summary>
+        void updateBaseRoundTripTime(float a_RoundTripTime, float a_DeltaTime);
+    };
+}
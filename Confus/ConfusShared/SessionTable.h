@@ -0,0 +1,253 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "CharacterController.h"
+#include "InputJitterBuffer.h"
+#include "MessageBatch.h"
+#include "PlayerInput.h"
+#include "SendRateController.h"
+#include "Teams.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Identifies a connected peer in a <see cref="SessionTable"/>. The generation is bumped whenever a slot is reused,
+    /// so the handle of a peer that disconnected never refers to the peer that took its slot.
+    /// </summary>
+    struct PeerHandle
+    {
+        static const std::uint16_t InvalidIndex = 0xFFFF;
+
+        /// <summary> The slot of the peer, InvalidIndex if it refers to nothing </summary>
+        std::uint16_t Index = InvalidIndex;
+        /// <summary> The generation of the slot at the time the peer connected </summary>
+        std::uint16_t Generation = 0;
+
+        /// <summary>
+        /// Whether the handle was given out by a table, the peer may have disconnected since.
+        /// </summary>
+        bool isValid() const
+        {
+            return Index != InvalidIndex;
+        }
+
+        bool operator==(const PeerHandle& a_Other) const
+        {
+            return Index == a_Other.Index && Generation == a_Other.Generation;
+        }
+
+        bool operator!=(const PeerHandle& a_Other) const
+        {
+            return !(*this == a_Other);
+        }
+    };
+
+    /// <summary>
+    /// Everything that is kept per connected peer
+    /// </summary>
+    template<typename TAddress>
+    struct Session
+    {
+        PeerHandle Handle;
+        /// <summary> Where packets for the peer are sent to </summary>
+        TAddress Address;
+        /// <summary> The id of the peer, which unlike its address stays the same for the whole connection </summary>
+        std::uint64_t Guid = 0;
+        /// <summary> The last tick the peer acknowledged having received, the baseline for what is sent to it next </summary>
+        std::uint32_t AckedTick = 0;
+        /// <summary> The smoothed round trip time in seconds </summary>
+        float RoundTripTime = 0.0f;
+        /// <summary> How many bytes may be sent to the peer per second </summary>
+        SendRateController SendRate;
+        /// <summary> The inputs received from the peer that have not been simulated yet </summary>
+        InputJitterBuffer Inputs;
+        /// <summary> The input of the peer simulated during the current tick </summary>
+        PlayerInput Input;
+        /// <summary> Whether there is an input to simulate this tick, there is none until the jitter buffer first filled up </summary>
+        bool HasInput = false;
+        /// <summary> The team the character of the peer plays for, which decides where it spawns </summary>
+        ETeamIdentifier Team = ETeamIdentifier::None;
+        /// <summary> The character of the peer, moved by its input with the same controller the peer predicts it with </summary>
+        CharacterState Character;
+        /// <summary> The messages for the peer queued during the current tick </summary>
+        MessageBatch Outbox;
+    };
+
+    /// <summary>
+    /// Maps the peers a connection talks to onto compact handles, keeping their sessions in a flat table of slots.
+    /// The table has a fixed amount of slots, so once it has been created, opening, closing and finding sessions
+    /// does not allocate anything besides the id lookup of a newly connected peer.
+    /// </summary>
+    /// <remarks>
+    /// The address type is a template parameter so the table does not depend on the networking library.
+    /// References to sessions stay valid until the session is closed.
+    /// </remarks>
+    template<typename TAddress>
+    class SessionTable
+    {
+    public:
+        using SessionType = Session<TAddress>;
+    private:
+        /// <summary> Every slot, the ones without an open session have an invalid handle </summary>
+        std::vector<SessionType> m_Slots;
+        /// <summary> The generation each slot will hand out next </summary>
+        std::vector<std::uint16_t> m_Generations;
+        /// <summary> The slots of the open sessions, packed so they can be walked without skipping closed ones </summary>
+        std::vector<std::uint16_t> m_OpenSlots;
+        /// <summary> The position of each slot in the open slots </summary>
+        std::vector<std::uint16_t> m_OpenPositions;
+        /// <summary> The slot of every open session by the id of its peer </summary>
+        std::unordered_map<std::uint64_t, std::uint16_t> m_SlotsByGuid;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="SessionTable"/> class.
+        /// </summary>
+        /// <param name="a_Capacity">The maximum amount of sessions that are open at once.</param>
+        explicit SessionTable(std::uint16_t a_Capacity)
+            : m_Slots(a_Capacity), m_Generations(a_Capacity, 0), m_OpenPositions(a_Capacity, 0)
+        {
+            if(a_Capacity == PeerHandle::InvalidIndex)
+            {
+                throw std::invalid_argument("The capacity of a session table has to be below 65535.");
+            }
+            m_OpenSlots.reserve(a_Capacity);
+            m_SlotsByGuid.reserve(a_Capacity);
+        }
+
+        /// <summary>
+        /// Opens a session for a peer that connected, or gets the one that is already open for it.
+        /// </summary>
+        /// <param name="a_Address">The address of the peer.</param>
+        /// <param name="a_Guid">The id of the peer.</param>
+        /// <exception cref="std::invalid_argument">All slots are taken.</exception>
+        SessionType& open(const TAddress& a_Address, std::uint64_t a_Guid)
+        {
+            auto existing = m_SlotsByGuid.find(a_Guid);
+            if(existing != m_SlotsByGuid.end())
+            {
+                return m_Slots[existing->second];
+            }
+            if(m_OpenSlots.size() == m_Slots.size())
+            {
+                throw std::invalid_argument("There is no slot left for another session.");
+            }
+
+            std::uint16_t slot = 0;
+            while(m_Slots[slot].Handle.isValid())
+            {
+                ++slot;
+            }
+            SessionType& session = m_Slots[slot];
+            session = SessionType();
+            session.Handle.Index = slot;
+            session.Handle.Generation = m_Generations[slot];
+            session.Address = a_Address;
+            session.Guid = a_Guid;
+
+            m_OpenPositions[slot] = static_cast<std::uint16_t>(m_OpenSlots.size());
+            m_OpenSlots.push_back(slot);
+            m_SlotsByGuid.emplace(a_Guid, slot);
+            return session;
+        }
+
+        /// <summary>
+        /// Closes the session of a peer, if it is still open.
+        /// </summary>
+        void close(PeerHandle a_Peer)
+        {
+            if(!has(a_Peer))
+            {
+                return;
+            }
+
+            SessionType& session = m_Slots[a_Peer.Index];
+            m_SlotsByGuid.erase(session.Guid);
+            session.Handle = PeerHandle();
+            ++m_Generations[a_Peer.Index];
+
+            std::uint16_t position = m_OpenPositions[a_Peer.Index];
+            m_OpenSlots[position] = m_OpenSlots.back();
+            m_OpenPositions[m_OpenSlots[position]] = position;
+            m_OpenSlots.pop_back();
+        }
+
+        /// <summary>
+        /// Gets whether the session of a peer is still open.
+        /// </summary>
+        bool has(PeerHandle a_Peer) const
+        {
+            return a_Peer.isValid() && a_Peer.Index < m_Slots.size() && m_Slots[a_Peer.Index].Handle == a_Peer;
+        }
+
+        /// <summary>
+        /// Gets the session of a peer.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The session has been closed.</exception>
+        SessionType& get(PeerHandle a_Peer)
+        {
+            if(!has(a_Peer))
+            {
+                throw std::invalid_argument("The session of the peer has been closed.");
+            }
+            return m_Slots[a_Peer.Index];
+        }
+
+        /// <summary>
+        /// Gets the session of a peer.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The session has been closed.</exception>
+        const SessionType& get(PeerHandle a_Peer) const
+        {
+            if(!has(a_Peer))
+            {
+                throw std::invalid_argument("The session of the peer has been closed.");
+            }
+            return m_Slots[a_Peer.Index];
+        }
+
+        /// <summary>
+        /// Finds the handle of a connected peer by its id.
+        /// </summary>
+        /// <returns>The handle, or an invalid one if the peer has no open session.</returns>
+        PeerHandle find(std::uint64_t a_Guid) const
+        {
+            auto slot = m_SlotsByGuid.find(a_Guid);
+            return slot != m_SlotsByGuid.end() ? m_Slots[slot->second].Handle : PeerHandle();
+        }
+
+        /// <summary>
+        /// Gets the amount of open sessions.
+        /// </summary>
+        std::size_t size() const
+        {
+            return m_OpenSlots.size();
+        }
+
+        /// <summary>
+        /// Gets an open session by its position among the open sessions, which changes when sessions are closed.
+        /// </summary>
+        SessionType& at(std::size_t a_Position)
+        {
+            return m_Slots[m_OpenSlots[a_Position]];
+        }
+
+        /// <summary>
+        /// Gets an open session by its position among the open sessions, which changes when sessions are closed.
+        /// </summary>
+        const SessionType& at(std::size_t a_Position) const
+        {
+            return m_Slots[m_OpenSlots[a_Position]];
+        }
+
+        /// <summary>
+        /// Gets the maximum amount of sessions that are open at once.
+        /// </summary>
+        std::size_t getCapacity() const
+        {
+            return m_Slots.size();
+        }
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// The direction in which an object changed whether it can be walked through
+    /// </summary>
+    enum class ESolidityChange
+    {
+        BecameSolid,
+        BecamePassable
+    };
+
+    /// <summary>
+    /// Published once when an object, such as a maze wall or a respawn floor, starts or stops blocking movement
+    /// </summary>
+    /// <typeparam name="TCollider">What the object collides through, which the listeners use to find its collision body.</typeparam>
+    template<typename TCollider>
+    struct SolidityEvent
+    {
+        /// <summary>
+        /// What the object collides through while it is solid, owned by the object
+        /// </summary>
+        TCollider Collider;
+        ESolidityChange Change;
+    };
+
+    /// <summary>
+    /// Passes solidity changes from the objects that track them on to everything that reacts to them,
+    /// so colliders are only updated on an actual transition instead of every fixed update.
+    /// The client and the server publish the same changes, each with the collider type of its own scene.
+    /// </summary>
+    template<typename TCollider>
+    class SolidityEvents
+    {
+    public:
+        using Event = SolidityEvent<TCollider>;
+        using Listener = std::function<void(const Event& a_Event)>;
+    private:
+        /// <summary>
+        /// The callbacks called for every published event, in the order they were added
+        /// </summary>
+        std::vector<Listener> m_Listeners;
+    public:
+        /// <summary>
+        /// Adds a callback to be called for every event published from then on.
+        /// </summary>
+        /// <param name="a_Listener">The callback to add.</param>
+        void addListener(const Listener& a_Listener)
+        {
+            m_Listeners.push_back(a_Listener);
+        }
+
+        /// <summary>
+        /// Calls every listener with the event.
+        /// </summary>
+        /// <param name="a_Event">The change that occured.</param>
+        void publish(const Event& a_Event) const
+        {
+            for(auto& listener : m_Listeners)
+            {
+                listener(a_Event);
+            }
+        }
+    };
+}
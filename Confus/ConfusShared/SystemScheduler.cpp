@@ -0,0 +1,118 @@
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "SystemScheduler.h"
+
+namespace ConfusShared
+{
+    SystemScheduler::SystemScheduler(WorkerPool& a_WorkerPool)
+        : m_WorkerPool(a_WorkerPool)
+    {
+    }
+
+    void SystemScheduler::addSystem(const std::string& a_Name, ComponentSet a_Reads, ComponentSet a_Writes, std::function<void()> a_Update)
+    {
+        if(!a_Update)
+        {
+            throw std::invalid_argument("The system " + a_Name + " has nothing to run.");
+        }
+
+        System system;
+        system.Name = a_Name;
+        system.Reads = a_Reads;
+        system.Writes = a_Writes;
+        system.Update = std::move(a_Update);
+
+        std::size_t systemIndex = m_Systems.size();
+        for(std::size_t earlierIndex = 0; earlierIndex < systemIndex; ++earlierIndex)
+        {
+            System& earlier = m_Systems[earlierIndex];
+            bool conflicts = earlier.Writes.intersects(system.Reads) || earlier.Writes.intersects(system.Writes) || earlier.Reads.intersects(system.Writes);
+            if(conflicts)
+            {
+                earlier.Dependents.push_back(systemIndex);
+                ++system.DependencyCount;
+            }
+        }
+        m_Systems.push_back(std::move(system));
+        m_RemainingDependencies.reset(new std::atomic<std::uint32_t>[m_Systems.size()]);
+    }
+
+    void SystemScheduler::run()
+    {
+        if(m_Systems.empty())
+        {
+            return;
+        }
+
+        m_Failed = false;
+        m_Failure.clear();
+        for(std::size_t i = 0; i < m_Systems.size(); ++i)
+        {
+            m_RemainingDependencies[i] = m_Systems[i].DependencyCount;
+        }
+        m_RemainingSystems = m_Systems.size();
+
+        for(std::size_t i = 0; i < m_Systems.size(); ++i)
+        {
+            if(m_Systems[i].DependencyCount == 0)
+            {
+                submitSystem(i);
+            }
+        }
+        while(m_RemainingSystems > 0)
+        {
+            if(!m_WorkerPool.runPendingJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if(m_Failed)
+        {
+            throw std::runtime_error(m_Failure);
+        }
+    }
+
+    std::size_t SystemScheduler::getSystemCount() const
+    {
+        return m_Systems.size();
+    }
+
+    void SystemScheduler::submitSystem(std::size_t a_SystemIndex)
+    {
+        m_WorkerPool.submit([this, a_SystemIndex]() { runSystem(a_SystemIndex); });
+    }
+
+    void SystemScheduler::runSystem(std::size_t a_SystemIndex)
+    {
+        System& system = m_Systems[a_SystemIndex];
+        if(!m_Failed)
+        {
+            try
+            {
+                system.Update();
+            }
+            catch(const std::exception& exception)
+            {
+                std::lock_guard<std::mutex> lock(m_FailureMutex);
+                if(!m_Failed)
+                {
+                    m_Failure = "The system " + system.Name + " failed: " + exception.what();
+                    m_Failed = true;
+                }
+            }
+        }
+
+        for(std::size_t dependent : system.Dependents)
+        {
+            if(--m_RemainingDependencies[dependent] == 0)
+            {
+                submitSystem(dependent);
+            }
+        }
+        //Only counted as finished after its dependents are queued, so the run cannot end with systems left over
+        --m_RemainingSystems;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "WorkerPool.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A set of the components, or other shared state, a system accesses. Every executable numbers its own components
+    /// with an enum of at most 64 entries.
+    /// </summary>
+    struct ComponentSet
+    {
+        std::uint64_t Bits = 0;
+
+        ComponentSet() = default;
+
+        template<typename TComponent>
+        ComponentSet(std::initializer_list<TComponent> a_Components)
+        {
+            for(TComponent component : a_Components)
+            {
+                Bits |= std::uint64_t(1) << static_cast<unsigned int>(component);
+            }
+        }
+
+        bool intersects(const ComponentSet& a_Other) const
+        {
+            return (Bits & a_Other.Bits) != 0;
+        }
+    };
+
+    /// <summary>
+    /// Runs a set of systems once per call to <see cref="run"/>, spreading the ones that do not conflict over a worker pool.
+    /// Each system declares the components it reads and writes. A system waits for every system registered before it
+    /// that writes what it accesses or reads what it writes, so conflicting systems always run in registration order
+    /// and the outcome does not depend on how the systems are spread over the threads.
+    /// </summary>
+    class SystemScheduler
+    {
+    private:
+        /// <summary>
+        /// A registered system and its place in the dependency graph
+        /// </summary>
+        struct System
+        {
+            std::string Name;
+            ComponentSet Reads;
+            ComponentSet Writes;
+            std::function<void()> Update;
+            /// <summary> The amount of earlier systems this one waits for </summary>
+            std::uint32_t DependencyCount = 0;
+            /// <summary> The later systems that wait for this one </summary>
+            std::vector<std::size_t> Dependents;
+        };
+
+        WorkerPool& m_WorkerPool;
+        std::vector<System> m_Systems;
+        /// <summary> The amount of dependencies each system still waits for during a run </summary>
+        std::unique_ptr<std::atomic<std::uint32_t>[]> m_RemainingDependencies;
+        /// <summary> The amount of systems that have not finished during a run </summary>
+        std::atomic<std::size_t> m_RemainingSystems{ 0 };
+        /// <summary> Set once a system throws, after which the systems that have not started yet are skipped </summary>
+        std::atomic<bool> m_Failed{ false };
+        /// <summary> Describes the first system that threw during a run, reported once the run is over </summary>
+        std::string m_Failure;
+        std::mutex m_FailureMutex;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="SystemScheduler"/> class.
+        /// </summary>
+        /// <param name="a_WorkerPool">The pool the systems are run on, which has to outlive this.</param>
+        explicit SystemScheduler(WorkerPool& a_WorkerPool);
+
+        /// <summary>
+        /// Registers a system, after all systems registered before it. Not allowed during a run.
+        /// </summary>
+        /// <param name="a_Name">The name of the system, used when it throws.</param>
+        /// <param name="a_Reads">The components the system only reads.</param>
+        /// <param name="a_Writes">The components the system writes.</param>
+        /// <param name="a_Update">Runs the system, possibly on another thread.</param>
+        void addSystem(const std::string& a_Name, ComponentSet a_Reads, ComponentSet a_Writes, std::function<void()> a_Update);
+
+        /// <summary>
+        /// Runs every system once and returns when all of them have finished, helping out on the calling thread.
+        /// </summary>
+        /// <exception cref="std::runtime_error">A system threw, the systems that had not started yet have been skipped.</exception>
+        void run();
+
+        /// <summary>
+        /// Gets the amount of registered systems.
+        /// </summary>
+        std::size_t getSystemCount() const;
+    private:
+        /// <summary>
+        /// Queues a system whose dependencies have all finished.
+        /// </summary>
+        void submitSystem(std::size_t a_SystemIndex);
+
+        /// <summary>
+        /// Runs a system and queues the dependents it was the last dependency of.
+        /// </summary>
+        void runSystem(std::size_t a_SystemIndex);
+    };
+}
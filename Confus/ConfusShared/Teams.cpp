@@ -0,0 +1,23 @@
+#include "Teams.h"
+
+namespace ConfusShared
+{
+    SpawnPoint getSpawnPoint(ETeamIdentifier a_Team)
+    {
+        switch(a_Team)
+        {
+        case ETeamIdentifier::TeamBlue:
+            return { 0.0f, 10.0f, 11.0f };
+        case ETeamIdentifier::TeamRed:
+            return { 0.0f, 10.0f, -85.0f };
+        default:
+            return { 0.0f, 10.0f, 0.0f };
+        }
+    }
+
+    Vector3 getSpawnPosition(ETeamIdentifier a_Team, float a_EyeHeight)
+    {
+        SpawnPoint spawnPoint = getSpawnPoint(a_Team);
+        return Vector3(spawnPoint.X, spawnPoint.Y - a_EyeHeight, spawnPoint.Z);
+    }
+}
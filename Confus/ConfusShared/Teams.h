@@ -0,0 +1,48 @@
+#pragma once
+#include "Vector3.h"
+
+namespace ConfusShared
+{
+    /// <summary> The Team's Identifier. A player has a team, flag has a team, ui has a team, etc. </summary>
+    enum class ETeamIdentifier
+    {
+        None, ///< This object doesn't have a team identifier.
+        TeamRed, ///< This object has a red team identifier.
+        TeamBlue ///< This object has a blue team identifier.
+    };
+
+    /// <summary> The Flag's status. A player can have flagtaken or no flag. A flag can be taken, dropped or at base. </summary>
+    enum class EFlagEnum
+    {
+        None, ///< Player is carrying nothing
+        FlagBase, ///< Flag is at the base
+        FlagTaken, ///< The flag is taken. / A player is carrying a flag.
+        FlagDropped ///< The flag is dropped.
+    };
+
+    /// <summary>
+    /// A position in the world, kept free of any engine type so the simulation core does not depend on one
+    /// </summary>
+    struct SpawnPoint
+    {
+        float X;
+        float Y;
+        float Z;
+    };
+
+    /// <summary>
+    /// Gets where the players of a team enter the level, at their base.
+    /// </summary>
+    /// <param name="a_Team">The team of the player.</param>
+    SpawnPoint getSpawnPoint(ETeamIdentifier a_Team);
+
+    /// <summary> The height below which a character has fallen out of the level and goes back to its spawn </summary>
+    constexpr float FallHeight = -10.0f;
+
+    /// <summary>
+    /// Gets where the feet of a character of a team go when it spawns, below the eyes at the spawn point.
+    /// </summary>
+    /// <param name="a_Team">The team of the character.</param>
+    /// <param name="a_EyeHeight">The height of the eyes of the character above its feet.</param>
+    Vector3 getSpawnPosition(ETeamIdentifier a_Team, float a_EyeHeight);
+}
@@ -0,0 +1,65 @@
+#include "ConfusShared/EntityStore.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::Entity;
+    using ConfusShared::EntityStore;
+    using ConfusShared::ETeamIdentifier;
+    using ConfusShared::TeamComponent;
+    using ConfusShared::Tests::check;
+
+    TeamComponent createTeam(ETeamIdentifier a_Team)
+    {
+        TeamComponent team;
+        team.Team = a_Team;
+        return team;
+    }
+
+    void testDestroyedEntityIsStale()
+    {
+        EntityStore store;
+        Entity first = store.create();
+        store.Teams.add(first, createTeam(ETeamIdentifier::TeamRed));
+        store.destroy(first);
+        check(!store.isAlive(first) && store.getCount() == 0, "A destroyed entity is no longer alive");
+        check(!store.Teams.has(first), "Destroying an entity removes its components");
+
+        Entity second = store.create();
+        check(second.Index == first.Index && second.Generation != first.Generation, "The index of a destroyed entity is reused with a new generation");
+        check(store.isAlive(second) && !store.isAlive(first), "The old entity does not come back with the reused index");
+        check(!store.Teams.has(second), "The new entity does not get the components of the old one");
+    }
+
+    void testRemoveKeepsComponentsPacked()
+    {
+        EntityStore store;
+        Entity red = store.create();
+        Entity blue = store.create();
+        Entity neutral = store.create();
+        store.Teams.add(red, createTeam(ETeamIdentifier::TeamRed));
+        store.Teams.add(blue, createTeam(ETeamIdentifier::TeamBlue));
+        store.Teams.add(neutral, createTeam(ETeamIdentifier::None));
+
+        store.Teams.remove(red);
+        check(store.Teams.size() == 2, "Removing a component shrinks the packed array");
+        check(store.Teams.get(blue).Team == ETeamIdentifier::TeamBlue && store.Teams.get(neutral).Team == ETeamIdentifier::None,
+            "The other entities keep their own components after the last one is moved");
+        for(std::size_t i = 0; i < store.Teams.size(); ++i)
+        {
+            Entity entity = store.Teams.getEntity(i);
+            check(&store.Teams.at(i) == &store.Teams.get(entity), "Every packed component belongs to the entity stored with it");
+        }
+    }
+}
+
+/// <summary>
+/// Tests that the entities the client and the server keep their game state in are created and destroyed safely.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("DestroyedEntityIsStale", testDestroyedEntityIsStale);
+    runner.add("RemoveKeepsComponentsPacked", testRemoveKeepsComponentsPacked);
+    return runner.run();
+}
@@ -0,0 +1,144 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "ConfusShared/BitBuffer.h"
+#include "ConfusShared/InputCodec.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::BitBuffer;
+    using ConfusShared::InputCodec;
+    using ConfusShared::PlayerInput;
+    using ConfusShared::Tests::check;
+    using ConfusShared::Tests::checkThrows;
+
+    PlayerInput createInput(std::uint32_t a_Tick, std::uint16_t a_Buttons, float a_Yaw, float a_Pitch)
+    {
+        PlayerInput input;
+        input.Tick = a_Tick;
+        input.Buttons = a_Buttons;
+        input.Yaw = a_Yaw;
+        input.Pitch = a_Pitch;
+        return input;
+    }
+
+    bool isEqual(const PlayerInput& a_Input, const PlayerInput& a_Other)
+    {
+        return a_Input.Tick == a_Other.Tick && a_Input.Buttons == a_Other.Buttons && a_Input.Yaw == a_Other.Yaw && a_Input.Pitch == a_Other.Pitch;
+    }
+
+    /// <summary>
+    /// Writes a history and reads it back, newest first.
+    /// </summary>
+    std::vector<PlayerInput> roundTrip(const InputCodec::History& a_History, std::size_t& a_Bits)
+    {
+        BitBuffer buffer;
+        InputCodec::write(buffer, a_History);
+        a_Bits = buffer.getWrittenBits();
+        std::vector<PlayerInput> inputs;
+        InputCodec::read(buffer, [&inputs](const PlayerInput& a_Input) { inputs.push_back(a_Input); });
+        return inputs;
+    }
+
+    void testRepeatedInputTakesABit()
+    {
+        InputCodec::History history;
+        for(std::uint32_t tick = 100; tick < 100 + InputCodec::MaxInputs; ++tick)
+        {
+            InputCodec::record(history, createInput(tick, 5, 45.0f, -10.0f));
+        }
+        std::size_t bits;
+        std::vector<PlayerInput> inputs = roundTrip(history, bits);
+        check(bits == 32 + InputCodec::CountBits + InputCodec::InputBits + (InputCodec::MaxInputs - 1),
+            "Every input equal to the one after it takes a single bit");
+        check(inputs.size() == InputCodec::MaxInputs, "Every input in the history is sent");
+        for(std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            PlayerInput expected = InputCodec::quantize(history.at(history.size() - 1 - i));
+            check(isEqual(inputs[i], expected), "The repeated inputs come out as they were quantized, newest first");
+        }
+    }
+
+    void testChangingInputRoundTrip()
+    {
+        InputCodec::History history;
+        for(std::uint32_t tick = 0; tick < 5; ++tick)
+        {
+            InputCodec::record(history, createInput(tick, static_cast<std::uint16_t>(tick * 3), tick * 71.3f, tick * 17.0f - 40.0f));
+        }
+        std::size_t bits;
+        std::vector<PlayerInput> inputs = roundTrip(history, bits);
+        check(inputs.size() == 5, "Every input in the history is sent");
+        for(std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            PlayerInput expected = InputCodec::quantize(history.at(history.size() - 1 - i));
+            check(isEqual(inputs[i], expected), "Changing inputs come out as they were quantized, newest first");
+        }
+    }
+
+    void testTickGapRestartsHistory()
+    {
+        InputCodec::History history;
+        InputCodec::record(history, createInput(100, 0, 0.0f, 0.0f));
+        InputCodec::record(history, createInput(101, 0, 0.0f, 0.0f));
+        InputCodec::record(history, createInput(105, 1, 0.0f, 0.0f));
+        check(history.size() == 1 && history.at(0).Tick == 105, "The history starts over when a tick is skipped");
+
+        InputCodec::record(history, createInput(90, 2, 0.0f, 0.0f));
+        check(history.size() == 1 && history.at(0).Tick == 90, "The history starts over when the ticks go back");
+        std::size_t bits;
+        std::vector<PlayerInput> inputs = roundTrip(history, bits);
+        check(inputs.size() == 1 && inputs[0].Tick == 90 && inputs[0].Buttons == 2, "Only the input after the gap is sent");
+    }
+
+    void testTicksWrapAround()
+    {
+        InputCodec::History history;
+        const std::uint32_t first = 0xFFFFFFFDu;
+        for(std::uint32_t i = 0; i < 5; ++i)
+        {
+            InputCodec::record(history, createInput(first + i, static_cast<std::uint16_t>(i), 0.0f, 0.0f));
+        }
+        check(history.size() == 5, "Wrapping around is not mistaken for a gap");
+        std::size_t bits;
+        std::vector<PlayerInput> inputs = roundTrip(history, bits);
+        for(std::uint32_t i = 0; i < 5; ++i)
+        {
+            check(inputs[i].Tick == first + 4 - i && inputs[i].Buttons == 4 - i, "The ticks of older inputs count back across the wrap");
+        }
+    }
+
+    void testRejectsEmptyAndTruncated()
+    {
+        InputCodec::History history;
+        BitBuffer buffer;
+        checkThrows<std::invalid_argument>([&]() { InputCodec::write(buffer, history); }, "An empty history is not sent");
+
+        InputCodec::record(history, createInput(7, 1, 0.0f, 0.0f));
+        InputCodec::record(history, createInput(8, 2, 0.0f, 0.0f));
+        InputCodec::write(buffer, history);
+        BitBuffer truncated = buffer.getPrefix(32 + InputCodec::CountBits + InputCodec::InputBits);
+        std::size_t handled = 0;
+        checkThrows<std::invalid_argument>([&]()
+        {
+            InputCodec::read(truncated, [&handled](const PlayerInput&) { ++handled; });
+        }, "A packet cut off before its last input is refused");
+        check(handled == 1, "The inputs before the end are still handled");
+    }
+}
+
+/// <summary>
+/// Tests that the inputs a client sends come out at the server as the client simulated them.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("RepeatedInputTakesABit", testRepeatedInputTakesABit);
+    runner.add("ChangingInputRoundTrip", testChangingInputRoundTrip);
+    runner.add("TickGapRestartsHistory", testTickGapRestartsHistory);
+    runner.add("TicksWrapAround", testTicksWrapAround);
+    runner.add("RejectsEmptyAndTruncated", testRejectsEmptyAndTruncated);
+    return runner.run();
+}
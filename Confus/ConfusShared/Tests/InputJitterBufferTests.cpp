@@ -0,0 +1,153 @@
+#include <cstdint>
+
+#include "ConfusShared/InputJitterBuffer.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::InputJitterBuffer;
+    using ConfusShared::PlayerInput;
+    using ConfusShared::Tests::check;
+
+    PlayerInput createInput(std::uint32_t a_Tick, std::uint16_t a_Buttons = 0)
+    {
+        PlayerInput input;
+        input.Tick = a_Tick;
+        input.Buttons = a_Buttons;
+        return input;
+    }
+
+    /// <summary>
+    /// Receives the inputs a client sends in a single packet, the newest first.
+    /// </summary>
+    void receivePacket(InputJitterBuffer& a_Buffer, std::uint32_t a_NewestTick, std::uint32_t a_Count)
+    {
+        for(std::uint32_t i = 0; i < a_Count; ++i)
+        {
+            a_Buffer.receive(createInput(a_NewestTick - i));
+        }
+    }
+
+    void testStartsAtTargetDepth()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        buffer.receive(createInput(100));
+        check(!buffer.consume(input), "Nothing is handed out before the buffer reached its target depth");
+        buffer.receive(createInput(101));
+        check(buffer.consume(input) && input.Tick == 100, "The oldest input is handed out first");
+        check(buffer.consume(input) && input.Tick == 101, "The inputs are handed out a tick at a time");
+        check(buffer.getMissedCount() == 0, "No input was missed");
+    }
+
+    void testMissingInputRepeatsLast()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        buffer.receive(createInput(100));
+        buffer.receive(createInput(101, 3));
+        buffer.consume(input);
+        buffer.consume(input);
+        check(buffer.consume(input), "There still is an input when the next one is late");
+        check(input.Tick == 101 && input.Buttons == 3, "The last input is repeated in place of the late one");
+        check(buffer.getMissedCount() == 1, "The late input counts as missed");
+    }
+
+    void testDuplicatesAreIgnored()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        buffer.receive(createInput(100, 1));
+        buffer.receive(createInput(100, 2));
+        buffer.receive(createInput(101));
+        buffer.consume(input);
+        check(input.Buttons == 1, "The first copy of an input is the one kept");
+    }
+
+    void testLateRepeatIsIgnored()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        for(std::uint32_t tick = 100; tick < 110; ++tick)
+        {
+            receivePacket(buffer, tick, 8);
+            buffer.consume(input);
+        }
+        std::uint32_t depth = buffer.getDepth();
+        std::uint32_t lastTick = input.Tick;
+        buffer.receive(createInput(lastTick - 3, 7));
+        check(buffer.getDepth() == depth, "An input that was handed out already does not change the depth");
+        receivePacket(buffer, 110, 8);
+        buffer.consume(input);
+        check(input.Tick == lastTick + 1 && input.Buttons == 0, "A repeat of an old input does not restart the buffer");
+    }
+
+    void testClientGoingBackRestarts()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        for(std::uint32_t tick = 1000; tick < 1010; ++tick)
+        {
+            receivePacket(buffer, tick, 8);
+            buffer.consume(input);
+        }
+        std::uint64_t missed = buffer.getMissedCount();
+
+        receivePacket(buffer, 500, 8);
+        check(buffer.consume(input) && input.Tick == 500 - (buffer.getTargetDepth() - 1),
+            "After the client went back in time its inputs are handed out right away");
+        check(buffer.consume(input) && input.Tick == 500 - (buffer.getTargetDepth() - 2), "The inputs follow on from there");
+        check(buffer.getMissedCount() == missed, "No input is missed while the buffer starts over");
+    }
+
+    void testStallIsDrainedInOneWindow()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        //A stall followed by a burst leaves many more inputs buffered than the target
+        for(std::uint32_t tick = 0; tick < 20; ++tick)
+        {
+            buffer.receive(createInput(tick));
+        }
+        for(std::uint32_t i = 0; i < InputJitterBuffer::AdaptationWindow; ++i)
+        {
+            buffer.receive(createInput(20 + i));
+            buffer.consume(input);
+        }
+        check(buffer.getDepth() == buffer.getTargetDepth(), "Everything beyond the target is dropped after a single window");
+        check(buffer.getSkippedCount() == 20 - buffer.getTargetDepth(), "Every dropped input counts as skipped");
+        check(buffer.getMissedCount() == 0, "Draining does not make the buffer run dry");
+    }
+
+    void testTicksWrapAround()
+    {
+        InputJitterBuffer buffer;
+        PlayerInput input;
+        const std::uint32_t first = 0xFFFFFFFEu;
+        for(std::uint32_t i = 0; i < 4; ++i)
+        {
+            buffer.receive(createInput(first + i));
+        }
+        for(std::uint32_t i = 0; i < 4; ++i)
+        {
+            check(buffer.consume(input) && input.Tick == first + i, "Inputs are handed out in order when the tick counter wraps around");
+        }
+        check(buffer.getMissedCount() == 0 && buffer.getSkippedCount() == 0, "Wrapping around is not mistaken for a jump in time");
+    }
+}
+
+/// <summary>
+/// Tests how the jitter buffer hands out the inputs of a client when they arrive late, repeated, in bursts or from the past.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("StartsAtTargetDepth", testStartsAtTargetDepth);
+    runner.add("MissingInputRepeatsLast", testMissingInputRepeatsLast);
+    runner.add("DuplicatesAreIgnored", testDuplicatesAreIgnored);
+    runner.add("LateRepeatIsIgnored", testLateRepeatIsIgnored);
+    runner.add("ClientGoingBackRestarts", testClientGoingBackRestarts);
+    runner.add("StallIsDrainedInOneWindow", testStallIsDrainedInOneWindow);
+    runner.add("TicksWrapAround", testTicksWrapAround);
+    return runner.run();
+}
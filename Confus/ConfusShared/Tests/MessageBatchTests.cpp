@@ -0,0 +1,258 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "ConfusShared/MessageBatch.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::MessageBatch;
+    using ConfusShared::Tests::check;
+    using ConfusShared::Tests::checkThrows;
+
+    const std::uint8_t BatchId = 136;
+
+    /// <summary>
+    /// Flushes a batch and collects the datagrams it sends.
+    /// </summary>
+    std::vector<std::vector<std::uint8_t>> flush(MessageBatch& a_Batch, std::size_t a_MaxDatagramSize)
+    {
+        std::vector<std::vector<std::uint8_t>> datagrams;
+        a_Batch.flush(BatchId, a_MaxDatagramSize, [&datagrams](const std::uint8_t* a_Data, std::size_t a_Size)
+        {
+            datagrams.emplace_back(a_Data, a_Data + a_Size);
+        });
+        return datagrams;
+    }
+
+    /// <summary>
+    /// Unpacks datagrams into the messages they hold.
+    /// </summary>
+    std::vector<std::vector<std::uint8_t>> unpack(const std::vector<std::vector<std::uint8_t>>& a_Datagrams)
+    {
+        std::vector<std::vector<std::uint8_t>> messages;
+        for(const auto& datagram : a_Datagrams)
+        {
+            MessageBatch::unpack(datagram.data(), datagram.size(), [&messages](const std::uint8_t* a_Data, std::size_t a_Size)
+            {
+                messages.emplace_back(a_Data, a_Data + a_Size);
+            });
+        }
+        return messages;
+    }
+
+    std::vector<std::uint8_t> createMessage(std::size_t a_Size, std::uint8_t a_Seed)
+    {
+        std::vector<std::uint8_t> message(a_Size);
+        for(std::size_t i = 0; i < a_Size; ++i)
+        {
+            message[i] = static_cast<std::uint8_t>(a_Seed + i * 7);
+        }
+        return message;
+    }
+
+    void testRoundTrip()
+    {
+        MessageBatch batch;
+        std::vector<std::vector<std::uint8_t>> sent = { createMessage(1, 1), createMessage(127, 2), createMessage(128, 3), createMessage(300, 4) };
+        for(const auto& message : sent)
+        {
+            batch.add(message.data(), message.size());
+        }
+        check(batch.getQueuedBytes() == 1 + 1 + 1 + 127 + 2 + 128 + 2 + 300, "Lengths below 128 take one byte of prefix, longer ones two");
+
+        auto datagrams = flush(batch, 1400);
+        check(datagrams.size() == 1, "Messages that fit in a datagram together are sent together");
+        check(datagrams[0][0] == BatchId, "Every datagram starts with the batch id");
+        check(unpack(datagrams) == sent, "The messages come out as they went in, in order");
+        check(batch.getMessageCount() == 0 && batch.getQueuedBytes() == 0, "Flushing empties the batch");
+    }
+
+    void testSplitsAtDatagramSize()
+    {
+        MessageBatch batch;
+        std::vector<std::vector<std::uint8_t>> sent;
+        for(std::uint8_t i = 0; i < 10; ++i)
+        {
+            sent.push_back(createMessage(100, i));
+            batch.add(sent.back().data(), sent.back().size());
+        }
+        auto datagrams = flush(batch, 250);
+        check(datagrams.size() == 5, "Two messages of 101 bytes fit in a datagram of 250 bytes along with the id");
+        for(const auto& datagram : datagrams)
+        {
+            check(datagram.size() <= 250, "No datagram grows past the maximum size");
+        }
+        check(unpack(datagrams) == sent, "Split up messages still come out in order");
+    }
+
+    void testOversizeMessageGetsOwnDatagram()
+    {
+        MessageBatch batch;
+        std::vector<std::vector<std::uint8_t>> sent = { createMessage(10, 1), createMessage(2000, 2), createMessage(10, 3) };
+        for(const auto& message : sent)
+        {
+            batch.add(message.data(), message.size());
+        }
+        auto datagrams = flush(batch, 1400);
+        check(datagrams.size() == 3, "A message larger than a datagram is sent on its own");
+        check(datagrams[1].size() == 1 + 2 + 2000, "The large datagram holds only the id, the prefix and the message");
+        check(unpack(datagrams) == sent, "The large message comes out whole");
+    }
+
+    void testEmptyBatchSendsNothing()
+    {
+        MessageBatch batch;
+        check(flush(batch, 1400).empty(), "Flushing an empty batch sends no datagram");
+        checkThrows<std::invalid_argument>([&batch]() { batch.add(nullptr, 0); }, "A message without a packet id is refused");
+    }
+
+    void testFlushStopsWhenNotPermitted()
+    {
+        MessageBatch batch;
+        std::vector<std::vector<std::uint8_t>> sent;
+        for(std::uint8_t i = 0; i < 10; ++i)
+        {
+            sent.push_back(createMessage(100, i));
+            batch.add(sent.back().data(), sent.back().size());
+        }
+
+        std::vector<std::vector<std::uint8_t>> datagrams;
+        std::size_t permitted = 2;
+        auto maySend = [&permitted]() { return permitted > 0; };
+        auto send = [&](const std::uint8_t* a_Data, std::size_t a_Size)
+        {
+            datagrams.emplace_back(a_Data, a_Data + a_Size);
+            --permitted;
+        };
+        batch.flush(BatchId, 250, maySend, send);
+        check(datagrams.size() == 2, "No datagram is sent once sending is no longer permitted");
+        check(batch.getMessageCount() == 6, "The messages that were not sent stay queued");
+        check(batch.getQueuedBytes() == 6 * 101, "Only the sent messages leave the queue");
+
+        permitted = 10;
+        batch.flush(BatchId, 250, maySend, send);
+        check(datagrams.size() == 5, "A later flush sends the rest");
+        check(batch.getMessageCount() == 0, "The queue is empty once everything has been sent");
+        check(unpack(datagrams) == sent, "A flush spread over several calls keeps the messages in order");
+    }
+
+    void testFlushWithoutPermissionSendsNothing()
+    {
+        MessageBatch batch;
+        auto message = createMessage(10, 1);
+        batch.add(message.data(), message.size());
+        std::size_t sentCount = 0;
+        batch.flush(BatchId, 1400, []() { return false; }, [&sentCount](const std::uint8_t*, std::size_t) { ++sentCount; });
+        check(sentCount == 0, "Nothing is sent without permission");
+        check(batch.getMessageCount() == 1, "The message stays queued");
+    }
+
+    void testByteLimitDropsOldestDroppable()
+    {
+        MessageBatch batch(3 * 101);
+        std::vector<std::vector<std::uint8_t>> messages;
+        for(std::uint8_t i = 0; i < 5; ++i)
+        {
+            messages.push_back(createMessage(100, i));
+        }
+        batch.add(messages[0].data(), messages[0].size(), true);
+        batch.add(messages[1].data(), messages[1].size());
+        batch.add(messages[2].data(), messages[2].size(), true);
+        batch.add(messages[3].data(), messages[3].size(), true);
+        check(batch.getMessageCount() == 3 && batch.getQueuedBytes() == 3 * 101, "The oldest droppable message makes room");
+        batch.add(messages[4].data(), messages[4].size());
+        check(batch.getQueuedBytes() == 3 * 101, "The queue stays within its limit");
+
+        std::vector<std::vector<std::uint8_t>> expected = { messages[1], messages[3], messages[4] };
+        check(unpack(flush(batch, 1400)) == expected, "Messages that may not be dropped are kept, the rest stay in order");
+    }
+
+    void testByteLimitKeepsMessagesThatMayNotBeDropped()
+    {
+        MessageBatch batch(150);
+        auto message = createMessage(100, 1);
+        batch.add(message.data(), message.size());
+        batch.add(message.data(), message.size());
+        check(batch.getMessageCount() == 2, "A message that may not be dropped is kept past the limit");
+    }
+
+    void testUnpackRejectsTruncatedMessage()
+    {
+        std::vector<std::uint8_t> datagram = { BatchId, 5, 1, 2, 3 };
+        std::size_t handled = 0;
+        checkThrows<std::invalid_argument>([&]()
+        {
+            MessageBatch::unpack(datagram.data(), datagram.size(), [&handled](const std::uint8_t*, std::size_t) { ++handled; });
+        }, "A message running past the end of the datagram is refused");
+        check(handled == 0, "Nothing of the truncated message is handled");
+    }
+
+    void testUnpackRejectsTruncatedPrefix()
+    {
+        std::vector<std::uint8_t> datagram = { BatchId, 2, 7, 7, 0x80 };
+        std::size_t handled = 0;
+        checkThrows<std::invalid_argument>([&]()
+        {
+            MessageBatch::unpack(datagram.data(), datagram.size(), [&handled](const std::uint8_t*, std::size_t) { ++handled; });
+        }, "A length prefix cut off by the end of the datagram is refused");
+        check(handled == 1, "The messages before the error are still handled");
+    }
+
+    void testUnpackRejectsZeroLengthMessage()
+    {
+        std::vector<std::uint8_t> datagram = { BatchId, 1, 9, 0 };
+        checkThrows<std::invalid_argument>([&datagram]()
+        {
+            MessageBatch::unpack(datagram.data(), datagram.size(), [](const std::uint8_t*, std::size_t) {});
+        }, "A message of zero bytes is refused, as every message holds at least its packet id");
+    }
+
+    void testUnpackRejectsOversizeLength()
+    {
+        //A prefix that never ends encodes a length beyond anything that fits in the datagram
+        std::vector<std::uint8_t> datagram(1 + 12, 0xFF);
+        datagram[0] = BatchId;
+        checkThrows<std::invalid_argument>([&datagram]()
+        {
+            MessageBatch::unpack(datagram.data(), datagram.size(), [](const std::uint8_t*, std::size_t) {});
+        }, "A length prefix longer than a length can be is refused");
+
+        std::vector<std::uint8_t> huge = { BatchId, 0xFF, 0xFF, 0xFF, 0x7F, 1, 2 };
+        checkThrows<std::invalid_argument>([&huge]()
+        {
+            MessageBatch::unpack(huge.data(), huge.size(), [](const std::uint8_t*, std::size_t) {});
+        }, "A length larger than the rest of the datagram is refused");
+    }
+
+    void testUnpackEmptyDatagram()
+    {
+        std::vector<std::uint8_t> datagram = { BatchId };
+        std::size_t handled = 0;
+        MessageBatch::unpack(datagram.data(), datagram.size(), [&handled](const std::uint8_t*, std::size_t) { ++handled; });
+        check(handled == 0, "A datagram holding only the id has no messages");
+    }
+}
+
+/// <summary>
+/// Tests the length prefixed framing of batched messages, including the datagrams a peer could damage or forge.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("RoundTrip", testRoundTrip);
+    runner.add("SplitsAtDatagramSize", testSplitsAtDatagramSize);
+    runner.add("OversizeMessageGetsOwnDatagram", testOversizeMessageGetsOwnDatagram);
+    runner.add("EmptyBatchSendsNothing", testEmptyBatchSendsNothing);
+    runner.add("FlushStopsWhenNotPermitted", testFlushStopsWhenNotPermitted);
+    runner.add("FlushWithoutPermissionSendsNothing", testFlushWithoutPermissionSendsNothing);
+    runner.add("ByteLimitDropsOldestDroppable", testByteLimitDropsOldestDroppable);
+    runner.add("ByteLimitKeepsMessagesThatMayNotBeDropped", testByteLimitKeepsMessagesThatMayNotBeDropped);
+    runner.add("UnpackRejectsTruncatedMessage", testUnpackRejectsTruncatedMessage);
+    runner.add("UnpackRejectsTruncatedPrefix", testUnpackRejectsTruncatedPrefix);
+    runner.add("UnpackRejectsZeroLengthMessage", testUnpackRejectsZeroLengthMessage);
+    runner.add("UnpackRejectsOversizeLength", testUnpackRejectsOversizeLength);
+    runner.add("UnpackEmptyDatagram", testUnpackEmptyDatagram);
+    return runner.run();
+}
@@ -0,0 +1,80 @@
+#include <cstdint>
+
+#include "ConfusShared/SendRateController.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::LinkStatistics;
+    using ConfusShared::SendRateController;
+    using ConfusShared::Tests::check;
+
+    const float UpdateInterval = 0.05f;
+
+    /// <summary>
+    /// Updates the controller for a while with a link that has the same round trip time and no loss.
+    /// </summary>
+    void run(SendRateController& a_Controller, float a_RoundTripTime, float a_Duration)
+    {
+        LinkStatistics statistics;
+        statistics.RoundTripTime = a_RoundTripTime;
+        for(float time = 0.0f; time < a_Duration; time += UpdateInterval)
+        {
+            a_Controller.update(statistics, UpdateInterval);
+        }
+    }
+
+    void testSteadyLinkGrows()
+    {
+        SendRateController controller;
+        run(controller, 0.05f, 5.0f);
+        check(!controller.isCongested(), "A link with a steady round trip time is not congested");
+        check(controller.getBandwidthBudget() > SendRateController::DefaultBandwidthBudget, "The budget grows on a steady link");
+    }
+
+    void testDelaySpikeBacksOff()
+    {
+        SendRateController controller;
+        run(controller, 0.05f, 5.0f);
+        std::uint32_t budget = controller.getBandwidthBudget();
+        run(controller, 0.2f, 1.0f);
+        check(controller.isCongested(), "A round trip time well above the base counts as congestion");
+        check(controller.getBandwidthBudget() < budget, "The budget backs off while the round trip time is raised");
+        check(controller.getBaseRoundTripTime() == 0.05f, "A short spike does not raise the base round trip time");
+    }
+
+    void testRoundTripStepRecovers()
+    {
+        SendRateController controller;
+        run(controller, 0.05f, 5.0f);
+        run(controller, 0.2f, SendRateController::BaseRoundTripWindow + 1.0f);
+        check(controller.getBaseRoundTripTime() == 0.2f, "The base follows a round trip time that rose for good");
+        check(!controller.isCongested(), "The raised round trip time is no longer taken for congestion");
+
+        std::uint32_t budget = controller.getBandwidthBudget();
+        run(controller, 0.2f, 5.0f);
+        check(controller.getBandwidthBudget() > budget && controller.getBandwidthBudget() > SendRateController::MinBandwidthBudget,
+            "The budget recovers from the minimum after the round trip time stepped up");
+    }
+
+    void testBaseDropsRightAway()
+    {
+        SendRateController controller;
+        run(controller, 0.2f, 5.0f);
+        run(controller, 0.05f, UpdateInterval);
+        check(controller.getBaseRoundTripTime() == 0.05f, "A lower round trip time becomes the base as soon as it is seen");
+    }
+}
+
+/// <summary>
+/// Tests how the send rate of a peer follows the round trip time of its link.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("SteadyLinkGrows", testSteadyLinkGrows);
+    runner.add("DelaySpikeBacksOff", testDelaySpikeBacksOff);
+    runner.add("RoundTripStepRecovers", testRoundTripStepRecovers);
+    runner.add("BaseDropsRightAway", testBaseDropsRightAway);
+    return runner.run();
+}
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include "ConfusShared/SessionTable.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::PeerHandle;
+    using ConfusShared::Tests::check;
+    using ConfusShared::Tests::checkThrows;
+    using SessionTable = ConfusShared::SessionTable<int>;
+
+    void testOpenAndFind()
+    {
+        SessionTable table(4);
+        PeerHandle first = table.open(10, 100).Handle;
+        PeerHandle second = table.open(20, 200).Handle;
+        check(first.isValid() && second.isValid() && first != second, "Every session gets a handle of its own");
+        check(table.size() == 2, "Both sessions are open");
+        check(table.find(100) == first && table.find(200) == second, "Sessions are found by the id of their peer");
+        check(!table.find(300).isValid(), "A peer without a session is not found");
+        check(table.get(second).Address == 20, "The session keeps the address of its peer");
+        check(table.open(11, 100).Handle == first && table.size() == 2, "Opening a session for a connected peer gets the open one");
+    }
+
+    void testClosedHandleIsStale()
+    {
+        SessionTable table(1);
+        PeerHandle old = table.open(10, 100).Handle;
+        table.close(old);
+        check(!table.has(old) && table.size() == 0, "A closed session is gone");
+        checkThrows<std::invalid_argument>([&]() { table.get(old); }, "Getting a closed session throws");
+
+        PeerHandle reopened = table.open(20, 200).Handle;
+        check(reopened.Index == old.Index, "The only slot is reused");
+        check(reopened.Generation != old.Generation, "A reused slot hands out a new generation");
+        check(!table.has(old) && table.has(reopened), "The old handle does not refer to the session in the reused slot");
+        check(table.get(reopened).Guid == 200, "The reused slot holds the new peer");
+
+        table.close(old);
+        check(table.has(reopened), "Closing through a stale handle leaves the new session open");
+    }
+
+    void testGenerationsKeepAdvancing()
+    {
+        SessionTable table(1);
+        PeerHandle previous = table.open(0, 0).Handle;
+        for(std::uint64_t guid = 1; guid < 1000; ++guid)
+        {
+            table.close(previous);
+            PeerHandle handle = table.open(0, guid).Handle;
+            check(handle.Generation == static_cast<std::uint16_t>(previous.Generation + 1), "Every reuse of a slot advances its generation by one");
+            previous = handle;
+        }
+    }
+
+    void testSessionStartsFresh()
+    {
+        SessionTable table(1);
+        auto& session = table.open(10, 100);
+        session.AckedTick = 55;
+        session.RoundTripTime = 0.2f;
+        table.close(session.Handle);
+        auto& reopened = table.open(20, 200);
+        check(reopened.AckedTick == 0 && reopened.RoundTripTime == 0.0f, "A reused slot starts without the state of the previous session");
+    }
+
+    void testCapacity()
+    {
+        SessionTable table(2);
+        table.open(1, 1);
+        table.open(2, 2);
+        checkThrows<std::invalid_argument>([&table]() { table.open(3, 3); }, "Opening more sessions than there are slots throws");
+        checkThrows<std::invalid_argument>([]() { SessionTable(PeerHandle::InvalidIndex); }, "The invalid index cannot be a slot");
+    }
+
+    void testOpenSessionsStayPacked()
+    {
+        SessionTable table(4);
+        PeerHandle handles[4];
+        for(std::uint16_t i = 0; i < 4; ++i)
+        {
+            handles[i] = table.open(i, i).Handle;
+        }
+        table.close(handles[1]);
+        table.close(handles[3]);
+        check(table.size() == 2, "Two sessions are left open");
+        for(std::size_t i = 0; i < table.size(); ++i)
+        {
+            check(table.at(i).Handle == handles[0] || table.at(i).Handle == handles[2], "Only the open sessions are walked");
+        }
+        check(!table.has(PeerHandle()), "The invalid handle never has a session");
+    }
+}
+
+/// <summary>
+/// Tests how sessions are opened, found and closed, and that handles of closed sessions never reach a newer one.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("OpenAndFind", testOpenAndFind);
+    runner.add("ClosedHandleIsStale", testClosedHandleIsStale);
+    runner.add("GenerationsKeepAdvancing", testGenerationsKeepAdvancing);
+    runner.add("SessionStartsFresh", testSessionStartsFresh);
+    runner.add("Capacity", testCapacity);
+    runner.add("OpenSessionsStayPacked", testOpenSessionsStayPacked);
+    return runner.run();
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ConfusShared
+{
+    namespace Tests
+    {
+        /// <summary>
+        /// Thrown by a check that does not hold, ending the test it is in
+        /// </summary>
+        class TestFailure : public std::runtime_error
+        {
+        public:
+            explicit TestFailure(const std::string& a_Description)
+                : std::runtime_error(a_Description)
+            {
+            }
+        };
+
+        /// <summary>
+        /// Fails the running test when a condition does not hold.
+        /// </summary>
+        /// <param name="a_Condition">The condition.</param>
+        /// <param name="a_Description">What the condition means, reported when it does not hold.</param>
+        inline void check(bool a_Condition, const std::string& a_Description)
+        {
+            if(!a_Condition)
+            {
+                throw TestFailure(a_Description);
+            }
+        }
+
+        /// <summary>
+        /// Fails the running test unless a function throws the given kind of exception.
+        /// </summary>
+        template<typename TException, typename TFunction>
+        void checkThrows(TFunction a_Function, const std::string& a_Description)
+        {
+            try
+            {
+                a_Function();
+            }
+            catch(const TException&)
+            {
+                return;
+            }
+            throw TestFailure(a_Description);
+        }
+
+        /// <summary>
+        /// Runs a set of named tests, each until its first failed check, and reports the ones that failed.
+        /// Every test executable of the shared library has a runner in its main, and returns what it returns.
+        /// </summary>
+        class TestRunner
+        {
+        private:
+            std::vector<std::pair<std::string, std::function<void()>>> m_Tests;
+        public:
+            /// <summary>
+            /// Adds a test to run.
+            /// </summary>
+            void add(const std::string& a_Name, const std::function<void()>& a_Test)
+            {
+                m_Tests.emplace_back(a_Name, a_Test);
+            }
+
+            /// <summary>
+            /// Runs every test in the order they were added.
+            /// </summary>
+            /// <returns>Zero if every test passed, one otherwise, to be returned from main.</returns>
+            int run() const
+            {
+                std::size_t failures = 0;
+                for(const auto& test : m_Tests)
+                {
+                    try
+                    {
+                        test.second();
+                    }
+                    catch(const std::exception& exception)
+                    {
+                        std::cerr << test.first << " failed: " << exception.what() << std::endl;
+                        ++failures;
+                    }
+                }
+                std::cout << m_Tests.size() - failures << " of " << m_Tests.size() << " tests passed" << std::endl;
+                return failures == 0 ? 0 : 1;
+            }
+        };
+    }
+}
@@ -0,0 +1,108 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "ConfusShared/WorkerPool.h"
+#include "TestRunner.h"
+
+namespace
+{
+    using ConfusShared::WorkerPool;
+    using ConfusShared::Tests::check;
+    using ConfusShared::Tests::checkThrows;
+
+    void testParallelForVisitsEveryIndexOnce()
+    {
+        WorkerPool pool(3);
+        std::vector<std::atomic<int>> visits(1000);
+        pool.parallelFor(visits.size(), 7, [&visits](std::size_t a_Begin, std::size_t a_End)
+        {
+            for(std::size_t i = a_Begin; i < a_End; ++i)
+            {
+                ++visits[i];
+            }
+        });
+        for(const auto& count : visits)
+        {
+            check(count == 1, "Every index is visited exactly once");
+        }
+    }
+
+    void testSingleChunkRunsInline()
+    {
+        WorkerPool pool(3);
+        std::size_t calls = 0;
+        pool.parallelFor(5, 16, [&calls](std::size_t a_Begin, std::size_t a_End)
+        {
+            check(a_Begin == 0 && a_End == 5, "A range that fits in a chunk is handled as a whole");
+            ++calls;
+        });
+        check(calls == 1, "A range that fits in a chunk is handled once");
+        pool.parallelFor(0, 16, [&calls](std::size_t, std::size_t) { ++calls; });
+        check(calls == 1, "An empty range calls nothing");
+        checkThrows<std::invalid_argument>([&pool]() { pool.parallelFor(5, 0, [](std::size_t, std::size_t) {}); }, "Chunks of zero indices are refused");
+    }
+
+    void testParallelForRethrows()
+    {
+        WorkerPool pool(3);
+        std::atomic<int> finished{ 0 };
+        checkThrows<std::runtime_error>([&]()
+        {
+            pool.parallelFor(100, 10, [&finished](std::size_t a_Begin, std::size_t)
+            {
+                if(a_Begin == 50)
+                {
+                    throw std::runtime_error("Chunk failed");
+                }
+                ++finished;
+            });
+        }, "The exception of a chunk reaches the caller");
+        check(finished == 9, "The other chunks still run to the end before it does");
+    }
+
+    void testParallelForWithoutWorkers()
+    {
+        WorkerPool pool(0);
+        std::vector<int> visits(100, 0);
+        pool.parallelFor(visits.size(), 10, [&visits](std::size_t a_Begin, std::size_t a_End)
+        {
+            for(std::size_t i = a_Begin; i < a_End; ++i)
+            {
+                ++visits[i];
+            }
+        });
+        check(visits == std::vector<int>(100, 1), "A pool without workers runs every chunk on the calling thread");
+    }
+
+    void testParallelForInsideJob()
+    {
+        WorkerPool pool(2);
+        std::atomic<int> total{ 0 };
+        std::atomic<bool> done{ false };
+        pool.submit([&]()
+        {
+            pool.parallelFor(64, 4, [&total](std::size_t a_Begin, std::size_t a_End) { total += static_cast<int>(a_End - a_Begin); });
+            done = true;
+        });
+        while(!done)
+        {
+            pool.runPendingJob();
+        }
+        check(total == 64, "A job can split its own work over the pool");
+    }
+}
+
+/// <summary>
+/// Tests splitting work over the worker pool, as the server does with the characters of its clients.
+/// </summary>
+int main()
+{
+    ConfusShared::Tests::TestRunner runner;
+    runner.add("ParallelForVisitsEveryIndexOnce", testParallelForVisitsEveryIndexOnce);
+    runner.add("SingleChunkRunsInline", testSingleChunkRunsInline);
+    runner.add("ParallelForRethrows", testParallelForRethrows);
+    runner.add("ParallelForWithoutWorkers", testParallelForWithoutWorkers);
+    runner.add("ParallelForInsideJob", testParallelForInsideJob);
+    return runner.run();
+}
@@ -0,0 +1,298 @@
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using SocketHandle = SOCKET;
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using SocketHandle = int;
+const SocketHandle INVALID_SOCKET = -1;
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "ConfusShared/NetworkEmulator.h"
+
+namespace
+{
+    /// <summary> The largest datagram that is relayed, larger than anything RakNet sends </summary>
+    const std::size_t MaxDatagramSize = 2048;
+    /// <summary> The time in seconds between statistics reports </summary>
+    const double ReportInterval = 5.0;
+
+    /// <summary>
+    /// A client of the relay, with its own socket towards the server so the server sees every client at its own address
+    /// </summary>
+    struct Client
+    {
+        /// <summary> The order in which the client connected </summary>
+        std::size_t Index;
+        sockaddr_in Address;
+        SocketHandle ServerSocket;
+        /// <summary> The direction from the client to the server </summary>
+        std::unique_ptr<ConfusShared::EmulatedLink> Upstream;
+        /// <summary> The direction from the server to the client </summary>
+        std::unique_ptr<ConfusShared::EmulatedLink> Downstream;
+    };
+
+    void closeSocket(SocketHandle a_Socket)
+    {
+#ifdef _WIN32
+        closesocket(a_Socket);
+#else
+        close(a_Socket);
+#endif
+    }
+
+    SocketHandle openSocket(std::uint16_t a_Port)
+    {
+        SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if(handle == INVALID_SOCKET)
+        {
+            throw std::runtime_error("Could not open a socket.");
+        }
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(a_Port);
+        if(bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            closeSocket(handle);
+            throw std::runtime_error("Could not bind a socket to port " + std::to_string(a_Port) + ".");
+        }
+        return handle;
+    }
+
+    sockaddr_in resolve(const std::string& a_HostAndPort)
+    {
+        std::size_t separator = a_HostAndPort.rfind(':');
+        if(separator == std::string::npos)
+        {
+            throw std::invalid_argument("The server has to be given as <host>:<port>.");
+        }
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* result = nullptr;
+        if(getaddrinfo(a_HostAndPort.substr(0, separator).c_str(), a_HostAndPort.substr(separator + 1).c_str(), &hints, &result) != 0)
+        {
+            throw std::invalid_argument("Could not resolve " + a_HostAndPort + ".");
+        }
+        sockaddr_in address = *reinterpret_cast<sockaddr_in*>(result->ai_addr);
+        freeaddrinfo(result);
+        return address;
+    }
+
+    /// <summary>
+    /// Gets a built in profile by its name, or reads the script at the path otherwise.
+    /// </summary>
+    ConfusShared::LinkProfile loadProfile(const std::string& a_NameOrPath)
+    {
+        std::ifstream script(a_NameOrPath);
+        if(script)
+        {
+            return ConfusShared::LinkProfile::parse(script);
+        }
+        return ConfusShared::LinkProfile::getNamed(a_NameOrPath);
+    }
+
+    /// <summary> Orders addresses, to look clients up by the address their datagrams come from </summary>
+    struct AddressLess
+    {
+        bool operator()(const sockaddr_in& a_First, const sockaddr_in& a_Second) const
+        {
+            return std::tie(a_First.sin_addr.s_addr, a_First.sin_port) < std::tie(a_Second.sin_addr.s_addr, a_Second.sin_port);
+        }
+    };
+
+    void report(const char* a_Direction, std::size_t a_Client, const ConfusShared::EmulatedLink& a_Link)
+    {
+        const auto& statistics = a_Link.getStatistics();
+        std::cout << "Client " << a_Client << " " << a_Direction << ": " << statistics.Sent << " sent, " << statistics.Delivered
+            << " delivered, " << statistics.Lost << " lost, " << statistics.Overflowed << " overflowed, "
+            << statistics.Duplicated << " duplicated, " << statistics.Reordered << " reordered" << std::endl;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: NetworkEmulatorRelay --server <host>:<port> [--listen <port>] [--seed <seed>]"
+            " [--up <profile>] [--down <profile>]\n"
+            "Clients connect to the listen port instead of the server. A profile is lan, broadband, mobile,\n"
+            "congested, flaky or the path of a link profile script, see ConfusShared/NetworkEmulator.h." << std::endl;
+    }
+}
+
+/// <summary>
+/// Relays UDP between game clients and a server on the same machine, emulating the link in each direction,
+/// so the netcode can be measured under the same conditions every run. The decisions for every client depend only on
+/// the seed, the order clients connect in and the datagrams they send.
+/// </summary>
+int main(int a_ArgumentCount, char** a_Arguments)
+{
+    std::uint16_t listenPort = 60001;
+    std::string server;
+    std::uint32_t seed = 1;
+    std::string upstreamProfile = "lan";
+    std::string downstreamProfile = "lan";
+    for(int i = 1; i + 1 < a_ArgumentCount; i += 2)
+    {
+        std::string option = a_Arguments[i];
+        std::string value = a_Arguments[i + 1];
+        if(option == "--listen")
+        {
+            listenPort = static_cast<std::uint16_t>(std::stoi(value));
+        }
+        else if(option == "--server")
+        {
+            server = value;
+        }
+        else if(option == "--seed")
+        {
+            seed = static_cast<std::uint32_t>(std::stoul(value));
+        }
+        else if(option == "--up")
+        {
+            upstreamProfile = value;
+        }
+        else if(option == "--down")
+        {
+            downstreamProfile = value;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if(server.empty() || a_ArgumentCount % 2 == 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+#ifdef _WIN32
+    WSADATA winsockData;
+    WSAStartup(MAKEWORD(2, 2), &winsockData);
+#endif
+
+    try
+    {
+        ConfusShared::LinkProfile upstream = loadProfile(upstreamProfile);
+        ConfusShared::LinkProfile downstream = loadProfile(downstreamProfile);
+        sockaddr_in serverAddress = resolve(server);
+        SocketHandle listenSocket = openSocket(listenPort);
+        std::map<sockaddr_in, Client, AddressLess> clients;
+        std::cout << "Relaying port " << listenPort << " to " << server << ", up: " << upstreamProfile
+            << ", down: " << downstreamProfile << ", seed " << seed << std::endl;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto getTime = [start]()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        double nextReport = ReportInterval;
+        std::uint8_t buffer[MaxDatagramSize];
+        while(true)
+        {
+            //Sleep until a datagram comes in or one in flight arrives, whichever is first
+            double nextArrival = nextReport;
+            fd_set sockets;
+            FD_ZERO(&sockets);
+            FD_SET(listenSocket, &sockets);
+            SocketHandle highestSocket = listenSocket;
+            for(auto& client : clients)
+            {
+                FD_SET(client.second.ServerSocket, &sockets);
+                highestSocket = std::max(highestSocket, client.second.ServerSocket);
+                nextArrival = std::min({ nextArrival, client.second.Upstream->getNextArrivalTime(), client.second.Downstream->getNextArrivalTime() });
+            }
+            double wait = std::max(nextArrival - getTime(), 0.0);
+            timeval timeout;
+            timeout.tv_sec = static_cast<long>(wait);
+            timeout.tv_usec = static_cast<long>((wait - timeout.tv_sec) * 1000000.0);
+            select(static_cast<int>(highestSocket + 1), &sockets, nullptr, nullptr, &timeout);
+
+            double time = getTime();
+            if(FD_ISSET(listenSocket, &sockets))
+            {
+                sockaddr_in from;
+                socklen_t fromSize = sizeof(from);
+                int size = recvfrom(listenSocket, reinterpret_cast<char*>(buffer), sizeof(buffer), 0, reinterpret_cast<sockaddr*>(&from), &fromSize);
+                if(size > 0)
+                {
+                    auto client = clients.find(from);
+                    if(client == clients.end())
+                    {
+                        //Each client gets seeds of its own, so a new client does not change what happens to the others
+                        std::uint32_t clientSeed = seed + static_cast<std::uint32_t>(clients.size()) * 2u;
+                        Client newClient;
+                        newClient.Index = clients.size();
+                        newClient.Address = from;
+                        newClient.ServerSocket = openSocket(0);
+                        newClient.Upstream.reset(new ConfusShared::EmulatedLink(upstream, clientSeed));
+                        newClient.Downstream.reset(new ConfusShared::EmulatedLink(downstream, clientSeed + 1u));
+                        std::cout << "Client " << clients.size() << " connected from port " << ntohs(from.sin_port) << std::endl;
+                        client = clients.emplace(from, std::move(newClient)).first;
+                    }
+                    client->second.Upstream->send(buffer, static_cast<std::size_t>(size), time);
+                }
+            }
+            for(auto& client : clients)
+            {
+                if(FD_ISSET(client.second.ServerSocket, &sockets))
+                {
+                    int size = recv(client.second.ServerSocket, reinterpret_cast<char*>(buffer), sizeof(buffer), 0);
+                    if(size > 0)
+                    {
+                        client.second.Downstream->send(buffer, static_cast<std::size_t>(size), time);
+                    }
+                }
+            }
+
+            for(auto& client : clients)
+            {
+                Client& relayed = client.second;
+                relayed.Upstream->deliver(time, [&relayed, &serverAddress](const std::uint8_t* a_Data, std::size_t a_Size)
+                {
+                    sendto(relayed.ServerSocket, reinterpret_cast<const char*>(a_Data), static_cast<int>(a_Size), 0,
+                        reinterpret_cast<const sockaddr*>(&serverAddress), sizeof(serverAddress));
+                });
+                relayed.Downstream->deliver(time, [&relayed, listenSocket](const std::uint8_t* a_Data, std::size_t a_Size)
+                {
+                    sendto(listenSocket, reinterpret_cast<const char*>(a_Data), static_cast<int>(a_Size), 0,
+                        reinterpret_cast<const sockaddr*>(&relayed.Address), sizeof(relayed.Address));
+                });
+            }
+
+            if(time >= nextReport)
+            {
+                nextReport += ReportInterval;
+                for(auto& client : clients)
+                {
+                    report("up", client.second.Index, *client.second.Upstream);
+                    report("down", client.second.Index, *client.second.Downstream);
+                }
+            }
+        }
+    }
+    catch(std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,59 @@
+#include "TransformCodec.h"
+
+namespace ConfusShared
+{
+    const float TransformCodec::MinimumX = -32.0f;
+    const float TransformCodec::MaximumX = 32.0f;
+    const float TransformCodec::MinimumY = -4.0f;
+    const float TransformCodec::MaximumY = 12.0f;
+    const float TransformCodec::MinimumZ = -96.0f;
+    const float TransformCodec::MaximumZ = 24.0f;
+    const float TransformCodec::MinimumPitch = -90.0f;
+    const float TransformCodec::MaximumPitch = 90.0f;
+
+    QuantizedTransform TransformCodec::quantize(const PlayerTransform& a_Transform)
+    {
+        QuantizedTransform quantized;
+        quantized.X = ConfusShared::quantize(a_Transform.X, MinimumX, MaximumX, XBits);
+        quantized.Y = ConfusShared::quantize(a_Transform.Y, MinimumY, MaximumY, YBits);
+        quantized.Z = ConfusShared::quantize(a_Transform.Z, MinimumZ, MaximumZ, ZBits);
+        quantized.Yaw = packAngle(a_Transform.Yaw, YawBits);
+        quantized.Pitch = ConfusShared::quantize(a_Transform.Pitch, MinimumPitch, MaximumPitch, PitchBits);
+        return quantized;
+    }
+
+    PlayerTransform TransformCodec::dequantize(const QuantizedTransform& a_Transform)
+    {
+        PlayerTransform transform;
+        transform.X = ConfusShared::dequantize(a_Transform.X, MinimumX, MaximumX, XBits);
+        transform.Y = ConfusShared::dequantize(a_Transform.Y, MinimumY, MaximumY, YBits);
+        transform.Z = ConfusShared::dequantize(a_Transform.Z, MinimumZ, MaximumZ, ZBits);
+        transform.Yaw = unpackAngle(a_Transform.Yaw, YawBits);
+        transform.Pitch = ConfusShared::dequantize(a_Transform.Pitch, MinimumPitch, MaximumPitch, PitchBits);
+        return transform;
+    }
+
+    std::int32_t TransformCodec::getDelta(std::uint32_t a_Value, std::uint32_t a_Baseline, unsigned a_Bits, bool a_Wraps)
+    {
+        std::int32_t delta = static_cast<std::int32_t>(a_Value) - static_cast<std::int32_t>(a_Baseline);
+        if(a_Wraps)
+        {
+            //Turning from 359 to 1 degrees is a change of 2 degrees, not of -358
+            const std::int32_t steps = 1 << a_Bits;
+            if(delta >= steps / 2)
+            {
+                delta -= steps;
+            }
+            else if(delta < -steps / 2)
+            {
+                delta += steps;
+            }
+        }
+        return delta;
+    }
+
+    std::uint32_t TransformCodec::applyDelta(std::uint32_t a_Baseline, std::int32_t a_Delta, unsigned a_Bits)
+    {
+        return (a_Baseline + static_cast<std::uint32_t>(a_Delta)) & ((1u << a_Bits) - 1u);
+    }
+}
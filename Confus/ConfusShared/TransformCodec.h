@@ -0,0 +1,202 @@
+#pragma once
+#include <cstdint>
+
+#include "BitPacking.h"
+#include "Quantization.h"
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// Where a player is and where it looks, kept free of any engine type so the codec does not depend on one
+    /// </summary>
+    struct PlayerTransform
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        /// <summary> The rotation around the vertical axis in degrees </summary>
+        float Yaw = 0.0f;
+        /// <summary> The rotation up or down in degrees, from -90 to 90 </summary>
+        float Pitch = 0.0f;
+    };
+
+    /// <summary>
+    /// A <see cref="PlayerTransform"/> as the integers that are sent, each in the bits given by <see cref="TransformCodec"/>
+    /// </summary>
+    struct QuantizedTransform
+    {
+        std::uint32_t X = 0;
+        std::uint32_t Y = 0;
+        std::uint32_t Z = 0;
+        std::uint32_t Yaw = 0;
+        std::uint32_t Pitch = 0;
+
+        bool operator==(const QuantizedTransform& a_Other) const
+        {
+            return X == a_Other.X && Y == a_Other.Y && Z == a_Other.Z && Yaw == a_Other.Yaw && Pitch == a_Other.Pitch;
+        }
+
+        bool operator!=(const QuantizedTransform& a_Other) const
+        {
+            return !(*this == a_Other);
+        }
+    };
+
+    /// <summary>
+    /// Packs player transforms and rotations into as few bits as the game can tell apart.
+    /// Positions are quantized relative to the bounds of the level, angles wrap around, and a transform fits 48 bits.
+    /// Against a baseline the receiver already has, a transform is sent as the change of every component,
+    /// which costs a single bit for a component that did not change.
+    /// </summary>
+    /// <remarks>
+    /// The streams are anything with the WriteBits and ReadBits of RakNet::BitStream, see <see cref="writeBits"/>.
+    /// </remarks>
+    class TransformCodec
+    {
+    public:
+        /// <summary>
+        /// The bounds of the level: the maze is 60 units wide around the middle of X, both bases lie along Z,
+        /// and a character does not get higher than a jump above the spawns. A character that falls further is respawned.
+        /// </summary>
+        static const float MinimumX;
+        static const float MaximumX;
+        static const float MinimumY;
+        static const float MaximumY;
+        static const float MinimumZ;
+        static const float MaximumZ;
+        static const float MinimumPitch;
+        static const float MaximumPitch;
+
+        /// <summary> The bits of each component, giving steps of about 6 cm, which the interpolation of other players smooths over </summary>
+        static const unsigned XBits = 10;
+        static const unsigned YBits = 8;
+        static const unsigned ZBits = 11;
+        /// <summary> The bits of the yaw, giving steps of 0.18 degrees, so a player far away is not seen aiming beside where they aim </summary>
+        static const unsigned YawBits = 11;
+        /// <summary> The bits of the pitch, giving steps of 0.7 degrees, which only tilts the head and weapon of other players </summary>
+        static const unsigned PitchBits = 8;
+        static const unsigned TransformBits = XBits + YBits + ZBits + YawBits + PitchBits;
+        /// <summary> The bits of each of the three components kept of a quaternion </summary>
+        static const unsigned RotationComponentBits = 9;
+        /// <summary> The bits of the change in a component are written in groups of this size </summary>
+        static const unsigned DeltaGroupBits = 4;
+
+        /// <summary>
+        /// Quantizes a transform, positions outside the level are clamped to its bounds.
+        /// </summary>
+        static QuantizedTransform quantize(const PlayerTransform& a_Transform);
+
+        /// <summary>
+        /// Maps a quantized transform back, with the yaw in the range [0, 360).
+        /// </summary>
+        static PlayerTransform dequantize(const QuantizedTransform& a_Transform);
+
+        /// <summary>
+        /// Writes a transform in <see cref="TransformBits"/> bits.
+        /// </summary>
+        template<typename TBitStream>
+        static void write(TBitStream& a_Stream, const QuantizedTransform& a_Transform)
+        {
+            writeBits(a_Stream, a_Transform.X, XBits);
+            writeBits(a_Stream, a_Transform.Y, YBits);
+            writeBits(a_Stream, a_Transform.Z, ZBits);
+            writeBits(a_Stream, a_Transform.Yaw, YawBits);
+            writeBits(a_Stream, a_Transform.Pitch, PitchBits);
+        }
+
+        /// <summary>
+        /// Reads a transform written by <see cref="write"/>.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The stream ends before the transform does.</exception>
+        template<typename TBitStream>
+        static QuantizedTransform read(TBitStream& a_Stream)
+        {
+            QuantizedTransform transform;
+            transform.X = readBits(a_Stream, XBits);
+            transform.Y = readBits(a_Stream, YBits);
+            transform.Z = readBits(a_Stream, ZBits);
+            transform.Yaw = readBits(a_Stream, YawBits);
+            transform.Pitch = readBits(a_Stream, PitchBits);
+            return transform;
+        }
+
+        /// <summary>
+        /// Writes a transform as its change from a baseline the receiver has, which takes 5 bits when nothing changed.
+        /// </summary>
+        template<typename TBitStream>
+        static void writeDelta(TBitStream& a_Stream, const QuantizedTransform& a_Transform, const QuantizedTransform& a_Baseline)
+        {
+            writeComponentDelta(a_Stream, getDelta(a_Transform.X, a_Baseline.X, XBits, false));
+            writeComponentDelta(a_Stream, getDelta(a_Transform.Y, a_Baseline.Y, YBits, false));
+            writeComponentDelta(a_Stream, getDelta(a_Transform.Z, a_Baseline.Z, ZBits, false));
+            writeComponentDelta(a_Stream, getDelta(a_Transform.Yaw, a_Baseline.Yaw, YawBits, true));
+            writeComponentDelta(a_Stream, getDelta(a_Transform.Pitch, a_Baseline.Pitch, PitchBits, false));
+        }
+
+        /// <summary>
+        /// Reads a transform written by <see cref="writeDelta"/> against the same baseline.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The stream ends before the transform does.</exception>
+        template<typename TBitStream>
+        static QuantizedTransform readDelta(TBitStream& a_Stream, const QuantizedTransform& a_Baseline)
+        {
+            QuantizedTransform transform;
+            transform.X = applyDelta(a_Baseline.X, readComponentDelta(a_Stream), XBits);
+            transform.Y = applyDelta(a_Baseline.Y, readComponentDelta(a_Stream), YBits);
+            transform.Z = applyDelta(a_Baseline.Z, readComponentDelta(a_Stream), ZBits);
+            transform.Yaw = applyDelta(a_Baseline.Yaw, readComponentDelta(a_Stream), YawBits);
+            transform.Pitch = applyDelta(a_Baseline.Pitch, readComponentDelta(a_Stream), PitchBits);
+            return transform;
+        }
+
+        /// <summary>
+        /// Writes a rotation with its largest component left out, in 2 + 3 * <see cref="RotationComponentBits"/> bits.
+        /// </summary>
+        template<typename TBitStream>
+        static void writeRotation(TBitStream& a_Stream, const Quaternion& a_Rotation)
+        {
+            writeBits(a_Stream, packQuaternion(a_Rotation, RotationComponentBits), 2 + 3 * RotationComponentBits);
+        }
+
+        /// <summary>
+        /// Reads a rotation written by <see cref="writeRotation"/>.
+        /// </summary>
+        /// <exception cref="std::invalid_argument">The stream ends before the rotation does.</exception>
+        template<typename TBitStream>
+        static Quaternion readRotation(TBitStream& a_Stream)
+        {
+            return unpackQuaternion(readBits(a_Stream, 2 + 3 * RotationComponentBits), RotationComponentBits);
+        }
+    private:
+        /// <summary>
+        /// Gets the change of a component, for a wrapping component the shortest way around.
+        /// </summary>
+        static std::int32_t getDelta(std::uint32_t a_Value, std::uint32_t a_Baseline, unsigned a_Bits, bool a_Wraps);
+
+        /// <summary>
+        /// Applies the change of a component, keeping it within its bits.
+        /// </summary>
+        static std::uint32_t applyDelta(std::uint32_t a_Baseline, std::int32_t a_Delta, unsigned a_Bits);
+
+        template<typename TBitStream>
+        static void writeComponentDelta(TBitStream& a_Stream, std::int32_t a_Delta)
+        {
+            writeBits(a_Stream, a_Delta != 0 ? 1u : 0u, 1);
+            if(a_Delta != 0)
+            {
+                //A change of zero has its own bit, so the encoded change starts at zero for the smallest change there is
+                writeVarBits(a_Stream, zigZagEncode(a_Delta) - 1u, DeltaGroupBits);
+            }
+        }
+
+        template<typename TBitStream>
+        static std::int32_t readComponentDelta(TBitStream& a_Stream)
+        {
+            if(readBits(a_Stream, 1) == 0)
+            {
+                return 0;
+            }
+            return zigZagDecode(readVarBits(a_Stream, DeltaGroupBits) + 1u);
+        }
+    };
+}
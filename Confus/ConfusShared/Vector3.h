@@ -0,0 +1,79 @@
+#pragma once
+#include <cmath>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A point or direction in the world, kept free of any engine type so the simulation core does not depend on one.
+    /// The axes are those of the level: Y points up and the world is left handed, as in Irrlicht.
+    /// </summary>
+    struct Vector3
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+
+        Vector3() = default;
+
+        Vector3(float a_X, float a_Y, float a_Z)
+            : X(a_X), Y(a_Y), Z(a_Z)
+        {
+        }
+
+        Vector3 operator+(const Vector3& a_Other) const
+        {
+            return Vector3(X + a_Other.X, Y + a_Other.Y, Z + a_Other.Z);
+        }
+
+        Vector3 operator-(const Vector3& a_Other) const
+        {
+            return Vector3(X - a_Other.X, Y - a_Other.Y, Z - a_Other.Z);
+        }
+
+        Vector3 operator-() const
+        {
+            return Vector3(-X, -Y, -Z);
+        }
+
+        Vector3 operator*(float a_Scale) const
+        {
+            return Vector3(X * a_Scale, Y * a_Scale, Z * a_Scale);
+        }
+
+        Vector3& operator+=(const Vector3& a_Other)
+        {
+            X += a_Other.X;
+            Y += a_Other.Y;
+            Z += a_Other.Z;
+            return *this;
+        }
+
+        Vector3& operator-=(const Vector3& a_Other)
+        {
+            X -= a_Other.X;
+            Y -= a_Other.Y;
+            Z -= a_Other.Z;
+            return *this;
+        }
+
+        float dot(const Vector3& a_Other) const
+        {
+            return X * a_Other.X + Y * a_Other.Y + Z * a_Other.Z;
+        }
+
+        Vector3 cross(const Vector3& a_Other) const
+        {
+            return Vector3(Y * a_Other.Z - Z * a_Other.Y, Z * a_Other.X - X * a_Other.Z, X * a_Other.Y - Y * a_Other.X);
+        }
+
+        float getLengthSquared() const
+        {
+            return dot(*this);
+        }
+
+        float getLength() const
+        {
+            return std::sqrt(getLengthSquared());
+        }
+    };
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "WorkerPool.h"
+
+namespace ConfusShared
+{
+    namespace
+    {
+        /// <summary> The pool the current thread is a worker of, and the index of its queue in that pool </summary>
+        thread_local const WorkerPool* t_Pool = nullptr;
+        thread_local std::size_t t_QueueIndex = 0;
+    }
+
+    WorkerPool::WorkerPool(std::size_t a_WorkerCount)
+    {
+        for(std::size_t i = 0; i <= a_WorkerCount; ++i)
+        {
+            m_Queues.push_back(std::make_unique<JobQueue>());
+        }
+        for(std::size_t i = 1; i <= a_WorkerCount; ++i)
+        {
+            m_Workers.emplace_back(&WorkerPool::work, this, i);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Stopping = true;
+        }
+        m_WakeUp.notify_all();
+        for(auto& worker : m_Workers)
+        {
+            worker.join();
+        }
+    }
+
+    void WorkerPool::submit(std::function<void()> a_Job)
+    {
+        {
+            //Counted before it is queued so the count never drops below zero when the job is taken right away,
+            //and under the lock so a worker cannot miss it between checking for jobs and going to sleep
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            ++m_QueuedJobs;
+        }
+        JobQueue& queue = *m_Queues[getQueueIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            queue.Jobs.push_back(std::move(a_Job));
+        }
+        m_WakeUp.notify_one();
+    }
+
+    void WorkerPool::parallelFor(std::size_t a_Count, std::size_t a_ChunkSize, const std::function<void(std::size_t a_Begin, std::size_t a_End)>& a_Body)
+    {
+        if(a_ChunkSize == 0)
+        {
+            throw std::invalid_argument("The chunks of a parallel for have to hold at least one index.");
+        }
+        if(a_Count <= a_ChunkSize)
+        {
+            if(a_Count > 0)
+            {
+                a_Body(0, a_Count);
+            }
+            return;
+        }
+
+        //The state lives on this stack, which is fine as this only returns once every chunk stopped touching it
+        std::atomic<std::size_t> remainingChunks{ (a_Count + a_ChunkSize - 1) / a_ChunkSize };
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+        for(std::size_t begin = 0; begin < a_Count; begin += a_ChunkSize)
+        {
+            std::size_t end = std::min(begin + a_ChunkSize, a_Count);
+            submit([&a_Body, &remainingChunks, &failureMutex, &failure, begin, end]()
+            {
+                try
+                {
+                    a_Body(begin, end);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if(!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                }
+                --remainingChunks;
+            });
+        }
+
+        while(remainingChunks > 0)
+        {
+            if(!runPendingJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+        if(failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    bool WorkerPool::runPendingJob()
+    {
+        std::function<void()> job;
+        if(!takeJob(getQueueIndex(), job))
+        {
+            return false;
+        }
+        job();
+        return true;
+    }
+
+    std::size_t WorkerPool::getWorkerCount() const
+    {
+        return m_Workers.size();
+    }
+
+    std::size_t WorkerPool::getDefaultWorkerCount()
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    void WorkerPool::work(std::size_t a_QueueIndex)
+    {
+        t_Pool = this;
+        t_QueueIndex = a_QueueIndex;
+        while(true)
+        {
+            std::function<void()> job;
+            if(takeJob(a_QueueIndex, job))
+            {
+                job();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            m_WakeUp.wait(lock, [this]() { return m_Stopping || m_QueuedJobs > 0; });
+            if(m_Stopping)
+            {
+                return;
+            }
+        }
+    }
+
+    bool WorkerPool::takeJob(std::size_t a_QueueIndex, std::function<void()>& a_Job)
+    {
+        {
+            JobQueue& queue = *m_Queues[a_QueueIndex];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if(!queue.Jobs.empty())
+            {
+                a_Job = std::move(queue.Jobs.back());
+                queue.Jobs.pop_back();
+                --m_QueuedJobs;
+                return true;
+            }
+        }
+
+        //Starting at the next queue spreads the stealing threads over the queues
+        for(std::size_t offset = 1; offset < m_Queues.size(); ++offset)
+        {
+            JobQueue& queue = *m_Queues[(a_QueueIndex + offset) % m_Queues.size()];
+            std::lock_guard<std::mutex> lock(queue.Mutex);
+            if(!queue.Jobs.empty())
+            {
+                a_Job = std::move(queue.Jobs.front());
+                queue.Jobs.pop_front();
+                --m_QueuedJobs;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t WorkerPool::getQueueIndex() const
+    {
+        return t_Pool == this ? t_QueueIndex : 0;
+    }
+}
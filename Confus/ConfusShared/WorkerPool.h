@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ConfusShared
+{
+    /// <summary>
+    /// A fixed set of worker threads that run submitted jobs, each with its own queue.
+    /// A thread pushes and pops jobs at the back of its own queue and steals from the front of the others once it runs dry,
+    /// so jobs that spawn follow-up jobs mostly keep them on the same thread.
+    /// The thread that created the pool has a queue of its own and helps out through <see cref="runPendingJob"/>.
+    /// </summary>
+    class WorkerPool
+    {
+    private:
+        /// <summary>
+        /// The jobs waiting to be run by one thread, which other threads may steal from
+        /// </summary>
+        struct JobQueue
+        {
+            std::mutex Mutex;
+            std::deque<std::function<void()>> Jobs;
+        };
+
+        /// <summary> The queues of the threads, the first belonging to the thread that created the pool </summary>
+        std::vector<std::unique_ptr<JobQueue>> m_Queues;
+        std::vector<std::thread> m_Workers;
+        /// <summary> The amount of jobs in all queues, so idle workers know when to wake up </summary>
+        std::atomic<std::size_t> m_QueuedJobs{ 0 };
+        std::atomic<bool> m_Stopping{ false };
+        std::mutex m_SleepMutex;
+        std::condition_variable m_WakeUp;
+    public:
+        /// <summary>
+        /// Initializes a new instance of the <see cref="WorkerPool"/> class, starting its workers.
+        /// </summary>
+        /// <param name="a_WorkerCount">The amount of threads to start besides the calling thread, zero runs every job on the calling thread.</param>
+        explicit WorkerPool(std::size_t a_WorkerCount = getDefaultWorkerCount());
+
+        /// <summary>
+        /// Finalizes an instance of the <see cref="WorkerPool"/> class, joining the workers. Jobs that are still queued are not run.
+        /// </summary>
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /// <summary>
+        /// Queues a job on the queue of the calling thread, or on that of the creating thread when called from outside the pool.
+        /// </summary>
+        void submit(std::function<void()> a_Job);
+
+        /// <summary>
+        /// Splits a range of indices into chunks that run as jobs, helping out on the calling thread until all of them are done.
+        /// A range that fits in a single chunk runs on the calling thread straight away, without going through the queues.
+        /// </summary>
+        /// <param name="a_Count">The amount of indices, from zero up to but not including the count.</param>
+        /// <param name="a_ChunkSize">The most indices a single job handles, which has to be above zero.</param>
+        /// <param name="a_Body">Called with the first index of a chunk and the index after its last, from any thread.</param>
+        /// <exception cref="std::invalid_argument">The chunk size is zero.</exception>
+        /// <remarks> The first exception a chunk throws is rethrown once every chunk has finished </remarks>
+        void parallelFor(std::size_t a_Count, std::size_t a_ChunkSize, const std::function<void(std::size_t a_Begin, std::size_t a_End)>& a_Body);
+
+        /// <summary>
+        /// Runs a single queued job on the calling thread, taken from its own queue first.
+        /// </summary>
+        /// <returns>Whether a job was run.</returns>
+        bool runPendingJob();
+
+        /// <summary>
+        /// Gets the amount of threads started by the pool.
+        /// </summary>
+        std::size_t getWorkerCount() const;
+
+        /// <summary>
+        /// Gets one worker less than the amount of hardware threads, as the creating thread takes part as well.
+        /// </summary>
+        static std::size_t getDefaultWorkerCount();
+    private:
+        /// <summary>
+        /// Runs jobs on a worker until the pool is stopped, sleeping while there are none.
+        /// </summary>
+        /// <param name="a_QueueIndex">The index of the queue of the worker.</param>
+        void work(std::size_t a_QueueIndex);
+
+        /// <summary>
+        /// Takes a job, from the back of the given queue or else from the front of any other.
+        /// </summary>
+        bool takeJob(std::size_t a_QueueIndex, std::function<void()>& a_Job);
+
+        /// <summary>
+        /// Gets the index of the queue of the calling thread.
+        /// </summary>
+        std::size_t getQueueIndex() const;
+    };
+}